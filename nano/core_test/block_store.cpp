@@ -384,6 +384,28 @@ TEST (block_store, pending_iterator_comparison)
 	}
 }
 
+TEST (block_store, pending_account_iterator)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	auto transaction (store->tx_begin_write ());
+	store->pending.put (transaction, nano::pending_key (nano::account (1), nano::block_hash (5)), nano::pending_info (nano::account (10), nano::amount (1), nano::epoch::epoch_0));
+	store->pending.put (transaction, nano::pending_key (nano::account (2), nano::block_hash (1)), nano::pending_info (nano::account (10), nano::amount (2), nano::epoch::epoch_0));
+	store->pending.put (transaction, nano::pending_key (nano::account (2), nano::block_hash (3)), nano::pending_info (nano::account (10), nano::amount (3), nano::epoch::epoch_0));
+	store->pending.put (transaction, nano::pending_key (nano::account (4), nano::block_hash (2)), nano::pending_info (nano::account (10), nano::amount (4), nano::epoch::epoch_0));
+	size_t count = 0;
+	for (auto i (store->pending.begin (transaction, nano::account (2))), n (store->pending.end ()); i != n && i->first.account == nano::account (2); ++i, ++count)
+	{
+		ASSERT_LT (count, 2);
+	}
+	ASSERT_EQ (2, count);
+	ASSERT_TRUE (store->pending.any (transaction, nano::account (2)));
+	ASSERT_FALSE (store->pending.any (transaction, nano::account (3)));
+	ASSERT_TRUE (store->pending.exists (transaction, nano::pending_key (nano::account (4), nano::block_hash (2))));
+	ASSERT_FALSE (store->pending.exists (transaction, nano::pending_key (nano::account (4), nano::block_hash (3))));
+}
+
 TEST (block_store, genesis)
 {
 	nano::logger_mt logger;
@@ -2444,6 +2466,76 @@ TEST (block_store, reset_renew_existing_transaction)
 	ASSERT_NE (nullptr, block_existing);
 }
 
+TEST (mdb_block_store, read_txn_pool)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		GTEST_SKIP ();
+	}
+	auto dir (nano::unique_path ());
+	boost::filesystem::create_directory (dir);
+	nano::logger_mt logger;
+	nano::lmdb_config config;
+	config.max_read_txn_age = std::chrono::milliseconds (0);
+	nano::lmdb::store store (logger, dir / "data.ldb", nano::dev::constants, nano::txn_tracking_config{}, std::chrono::seconds (5), config);
+	ASSERT_FALSE (store.init_error ());
+
+	void * handle (nullptr);
+	{
+		auto transaction (store.tx_begin_read ());
+		handle = transaction.get_handle ();
+	}
+
+	// Writes committed while the transaction was pooled are seen once it is renewed
+	{
+		auto transaction (store.tx_begin_write ());
+		store.pruned.put (transaction, 1);
+	}
+	{
+		auto transaction (store.tx_begin_read ());
+		ASSERT_EQ (handle, transaction.get_handle ());
+		ASSERT_TRUE (store.pruned.exists (transaction, 1));
+
+		// A held transaction only sees new writes once it is refreshed after exceeding the staleness bound
+		{
+			auto write_transaction (store.tx_begin_write ());
+			store.pruned.put (write_transaction, 2);
+		}
+		ASSERT_FALSE (store.pruned.exists (transaction, 2));
+		transaction.refresh_if_needed ();
+		ASSERT_TRUE (store.pruned.exists (transaction, 2));
+
+		// Only one transaction is pooled per thread, so a nested transaction gets its own
+		auto nested (store.tx_begin_read ());
+		ASSERT_NE (handle, nested.get_handle ());
+	}
+}
+
+TEST (mdb_block_store, read_txn_pool_size)
+{
+	bool init (false);
+	nano::mdb_env env (init, nano::unique_path ());
+	ASSERT_FALSE (init);
+	nano::mdb_read_txn_pool pool (env, nano::mdb_txn_callbacks{}, 2);
+
+	// Each thread returns its transaction to the pool, which keeps at most two of them
+	std::vector<std::thread> threads;
+	for (auto i = 0; i < 4; ++i)
+	{
+		threads.emplace_back ([&pool] () {
+			pool.acquire ();
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	ASSERT_EQ (2, pool.size ());
+	pool.clear ();
+	ASSERT_EQ (0, pool.size ());
+}
+
 TEST (block_store, rocksdb_force_test_env_variable)
 {
 	nano::logger_mt logger;
@@ -67,4 +67,91 @@ TEST (block_processor, add_blocking_invalid_block)
 
 	ASSERT_TIMELY (5s, background.wait_for (std::chrono::seconds (0)) == std::future_status::ready);
 	ASSERT_FALSE (background.get ().has_value ());
-}
\ No newline at end of file
+}
+
+TEST (block_processor, work_validation)
+{
+	nano::test::system system{ 1 };
+	auto & node = *system.nodes[0];
+	nano::state_block_builder builder;
+	auto send1 = builder.make_block ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (nano::dev::genesis->hash ()))
+				 .build_shared ();
+	uint64_t insufficient_work{ 0 };
+	while (nano::dev::network_params.work.difficulty (nano::work_version::work_1, send1->hash (), insufficient_work) >= nano::dev::network_params.work.threshold_entry (nano::work_version::work_1, nano::block_type::state))
+	{
+		++insufficient_work;
+	}
+	auto send2 = builder.make_block ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 2 * nano::Gxrb_ratio)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (insufficient_work)
+				 .build_shared ();
+	ASSERT_EQ (0, send1->work_value_cached ());
+	node.block_processor.add (send1);
+	node.block_processor.add (send2);
+	ASSERT_TIMELY (5s, node.ledger.block_or_pruned_exists (send1->hash ()));
+	node.block_processor.flush ();
+	ASSERT_FALSE (node.ledger.block_or_pruned_exists (send2->hash ()));
+	// The work value computed by the validation stage is kept on the block
+	ASSERT_EQ (nano::dev::network_params.work.value (send1->root (), send1->block_work ()), send1->work_value_cached ());
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::work_validation, nano::stat::detail::work_validated));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::work_validation, nano::stat::detail::insufficient_work));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::blockprocessor, nano::stat::detail::insufficient_work));
+	// Blocks which already carry a work value are not hashed again
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::work_validation, nano::stat::detail::work_cached));
+	node.block_processor.add (send1);
+	node.block_processor.flush ();
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::work_validation, nano::stat::detail::work_cached));
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::work_validation, nano::stat::detail::work_validated));
+	// Changing the work clears the cached value
+	send2->block_work_set (*system.work.generate (send1->hash ()));
+	ASSERT_EQ (0, send2->work_value_cached ());
+}
+
+TEST (block_processor, work_validation_order)
+{
+	nano::stats stats;
+	nano::work_validation validation{ nano::dev::network_params.work, stats, 4 };
+	nano::mutex mutex;
+	std::vector<nano::block_hash> delivered;
+	validation.blocks_validated_callback = [&mutex, &delivered] (std::deque<nano::work_validation::value_type> & items_a, std::vector<bool> const &) {
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		for (auto const & [block, time] : items_a)
+		{
+			delivered.push_back (block->hash ());
+		}
+	};
+	std::vector<nano::block_hash> added;
+	nano::state_block_builder builder;
+	nano::block_hash previous{ nano::dev::genesis->hash () };
+	for (auto i = 0u; i < 4 * nano::work_validation::batch_size; ++i)
+	{
+		auto block = builder.make_block ()
+					 .account (nano::dev::genesis_key.pub)
+					 .previous (previous)
+					 .representative (nano::dev::genesis_key.pub)
+					 .balance (nano::dev::constants.genesis_amount - i - 1)
+					 .link (nano::dev::genesis_key.pub)
+					 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					 .work (0)
+					 .build_shared ();
+		previous = block->hash ();
+		added.push_back (previous);
+		validation.add ({ block, std::chrono::steady_clock::now () });
+	}
+	// Batches validated on different threads are still delivered in the order their blocks were added
+	ASSERT_TIMELY (5s, !validation.is_active ());
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	ASSERT_EQ (added, delivered);
+}
@@ -320,6 +320,33 @@ TEST (bootstrap_processor, process_one)
 	node1->stop ();
 }
 
+TEST (bootstrap_processor, process_chunked)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	node_config.enable_voting = false;
+	// Chain length is not a multiple of the batch size and several chunks are in flight at once
+	node_config.bootstrap_serving_batch_size = 3;
+	node_config.bootstrap_serving_max_in_flight = 2;
+	nano::node_flags node_flags;
+	node_flags.disable_bootstrap_bulk_push_client = true;
+	auto node0 = system.add_node (node_config, node_flags);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	for (auto i = 0; i < 10; ++i)
+	{
+		ASSERT_NE (nullptr, system.wallet (0)->send_action (nano::dev::genesis_key.pub, nano::dev::genesis_key.pub, 100));
+	}
+
+	node_config.peering_port = system.get_available_port ();
+	node_flags.disable_rep_crawler = true;
+	auto node1 (std::make_shared<nano::node> (system.io_ctx, nano::unique_path (), node_config, system.work, node_flags));
+	node1->bootstrap_initiator.bootstrap (node0->network.endpoint (), false);
+	ASSERT_TIMELY (10s, node1->latest (nano::dev::genesis_key.pub) == node0->latest (nano::dev::genesis_key.pub));
+	ASSERT_EQ (node0->ledger.cache.block_count, node1->ledger.cache.block_count);
+	node1->stop ();
+}
+
 TEST (bootstrap_processor, process_two)
 {
 	nano::test::system system;
@@ -148,6 +148,35 @@ TEST (account_sets, saturate_priority)
 	ASSERT_EQ (sets.priority (account), nano::bootstrap_ascending::account_sets::priority_max);
 }
 
+TEST (peer_scoring, window)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	nano::bootstrap_ascending_config config;
+	nano::stats stats;
+	nano::bootstrap_ascending::peer_scoring scoring{ config, node.network_params.network, stats };
+	auto channel = nano::test::fake_channel (node);
+	for (auto i = 0u; i < nano::bootstrap_ascending::peer_scoring::window_initial; ++i)
+	{
+		ASSERT_FALSE (scoring.try_send_message (channel));
+	}
+	ASSERT_TRUE (scoring.try_send_message (channel));
+	// A timeout releases its slot but halves the window, leaving the peer over its limit
+	scoring.timed_out (channel);
+	ASSERT_EQ (1, stats.count (nano::stat::type::bootstrap_ascending_peers, nano::stat::detail::timeout));
+	ASSERT_EQ (1, stats.count (nano::stat::type::bootstrap_ascending_peers, nano::stat::detail::window_shrink));
+	ASSERT_TRUE (scoring.try_send_message (channel));
+	// Replies release slots until the peer is under its window again
+	auto const outstanding = nano::bootstrap_ascending::peer_scoring::window_initial - 1;
+	auto const window = nano::bootstrap_ascending::peer_scoring::window_initial / 2;
+	for (auto i = 0u; i <= outstanding - window; ++i)
+	{
+		scoring.received_message (channel, 100);
+	}
+	ASSERT_FALSE (scoring.try_send_message (channel));
+	ASSERT_TRUE (scoring.try_send_message (channel));
+}
+
 /**
  * Tests the base case for returning
  */
@@ -171,6 +200,32 @@ TEST (bootstrap_ascending, account_base)
 	ASSERT_TIMELY (5s, node1.block (send1->hash ()) != nullptr);
 }
 
+/**
+ * Tests that replies containing a block with insufficient work are discarded
+ */
+TEST (bootstrap_ascending, insufficient_work)
+{
+	nano::node_flags flags;
+	nano::test::system system{ 1, nano::transport::transport_type::tcp, flags };
+	auto & node0 = *system.nodes[0];
+	nano::state_block_builder builder;
+	auto send1 = builder.make_block ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .link (0)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (0)
+				 .build_shared ();
+	// Fake a cached work value so the serving node accepts the block, it is not sent over the network
+	send1->work_value_cache (std::numeric_limits<uint64_t>::max ());
+	ASSERT_EQ (nano::process_result::progress, node0.process (*send1).code);
+	auto & node1 = *system.add_node (flags);
+	ASSERT_TIMELY (5s, node1.stats.count (nano::stat::type::bootstrap_ascending_verify, nano::stat::detail::insufficient_work) > 0);
+	ASSERT_EQ (nullptr, node1.block (send1->hash ()));
+}
+
 /**
  * Tests that bootstrap_ascending will return multiple new blocks in-order
  */
@@ -15,8 +15,20 @@ class responses_helper final
 public:
 	void add (nano::asc_pull_ack & ack)
 	{
+		// Blocks are served as raw bytes copied from the store, compare responses as they appear on the wire
+		std::vector<uint8_t> bytes;
+		{
+			nano::vectorstream stream{ bytes };
+			ack.serialize (stream);
+		}
+		nano::bufferstream stream{ bytes.data (), bytes.size () };
+		bool error = false;
+		nano::message_header header{ error, stream };
+		debug_assert (!error);
+		nano::asc_pull_ack message{ error, stream, header };
+		debug_assert (!error);
 		nano::lock_guard<nano::mutex> lock{ mutex };
-		responses.push_back (ack);
+		responses.push_back (message);
 	}
 
 	std::vector<nano::asc_pull_ack> get ()
@@ -339,6 +351,54 @@ TEST (bootstrap_server, serve_multiple)
 	ASSERT_ALWAYS (1s, responses.size () == chains.size ());
 }
 
+TEST (bootstrap_server, serve_cached)
+{
+	nano::test::system system{};
+	auto & node = *system.add_node ();
+
+	responses_helper responses;
+	node.bootstrap_server.on_response.add ([&] (auto & response, auto & channel) {
+		responses.add (response);
+	});
+
+	auto chains = nano::test::setup_chains (system, node, 1, 256);
+	auto [account, blocks] = chains.front ();
+
+	auto send_request = [&] (nano::asc_pull_req::id_t id, uint8_t count) {
+		nano::asc_pull_req request{ node.network_params.network };
+		request.id = id;
+		request.type = nano::asc_pull_type::blocks;
+
+		nano::asc_pull_req::blocks_payload request_payload;
+		request_payload.start = account;
+		request_payload.count = count;
+		request_payload.start_type = nano::asc_pull_req::hash_type::account;
+
+		request.payload = request_payload;
+		request.update_header ();
+
+		node.network.inbound (request, nano::test::fake_channel (node));
+	};
+
+	send_request (1, 64);
+	ASSERT_TIMELY (5s, responses.size () == 1);
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::bootstrap_server, nano::stat::detail::hit));
+
+	// Same segment and a shorter prefix of it are both served from the cache
+	send_request (2, 64);
+	send_request (3, 32);
+	ASSERT_TIMELY (5s, responses.size () == 3);
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::bootstrap_server, nano::stat::detail::hit));
+
+	for (auto & response : responses.get ())
+	{
+		nano::asc_pull_ack::blocks_payload response_payload;
+		ASSERT_NO_THROW (response_payload = std::get<nano::asc_pull_ack::blocks_payload> (response.payload));
+		ASSERT_EQ (response_payload.blocks.size (), response.id == 3 ? 32 : 64);
+		ASSERT_TRUE (compare_blocks (response_payload.blocks, blocks));
+	}
+}
+
 TEST (bootstrap_server, serve_account_info)
 {
 	nano::test::system system{};
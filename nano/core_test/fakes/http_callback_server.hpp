@@ -0,0 +1,130 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace
+{
+/**
+ * Accepts HTTP callbacks on keep-alive connections and records the request bodies
+ */
+class fake_http_callback_server : public std::enable_shared_from_this<fake_http_callback_server>
+{
+	class connection : public std::enable_shared_from_this<connection>
+	{
+	public:
+		connection (boost::asio::io_context & ioc_a, std::shared_ptr<fake_http_callback_server> const & server_a) :
+			socket (ioc_a),
+			server (server_a)
+		{
+		}
+
+		void read ()
+		{
+			request = {};
+			boost::beast::http::async_read (socket, buffer, request, [this_l = shared_from_this ()] (boost::beast::error_code ec, std::size_t) {
+				if (!ec)
+				{
+					this_l->respond ();
+				}
+			});
+		}
+
+		boost::asio::ip::tcp::socket socket;
+
+	private:
+		void respond ()
+		{
+			auto failed (server->received (request.body ()));
+			response = {};
+			response.version (request.version ());
+			response.result (failed ? boost::beast::http::status::internal_server_error : boost::beast::http::status::ok);
+			response.keep_alive (request.keep_alive ());
+			response.prepare_payload ();
+			boost::beast::http::async_write (socket, response, [this_l = shared_from_this ()] (boost::beast::error_code ec, std::size_t) {
+				if (!ec && this_l->request.keep_alive ())
+				{
+					this_l->read ();
+				}
+			});
+		}
+
+		std::shared_ptr<fake_http_callback_server> server;
+		boost::beast::flat_buffer buffer;
+		boost::beast::http::request<boost::beast::http::string_body> request;
+		boost::beast::http::response<boost::beast::http::empty_body> response;
+	};
+
+public:
+	fake_http_callback_server (boost::asio::io_context & ioc_a, unsigned short port_a) :
+		ioc (ioc_a),
+		acceptor (ioc_a, boost::asio::ip::tcp::endpoint{ boost::asio::ip::address_v6::loopback (), port_a })
+	{
+	}
+
+	void start ()
+	{
+		listen ();
+	}
+
+	void stop ()
+	{
+		boost::system::error_code ignored;
+		acceptor.close (ignored);
+	}
+
+	unsigned short port () const
+	{
+		return acceptor.local_endpoint ().port ();
+	}
+
+	std::vector<std::string> bodies ()
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		return bodies_m;
+	}
+
+	std::atomic<std::size_t> connections{ 0 };
+	/** Number of upcoming requests answered with an error status */
+	std::atomic<std::size_t> failures{ 0 };
+
+private:
+	void listen ()
+	{
+		auto connection_l (std::make_shared<connection> (ioc, shared_from_this ()));
+		acceptor.async_accept (connection_l->socket, [this_l = shared_from_this (), connection_l] (boost::beast::error_code ec) {
+			if (!ec)
+			{
+				++this_l->connections;
+				connection_l->read ();
+				this_l->listen ();
+			}
+		});
+	}
+
+	/** Returns true if the request is to be answered with an error */
+	bool received (std::string const & body_a)
+	{
+		if (failures > 0)
+		{
+			--failures;
+			return true;
+		}
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		bodies_m.push_back (body_a);
+		return false;
+	}
+
+	boost::asio::io_context & ioc;
+	boost::asio::ip::tcp::acceptor acceptor;
+	nano::mutex mutex;
+	std::vector<std::string> bodies_m;
+};
+}
@@ -0,0 +1,104 @@
+#include <nano/core_test/fakes/http_callback_server.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/format.hpp>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::shared_ptr<fake_http_callback_server> start_server (nano::test::system & system, nano::node_config & config)
+{
+	auto server (std::make_shared<fake_http_callback_server> (system.io_ctx, 0));
+	server->start ();
+	config.callback_address = "::1";
+	config.callback_port = server->port ();
+	config.callback_target = "/";
+	return server;
+}
+
+std::string event (int index)
+{
+	return boost::str (boost::format ("{\"index\": \"%1%\"}") % index);
+}
+}
+
+TEST (http_callbacks, keep_alive)
+{
+	nano::test::system system;
+	auto config = system.default_config ();
+	auto server = start_server (system, config);
+	config.callback_connections = 2;
+	auto node = system.add_node (config);
+	for (auto i = 0; i < 20; ++i)
+	{
+		ASSERT_FALSE (node->http_callbacks->add (event (i)));
+	}
+	ASSERT_TIMELY (5s, server->bodies ().size () == 20);
+	// Requests reuse the pooled connections instead of connecting per callback
+	ASSERT_LE (server->connections, 2);
+	ASSERT_EQ (20, node->stats.count (nano::stat::type::http_callback, nano::stat::detail::initiate, nano::stat::dir::out));
+	ASSERT_EQ (0, node->stats.count (nano::stat::type::error, nano::stat::detail::http_callback, nano::stat::dir::out));
+	ASSERT_EQ ("{\"index\": \"0\"}", server->bodies ().front ());
+	server->stop ();
+}
+
+TEST (http_callbacks, batch)
+{
+	nano::test::system system;
+	auto config = system.default_config ();
+	auto server = start_server (system, config);
+	config.callback_connections = 1;
+	config.callback_batch_max = 8;
+	auto node = system.add_node (config);
+	for (auto i = 0; i < 20; ++i)
+	{
+		ASSERT_FALSE (node->http_callbacks->add (event (i)));
+	}
+	ASSERT_TIMELY (5s, node->stats.count (nano::stat::type::http_callback, nano::stat::detail::initiate, nano::stat::dir::out) == 20);
+	auto bodies (server->bodies ());
+	ASSERT_LT (bodies.size (), 20);
+	std::size_t events{ 0 };
+	for (auto const & body : bodies)
+	{
+		ASSERT_EQ ('[', body.front ());
+		ASSERT_EQ (']', body.back ());
+		events += std::count (body.begin (), body.end (), '{');
+	}
+	ASSERT_EQ (20, events);
+	server->stop ();
+}
+
+TEST (http_callbacks, retry)
+{
+	nano::test::system system;
+	auto config = system.default_config ();
+	auto server = start_server (system, config);
+	config.callback_retries = 2;
+	auto node = system.add_node (config);
+	server->failures = 2;
+	ASSERT_FALSE (node->http_callbacks->add (event (0)));
+	ASSERT_TIMELY (5s, server->bodies ().size () == 1);
+	ASSERT_EQ (2, node->stats.count (nano::stat::type::http_callback, nano::stat::detail::retry, nano::stat::dir::out));
+	ASSERT_EQ (0, node->stats.count (nano::stat::type::error, nano::stat::detail::http_callback, nano::stat::dir::out));
+	server->stop ();
+}
+
+TEST (http_callbacks, drop)
+{
+	nano::test::system system;
+	auto config = system.default_config ();
+	config.callback_address = "::1";
+	config.callback_port = system.get_available_port (false);
+	config.callback_target = "/";
+	config.callback_retries = 1;
+	auto node = system.add_node (config);
+	ASSERT_FALSE (node->http_callbacks->add (event (0)));
+	// Nothing listens on the callback port, the event is dropped once its retry failed
+	ASSERT_TIMELY (5s, node->stats.count (nano::stat::type::error, nano::stat::detail::http_callback, nano::stat::dir::out) == 1);
+	ASSERT_EQ (1, node->stats.count (nano::stat::type::http_callback, nano::stat::detail::retry, nano::stat::dir::out));
+	ASSERT_TIMELY (5s, node->http_callbacks->size () == 0);
+}
@@ -1,3 +1,4 @@
+#include <nano/lib/blockbuilders.hpp>
 #include <nano/lib/ipc_client.hpp>
 #include <nano/lib/tomlconfig.hpp>
 #include <nano/node/ipc/ipc_access_config.hpp>
@@ -11,12 +12,60 @@
 #include <boost/property_tree/json_parser.hpp>
 
 #include <chrono>
+#include <future>
 #include <memory>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 using namespace std::chrono_literals;
 
+namespace
+{
+/** Keeps the events queued by the broker instead of writing them to a session */
+class test_subscriber final : public nano::ipc::subscriber
+{
+public:
+	void async_send_message (uint8_t const * data_a, std::size_t length_a, std::function<void (nano::error const &)> broadcast_completion_handler_a) override
+	{
+	}
+	uint64_t get_id () const override
+	{
+		return 0;
+	}
+	std::string get_service_name () const override
+	{
+		return {};
+	}
+	void set_service_name (std::string const & service_name_a) override
+	{
+	}
+	nano::ipc::payload_encoding get_active_encoding () const override
+	{
+		return nano::ipc::payload_encoding::flatbuffers;
+	}
+	void async_send_event (nano::ipc::event_payload const & event_a) override
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		events.push_back (event_a);
+	}
+	std::vector<nano::ipc::event_payload> get_events ()
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		return events;
+	}
+
+private:
+	nano::mutex mutex;
+	std::vector<nano::ipc::event_payload> events;
+};
+
+nanoapi::Envelope const * get_envelope (nano::ipc::event_payload const & event_a)
+{
+	return nanoapi::GetEnvelope (event_a.data);
+}
+}
+
 TEST (ipc, asynchronous)
 {
 	nano::test::system system (1);
@@ -86,6 +135,340 @@ TEST (ipc, synchronous)
 	ipc.stop ();
 }
 
+// Both requests are written before any response is read, responses are matched through the correlation id
+TEST (ipc, flatbuffers_multiplexed)
+{
+	nano::test::system system (1);
+	system.nodes[0]->config.ipc_config.transport_tcp.enabled = true;
+	system.nodes[0]->config.ipc_config.transport_tcp.port = system.get_available_port ();
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (*system.nodes[0], node_rpc_config);
+	nano::ipc::ipc_client client (system.nodes[0]->io_ctx);
+
+	nanoapi::AccountInfoT account_info;
+	account_info.account = nano::dev::genesis_key.pub.to_account ();
+	auto account_info_request (nano::ipc::prepare_flatbuffers_request (nano::ipc::flatbuffer_producer::make_buffer (account_info, "account_info"), nano::ipc::payload_encoding::flatbuffers_multiplexed));
+	nanoapi::BlocksInfoT blocks_info;
+	blocks_info.hashes.push_back (nano::dev::genesis->hash ().to_string ());
+	blocks_info.hashes.push_back (nano::block_hash (1).to_string ());
+	auto blocks_info_request (nano::ipc::prepare_flatbuffers_request (nano::ipc::flatbuffer_producer::make_buffer (blocks_info, "blocks_info"), nano::ipc::payload_encoding::flatbuffers_multiplexed));
+
+	std::atomic<bool> call_completed{ false };
+	std::thread client_thread ([&] () {
+		client.connect ("::1", ipc.listening_tcp_port ().value ());
+		std::promise<void> written;
+		client.async_write (account_info_request, [&client, &blocks_info_request, &written] (nano::error const &, size_t) {
+			client.async_write (blocks_info_request, [&written] (nano::error const &, size_t) {
+				written.set_value ();
+			});
+		});
+		written.get_future ().wait ();
+
+		std::unordered_map<std::string, std::shared_ptr<std::vector<uint8_t>>> responses;
+		for (auto i (0); i < 2; ++i)
+		{
+			auto buffer (std::make_shared<std::vector<uint8_t>> ());
+			std::promise<void> read;
+			client.async_read_message (buffer, std::chrono::seconds (5), [&read] (nano::error const &, size_t) {
+				read.set_value ();
+			});
+			read.get_future ().wait ();
+			auto verifier (flatbuffers::Verifier (buffer->data (), buffer->size ()));
+			ASSERT_TRUE (nanoapi::VerifyEnvelopeBuffer (verifier));
+			responses[nanoapi::GetEnvelope (buffer->data ())->correlation_id ()->str ()] = buffer;
+		}
+		ASSERT_EQ (1, responses.count ("account_info"));
+		ASSERT_EQ (1, responses.count ("blocks_info"));
+
+		// Responses are read in place from the received buffers
+		auto account_info_response (nanoapi::GetEnvelope (responses["account_info"]->data ())->message_as_AccountInfoResponse ());
+		ASSERT_NE (nullptr, account_info_response);
+		ASSERT_EQ (nano::dev::genesis->hash ().to_string (), account_info_response->frontier ()->str ());
+		ASSERT_EQ (nano::dev::constants.genesis_amount.convert_to<std::string> (), account_info_response->balance ()->str ());
+		ASSERT_EQ (1, account_info_response->block_count ());
+
+		auto blocks_info_response (nanoapi::GetEnvelope (responses["blocks_info"]->data ())->message_as_BlocksInfoResponse ());
+		ASSERT_NE (nullptr, blocks_info_response);
+		ASSERT_EQ (1, blocks_info_response->blocks ()->size ());
+		ASSERT_EQ (nanoapi::Block::Block_BlockOpen, blocks_info_response->blocks ()->Get (0)->block_type ());
+		ASSERT_EQ (1, blocks_info_response->blocks ()->Get (0)->height ());
+		ASSERT_EQ (1, blocks_info_response->not_found ()->size ());
+		ASSERT_EQ (nano::block_hash (1).to_string (), blocks_info_response->not_found ()->Get (0)->str ());
+
+		call_completed = true;
+	});
+	client_thread.detach ();
+
+	ASSERT_TIMELY (5s, call_completed);
+	ipc.stop ();
+}
+
+// More requests than a session keeps in flight are all answered, reading resumes as responses are written
+TEST (ipc, flatbuffers_multiplexed_in_flight)
+{
+	nano::test::system system (1);
+	system.nodes[0]->config.ipc_config.transport_tcp.enabled = true;
+	system.nodes[0]->config.ipc_config.transport_tcp.port = system.get_available_port ();
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (*system.nodes[0], node_rpc_config);
+	nano::ipc::ipc_client client (system.nodes[0]->io_ctx);
+
+	nanoapi::AccountInfoT account_info;
+	account_info.account = nano::dev::genesis_key.pub.to_account ();
+	auto request (nano::ipc::prepare_flatbuffers_request (nano::ipc::flatbuffer_producer::make_buffer (account_info, "account_info"), nano::ipc::payload_encoding::flatbuffers_multiplexed));
+	auto const count (200);
+
+	std::atomic<bool> call_completed{ false };
+	std::thread client_thread ([&] () {
+		client.connect ("::1", ipc.listening_tcp_port ().value ());
+		for (auto i (0); i < count; ++i)
+		{
+			std::promise<void> written;
+			client.async_write (request, [&written] (nano::error const &, size_t) {
+				written.set_value ();
+			});
+			written.get_future ().wait ();
+		}
+		for (auto i (0); i < count; ++i)
+		{
+			auto buffer (std::make_shared<std::vector<uint8_t>> ());
+			std::promise<void> read;
+			client.async_read_message (buffer, std::chrono::seconds (5), [&read] (nano::error const &, size_t) {
+				read.set_value ();
+			});
+			read.get_future ().wait ();
+			auto verifier (flatbuffers::Verifier (buffer->data (), buffer->size ()));
+			ASSERT_TRUE (nanoapi::VerifyEnvelopeBuffer (verifier));
+			ASSERT_NE (nullptr, nanoapi::GetEnvelope (buffer->data ())->message_as_AccountInfoResponse ());
+		}
+		call_completed = true;
+	});
+	client_thread.detach ();
+
+	ASSERT_TIMELY (10s, call_completed);
+	ipc.stop ();
+}
+
+// Only blocks of the subscribed accounts are sent
+TEST (ipc, event_new_unconfirmed_block)
+{
+	nano::test::system system (1);
+	auto node (system.nodes[0]);
+	node->config.ipc_config.transport_tcp.enabled = true;
+	node->config.ipc_config.transport_tcp.port = system.get_available_port ();
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (*node, node_rpc_config);
+	nano::ipc::ipc_client client (node->io_ctx);
+	nano::keypair key1;
+	nano::keypair key2;
+
+	auto read_envelope = [&client] () {
+		auto buffer (std::make_shared<std::vector<uint8_t>> ());
+		std::promise<void> read;
+		client.async_read_message (buffer, std::chrono::seconds (5), [&read] (nano::error const &, size_t) {
+			read.set_value ();
+		});
+		read.get_future ().wait ();
+		return buffer;
+	};
+
+	std::atomic<bool> subscribed{ false };
+	std::atomic<bool> call_completed{ false };
+	std::string hash;
+	std::thread client_thread ([&] () {
+		client.connect ("::1", ipc.listening_tcp_port ().value ());
+		nanoapi::TopicNewUnconfirmedBlockT topic;
+		topic.options = std::make_unique<nanoapi::TopicNewUnconfirmedBlockOptionsT> ();
+		topic.options->accounts.push_back (key1.pub.to_account ());
+		topic.options->include_block = false;
+		std::promise<void> written;
+		client.async_write (nano::ipc::prepare_flatbuffers_request (nano::ipc::flatbuffer_producer::make_buffer (topic)), [&written] (nano::error const &, size_t) {
+			written.set_value ();
+		});
+		written.get_future ().wait ();
+		auto ack (read_envelope ());
+		ASSERT_EQ (nanoapi::Message::Message_EventAck, nanoapi::GetEnvelope (ack->data ())->message_type ());
+		subscribed = true;
+
+		auto buffer (read_envelope ());
+		auto verifier (flatbuffers::Verifier (buffer->data (), buffer->size ()));
+		ASSERT_TRUE (nanoapi::VerifyEnvelopeBuffer (verifier));
+		auto event (nanoapi::GetEnvelope (buffer->data ())->message_as_EventNewUnconfirmedBlock ());
+		ASSERT_NE (nullptr, event);
+		ASSERT_EQ (nano::dev::genesis_key.pub.to_account (), event->account ()->str ());
+		ASSERT_EQ (nanoapi::Block::Block_NONE, event->block_type ());
+		hash = event->hash ()->str ();
+		call_completed = true;
+	});
+	client_thread.detach ();
+	ASSERT_TIMELY (5s, subscribed);
+
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .link (key2.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (nano::dev::genesis->hash ()))
+				 .build_shared ();
+	auto send2 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 2)
+				 .link (key1.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (send1->hash ()))
+				 .build_shared ();
+	ASSERT_EQ (nano::process_result::progress, node->process_local (send1).value ().code);
+	ASSERT_EQ (nano::process_result::progress, node->process_local (send2).value ().code);
+
+	// The first event read is the send to the subscribed account
+	ASSERT_TIMELY (5s, call_completed);
+	ASSERT_EQ (send2->hash ().to_string (), hash);
+	ipc.stop ();
+}
+
+// Votes are filtered on representative, weight and vote type, and subscribers receiving the same vote share its payload
+TEST (ipc, broker_vote_filters)
+{
+	nano::test::system system (1);
+	auto node (system.nodes[0]);
+	auto broker (std::make_shared<nano::ipc::broker> (*node));
+	broker->start ();
+	nano::keypair key;
+
+	// Only votes of the genesis representative
+	auto representative (std::make_shared<test_subscriber> ());
+	auto representative_topic (std::make_shared<nanoapi::TopicVoteT> ());
+	representative_topic->options = std::make_unique<nanoapi::TopicVoteOptionsT> ();
+	representative_topic->options->representatives.push_back (nano::dev::genesis_key.pub.to_account ());
+	broker->subscribe (representative, representative_topic);
+
+	// Only votes of representatives with weight
+	auto weight (std::make_shared<test_subscriber> ());
+	auto weight_topic (std::make_shared<nanoapi::TopicVoteT> ());
+	weight_topic->options = std::make_unique<nanoapi::TopicVoteOptionsT> ();
+	weight_topic->options->min_weight = "1";
+	broker->subscribe (weight, weight_topic);
+
+	// All votes including replays
+	auto replays (std::make_shared<test_subscriber> ());
+	auto replays_topic (std::make_shared<nanoapi::TopicVoteT> ());
+	replays_topic->options = std::make_unique<nanoapi::TopicVoteOptionsT> ();
+	replays_topic->options->include_replays = true;
+	broker->subscribe (replays, replays_topic);
+
+	std::vector<nano::block_hash> hashes{ nano::dev::genesis->hash () };
+	auto vote1 (std::make_shared<nano::vote> (key.pub, key.prv, 0, 0, hashes));
+	auto vote2 (std::make_shared<nano::vote> (nano::dev::genesis_key.pub, nano::dev::genesis_key.prv, 0, 0, hashes));
+	auto vote3 (std::make_shared<nano::vote> (nano::dev::genesis_key.pub, nano::dev::genesis_key.prv, 16, 0, hashes));
+	node->observers.vote.notify (vote1, nullptr, nano::vote_code::vote);
+	node->observers.vote.notify (vote2, nullptr, nano::vote_code::replay);
+	node->observers.vote.notify (vote3, nullptr, nano::vote_code::vote);
+
+	auto representative_events (representative->get_events ());
+	ASSERT_EQ (1, representative_events.size ());
+	auto event (get_envelope (representative_events[0])->message_as_EventVote ());
+	ASSERT_NE (nullptr, event);
+	ASSERT_EQ (nano::dev::genesis_key.pub.to_account (), event->account ()->str ());
+	ASSERT_EQ (nanoapi::VoteType::VoteType_vote, event->type ());
+	ASSERT_EQ (vote3->timestamp (), event->timestamp ());
+
+	auto weight_events (weight->get_events ());
+	ASSERT_EQ (1, weight_events.size ());
+	ASSERT_EQ (nano::dev::genesis_key.pub.to_account (), get_envelope (weight_events[0])->message_as_EventVote ()->account ()->str ());
+
+	auto replays_events (replays->get_events ());
+	ASSERT_EQ (3, replays_events.size ());
+	ASSERT_EQ (key.pub.to_account (), get_envelope (replays_events[0])->message_as_EventVote ()->account ()->str ());
+	ASSERT_EQ (nanoapi::VoteType::VoteType_replay, get_envelope (replays_events[1])->message_as_EventVote ()->type ());
+
+	// The vote is serialized once for all subscribers
+	ASSERT_EQ (representative_events[0].data, replays_events[2].data);
+	ASSERT_EQ (weight_events[0].data, replays_events[2].data);
+}
+
+// Confirmations moving less than the subscribed minimum amount are not sent
+TEST (ipc, broker_confirmation_min_amount)
+{
+	nano::test::system system (1);
+	auto node (system.nodes[0]);
+	auto broker (std::make_shared<nano::ipc::broker> (*node));
+	broker->start ();
+
+	auto all (std::make_shared<test_subscriber> ());
+	auto all_topic (std::make_shared<nanoapi::TopicConfirmationT> ());
+	all_topic->options = std::make_unique<nanoapi::TopicConfirmationOptionsT> ();
+	broker->subscribe (all, all_topic);
+
+	auto large (std::make_shared<test_subscriber> ());
+	auto large_topic (std::make_shared<nanoapi::TopicConfirmationT> ());
+	large_topic->options = std::make_unique<nanoapi::TopicConfirmationOptionsT> ();
+	large_topic->options->min_amount = "100";
+	large_topic->options->include_election_info = false;
+	broker->subscribe (large, large_topic);
+
+	nano::election_status status{};
+	status.winner = nano::dev::genesis;
+	status.type = nano::election_status_type::active_confirmed_quorum;
+	std::vector<nano::vote_with_weight_info> votes;
+	node->observers.blocks.notify (status, votes, nano::dev::genesis_key.pub, nano::uint128_t{ 99 }, false, false);
+	node->observers.blocks.notify (status, votes, nano::dev::genesis_key.pub, nano::uint128_t{ 100 }, false, false);
+
+	auto all_events (all->get_events ());
+	ASSERT_EQ (2, all_events.size ());
+	ASSERT_EQ ("99", get_envelope (all_events[0])->message_as_EventConfirmation ()->amount ()->str ());
+	ASSERT_NE (nullptr, get_envelope (all_events[1])->message_as_EventConfirmation ()->election_info ());
+
+	auto large_events (large->get_events ());
+	ASSERT_EQ (1, large_events.size ());
+	auto event (get_envelope (large_events[0])->message_as_EventConfirmation ());
+	ASSERT_NE (nullptr, event);
+	ASSERT_EQ ("100", event->amount ()->str ());
+	ASSERT_EQ (nullptr, event->election_info ());
+}
+
+// Started and stopped elections are only sent to subscribers of the matching topic
+TEST (ipc, broker_election_started_stopped)
+{
+	nano::test::system system (1);
+	auto node (system.nodes[0]);
+	auto broker (std::make_shared<nano::ipc::broker> (*node));
+	broker->start ();
+
+	auto started (std::make_shared<test_subscriber> ());
+	broker->subscribe (started, std::make_shared<nanoapi::TopicStartedElectionT> ());
+	auto stopped (std::make_shared<test_subscriber> ());
+	broker->subscribe (stopped, std::make_shared<nanoapi::TopicStoppedElectionT> ());
+
+	node->observers.active_started.notify (nano::block_hash{ 1 });
+	node->observers.active_stopped.notify (nano::block_hash{ 2 });
+
+	auto started_events (started->get_events ());
+	ASSERT_EQ (1, started_events.size ());
+	auto started_event (get_envelope (started_events[0])->message_as_EventStartedElection ());
+	ASSERT_NE (nullptr, started_event);
+	ASSERT_EQ (nano::block_hash{ 1 }.to_string (), started_event->hash ()->str ());
+
+	auto stopped_events (stopped->get_events ());
+	ASSERT_EQ (1, stopped_events.size ());
+	auto stopped_event (get_envelope (stopped_events[0])->message_as_EventStoppedElection ());
+	ASSERT_NE (nullptr, stopped_event);
+	ASSERT_EQ (nano::block_hash{ 2 }.to_string (), stopped_event->hash ()->str ());
+
+	// Unsubscribing stops the events
+	auto unsubscribe (std::make_shared<nanoapi::TopicStartedElectionT> ());
+	unsubscribe->unsubscribe = true;
+	broker->subscribe (started, unsubscribe);
+	node->observers.active_started.notify (nano::block_hash{ 3 });
+	ASSERT_EQ (1, started->get_events ().size ());
+}
+
 TEST (ipc, permissions_default_user)
 {
 	// Test empty/nonexistant access config. The default user still exists with default permissions.
@@ -0,0 +1,178 @@
+#include <nano/lib/blockbuilders.hpp>
+#include <nano/lib/json_writer.hpp>
+#include <nano/secure/common.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <sstream>
+
+namespace
+{
+std::string write_json (boost::property_tree::ptree const & tree_a, bool pretty_a = true)
+{
+	std::stringstream ostream;
+	boost::property_tree::write_json (ostream, tree_a, pretty_a);
+	return ostream.str ();
+}
+}
+
+TEST (json_writer, empty)
+{
+	nano::json_writer writer;
+	writer.begin_object ();
+	writer.end_object ();
+	ASSERT_EQ (write_json ({}), writer.finish ());
+}
+
+TEST (json_writer, ptree_equivalence)
+{
+	boost::property_tree::ptree tree;
+	tree.put ("account", nano::dev::genesis_key.pub.to_account ());
+	boost::property_tree::ptree hashes;
+	for (auto i (0); i < 3; ++i)
+	{
+		boost::property_tree::ptree entry;
+		entry.put ("", std::to_string (i));
+		hashes.push_back (std::make_pair ("", entry));
+	}
+	tree.add_child ("hashes", hashes);
+	boost::property_tree::ptree objects;
+	boost::property_tree::ptree object;
+	object.put ("key", "value");
+	objects.push_back (std::make_pair ("", object));
+	objects.push_back (std::make_pair ("", boost::property_tree::ptree{}));
+	tree.add_child ("objects", objects);
+	tree.put ("confirmed", true);
+
+	for (auto pretty : { true, false })
+	{
+		nano::json_writer writer (pretty);
+		writer.begin_object ();
+		writer.put ("account", nano::dev::genesis_key.pub.to_account ());
+		writer.key ("hashes").begin_array ();
+		for (auto i (0); i < 3; ++i)
+		{
+			writer.value (std::to_string (i));
+		}
+		writer.end_array ();
+		writer.key ("objects").begin_array ();
+		writer.begin_object ();
+		writer.put ("key", "value");
+		writer.end_object ();
+		writer.begin_object ();
+		writer.end_object ();
+		writer.end_array ();
+		writer.put ("confirmed", "true");
+		writer.end_object ();
+		ASSERT_EQ (write_json (tree, pretty), writer.finish ());
+
+		nano::json_writer tree_writer (pretty);
+		tree_writer.value (tree);
+		ASSERT_EQ (write_json (tree, pretty), tree_writer.finish ());
+	}
+}
+
+// Nested containers without members are written as empty strings, as write_json does
+TEST (json_writer, empty_nested)
+{
+	boost::property_tree::ptree tree;
+	tree.add_child ("blocks", boost::property_tree::ptree{});
+	tree.add_child ("history", boost::property_tree::ptree{});
+	nano::json_writer writer;
+	writer.begin_object ();
+	writer.key ("blocks").begin_object ();
+	writer.end_object ();
+	writer.key ("history").begin_array ();
+	writer.end_array ();
+	writer.end_object ();
+	auto json (writer.finish ());
+	ASSERT_EQ (write_json (tree), json);
+	ASSERT_NE (std::string::npos, json.find (R"("blocks": "")"));
+}
+
+TEST (json_writer, escapes)
+{
+	std::string text ("quote\" backslash\\ slash/ newline\n tab\t control\x01 del\x7f utf8\xc3\xa9");
+	boost::property_tree::ptree tree;
+	tree.put (text, text);
+	nano::json_writer writer;
+	writer.begin_object ();
+	writer.put (text, text);
+	writer.end_object ();
+	ASSERT_EQ (write_json (tree), writer.finish ());
+}
+
+// Bytes from 0x7F up are written unchanged, so UTF-8 strings echoed to websocket subscribers keep their characters
+TEST (json_writer, escapes_non_ascii)
+{
+	std::string text ("caf\xc3\xa9 \xff\x80 \x7f~");
+	nano::json_writer writer (false);
+	writer.begin_object ();
+	writer.put ("text", text);
+	writer.end_object ();
+	auto json (writer.finish ());
+	ASSERT_EQ ("{\"text\":\"caf\xc3\xa9 \xff\x80 \x7f~\"}\n", json);
+	boost::property_tree::ptree tree;
+	tree.put ("text", text);
+	ASSERT_EQ (write_json (tree, false), json);
+}
+
+TEST (json_writer, block)
+{
+	nano::keypair key;
+	nano::block_builder builder;
+	auto block = builder
+				 .state ()
+				 .account (key.pub)
+				 .previous (1)
+				 .representative (key.pub)
+				 .balance (2)
+				 .link (3)
+				 .sign (key.prv, key.pub)
+				 .work (4)
+				 .build ();
+	boost::property_tree::ptree tree;
+	block->serialize_json (tree);
+	for (auto single_line : { false, true })
+	{
+		std::string json;
+		block->serialize_json (json, single_line);
+		ASSERT_EQ (write_json (tree, !single_line), json);
+	}
+
+	// Nested below a member, as blocks_info does with json_block
+	boost::property_tree::ptree response;
+	response.add_child ("contents", tree);
+	nano::json_writer writer;
+	writer.begin_object ();
+	writer.key ("contents");
+	block->serialize_json (writer);
+	writer.end_object ();
+	ASSERT_EQ (write_json (response), writer.finish ());
+}
+
+// Handlers may put members such as deprecation notices into a tree while streaming the rest of the response
+TEST (json_writer, prepend)
+{
+	boost::property_tree::ptree leading;
+	leading.put ("deprecated", "1");
+	boost::property_tree::ptree tree (leading);
+	tree.put ("account", nano::dev::genesis_key.pub.to_account ());
+	for (auto pretty : { true, false })
+	{
+		nano::json_writer writer (pretty);
+		writer.begin_object ();
+		writer.put ("account", nano::dev::genesis_key.pub.to_account ());
+		writer.end_object ();
+		writer.prepend (leading);
+		ASSERT_EQ (write_json (tree, pretty), writer.finish ());
+
+		nano::json_writer empty (pretty);
+		empty.begin_object ();
+		empty.end_object ();
+		empty.prepend (leading);
+		ASSERT_EQ (write_json (leading, pretty), empty.finish ());
+	}
+}
@@ -5,6 +5,7 @@
 #include <nano/node/scheduler/buckets.hpp>
 #include <nano/node/scheduler/component.hpp>
 #include <nano/node/transport/inproc.hpp>
+#include <nano/secure/ledger_snapshot.hpp>
 #include <nano/test_common/ledger.hpp>
 #include <nano/test_common/system.hpp>
 #include <nano/test_common/testutil.hpp>
@@ -5579,8 +5580,14 @@ TEST (ledger, migrate_lmdb_to_rocksdb)
 		store.final_vote.put (transaction, send->qualified_root (), nano::block_hash (2));
 	}
 
-	auto error = ledger.migrate_lmdb_to_rocksdb (path);
+	std::unordered_map<std::string, uint64_t> migrated;
+	auto error = ledger.migrate_lmdb_to_rocksdb (path, [&migrated] (std::string const & table_a, uint64_t count_a) {
+		migrated[table_a] = count_a;
+	});
 	ASSERT_FALSE (error);
+	ASSERT_EQ (7, migrated.size ());
+	ASSERT_EQ (2, migrated["blocks"]);
+	ASSERT_EQ (1, migrated["pending"]);
 
 	nano::rocksdb::store rocksdb_store{ logger, path / "rocksdb", nano::dev::constants };
 	auto rocksdb_transaction (rocksdb_store.tx_begin_read ());
@@ -5610,6 +5617,54 @@ TEST (ledger, migrate_lmdb_to_rocksdb)
 	ASSERT_EQ (rocksdb_store.final_vote.get (rocksdb_transaction, nano::root (send->previous ()))[0], nano::block_hash (2));
 }
 
+TEST (ledger, snapshot_export_import)
+{
+	auto ctx = nano::test::context::ledger_send_receive ();
+	auto & store = ctx.store ();
+	auto snapshot_path = nano::unique_path ();
+	nano::ledger_snapshot snapshot{ store };
+	ASSERT_FALSE (snapshot.export_to (snapshot_path));
+
+	nano::logger_mt logger;
+	nano::stats stats;
+	auto imported = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_FALSE (imported->init_error ());
+	nano::ledger ledger{ *imported, stats, nano::dev::constants };
+	{
+		auto transaction = imported->tx_begin_write ();
+		imported->initialize (transaction, ledger.cache, ledger.constants);
+	}
+	nano::ledger_snapshot import_snapshot{ *imported };
+	import_snapshot.parallel_import = true;
+	std::vector<std::string> tables;
+	import_snapshot.progress = [&tables] (std::string const & table_a, uint64_t) {
+		tables.push_back (table_a);
+	};
+	ASSERT_FALSE (import_snapshot.import_from (snapshot_path));
+	ASSERT_EQ (7, tables.size ());
+
+	auto transaction = store.tx_begin_read ();
+	auto imported_transaction = imported->tx_begin_read ();
+	ASSERT_EQ (store.block.count (transaction), imported->block.count (imported_transaction));
+	ASSERT_EQ (store.account.count (transaction), imported->account.count (imported_transaction));
+	ASSERT_EQ (store.confirmation_height.count (transaction), imported->confirmation_height.count (imported_transaction));
+	for (auto const & block : ctx.blocks ())
+	{
+		auto imported_block = imported->block.get (imported_transaction, block->hash ());
+		ASSERT_NE (nullptr, imported_block);
+		ASSERT_EQ (*block, *imported_block);
+		ASSERT_EQ (block->sideband ().height, imported_block->sideband ().height);
+	}
+	nano::account_info info;
+	nano::account_info imported_info;
+	ASSERT_FALSE (store.account.get (transaction, nano::dev::genesis_key.pub, info));
+	ASSERT_FALSE (imported->account.get (imported_transaction, nano::dev::genesis_key.pub, imported_info));
+	ASSERT_EQ (info, imported_info);
+
+	// Only an empty ledger can be imported into
+	ASSERT_TRUE (import_snapshot.import_from (snapshot_path));
+}
+
 TEST (ledger, unconfirmed_frontiers)
 {
 	auto ctx = nano::test::context::ledger_empty ();
@@ -5682,3 +5737,84 @@ TEST (ledger, head_block)
 	auto tx = store.tx_begin_read ();
 	ASSERT_EQ (*nano::dev::genesis, *ledger.head_block (tx, nano::dev::genesis->account ()));
 }
+
+TEST (ledger, receivable_summary)
+{
+	auto ctx = nano::test::context::ledger_empty ();
+	auto & store = ctx.store ();
+	// The summary is opt-in, a ledger with the default cache flags never populates it and filters nothing
+	ASSERT_FALSE (ctx.ledger ().cache.receivable.populated ());
+	ASSERT_TRUE (ctx.ledger ().cache.receivable.may_have (nano::dev::genesis_key.pub, 1));
+	nano::generate_cache generate_cache;
+	generate_cache.receivable = true;
+	nano::ledger ledger (store, ctx.stats (), nano::dev::constants, generate_cache);
+	auto transaction = store.tx_begin_write ();
+	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	nano::keypair key1;
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1000)
+				 .link (key1.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (nano::dev::genesis->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *send1).code);
+	auto send2 = builder
+				 .send ()
+				 .previous (send1->hash ())
+				 .destination (key1.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1050)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (send1->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *send2).code);
+	auto & summary = ledger.cache.receivable;
+	ASSERT_TRUE (summary.populated ());
+	ASSERT_EQ (2, summary.get (key1.pub).count);
+	ASSERT_EQ (1050, summary.get (key1.pub).total);
+	ASSERT_TRUE (summary.may_have (key1.pub, 1000));
+	ASSERT_FALSE (summary.may_have (key1.pub, 4096));
+	ASSERT_FALSE (summary.may_have (nano::dev::genesis_key.pub, 1));
+
+	auto open = builder
+				.state ()
+				.account (key1.pub)
+				.previous (0)
+				.representative (key1.pub)
+				.balance (1000)
+				.link (send1->hash ())
+				.sign (key1.prv, key1.pub)
+				.work (*pool.generate (key1.pub))
+				.build ();
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, *open).code);
+	// Removals only apply once they are committed
+	ASSERT_EQ (2, summary.get (key1.pub).count);
+	transaction.refresh ();
+	ASSERT_EQ (1, summary.get (key1.pub).count);
+	ASSERT_EQ (50, summary.get (key1.pub).total);
+	// Only the 50 raw entry is left, which is in a lower amount bucket than the threshold
+	ASSERT_FALSE (summary.may_have (key1.pub, 1000));
+	ASSERT_TRUE (summary.may_have (key1.pub, 50));
+
+	ASSERT_FALSE (ledger.rollback (transaction, send2->hash ()));
+	transaction.refresh ();
+	ASSERT_EQ (0, summary.get (key1.pub).count);
+	ASSERT_FALSE (summary.may_have (key1.pub, 1));
+
+	// Additions apply immediately
+	ASSERT_FALSE (ledger.rollback (transaction, open->hash ()));
+	ASSERT_EQ (1, summary.get (key1.pub).count);
+	ASSERT_EQ (1000, summary.get (key1.pub).total);
+	ASSERT_TRUE (summary.may_have (key1.pub, 1000));
+
+	// A fresh ledger generates the same summary from the pending table
+	nano::stats stats;
+	transaction.commit ();
+	nano::ledger ledger2 (store, stats, nano::dev::constants, generate_cache);
+	ASSERT_EQ (1, ledger2.cache.receivable.get (key1.pub).count);
+	ASSERT_EQ (1000, ledger2.cache.receivable.get (key1.pub).total);
+}
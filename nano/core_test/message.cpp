@@ -416,6 +416,52 @@ TEST (message, asc_pull_ack_serialization_blocks)
 	ASSERT_TRUE (nano::at_end (stream));
 }
 
+TEST (message, asc_pull_ack_serialization_serialized_blocks)
+{
+	nano::asc_pull_ack original{ nano::dev::network_params.network };
+	original.id = 11;
+	original.type = nano::asc_pull_type::blocks;
+
+	// Blocks copied as raw bytes are written out the same as materialized blocks
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	nano::asc_pull_ack::blocks_payload original_payload;
+	{
+		nano::vectorstream stream{ original_payload.serialized };
+		for (int n = 0; n < 16; ++n)
+		{
+			blocks.push_back (random_block ());
+			nano::serialize_block (stream, *blocks.back ());
+		}
+	}
+	original_payload.serialized_count = blocks.size ();
+	ASSERT_EQ (blocks.size (), original_payload.count ());
+
+	original.payload = original_payload;
+	original.update_header ();
+
+	std::vector<uint8_t> bytes;
+	{
+		nano::vectorstream stream{ bytes };
+		original.serialize (stream);
+	}
+	nano::bufferstream stream{ bytes.data (), bytes.size () };
+
+	bool error = false;
+	nano::message_header header (error, stream);
+	ASSERT_FALSE (error);
+	nano::asc_pull_ack message (error, stream, header);
+	ASSERT_FALSE (error);
+
+	nano::asc_pull_ack::blocks_payload message_payload;
+	ASSERT_NO_THROW (message_payload = std::get<nano::asc_pull_ack::blocks_payload> (message.payload));
+	ASSERT_TRUE (message_payload.serialized.empty ());
+	ASSERT_TRUE (std::equal (blocks.begin (), blocks.end (), message_payload.blocks.begin (), message_payload.blocks.end (), [] (auto a, auto b) {
+		return *a == *b;
+	}));
+
+	ASSERT_TRUE (nano::at_end (stream));
+}
+
 TEST (message, asc_pull_ack_serialization_account_info)
 {
 	nano::asc_pull_ack original{ nano::dev::network_params.network };
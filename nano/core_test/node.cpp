@@ -2023,6 +2023,51 @@ TEST (node, stat_counting)
 	ASSERT_EQ (10, node1.stats.count (nano::stat::type::ledger, nano::stat::dir::in));
 }
 
+// Counters are sharded per thread, increments from concurrent threads must all be visible when read
+TEST (node, stat_counting_concurrent)
+{
+	nano::stats stats;
+	std::vector<std::thread> threads;
+	for (auto i (0); i < 8; ++i)
+	{
+		threads.emplace_back ([&stats] () {
+			for (auto j (0); j < 10000; ++j)
+			{
+				stats.inc (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in);
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	ASSERT_EQ (80000, stats.count (nano::stat::type::ledger, nano::stat::dir::in));
+	ASSERT_EQ (80000, stats.count (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in));
+
+	// Only counters which were updated are logged
+	auto sink (stats.log_sink_json ());
+	stats.log_counters (*sink);
+	auto tree (static_cast<boost::property_tree::ptree *> (sink->to_object ()));
+	ASSERT_EQ (2, tree->get_child ("entries").size ());
+
+	stats.clear ();
+	ASSERT_EQ (0, stats.count (nano::stat::type::ledger, nano::stat::dir::in));
+}
+
+TEST (node, stat_count_observer)
+{
+	nano::stats stats;
+	std::vector<std::pair<uint64_t, uint64_t>> observed;
+	stats.observe_count (nano::stat::type::ledger, nano::stat::detail::all, nano::stat::dir::in, [&observed] (uint64_t old_a, uint64_t new_a) {
+		observed.emplace_back (old_a, new_a);
+	});
+	stats.add (nano::stat::type::ledger, nano::stat::dir::in, 3);
+	stats.inc (nano::stat::type::ledger, nano::stat::detail::send, nano::stat::dir::in);
+	ASSERT_EQ (2, observed.size ());
+	ASSERT_EQ (std::make_pair<uint64_t, uint64_t> (0, 3), observed[0]);
+	ASSERT_EQ (std::make_pair<uint64_t, uint64_t> (3, 4), observed[1]);
+}
+
 TEST (node, stat_histogram)
 {
 	nano::test::system system (1);
@@ -2055,6 +2100,45 @@ TEST (node, stat_histogram)
 	ASSERT_EQ (histogram_ack_out->get_bins ()[1].value, 1);
 }
 
+TEST (node, stat_latency)
+{
+	nano::stats stats;
+	for (auto i (1); i <= 1000; ++i)
+	{
+		stats.sample (nano::stat::latency::vote_applied, std::chrono::milliseconds (i));
+	}
+	auto summary (stats.latency (nano::stat::latency::vote_applied));
+	ASSERT_EQ (1000, summary.count);
+	ASSERT_EQ (500500, summary.mean);
+	ASSERT_EQ (1000000, summary.max);
+	// Percentiles are reported as the upper end of their bucket, which is at most 1/32 above the recorded value
+	ASSERT_GE (summary.p50, 500000);
+	ASSERT_LE (summary.p50, 500000 + 500000 / 32);
+	ASSERT_GE (summary.p99, 990000);
+	ASSERT_LE (summary.p99, 990000 + 990000 / 32);
+	ASSERT_GE (summary.p999, 999000);
+	ASSERT_LE (summary.p999, summary.max);
+	ASSERT_EQ (0, stats.latency (nano::stat::latency::vote_verified).count);
+
+	stats.clear ();
+	ASSERT_EQ (0, stats.latency (nano::stat::latency::vote_applied).count);
+}
+
+TEST (node, stat_latency_stages)
+{
+	nano::test::system system (1);
+	auto & node (*system.nodes[0]);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	nano::keypair key;
+	auto send (system.wallet (0)->send_action (nano::dev::genesis_key.pub, key.pub, node.config.receive_minimum.number ()));
+	ASSERT_NE (nullptr, send);
+	ASSERT_TIMELY (5s, node.block_confirmed (send->hash ()));
+	ASSERT_LE (1, node.stats.latency (nano::stat::latency::block_processed).count);
+	ASSERT_LE (1, node.stats.latency (nano::stat::latency::election_started).count);
+	ASSERT_LE (1, node.stats.latency (nano::stat::latency::election_confirmed).count);
+	ASSERT_TIMELY (5s, node.stats.latency (nano::stat::latency::block_cemented).count >= 1);
+}
+
 TEST (node, online_reps)
 {
 	nano::test::system system (1);
@@ -99,6 +99,7 @@ TEST (toml, rpc_config_deserialize_defaults)
 	ASSERT_EQ (conf.enable_control, defaults.enable_control);
 	ASSERT_EQ (conf.max_json_depth, defaults.max_json_depth);
 	ASSERT_EQ (conf.max_request_size, defaults.max_request_size);
+	ASSERT_EQ (conf.response_chunk_size, defaults.response_chunk_size);
 	ASSERT_EQ (conf.port, defaults.port);
 
 	ASSERT_EQ (conf.rpc_process.io_threads, defaults.rpc_process.io_threads);
@@ -144,6 +145,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.opencl.threads, defaults.opencl.threads);
 	ASSERT_EQ (conf.rpc_enable, defaults.rpc_enable);
 	ASSERT_EQ (conf.rpc.enable_sign_hash, defaults.rpc.enable_sign_hash);
+	ASSERT_EQ (conf.rpc.bulk_parallelism, defaults.rpc.bulk_parallelism);
 	ASSERT_EQ (conf.rpc.child_process.enable, defaults.rpc.child_process.enable);
 	ASSERT_EQ (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
 
@@ -160,10 +162,13 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
 	ASSERT_EQ (conf.node.bootstrap_initiator_threads, defaults.node.bootstrap_initiator_threads);
 	ASSERT_EQ (conf.node.bootstrap_serving_threads, defaults.node.bootstrap_serving_threads);
+	ASSERT_EQ (conf.node.bootstrap_serving_batch_size, defaults.node.bootstrap_serving_batch_size);
+	ASSERT_EQ (conf.node.bootstrap_serving_max_in_flight, defaults.node.bootstrap_serving_max_in_flight);
 	ASSERT_EQ (conf.node.bootstrap_frontier_request_count, defaults.node.bootstrap_frontier_request_count);
 	ASSERT_EQ (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_EQ (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
 	ASSERT_EQ (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
+	ASSERT_EQ (conf.node.enable_receivable_summary, defaults.node.enable_receivable_summary);
 	ASSERT_EQ (conf.node.enable_voting, defaults.node.enable_voting);
 	ASSERT_EQ (conf.node.external_address, defaults.node.external_address);
 	ASSERT_EQ (conf.node.external_port, defaults.node.external_port);
@@ -185,12 +190,15 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.tcp_incoming_connections_max, defaults.node.tcp_incoming_connections_max);
 	ASSERT_EQ (conf.node.tcp_io_timeout, defaults.node.tcp_io_timeout);
 	ASSERT_EQ (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
+	ASSERT_EQ (conf.node.unchecked_spill_max, defaults.node.unchecked_spill_max);
 	ASSERT_EQ (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_EQ (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
 	ASSERT_EQ (conf.node.vote_generator_threshold, defaults.node.vote_generator_threshold);
 	ASSERT_EQ (conf.node.vote_minimum, defaults.node.vote_minimum);
+	ASSERT_EQ (conf.node.work_cache_concurrency, defaults.node.work_cache_concurrency);
 	ASSERT_EQ (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_EQ (conf.node.work_threads, defaults.node.work_threads);
+	ASSERT_EQ (conf.node.work_validation_threads, defaults.node.work_validation_threads);
 	ASSERT_EQ (conf.node.max_queued_requests, defaults.node.max_queued_requests);
 	ASSERT_EQ (conf.node.backlog_scan_batch_size, defaults.node.backlog_scan_batch_size);
 	ASSERT_EQ (conf.node.backlog_scan_frequency, defaults.node.backlog_scan_frequency);
@@ -231,6 +239,10 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.callback_address, defaults.node.callback_address);
 	ASSERT_EQ (conf.node.callback_port, defaults.node.callback_port);
 	ASSERT_EQ (conf.node.callback_target, defaults.node.callback_target);
+	ASSERT_EQ (conf.node.callback_connections, defaults.node.callback_connections);
+	ASSERT_EQ (conf.node.callback_batch_max, defaults.node.callback_batch_max);
+	ASSERT_EQ (conf.node.callback_queue_max, defaults.node.callback_queue_max);
+	ASSERT_EQ (conf.node.callback_retries, defaults.node.callback_retries);
 
 	ASSERT_EQ (conf.node.ipc_config.transport_domain.allow_unsafe, defaults.node.ipc_config.transport_domain.allow_unsafe);
 	ASSERT_EQ (conf.node.ipc_config.transport_domain.enabled, defaults.node.ipc_config.transport_domain.enabled);
@@ -243,6 +255,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.ipc_config.transport_tcp.port, defaults.node.ipc_config.transport_tcp.port);
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
+	ASSERT_EQ (conf.node.ipc_config.flatbuffers.event_queue_size, defaults.node.ipc_config.flatbuffers.event_queue_size);
 
 	ASSERT_EQ (conf.node.diagnostics_config.txn_tracking.enable, defaults.node.diagnostics_config.txn_tracking.enable);
 	ASSERT_EQ (conf.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time, defaults.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time);
@@ -262,10 +275,18 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_EQ (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_EQ (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_EQ (conf.node.lmdb_config.read_txn_pool, defaults.node.lmdb_config.read_txn_pool);
+	ASSERT_EQ (conf.node.lmdb_config.read_txn_pool_size, defaults.node.lmdb_config.read_txn_pool_size);
+	ASSERT_EQ (conf.node.lmdb_config.max_read_txn_age, defaults.node.lmdb_config.max_read_txn_age);
 
 	ASSERT_EQ (conf.node.rocksdb_config.enable, defaults.node.rocksdb_config.enable);
 	ASSERT_EQ (conf.node.rocksdb_config.memory_multiplier, defaults.node.rocksdb_config.memory_multiplier);
 	ASSERT_EQ (conf.node.rocksdb_config.io_threads, defaults.node.rocksdb_config.io_threads);
+	ASSERT_EQ (conf.node.rocksdb_config.pending_profile, defaults.node.rocksdb_config.pending_profile);
+	ASSERT_EQ (conf.node.rocksdb_config.blocks_profile, defaults.node.rocksdb_config.blocks_profile);
+	ASSERT_EQ (conf.node.rocksdb_config.accounts_profile, defaults.node.rocksdb_config.accounts_profile);
+	ASSERT_EQ (conf.node.rocksdb_config.confirmation_height_profile, defaults.node.rocksdb_config.confirmation_height_profile);
+	ASSERT_EQ (conf.node.rocksdb_config.max_read_txn_age, defaults.node.rocksdb_config.max_read_txn_age);
 
 	ASSERT_EQ (conf.node.optimistic_scheduler.enabled, defaults.node.optimistic_scheduler.enabled);
 	ASSERT_EQ (conf.node.optimistic_scheduler.gap_threshold, defaults.node.optimistic_scheduler.gap_threshold);
@@ -410,10 +431,13 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	bootstrap_connections_max = 999
 	bootstrap_initiator_threads = 999
 	bootstrap_serving_threads = 999
+	bootstrap_serving_batch_size = 999
+	bootstrap_serving_max_in_flight = 99
 	bootstrap_frontier_request_count = 9999
 	bootstrap_fraction_numerator = 999
 	conf_height_processor_batch_min_time = 999
 	confirmation_history_size = 999
+	enable_receivable_summary = true
 	enable_voting = false
 	external_address = "0:0:0:0:0:ffff:7f01:101"
 	external_port = 999
@@ -434,12 +458,15 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	tcp_incoming_connections_max = 999
 	tcp_io_timeout = 999
 	unchecked_cutoff_time = 999
+	unchecked_spill_max = 999
 	use_memory_pools = false
 	vote_generator_delay = 999
 	vote_generator_threshold = 9
 	vote_minimum = "999"
+	work_cache_concurrency = 999
 	work_peers = ["dev.org:999"]
 	work_threads = 999
+	work_validation_threads = 999
 	max_work_generate_multiplier = 1.0
 	max_queued_requests = 999
 	frontiers_confirmation = "always"
@@ -456,6 +483,10 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	address = "dev.org"
 	port = 999
 	target = "/dev"
+	connections = 999
+	batch_max = 999
+	queue_max = 999
+	retries = 999
 
 	[node.ipc.local]
 	allow_unsafe = true
@@ -473,6 +504,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	[node.ipc.flatbuffers]
 	skip_unexpected_fields_in_json = false
 	verify_buffers = false
+	event_queue_size = 999
 
 	[node.logging]
 	bulk_pull = true
@@ -526,6 +558,9 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	sync = "nosync_safe"
 	max_databases = 999
 	map_size = 999
+	read_txn_pool = false
+	read_txn_pool_size = 8
+	max_read_txn_age = 999
 
 	[node.optimistic_scheduler]
 	enabled = false
@@ -536,6 +571,11 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	enable = true
 	memory_multiplier = 3
 	io_threads = 99
+	pending_profile = "standard"
+	blocks_profile = "standard"
+	accounts_profile = "hash_index"
+	confirmation_height_profile = "hash_index"
+	max_read_txn_age = 999
 
 	[node.experimental]
 	secondary_work_peers = ["dev.org:998"]
@@ -551,6 +591,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	[rpc]
 	enable = true
 	enable_sign_hash = true
+	bulk_parallelism = 999
 
 	[rpc.child_process]
 	enable = true
@@ -571,6 +612,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.opencl.threads, defaults.opencl.threads);
 	ASSERT_NE (conf.rpc_enable, defaults.rpc_enable);
 	ASSERT_NE (conf.rpc.enable_sign_hash, defaults.rpc.enable_sign_hash);
+	ASSERT_NE (conf.rpc.bulk_parallelism, defaults.rpc.bulk_parallelism);
 	ASSERT_NE (conf.rpc.child_process.enable, defaults.rpc.child_process.enable);
 	ASSERT_NE (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
 
@@ -587,10 +629,13 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
 	ASSERT_NE (conf.node.bootstrap_initiator_threads, defaults.node.bootstrap_initiator_threads);
 	ASSERT_NE (conf.node.bootstrap_serving_threads, defaults.node.bootstrap_serving_threads);
+	ASSERT_NE (conf.node.bootstrap_serving_batch_size, defaults.node.bootstrap_serving_batch_size);
+	ASSERT_NE (conf.node.bootstrap_serving_max_in_flight, defaults.node.bootstrap_serving_max_in_flight);
 	ASSERT_NE (conf.node.bootstrap_frontier_request_count, defaults.node.bootstrap_frontier_request_count);
 	ASSERT_NE (conf.node.bootstrap_fraction_numerator, defaults.node.bootstrap_fraction_numerator);
 	ASSERT_NE (conf.node.conf_height_processor_batch_min_time, defaults.node.conf_height_processor_batch_min_time);
 	ASSERT_NE (conf.node.confirmation_history_size, defaults.node.confirmation_history_size);
+	ASSERT_NE (conf.node.enable_receivable_summary, defaults.node.enable_receivable_summary);
 	ASSERT_NE (conf.node.enable_voting, defaults.node.enable_voting);
 	ASSERT_NE (conf.node.external_address, defaults.node.external_address);
 	ASSERT_NE (conf.node.external_port, defaults.node.external_port);
@@ -615,12 +660,15 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.tcp_incoming_connections_max, defaults.node.tcp_incoming_connections_max);
 	ASSERT_NE (conf.node.tcp_io_timeout, defaults.node.tcp_io_timeout);
 	ASSERT_NE (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
+	ASSERT_NE (conf.node.unchecked_spill_max, defaults.node.unchecked_spill_max);
 	ASSERT_NE (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_NE (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
 	ASSERT_NE (conf.node.vote_generator_threshold, defaults.node.vote_generator_threshold);
 	ASSERT_NE (conf.node.vote_minimum, defaults.node.vote_minimum);
+	ASSERT_NE (conf.node.work_cache_concurrency, defaults.node.work_cache_concurrency);
 	ASSERT_NE (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_NE (conf.node.work_threads, defaults.node.work_threads);
+	ASSERT_NE (conf.node.work_validation_threads, defaults.node.work_validation_threads);
 	ASSERT_NE (conf.node.max_queued_requests, defaults.node.max_queued_requests);
 	ASSERT_NE (conf.node.backlog_scan_batch_size, defaults.node.backlog_scan_batch_size);
 	ASSERT_NE (conf.node.backlog_scan_frequency, defaults.node.backlog_scan_frequency);
@@ -661,6 +709,10 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.callback_address, defaults.node.callback_address);
 	ASSERT_NE (conf.node.callback_port, defaults.node.callback_port);
 	ASSERT_NE (conf.node.callback_target, defaults.node.callback_target);
+	ASSERT_NE (conf.node.callback_connections, defaults.node.callback_connections);
+	ASSERT_NE (conf.node.callback_batch_max, defaults.node.callback_batch_max);
+	ASSERT_NE (conf.node.callback_queue_max, defaults.node.callback_queue_max);
+	ASSERT_NE (conf.node.callback_retries, defaults.node.callback_retries);
 
 	ASSERT_NE (conf.node.ipc_config.transport_domain.allow_unsafe, defaults.node.ipc_config.transport_domain.allow_unsafe);
 	ASSERT_NE (conf.node.ipc_config.transport_domain.enabled, defaults.node.ipc_config.transport_domain.enabled);
@@ -673,6 +725,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.ipc_config.transport_tcp.port, defaults.node.ipc_config.transport_tcp.port);
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
+	ASSERT_NE (conf.node.ipc_config.flatbuffers.event_queue_size, defaults.node.ipc_config.flatbuffers.event_queue_size);
 
 	ASSERT_NE (conf.node.diagnostics_config.txn_tracking.enable, defaults.node.diagnostics_config.txn_tracking.enable);
 	ASSERT_NE (conf.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time, defaults.node.diagnostics_config.txn_tracking.ignore_writes_below_block_processor_max_time);
@@ -692,11 +745,19 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_NE (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_NE (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_NE (conf.node.lmdb_config.read_txn_pool, defaults.node.lmdb_config.read_txn_pool);
+	ASSERT_NE (conf.node.lmdb_config.read_txn_pool_size, defaults.node.lmdb_config.read_txn_pool_size);
+	ASSERT_NE (conf.node.lmdb_config.max_read_txn_age, defaults.node.lmdb_config.max_read_txn_age);
 
 	ASSERT_TRUE (conf.node.rocksdb_config.enable);
 	ASSERT_EQ (nano::rocksdb_config::using_rocksdb_in_tests (), defaults.node.rocksdb_config.enable);
 	ASSERT_NE (conf.node.rocksdb_config.memory_multiplier, defaults.node.rocksdb_config.memory_multiplier);
 	ASSERT_NE (conf.node.rocksdb_config.io_threads, defaults.node.rocksdb_config.io_threads);
+	ASSERT_NE (conf.node.rocksdb_config.pending_profile, defaults.node.rocksdb_config.pending_profile);
+	ASSERT_NE (conf.node.rocksdb_config.blocks_profile, defaults.node.rocksdb_config.blocks_profile);
+	ASSERT_NE (conf.node.rocksdb_config.accounts_profile, defaults.node.rocksdb_config.accounts_profile);
+	ASSERT_NE (conf.node.rocksdb_config.confirmation_height_profile, defaults.node.rocksdb_config.confirmation_height_profile);
+	ASSERT_NE (conf.node.rocksdb_config.max_read_txn_age, defaults.node.rocksdb_config.max_read_txn_age);
 
 	ASSERT_NE (conf.node.optimistic_scheduler.enabled, defaults.node.optimistic_scheduler.enabled);
 	ASSERT_NE (conf.node.optimistic_scheduler.gap_threshold, defaults.node.optimistic_scheduler.gap_threshold);
@@ -745,6 +806,7 @@ TEST (toml, rpc_config_deserialize_no_defaults)
 	enable_control = true
 	max_json_depth = 9
 	max_request_size = 999
+	response_chunk_size = 999
 	port = 999
 	[process]
 	io_threads = 999
@@ -767,6 +829,7 @@ TEST (toml, rpc_config_deserialize_no_defaults)
 	ASSERT_NE (conf.enable_control, defaults.enable_control);
 	ASSERT_NE (conf.max_json_depth, defaults.max_json_depth);
 	ASSERT_NE (conf.max_request_size, defaults.max_request_size);
+	ASSERT_NE (conf.response_chunk_size, defaults.response_chunk_size);
 	ASSERT_NE (conf.port, defaults.port);
 
 	ASSERT_NE (conf.rpc_process.io_threads, defaults.rpc_process.io_threads);
@@ -877,6 +940,21 @@ TEST (toml, daemon_config_deserialize_errors)
 
 		ASSERT_EQ (toml.get_error ().get_message (), "bootstrap_frontier_request_count must be greater than or equal to 1024");
 	}
+
+	{
+		std::stringstream ss;
+		ss << R"toml(
+		[node]
+		bootstrap_serving_max_in_flight = 129
+		)toml";
+
+		nano::tomlconfig toml;
+		toml.read (ss);
+		nano::daemon_config conf;
+		conf.deserialize_toml (toml);
+
+		ASSERT_EQ (toml.get_error ().get_message (), "bootstrap_serving_max_in_flight must be a number between 1 and 128");
+	}
 }
 
 TEST (toml, daemon_read_config)
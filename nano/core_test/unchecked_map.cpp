@@ -275,3 +275,129 @@ TEST (unchecked, multiple_get)
 	auto unchecked5 = unchecked.get (block2->hash ());
 	ASSERT_EQ (unchecked5.size (), 0);
 }
+
+// Tests that blocks over the memory limit are spilled to disk in batches instead of dropped and released once their dependency is triggered
+TEST (unchecked, spill)
+{
+	nano::test::system system{};
+	auto path (nano::unique_path () / "unchecked_spill.ldb");
+	nano::unchecked_map unchecked{ system.stats, false, path, 2 };
+	nano::block_builder builder;
+	nano::keypair key;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	// The oldest 256 blocks depend on 1, the newest 2 on 2
+	for (auto i = 0; i < 258; ++i)
+	{
+		blocks.push_back (builder
+						  .send ()
+						  .previous (i < 256 ? 1 : 2)
+						  .destination (1)
+						  .balance (i)
+						  .sign (key.prv, key.pub)
+						  .work (5)
+						  .build_shared ());
+		unchecked.put (blocks.back ()->previous (), nano::unchecked_info (blocks.back ()));
+		// Nothing is spilled until a full batch is over the memory limit
+		if (i == 256)
+		{
+			ASSERT_EQ (0, system.stats.count (nano::stat::type::unchecked, nano::stat::detail::spill));
+			ASSERT_FALSE (boost::filesystem::exists (path));
+		}
+	}
+	// Nothing was dropped, the 256 oldest entries live on disk
+	ASSERT_EQ (258, unchecked.count ());
+	ASSERT_EQ (256, system.stats.count (nano::stat::type::unchecked, nano::stat::detail::spill));
+	ASSERT_EQ (0, system.stats.count (nano::stat::type::unchecked, nano::stat::detail::spill_drop));
+	ASSERT_TRUE (boost::filesystem::exists (path));
+	ASSERT_TRUE (unchecked.exists (nano::unchecked_key{ 1, blocks[0]->hash () }));
+	ASSERT_EQ (256, unchecked.get (1).size ());
+	size_t count = 0;
+	unchecked.for_each ([&count] (nano::unchecked_key const & key, nano::unchecked_info const & info) {
+		++count;
+	});
+	ASSERT_EQ (258, count);
+	// Satisfying the dependency of every spilled entry releases them and removes the spill file
+	std::atomic<size_t> satisfied{ 0 };
+	unchecked.satisfied.add ([&satisfied] (std::vector<nano::unchecked_info> const & infos) {
+		satisfied += infos.size ();
+	});
+	unchecked.trigger (1);
+	ASSERT_TIMELY (5s, satisfied == 256);
+	ASSERT_TIMELY (5s, unchecked.count () == 2);
+	ASSERT_FALSE (boost::filesystem::exists (path));
+	ASSERT_EQ (2, unchecked.get (2).size ());
+}
+
+// Tests that the disk tier drops its oldest entries once over its limit and that batched deletes reach it
+TEST (unchecked, spill_max)
+{
+	nano::test::system system{};
+	auto path (nano::unique_path () / "unchecked_spill.ldb");
+	nano::unchecked_map unchecked{ system.stats, false, path, 0, 300 };
+	nano::block_builder builder;
+	nano::keypair key;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	for (auto i = 0; i < 512; ++i)
+	{
+		blocks.push_back (builder
+						  .send ()
+						  .previous (1)
+						  .destination (1)
+						  .balance (i)
+						  .sign (key.prv, key.pub)
+						  .work (5)
+						  .build_shared ());
+		unchecked.put (blocks.back ()->previous (), nano::unchecked_info (blocks.back ()));
+	}
+	// Two batches were spilled, the oldest 212 entries of the first were dropped to stay within 300
+	ASSERT_EQ (512, system.stats.count (nano::stat::type::unchecked, nano::stat::detail::spill));
+	ASSERT_EQ (212, system.stats.count (nano::stat::type::unchecked, nano::stat::detail::spill_drop));
+	ASSERT_EQ (300, unchecked.count ());
+	ASSERT_FALSE (unchecked.exists (nano::unchecked_key{ 1, blocks[211]->hash () }));
+	ASSERT_TRUE (unchecked.exists (nano::unchecked_key{ 1, blocks[212]->hash () }));
+	ASSERT_TRUE (unchecked.exists (nano::unchecked_key{ 1, blocks[511]->hash () }));
+	// Deleting every remaining entry in one call empties the disk tier and removes the spill file
+	std::vector<nano::unchecked_key> keys;
+	for (auto i = 212; i < 512; ++i)
+	{
+		keys.emplace_back (1, blocks[i]->hash ());
+	}
+	unchecked.del (keys);
+	ASSERT_EQ (0, unchecked.count ());
+	ASSERT_FALSE (boost::filesystem::exists (path));
+}
+
+// Tests that triggered dependencies are released in batches and each entry only once
+TEST (unchecked, trigger_batch)
+{
+	nano::test::system system{};
+	nano::unchecked_map unchecked{ system.stats, false };
+	nano::block_builder builder;
+	for (auto i = 0; i < 6; ++i)
+	{
+		auto block = builder
+					 .send ()
+					 .previous (1 + i % 3)
+					 .destination (1)
+					 .balance (i)
+					 .sign (nano::keypair ().prv, 4)
+					 .work (5)
+					 .build_shared ();
+		unchecked.put (block->previous (), nano::unchecked_info (block));
+	}
+	std::atomic<size_t> batches{ 0 };
+	std::atomic<size_t> satisfied{ 0 };
+	unchecked.satisfied.add ([&batches, &satisfied] (std::vector<nano::unchecked_info> const & infos) {
+		++batches;
+		satisfied += infos.size ();
+	});
+	unchecked.trigger (3);
+	unchecked.trigger (1);
+	unchecked.trigger (1);
+	ASSERT_TIMELY (5s, satisfied == 4);
+	// Each drained set of triggers is released at once, the repeated trigger releases nothing new
+	ASSERT_LE (batches, 2);
+	unchecked.flush ();
+	ASSERT_EQ (2, unchecked.count ());
+	ASSERT_EQ (2, unchecked.get (2).size ());
+}
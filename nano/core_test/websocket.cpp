@@ -525,6 +525,70 @@ TEST (websocket, confirmation_options_sideband)
 	}
 }
 
+// Sessions with different confirmation options each receive the variant of the message matching their options
+TEST (websocket, confirmation_options_variants)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = system.get_available_port ();
+	auto node1 (system.add_node (config));
+
+	std::atomic<int> ack_ready{ 0 };
+	auto subscribe = [&ack_ready, &node1] (std::string const & options_a) {
+		fake_websocket_client client (node1->websocket.server->listening_port ());
+		client.send_message (R"json({"action": "subscribe", "topic": "confirmation", "ack": "true", "options": {"confirmation_type": "active_quorum", )json" + options_a + "}}");
+		client.await_ack ();
+		++ack_ready;
+		return client.get_response ();
+	};
+	auto future1 = std::async (std::launch::async, subscribe, R"json("include_block": "false", "include_sideband_info": "true")json");
+	auto future2 = std::async (std::launch::async, subscribe, R"json("include_block": "true", "include_election_info": "true")json");
+
+	ASSERT_TIMELY (10s, ack_ready == 2);
+	ASSERT_EQ (2, node1->websocket.server->subscriber_count (nano::websocket::topic::confirmation));
+
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	nano::keypair key;
+	nano::block_hash previous (node1->latest (nano::dev::genesis_key.pub));
+	nano::state_block_builder builder;
+	auto send = builder
+				.account (nano::dev::genesis_key.pub)
+				.previous (previous)
+				.representative (nano::dev::genesis_key.pub)
+				.balance (nano::dev::constants.genesis_amount - node1->config.online_weight_minimum.number () - 1)
+				.link (key.pub)
+				.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				.work (*system.work.generate (previous))
+				.build_shared ();
+	node1->process_active (send);
+
+	ASSERT_TIMELY (5s, future1.wait_for (0s) == std::future_status::ready && future2.wait_for (0s) == std::future_status::ready);
+
+	auto parse = [] (boost::optional<std::string> const & response_a) {
+		boost::property_tree::ptree event;
+		std::stringstream stream;
+		stream << response_a.get ();
+		boost::property_tree::read_json (stream, event);
+		return event;
+	};
+	auto response1 = future1.get ();
+	ASSERT_TRUE (response1);
+	auto event1 (parse (response1));
+	ASSERT_EQ (event1.get<std::string> ("message.hash"), send->hash ().to_string ());
+	ASSERT_FALSE (event1.get_child_optional ("message.block"));
+	ASSERT_FALSE (event1.get_child_optional ("message.election_info"));
+	ASSERT_TRUE (event1.get_child_optional ("message.sideband"));
+
+	auto response2 = future2.get ();
+	ASSERT_TRUE (response2);
+	auto event2 (parse (response2));
+	ASSERT_EQ (event2.get<std::string> ("message.hash"), send->hash ().to_string ());
+	ASSERT_TRUE (event2.get_child_optional ("message.block"));
+	ASSERT_TRUE (event2.get_child_optional ("message.election_info"));
+	ASSERT_FALSE (event2.get_child_optional ("message.sideband"));
+}
+
 // Tests updating options of block confirmations
 TEST (websocket, confirmation_options_update)
 {
@@ -600,6 +664,76 @@ TEST (websocket, confirmation_options_update)
 	ASSERT_TIMELY (5s, future.wait_for (0s) == std::future_status::ready);
 }
 
+// Confirmation filters are indexed by account, and the index follows subscription updates
+TEST (websocket, confirmation_index)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.websocket_config.enabled = true;
+	config.websocket_config.port = system.get_available_port ();
+	auto node1 (system.add_node (config));
+	auto const & index (node1->websocket.server->get_confirmation_index ());
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::keypair key3;
+
+	std::atomic<bool> updated{ false };
+	auto task = ([&updated, &index, &node1, &key1, &key2, &key3] () {
+		fake_websocket_client client (node1->websocket.server->listening_port ());
+		// Either prefix decodes to the same key
+		auto key2_xrb (key2.pub.to_account ());
+		key2_xrb.replace (0, 4, "xrb");
+		std::string subscribe_message = boost::str (boost::format (R"json({"action": "subscribe", "topic": "confirmation", "ack": "true", "options": {"accounts": ["%1%", "%2%", "%3%"]}})json") % key1.pub.to_account () % key2_xrb % key2.pub.to_account ());
+		client.send_message (subscribe_message);
+		client.await_ack ();
+		EXPECT_EQ (2, index.account_count ());
+
+		// A subscription without account filtering is not indexed by account
+		fake_websocket_client unfiltered_client (node1->websocket.server->listening_port ());
+		unfiltered_client.send_message (R"json({"action": "subscribe", "topic": "confirmation", "ack": "true"})json");
+		unfiltered_client.await_ack ();
+		EXPECT_EQ (2, index.account_count ());
+
+		std::string update_message = boost::str (boost::format (R"json({"action": "update", "topic": "confirmation", "ack": "true", "options": {"accounts_add": ["%1%", "%2%"], "accounts_del": ["%3%"]}})json") % key3.pub.to_account () % key2.pub.to_account () % key1.pub.to_account ());
+		client.send_message (update_message);
+		client.await_ack ();
+		EXPECT_EQ (2, index.account_count ());
+		updated = true;
+
+		// Sent to key3, which was added to the filter
+		auto response (client.get_response ());
+		EXPECT_TRUE (response);
+		std::stringstream stream;
+		stream << response.get ();
+		boost::property_tree::ptree event;
+		boost::property_tree::read_json (stream, event);
+		EXPECT_EQ (key3.pub.to_account (), event.get<std::string> ("message.block.link_as_account"));
+
+		client.send_message (R"json({"action": "unsubscribe", "topic": "confirmation", "ack": "true"})json");
+		client.await_ack ();
+		EXPECT_EQ (0, index.account_count ());
+	});
+	auto future = std::async (std::launch::async, task);
+
+	ASSERT_TIMELY (5s, updated);
+
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	nano::state_block_builder builder;
+	auto previous (node1->latest (nano::dev::genesis_key.pub));
+	auto send = builder
+				.account (nano::dev::genesis_key.pub)
+				.previous (previous)
+				.representative (nano::dev::genesis_key.pub)
+				.balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio)
+				.link (key3.pub)
+				.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				.work (*system.work.generate (previous))
+				.build_shared ();
+	node1->process_active (send);
+
+	ASSERT_TIMELY (5s, future.wait_for (0s) == std::future_status::ready);
+}
+
 // Subscribes to votes, sends a block and awaits websocket notification of a vote arrival
 TEST (websocket, vote)
 {
@@ -3,6 +3,7 @@
 #include <nano/lib/logger_mt.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/lib/work.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/node/logging.hpp>
 #include <nano/node/openclconfig.hpp>
 #include <nano/node/openclwork.hpp>
@@ -88,6 +89,30 @@ TEST (work, cancel_many)
 	pool.cancel (key1);
 }
 
+// Interactive requests preempt background work, and cancelling one root does not disturb the others
+TEST (work, priority)
+{
+	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	nano::root background_root (1);
+	std::promise<boost::optional<uint64_t>> background;
+	// Practically impossible difficulty, this request only finishes when cancelled
+	pool.generate (
+	nano::work_version::work_1, background_root, std::numeric_limits<uint64_t>::max (), [&background] (boost::optional<uint64_t> work_a) {
+		background.set_value (work_a);
+	},
+	nano::work_priority::background);
+	nano::root interactive_root (2);
+	auto work (pool.generate (nano::work_version::work_1, interactive_root, nano::dev::network_params.work.base));
+	ASSERT_TRUE (work.is_initialized ());
+	ASSERT_GE (nano::dev::network_params.work.difficulty (nano::work_version::work_1, interactive_root, *work), nano::dev::network_params.work.base);
+	ASSERT_EQ (1, pool.size ());
+	pool.cancel (background_root);
+	auto future (background.get_future ());
+	ASSERT_EQ (std::future_status::ready, future.wait_for (5s));
+	ASSERT_FALSE (future.get ().is_initialized ());
+	ASSERT_EQ (0, pool.size ());
+}
+
 TEST (work, opencl)
 {
 	nano::logging logging;
@@ -192,3 +217,43 @@ TEST (work, eco_pow)
 	// It's possible under some unlucky circumstances that this fails to the random nature of valid work generation.
 	ASSERT_LT (future1.get (), future2.get ());
 }
+
+// Every kernel supported by the running CPU must match the reference blake2b implementation, including for counts that are not a multiple of the lane count
+TEST (work, kernel_reference)
+{
+	auto reference = [] (nano::root const & root_a, uint64_t work_a) {
+		uint64_t result;
+		blake2b_state hash;
+		blake2b_init (&hash, sizeof (result));
+		blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work_a), sizeof (work_a));
+		blake2b_update (&hash, root_a.bytes.data (), root_a.bytes.size ());
+		blake2b_final (&hash, reinterpret_cast<uint8_t *> (&result), sizeof (result));
+		return result;
+	};
+	std::size_t const count{ 37 };
+	std::vector<nano::root> roots (count);
+	std::vector<uint64_t> works (count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		nano::random_pool::generate_block (roots[i].bytes.data (), roots[i].bytes.size ());
+		nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (&works[i]), sizeof (works[i]));
+	}
+	ASSERT_EQ (reference (roots[0], works[0]), nano::work_kernel::value (roots[0], works[0]));
+	auto kernels = nano::work_kernel::available ();
+	ASSERT_FALSE (kernels.empty ());
+	ASSERT_EQ (nano::work_kernel::best (), kernels.back ());
+	for (auto kernel : kernels)
+	{
+		std::vector<uint64_t> values (count);
+		nano::work_kernel::values (kernel, roots[0], works.data (), values.data (), count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ASSERT_EQ (reference (roots[0], works[i]), values[i]) << nano::work_kernel::to_string (kernel);
+		}
+		nano::work_kernel::values (kernel, roots.data (), works.data (), values.data (), count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ASSERT_EQ (reference (roots[i], works[i]), values[i]) << nano::work_kernel::to_string (kernel);
+		}
+	}
+}
@@ -1,5 +1,6 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/blocks.hpp>
+#include <nano/lib/json_writer.hpp>
 #include <nano/lib/memory.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/threading.hpp>
@@ -34,6 +35,21 @@ std::shared_ptr<block> deserialize_block (nano::stream & stream_a)
 
 	return result;
 }
+
+/** Field sinks for serialize_json_fields, so the ptree and json_writer overloads share one field list per block type */
+auto ptree_put (boost::property_tree::ptree & tree_a)
+{
+	return [&tree_a] (char const * key_a, std::string const & value_a) {
+		tree_a.put (key_a, value_a);
+	};
+}
+
+auto writer_put (nano::json_writer & writer_a)
+{
+	return [&writer_a] (char const * key_a, std::string const & value_a) {
+		writer_a.put (key_a, value_a);
+	};
+}
 }
 
 void nano::block_memory_pool_purge ()
@@ -79,6 +95,21 @@ size_t nano::block::size (nano::block_type type_a)
 	return result;
 }
 
+nano::block::block (nano::block const & other_a) :
+	cached_hash (other_a.cached_hash),
+	cached_work_value (other_a.cached_work_value.load (std::memory_order_relaxed)),
+	sideband_m (other_a.sideband_m)
+{
+}
+
+nano::block & nano::block::operator= (nano::block const & other_a)
+{
+	cached_hash = other_a.cached_hash;
+	cached_work_value.store (other_a.cached_work_value.load (std::memory_order_relaxed), std::memory_order_relaxed);
+	sideband_m = other_a.sideband_m;
+	return *this;
+}
+
 nano::work_version nano::block::work_version () const
 {
 	return nano::work_version::work_1;
@@ -102,6 +133,17 @@ void nano::block::refresh ()
 	{
 		cached_hash = generate_hash ();
 	}
+	cached_work_value.store (0, std::memory_order_relaxed);
+}
+
+uint64_t nano::block::work_value_cached () const
+{
+	return cached_work_value.load (std::memory_order_relaxed);
+}
+
+void nano::block::work_value_cache (uint64_t value_a) const
+{
+	cached_work_value.store (value_a, std::memory_order_relaxed);
 }
 
 nano::block_hash const & nano::block::hash () const
@@ -214,6 +256,7 @@ uint64_t nano::send_block::block_work () const
 void nano::send_block::block_work_set (uint64_t work_a)
 {
 	work = work_a;
+	cached_work_value.store (0, std::memory_order_relaxed);
 }
 
 nano::send_hashables::send_hashables (nano::block_hash const & previous_a, nano::account const & destination_a, nano::amount const & balance_a) :
@@ -300,27 +343,38 @@ bool nano::send_block::deserialize (nano::stream & stream_a)
 
 void nano::send_block::serialize_json (std::string & string_a, bool single_line) const
 {
-	boost::property_tree::ptree tree;
-	serialize_json (tree);
-	std::stringstream ostream;
-	boost::property_tree::write_json (ostream, tree, !single_line);
-	string_a = ostream.str ();
+	nano::json_writer writer (!single_line);
+	serialize_json (writer);
+	string_a = writer.finish ();
 }
 
-void nano::send_block::serialize_json (boost::property_tree::ptree & tree) const
+template <typename Put>
+void nano::send_block::serialize_json_fields (Put const & put) const
 {
-	tree.put ("type", "send");
+	put ("type", "send");
 	std::string previous;
 	hashables.previous.encode_hex (previous);
-	tree.put ("previous", previous);
-	tree.put ("destination", hashables.destination.to_account ());
+	put ("previous", previous);
+	put ("destination", hashables.destination.to_account ());
 	std::string balance;
 	hashables.balance.encode_hex (balance);
-	tree.put ("balance", balance);
+	put ("balance", balance);
 	std::string signature_l;
 	signature.encode_hex (signature_l);
-	tree.put ("work", nano::to_string_hex (work));
-	tree.put ("signature", signature_l);
+	put ("work", nano::to_string_hex (work));
+	put ("signature", signature_l);
+}
+
+void nano::send_block::serialize_json (boost::property_tree::ptree & tree) const
+{
+	serialize_json_fields (ptree_put (tree));
+}
+
+void nano::send_block::serialize_json (nano::json_writer & writer) const
+{
+	writer.begin_object ();
+	serialize_json_fields (writer_put (writer));
+	writer.end_object ();
 }
 
 bool nano::send_block::deserialize_json (boost::property_tree::ptree const & tree_a)
@@ -594,6 +648,7 @@ uint64_t nano::open_block::block_work () const
 void nano::open_block::block_work_set (uint64_t work_a)
 {
 	work = work_a;
+	cached_work_value.store (0, std::memory_order_relaxed);
 }
 
 nano::block_hash const & nano::open_block::previous () const
@@ -637,23 +692,34 @@ bool nano::open_block::deserialize (nano::stream & stream_a)
 
 void nano::open_block::serialize_json (std::string & string_a, bool single_line) const
 {
-	boost::property_tree::ptree tree;
-	serialize_json (tree);
-	std::stringstream ostream;
-	boost::property_tree::write_json (ostream, tree, !single_line);
-	string_a = ostream.str ();
+	nano::json_writer writer (!single_line);
+	serialize_json (writer);
+	string_a = writer.finish ();
 }
 
-void nano::open_block::serialize_json (boost::property_tree::ptree & tree) const
+template <typename Put>
+void nano::open_block::serialize_json_fields (Put const & put) const
 {
-	tree.put ("type", "open");
-	tree.put ("source", hashables.source.to_string ());
-	tree.put ("representative", representative ().to_account ());
-	tree.put ("account", hashables.account.to_account ());
+	put ("type", "open");
+	put ("source", hashables.source.to_string ());
+	put ("representative", representative ().to_account ());
+	put ("account", hashables.account.to_account ());
 	std::string signature_l;
 	signature.encode_hex (signature_l);
-	tree.put ("work", nano::to_string_hex (work));
-	tree.put ("signature", signature_l);
+	put ("work", nano::to_string_hex (work));
+	put ("signature", signature_l);
+}
+
+void nano::open_block::serialize_json (boost::property_tree::ptree & tree) const
+{
+	serialize_json_fields (ptree_put (tree));
+}
+
+void nano::open_block::serialize_json (nano::json_writer & writer) const
+{
+	writer.begin_object ();
+	serialize_json_fields (writer_put (writer));
+	writer.end_object ();
 }
 
 bool nano::open_block::deserialize_json (boost::property_tree::ptree const & tree_a)
@@ -851,6 +917,7 @@ uint64_t nano::change_block::block_work () const
 void nano::change_block::block_work_set (uint64_t work_a)
 {
 	work = work_a;
+	cached_work_value.store (0, std::memory_order_relaxed);
 }
 
 nano::block_hash const & nano::change_block::previous () const
@@ -886,22 +953,33 @@ bool nano::change_block::deserialize (nano::stream & stream_a)
 
 void nano::change_block::serialize_json (std::string & string_a, bool single_line) const
 {
-	boost::property_tree::ptree tree;
-	serialize_json (tree);
-	std::stringstream ostream;
-	boost::property_tree::write_json (ostream, tree, !single_line);
-	string_a = ostream.str ();
+	nano::json_writer writer (!single_line);
+	serialize_json (writer);
+	string_a = writer.finish ();
 }
 
-void nano::change_block::serialize_json (boost::property_tree::ptree & tree) const
+template <typename Put>
+void nano::change_block::serialize_json_fields (Put const & put) const
 {
-	tree.put ("type", "change");
-	tree.put ("previous", hashables.previous.to_string ());
-	tree.put ("representative", representative ().to_account ());
-	tree.put ("work", nano::to_string_hex (work));
+	put ("type", "change");
+	put ("previous", hashables.previous.to_string ());
+	put ("representative", representative ().to_account ());
+	put ("work", nano::to_string_hex (work));
 	std::string signature_l;
 	signature.encode_hex (signature_l);
-	tree.put ("signature", signature_l);
+	put ("signature", signature_l);
+}
+
+void nano::change_block::serialize_json (boost::property_tree::ptree & tree) const
+{
+	serialize_json_fields (ptree_put (tree));
+}
+
+void nano::change_block::serialize_json (nano::json_writer & writer) const
+{
+	writer.begin_object ();
+	serialize_json_fields (writer_put (writer));
+	writer.end_object ();
 }
 
 bool nano::change_block::deserialize_json (boost::property_tree::ptree const & tree_a)
@@ -1136,6 +1214,7 @@ uint64_t nano::state_block::block_work () const
 void nano::state_block::block_work_set (uint64_t work_a)
 {
 	work = work_a;
+	cached_work_value.store (0, std::memory_order_relaxed);
 }
 
 nano::block_hash const & nano::state_block::previous () const
@@ -1183,26 +1262,37 @@ bool nano::state_block::deserialize (nano::stream & stream_a)
 
 void nano::state_block::serialize_json (std::string & string_a, bool single_line) const
 {
-	boost::property_tree::ptree tree;
-	serialize_json (tree);
-	std::stringstream ostream;
-	boost::property_tree::write_json (ostream, tree, !single_line);
-	string_a = ostream.str ();
+	nano::json_writer writer (!single_line);
+	serialize_json (writer);
+	string_a = writer.finish ();
 }
 
-void nano::state_block::serialize_json (boost::property_tree::ptree & tree) const
+template <typename Put>
+void nano::state_block::serialize_json_fields (Put const & put) const
 {
-	tree.put ("type", "state");
-	tree.put ("account", hashables.account.to_account ());
-	tree.put ("previous", hashables.previous.to_string ());
-	tree.put ("representative", representative ().to_account ());
-	tree.put ("balance", hashables.balance.to_string_dec ());
-	tree.put ("link", hashables.link.to_string ());
-	tree.put ("link_as_account", hashables.link.to_account ());
+	put ("type", "state");
+	put ("account", hashables.account.to_account ());
+	put ("previous", hashables.previous.to_string ());
+	put ("representative", representative ().to_account ());
+	put ("balance", hashables.balance.to_string_dec ());
+	put ("link", hashables.link.to_string ());
+	put ("link_as_account", hashables.link.to_account ());
 	std::string signature_l;
 	signature.encode_hex (signature_l);
-	tree.put ("signature", signature_l);
-	tree.put ("work", nano::to_string_hex (work));
+	put ("signature", signature_l);
+	put ("work", nano::to_string_hex (work));
+}
+
+void nano::state_block::serialize_json (boost::property_tree::ptree & tree) const
+{
+	serialize_json_fields (ptree_put (tree));
+}
+
+void nano::state_block::serialize_json (nano::json_writer & writer) const
+{
+	writer.begin_object ();
+	serialize_json_fields (writer_put (writer));
+	writer.end_object ();
 }
 
 bool nano::state_block::deserialize_json (boost::property_tree::ptree const & tree_a)
@@ -1471,26 +1561,37 @@ bool nano::receive_block::deserialize (nano::stream & stream_a)
 
 void nano::receive_block::serialize_json (std::string & string_a, bool single_line) const
 {
-	boost::property_tree::ptree tree;
-	serialize_json (tree);
-	std::stringstream ostream;
-	boost::property_tree::write_json (ostream, tree, !single_line);
-	string_a = ostream.str ();
+	nano::json_writer writer (!single_line);
+	serialize_json (writer);
+	string_a = writer.finish ();
 }
 
-void nano::receive_block::serialize_json (boost::property_tree::ptree & tree) const
+template <typename Put>
+void nano::receive_block::serialize_json_fields (Put const & put) const
 {
-	tree.put ("type", "receive");
+	put ("type", "receive");
 	std::string previous;
 	hashables.previous.encode_hex (previous);
-	tree.put ("previous", previous);
+	put ("previous", previous);
 	std::string source;
 	hashables.source.encode_hex (source);
-	tree.put ("source", source);
+	put ("source", source);
 	std::string signature_l;
 	signature.encode_hex (signature_l);
-	tree.put ("work", nano::to_string_hex (work));
-	tree.put ("signature", signature_l);
+	put ("work", nano::to_string_hex (work));
+	put ("signature", signature_l);
+}
+
+void nano::receive_block::serialize_json (boost::property_tree::ptree & tree) const
+{
+	serialize_json_fields (ptree_put (tree));
+}
+
+void nano::receive_block::serialize_json (nano::json_writer & writer) const
+{
+	writer.begin_object ();
+	serialize_json_fields (writer_put (writer));
+	writer.end_object ();
 }
 
 bool nano::receive_block::deserialize_json (boost::property_tree::ptree const & tree_a)
@@ -1584,6 +1685,7 @@ uint64_t nano::receive_block::block_work () const
 void nano::receive_block::block_work_set (uint64_t work_a)
 {
 	work = work_a;
+	cached_work_value.store (0, std::memory_order_relaxed);
 }
 
 bool nano::receive_block::operator== (nano::block const & other_a) const
@@ -12,11 +12,13 @@
 
 #include <boost/property_tree/ptree_fwd.hpp>
 
+#include <atomic>
 #include <unordered_map>
 
 namespace nano
 {
 class block_visitor;
+class json_writer;
 class mutable_block_visitor;
 enum class block_type : uint8_t
 {
@@ -75,6 +77,9 @@ public:
 class block
 {
 public:
+	block () = default;
+	block (nano::block const &);
+	nano::block & operator= (nano::block const &);
 	// Return a digest of the hashables in this block.
 	nano::block_hash const & hash () const;
 	// Return a digest of hashables and non-hashables in this block.
@@ -104,6 +109,8 @@ public:
 	virtual void serialize (nano::stream &) const = 0;
 	virtual void serialize_json (std::string &, bool = false) const = 0;
 	virtual void serialize_json (boost::property_tree::ptree &) const = 0;
+	/** Writes the same fields as the ptree overload, as a nested object or as the root object */
+	virtual void serialize_json (nano::json_writer &) const = 0;
 	virtual void visit (nano::block_visitor &) const = 0;
 	virtual void visit (nano::mutable_block_visitor &) = 0;
 	virtual bool operator== (nano::block const &) const = 0;
@@ -116,9 +123,14 @@ public:
 	virtual nano::work_version work_version () const;
 	// If there are any changes to the hashables, call this to update the cached hash
 	void refresh ();
+	// Work value of the block's root and work, zero if it has not been computed yet. See work_thresholds::difficulty
+	uint64_t work_value_cached () const;
+	void work_value_cache (uint64_t) const;
 
 protected:
 	mutable nano::block_hash cached_hash{ 0 };
+	// Cleared whenever the work or hashables change. Atomic as blocks are shared between the work validation, network and block processor threads
+	mutable std::atomic<uint64_t> cached_work_value{ 0 };
 	/**
 	 * Contextual details about a block, some fields may or may not be set depending on block type.
 	 * This field is set via sideband_set in ledger processing or deserializing blocks from the database.
@@ -165,6 +177,7 @@ public:
 	bool deserialize (nano::stream &);
 	void serialize_json (std::string &, bool = false) const override;
 	void serialize_json (boost::property_tree::ptree &) const override;
+	void serialize_json (nano::json_writer &) const override;
 	bool deserialize_json (boost::property_tree::ptree const &);
 	void visit (nano::block_visitor &) const override;
 	void visit (nano::mutable_block_visitor &) override;
@@ -178,6 +191,11 @@ public:
 	nano::signature signature;
 	uint64_t work;
 	static std::size_t constexpr size = nano::send_hashables::size + sizeof (signature) + sizeof (work);
+
+private:
+	/** Lists the JSON fields once for both the ptree and json_writer overloads */
+	template <typename Put>
+	void serialize_json_fields (Put const &) const;
 };
 class receive_hashables
 {
@@ -210,6 +228,7 @@ public:
 	bool deserialize (nano::stream &);
 	void serialize_json (std::string &, bool = false) const override;
 	void serialize_json (boost::property_tree::ptree &) const override;
+	void serialize_json (nano::json_writer &) const override;
 	bool deserialize_json (boost::property_tree::ptree const &);
 	void visit (nano::block_visitor &) const override;
 	void visit (nano::mutable_block_visitor &) override;
@@ -223,6 +242,10 @@ public:
 	nano::signature signature;
 	uint64_t work;
 	static std::size_t constexpr size = nano::receive_hashables::size + sizeof (signature) + sizeof (work);
+
+private:
+	template <typename Put>
+	void serialize_json_fields (Put const &) const;
 };
 class open_hashables
 {
@@ -259,6 +282,7 @@ public:
 	bool deserialize (nano::stream &);
 	void serialize_json (std::string &, bool = false) const override;
 	void serialize_json (boost::property_tree::ptree &) const override;
+	void serialize_json (nano::json_writer &) const override;
 	bool deserialize_json (boost::property_tree::ptree const &);
 	void visit (nano::block_visitor &) const override;
 	void visit (nano::mutable_block_visitor &) override;
@@ -272,6 +296,10 @@ public:
 	nano::signature signature;
 	uint64_t work;
 	static std::size_t constexpr size = nano::open_hashables::size + sizeof (signature) + sizeof (work);
+
+private:
+	template <typename Put>
+	void serialize_json_fields (Put const &) const;
 };
 class change_hashables
 {
@@ -304,6 +332,7 @@ public:
 	bool deserialize (nano::stream &);
 	void serialize_json (std::string &, bool = false) const override;
 	void serialize_json (boost::property_tree::ptree &) const override;
+	void serialize_json (nano::json_writer &) const override;
 	bool deserialize_json (boost::property_tree::ptree const &);
 	void visit (nano::block_visitor &) const override;
 	void visit (nano::mutable_block_visitor &) override;
@@ -317,6 +346,10 @@ public:
 	nano::signature signature;
 	uint64_t work;
 	static std::size_t constexpr size = nano::change_hashables::size + sizeof (signature) + sizeof (work);
+
+private:
+	template <typename Put>
+	void serialize_json_fields (Put const &) const;
 };
 class state_hashables
 {
@@ -365,6 +398,7 @@ public:
 	bool deserialize (nano::stream &);
 	void serialize_json (std::string &, bool = false) const override;
 	void serialize_json (boost::property_tree::ptree &) const override;
+	void serialize_json (nano::json_writer &) const override;
 	bool deserialize_json (boost::property_tree::ptree const &);
 	void visit (nano::block_visitor &) const override;
 	void visit (nano::mutable_block_visitor &) override;
@@ -378,6 +412,10 @@ public:
 	nano::signature signature;
 	uint64_t work;
 	static std::size_t constexpr size = nano::state_hashables::size + sizeof (signature) + sizeof (work);
+
+private:
+	template <typename Put>
+	void serialize_json_fields (Put const &) const;
 };
 class block_visitor
 {
@@ -1,5 +1,6 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/config.hpp>
+#include <nano/lib/work_kernel.hpp>
 
 #include <boost/filesystem/path.hpp>
 #include <boost/format.hpp>
@@ -74,19 +75,23 @@ uint64_t nano::work_thresholds::threshold_entry (nano::work_version const versio
 #ifndef NANO_FUZZER_TEST
 uint64_t nano::work_thresholds::value (nano::root const & root_a, uint64_t work_a) const
 {
-	uint64_t result;
-	blake2b_state hash;
-	blake2b_init (&hash, sizeof (result));
-	blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work_a), sizeof (work_a));
-	blake2b_update (&hash, root_a.bytes.data (), root_a.bytes.size ());
-	blake2b_final (&hash, reinterpret_cast<uint8_t *> (&result), sizeof (result));
-	return result;
+	return nano::work_kernel::value (root_a, work_a);
+}
+
+void nano::work_thresholds::values (nano::root const * roots_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a) const
+{
+	nano::work_kernel::values (nano::work_kernel::best (), roots_a, works_a, values_a, count_a);
 }
 #else
 uint64_t nano::work_thresholds::value (nano::root const & root_a, uint64_t work_a) const
 {
 	return base + 1;
 }
+
+void nano::work_thresholds::values (nano::root const * roots_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a) const
+{
+	std::fill (values_a, values_a + count_a, base + 1);
+}
 #endif
 
 uint64_t nano::work_thresholds::threshold (nano::block_details const & details_a) const
@@ -196,7 +201,13 @@ uint64_t nano::work_thresholds::difficulty (nano::work_version const version_a,
 
 uint64_t nano::work_thresholds::difficulty (nano::block const & block_a) const
 {
-	return difficulty (block_a.work_version (), block_a.root (), block_a.block_work ());
+	auto result = block_a.work_value_cached ();
+	if (result == 0)
+	{
+		result = difficulty (block_a.work_version (), block_a.root (), block_a.block_work ());
+		block_a.work_value_cache (result);
+	}
+	return result;
 }
 
 bool nano::work_thresholds::validate_entry (nano::work_version const version_a, nano::root const & root_a, uint64_t const work_a) const
@@ -209,6 +220,37 @@ bool nano::work_thresholds::validate_entry (nano::block const & block_a) const
 	return difficulty (block_a) < threshold_entry (block_a.work_version (), block_a.type ());
 }
 
+std::vector<bool> nano::work_thresholds::validate_entry (std::vector<std::shared_ptr<nano::block>> const & blocks_a) const
+{
+	// Only blocks without a cached work value are hashed, the computed values are cached on the blocks
+	std::vector<std::size_t> indices;
+	std::vector<nano::root> roots;
+	std::vector<uint64_t> works;
+	for (std::size_t i = 0; i < blocks_a.size (); ++i)
+	{
+		auto const & block = blocks_a[i];
+		debug_assert (block->work_version () == nano::work_version::work_1);
+		if (block->work_value_cached () == 0)
+		{
+			indices.push_back (i);
+			roots.push_back (block->root ());
+			works.push_back (block->block_work ());
+		}
+	}
+	std::vector<uint64_t> results (indices.size ());
+	values (roots.data (), works.data (), results.data (), results.size ());
+	for (std::size_t i = 0; i < indices.size (); ++i)
+	{
+		blocks_a[indices[i]]->work_value_cache (results[i]);
+	}
+	std::vector<bool> result (blocks_a.size ());
+	for (std::size_t i = 0; i < blocks_a.size (); ++i)
+	{
+		result[i] = blocks_a[i]->work_value_cached () < threshold_entry (blocks_a[i]->work_version (), blocks_a[i]->type ());
+	}
+	return result;
+}
+
 namespace nano
 {
 char const * network_constants::active_network_err_msg = "Invalid network. Valid values are live, test, beta and dev.";
@@ -6,8 +6,10 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -175,12 +177,16 @@ public:
 	uint64_t threshold (nano::work_version const, nano::block_details const) const;
 	uint64_t threshold_base (nano::work_version const) const;
 	uint64_t value (nano::root const & root_a, uint64_t work_a) const;
+	/** Computes the work value of count_a root and nonce pairs, using the widest SIMD kernel the CPU supports */
+	void values (nano::root const * roots_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a) const;
 	double normalized_multiplier (double const, uint64_t const) const;
 	double denormalized_multiplier (double const, uint64_t const) const;
 	uint64_t difficulty (nano::work_version const, nano::root const &, uint64_t const) const;
 	uint64_t difficulty (nano::block const & block_a) const;
 	bool validate_entry (nano::work_version const, nano::root const &, uint64_t const) const;
 	bool validate_entry (nano::block const &) const;
+	/** Batched validate_entry, the element for each block is true if its work is insufficient */
+	std::vector<bool> validate_entry (std::vector<std::shared_ptr<nano::block>> const &) const;
 
 	/** Network work thresholds. Define these inline as constexpr when moving to cpp17. */
 	static nano::work_thresholds const publish_full;
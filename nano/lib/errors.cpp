@@ -185,6 +185,8 @@ std::string nano::error_rpc_messages::message (int ev) const
 			return "Legacy bootstrap is disabled";
 		case nano::error_rpc::invalid_balance:
 			return "Invalid balance number";
+		case nano::error_rpc::invalid_cursor:
+			return "Invalid or outdated cursor";
 		case nano::error_rpc::invalid_destinations:
 			return "Invalid destinations number";
 		case nano::error_rpc::invalid_epoch:
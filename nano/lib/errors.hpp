@@ -105,6 +105,7 @@ enum class error_rpc
 	disabled_bootstrap_lazy,
 	disabled_bootstrap_legacy,
 	invalid_balance,
+	invalid_cursor,
 	invalid_destinations,
 	invalid_epoch,
 	invalid_epoch_signer,
@@ -2,16 +2,18 @@
 #include <nano/lib/utility.hpp>
 
 nano::ipc::socket_base::socket_base (boost::asio::io_context & io_ctx_a) :
-	io_timer (io_ctx_a)
+	read_timer (io_ctx_a),
+	write_timer (io_ctx_a)
 {
 }
 
-void nano::ipc::socket_base::timer_start (std::chrono::seconds timeout_a)
+void nano::ipc::socket_base::timer_start (timer_type type_a, std::chrono::seconds timeout_a)
 {
 	if (timeout_a < std::chrono::seconds::max ())
 	{
-		io_timer.expires_from_now (boost::posix_time::seconds (static_cast<long> (timeout_a.count ())));
-		io_timer.async_wait ([this] (boost::system::error_code const & ec) {
+		auto & timer_l (timer (type_a));
+		timer_l.expires_from_now (boost::posix_time::seconds (static_cast<long> (timeout_a.count ())));
+		timer_l.async_wait ([this] (boost::system::error_code const & ec) {
 			if (!ec)
 			{
 				this->timer_expired ();
@@ -25,13 +27,18 @@ void nano::ipc::socket_base::timer_expired ()
 	close ();
 }
 
-void nano::ipc::socket_base::timer_cancel ()
+void nano::ipc::socket_base::timer_cancel (timer_type type_a)
 {
 	boost::system::error_code ec;
-	io_timer.cancel (ec);
+	timer (type_a).cancel (ec);
 	debug_assert (!ec);
 }
 
+boost::asio::deadline_timer & nano::ipc::socket_base::timer (timer_type type_a)
+{
+	return type_a == timer_type::read ? read_timer : write_timer;
+}
+
 nano::ipc::dsock_file_remover::dsock_file_remover (std::string const & file_a) :
 	filename (file_a)
 {
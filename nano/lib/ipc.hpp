@@ -35,17 +35,28 @@ namespace ipc
 		/** Close socket */
 		virtual void close () = 0;
 
+		/** A read and a write may be in flight at the same time, so each direction has its own timer */
+		enum class timer_type
+		{
+			read,
+			write
+		};
+
 		/**
 		 * Start IO timer.
+		 * @param type_a The operation the timer guards
 		 * @param timeout_a Seconds to wait. To wait indefinitely, use std::chrono::seconds::max ()
 		 */
-		void timer_start (std::chrono::seconds timeout_a);
+		void timer_start (timer_type type_a, std::chrono::seconds timeout_a);
 		void timer_expired ();
-		void timer_cancel ();
+		void timer_cancel (timer_type type_a);
 
 	private:
-		/** IO operation timer */
-		boost::asio::deadline_timer io_timer;
+		boost::asio::deadline_timer & timer (timer_type type_a);
+
+		/** IO operation timers */
+		boost::asio::deadline_timer read_timer;
+		boost::asio::deadline_timer write_timer;
 	};
 
 	/**
@@ -70,7 +81,14 @@ namespace ipc
 		flatbuffers = 0x3,
 
 		/** JSON -> Flatbuffers -> JSON  */
-		flatbuffers_json = 0x4
+		flatbuffers_json = 0x4,
+
+		/**
+		 * Framing is the same as flatbuffers, but the session reads the next request without awaiting the response.
+		 * Requests on one connection are processed concurrently and responses may arrive out of order; clients
+		 * match responses to requests through the correlation id of the envelope.
+		 */
+		flatbuffers_multiplexed = 0x5
 	};
 
 	/** IPC transport interface */
@@ -312,9 +312,10 @@ std::vector<uint8_t> nano::ipc::get_preamble (nano::ipc::payload_encoding encodi
 	return buffer_l;
 }
 
-nano::shared_const_buffer nano::ipc::prepare_flatbuffers_request (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a)
+nano::shared_const_buffer nano::ipc::prepare_flatbuffers_request (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a, nano::ipc::payload_encoding encoding_a)
 {
-	auto buffer_l (get_preamble (nano::ipc::payload_encoding::flatbuffers));
+	debug_assert (encoding_a == nano::ipc::payload_encoding::flatbuffers || encoding_a == nano::ipc::payload_encoding::flatbuffers_multiplexed);
+	auto buffer_l (get_preamble (encoding_a));
 	auto payload_length = static_cast<uint32_t> (flatbuffer_a->GetSize ());
 	uint32_t be = boost::endian::native_to_big (payload_length);
 	char * chars = reinterpret_cast<char *> (&be);
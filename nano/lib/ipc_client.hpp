@@ -73,8 +73,9 @@ namespace ipc
 
 	/**
 	 * Returns a buffer with an IPC preamble, followed by 32-bit BE lenght, followed by payload
+	 * @param encoding_a Either flatbuffers or flatbuffers_multiplexed
 	 */
-	nano::shared_const_buffer prepare_flatbuffers_request (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a);
+	nano::shared_const_buffer prepare_flatbuffers_request (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a, nano::ipc::payload_encoding encoding_a = nano::ipc::payload_encoding::flatbuffers);
 
 	template <typename T>
 	nano::shared_const_buffer shared_buffer_from (T & object_a, std::string const & correlation_id_a = {}, std::string const & credentials_a = {})
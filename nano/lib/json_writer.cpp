@@ -0,0 +1,226 @@
+#include <nano/lib/json_writer.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+
+nano::json_writer::json_writer (bool pretty_a) :
+	pretty{ pretty_a }
+{
+}
+
+void nano::json_writer::begin_object ()
+{
+	begin ('{', '}');
+}
+
+void nano::json_writer::end_object ()
+{
+	end ('}');
+}
+
+void nano::json_writer::begin_array ()
+{
+	debug_assert (!frames.empty ());
+	begin ('[', ']');
+}
+
+void nano::json_writer::end_array ()
+{
+	end (']');
+}
+
+nano::json_writer & nano::json_writer::key (std::string_view key_a)
+{
+	debug_assert (!frames.empty () && frames.back ().close == '}');
+	member ();
+	buffer.push_back ('"');
+	escape (key_a);
+	buffer.append (pretty ? "\": " : "\":");
+	return *this;
+}
+
+void nano::json_writer::value (std::string_view value_a)
+{
+	debug_assert (!frames.empty ());
+	if (frames.back ().close == ']')
+	{
+		member ();
+	}
+	buffer.push_back ('"');
+	escape (value_a);
+	buffer.push_back ('"');
+}
+
+void nano::json_writer::value (boost::property_tree::ptree const & tree_a)
+{
+	if (!frames.empty () && tree_a.empty ())
+	{
+		value (tree_a.data ());
+	}
+	else if (!frames.empty () && tree_a.count ("") == tree_a.size ())
+	{
+		begin_array ();
+		for (auto const & [name, child] : tree_a)
+		{
+			value (child);
+		}
+		end_array ();
+	}
+	else
+	{
+		begin_object ();
+		for (auto const & [name, child] : tree_a)
+		{
+			key (name).value (child);
+		}
+		end_object ();
+	}
+}
+
+void nano::json_writer::put (std::string_view key_a, std::string_view value_a)
+{
+	key (key_a).value (value_a);
+}
+
+void nano::json_writer::prepend (boost::property_tree::ptree const & tree_a)
+{
+	debug_assert (frames.empty () && !buffer.empty () && buffer.front () == '{');
+	if (tree_a.empty ())
+	{
+		return;
+	}
+	// Leave the root object of the leading members open, the remainder of this document closes it
+	nano::json_writer leading (pretty);
+	leading.begin_object ();
+	for (auto const & [name, child] : tree_a)
+	{
+		leading.key (name).value (child);
+	}
+	if (root_members > 0)
+	{
+		leading.buffer.push_back (',');
+	}
+	leading.buffer.append (buffer, 1);
+	buffer = std::move (leading.buffer);
+	root_members += tree_a.size ();
+}
+
+std::string nano::json_writer::finish ()
+{
+	debug_assert (frames.empty ());
+	// write_json terminates the document with std::endl
+	buffer.push_back ('\n');
+	return std::move (buffer);
+}
+
+void nano::json_writer::member ()
+{
+	auto & frame (frames.back ());
+	if (!frame.opened)
+	{
+		buffer.push_back (frame.close == '}' ? '{' : '[');
+		frame.opened = true;
+	}
+	if (frame.members++ > 0)
+	{
+		buffer.push_back (',');
+	}
+	if (pretty)
+	{
+		buffer.push_back ('\n');
+		buffer.append (4 * frames.size (), ' ');
+	}
+}
+
+void nano::json_writer::begin (char open_a, char close_a)
+{
+	if (frames.empty ())
+	{
+		// The root object is written even when it has no members
+		buffer.push_back (open_a);
+		frames.push_back ({ close_a, true, 0 });
+	}
+	else
+	{
+		if (frames.back ().close == ']')
+		{
+			member ();
+		}
+		// Deferred until the first member, an empty container is written as an empty string
+		frames.push_back ({ close_a, false, 0 });
+	}
+}
+
+void nano::json_writer::end (char close_a)
+{
+	debug_assert (!frames.empty () && frames.back ().close == close_a);
+	auto frame (frames.back ());
+	frames.pop_back ();
+	if (frames.empty ())
+	{
+		root_members = frame.members;
+	}
+	if (!frame.opened)
+	{
+		buffer.append ("\"\"");
+		return;
+	}
+	if (pretty)
+	{
+		buffer.push_back ('\n');
+		buffer.append (4 * frames.size (), ' ');
+	}
+	buffer.push_back (close_a);
+}
+
+void nano::json_writer::escape (std::string_view string_a)
+{
+	// Same escapes as boost::property_tree::json_parser::create_escapes, bytes from 0x5D up are written as is so UTF-8 passes through unchanged
+	for (auto ch : string_a)
+	{
+		auto c (static_cast<unsigned char> (ch));
+		if (c == 0x20 || c == 0x21 || (c >= 0x23 && c <= 0x2E) || (c >= 0x30 && c <= 0x5B) || c >= 0x5D)
+		{
+			buffer.push_back (ch);
+		}
+		else
+		{
+			switch (ch)
+			{
+				case '\b':
+					buffer.append ("\\b");
+					break;
+				case '\f':
+					buffer.append ("\\f");
+					break;
+				case '\n':
+					buffer.append ("\\n");
+					break;
+				case '\r':
+					buffer.append ("\\r");
+					break;
+				case '\t':
+					buffer.append ("\\t");
+					break;
+				case '/':
+					buffer.append ("\\/");
+					break;
+				case '"':
+					buffer.append ("\\\"");
+					break;
+				case '\\':
+					buffer.append ("\\\\");
+					break;
+				default:
+				{
+					char const * hexdigits = "0123456789ABCDEF";
+					buffer.append ("\\u00");
+					buffer.push_back (hexdigits[c >> 4]);
+					buffer.push_back (hexdigits[c & 0xF]);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Streams JSON into a string without building a property tree first.
+ * The output is byte-identical to boost::property_tree::write_json for the equivalent ptree: values are always strings,
+ * and a nested object or array without members is written as an empty string.
+ */
+class json_writer final
+{
+public:
+	explicit json_writer (bool pretty = true);
+	void begin_object ();
+	void end_object ();
+	/** Arrays are only valid below the root object, as with ptree */
+	void begin_array ();
+	void end_array ();
+	/** Writes the name of the next member of the current object, followed by exactly one value, object or array */
+	nano::json_writer & key (std::string_view);
+	void value (std::string_view);
+	/** Writes a subtree the same way write_json would write it at this position */
+	void value (boost::property_tree::ptree const &);
+	void put (std::string_view, std::string_view);
+	/** Inserts the members of a tree in front of the members of the closed root object */
+	void prepend (boost::property_tree::ptree const &);
+	/** Returns the rendered document, the root object must have been closed */
+	std::string finish ();
+
+private:
+	class frame final
+	{
+	public:
+		char close;
+		bool opened;
+		std::size_t members;
+	};
+
+	/** Opens the innermost container if it was deferred and writes the separator and indentation of its next member */
+	void member ();
+	void begin (char open, char close);
+	void end (char close);
+	void escape (std::string_view);
+
+	bool const pretty;
+	std::string buffer;
+	std::vector<frame> frames;
+	std::size_t root_members{ 0 };
+};
+}
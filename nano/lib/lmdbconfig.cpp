@@ -26,6 +26,9 @@ nano::error nano::lmdb_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory}");
 	toml.put ("max_databases", max_databases, "Maximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large amounts of wallets are required (see https://docs.nano.org/integration-guides/key-management/).\ntype:uin32");
 	toml.put ("map_size", map_size, "Maximum ledger database map size in bytes.\ntype:uint64");
+	toml.put ("read_txn_pool", read_txn_pool, "Reuse read transactions per thread instead of beginning a new transaction for every read. Reduces reader table churn under heavy RPC load.\ntype:bool");
+	toml.put ("read_txn_pool_size", read_txn_pool_size, "Maximum number of pooled read transactions. Each pooled transaction holds one of the 126 LMDB reader slots, the least recently used one is dropped once the pool is full.\ntype:uint64,[0..64]");
+	toml.put ("max_read_txn_age", max_read_txn_age.count (), "Long running readers refresh their read transaction once it has been open for longer than this duration.\ntype:milliseconds");
 	return toml.get_error ();
 }
 
@@ -34,6 +37,11 @@ nano::error nano::lmdb_config::deserialize_toml (nano::tomlconfig & toml)
 	auto default_max_databases = max_databases;
 	toml.get_optional<uint32_t> ("max_databases", max_databases);
 	toml.get_optional<size_t> ("map_size", map_size);
+	toml.get_optional<bool> ("read_txn_pool", read_txn_pool);
+	toml.get_optional<std::size_t> ("read_txn_pool_size", read_txn_pool_size);
+	auto max_read_txn_age_l = static_cast<unsigned long> (max_read_txn_age.count ());
+	toml.get_optional ("max_read_txn_age", max_read_txn_age_l);
+	max_read_txn_age = std::chrono::milliseconds (max_read_txn_age_l);
 
 	if (!toml.get_error ())
 	{
@@ -61,5 +69,10 @@ nano::error nano::lmdb_config::deserialize_toml (nano::tomlconfig & toml)
 		}
 	}
 
+	if (read_txn_pool_size > 64)
+	{
+		toml.get_error ().set ("read_txn_pool_size must be at most 64, half of the LMDB reader slots");
+	}
+
 	return toml.get_error ();
 }
@@ -2,6 +2,7 @@
 
 #include <nano/lib/errors.hpp>
 
+#include <chrono>
 #include <thread>
 
 namespace nano
@@ -46,5 +47,11 @@ public:
 	sync_strategy sync{ always };
 	uint32_t max_databases{ 128 };
 	size_t map_size{ 256ULL * 1024 * 1024 * 1024 };
+	/** Reuse a reset read transaction per thread rather than beginning a new one for every read */
+	bool read_txn_pool{ true };
+	/** Maximum number of pooled read transactions. Each one holds an LMDB reader slot (126 by default) while it is pooled */
+	std::size_t read_txn_pool_size{ 32 };
+	/** Staleness bound after which read_transaction::refresh_if_needed renews the snapshot of a long running reader */
+	std::chrono::milliseconds max_read_txn_age{ 500 };
 };
 }
@@ -284,6 +284,8 @@ char const * nano::mutex_identifier (mutexes mutex)
 			return "votes_cache";
 		case mutexes::work_pool:
 			return "work_pool";
+		case mutexes::work_validation:
+			return "work_validation";
 	}
 
 	throw std::runtime_error ("Invalid mutexes enum specified");
@@ -36,7 +36,8 @@ enum class mutexes
 	vote_processor,
 	vote_uniquer,
 	votes_cache,
-	work_pool
+	work_pool,
+	work_validation
 };
 
 char const * mutex_identifier (mutexes mutex);
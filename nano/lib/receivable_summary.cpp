@@ -0,0 +1,106 @@
+#include <nano/lib/receivable_summary.hpp>
+
+void nano::receivable_summary::add (nano::account const & account_a, nano::uint128_t const & amount_a)
+{
+	if (populated ())
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto & entry (entries[account_a]);
+		++entry.count;
+		entry.total += amount_a;
+		++entry.buckets[bucket_index (amount_a)];
+	}
+}
+
+void nano::receivable_summary::remove (nano::account const & account_a, nano::uint128_t const & amount_a)
+{
+	if (populated ())
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto existing (entries.find (account_a));
+		// Entries can be missing if the pending table was written to directly, bypassing the ledger
+		if (existing != entries.end ())
+		{
+			auto & entry (existing->second);
+			if (entry.count <= 1)
+			{
+				entries.erase (existing);
+			}
+			else
+			{
+				--entry.count;
+				entry.total -= std::min (entry.total, amount_a);
+				auto & bucket (entry.buckets[bucket_index (amount_a)]);
+				bucket -= std::min<uint32_t> (bucket, 1);
+			}
+		}
+	}
+}
+
+std::size_t nano::receivable_summary::bucket_index (nano::uint128_t const & amount_a)
+{
+	return amount_a == 0 ? 0 : boost::multiprecision::msb (amount_a) / bucket_bits;
+}
+
+nano::receivable_summary::entry nano::receivable_summary::get (nano::account const & account_a) const
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	auto existing (entries.find (account_a));
+	return existing != entries.end () ? existing->second : entry{};
+}
+
+bool nano::receivable_summary::may_have (nano::account const & account_a, nano::uint128_t const & amount_a) const
+{
+	if (!populated ())
+	{
+		return true;
+	}
+	auto entry (get (account_a));
+	for (auto i (bucket_index (amount_a)); i < bucket_count; ++i)
+	{
+		if (entry.buckets[i] > 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void nano::receivable_summary::copy_from (nano::receivable_summary & other_a)
+{
+	nano::lock_guard<nano::mutex> guard_this (mutex);
+	nano::lock_guard<nano::mutex> guard_other (other_a.mutex);
+	for (auto const & [account, other_entry] : other_a.entries)
+	{
+		auto & entry (entries[account]);
+		entry.count += other_entry.count;
+		entry.total += other_entry.total;
+		for (std::size_t i (0); i < bucket_count; ++i)
+		{
+			entry.buckets[i] += other_entry.buckets[i];
+		}
+	}
+}
+
+void nano::receivable_summary::set_populated ()
+{
+	populated_m = true;
+}
+
+bool nano::receivable_summary::populated () const
+{
+	return populated_m;
+}
+
+std::size_t nano::receivable_summary::size () const
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return entries.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (nano::receivable_summary const & receivable_summary, std::string const & name)
+{
+	auto composite = std::make_unique<nano::container_info_composite> (name);
+	composite->add_component (std::make_unique<nano::container_info_leaf> (container_info{ "entries", receivable_summary.size (), sizeof (decltype (receivable_summary.entries)::value_type) }));
+	return composite;
+}
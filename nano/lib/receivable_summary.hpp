@@ -0,0 +1,58 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace nano
+{
+/**
+ * In-memory summary of the pending table per destination account, maintained by the ledger alongside the pending entries.
+ * Allows receivable queries with a threshold to skip accounts which cannot have a qualifying entry without iterating all of their pending entries.
+ */
+class receivable_summary
+{
+public:
+	/** Amounts are bucketed by magnitude, each bucket covers bucket_bits bits of the 128 bit amount */
+	static std::size_t constexpr bucket_bits = 4;
+	static std::size_t constexpr bucket_count = 128 / bucket_bits;
+
+	class entry
+	{
+	public:
+		uint64_t count{ 0 };
+		nano::uint128_t total{ 0 };
+		/** Number of pending entries per amount bucket, see bucket_index */
+		std::array<uint32_t, bucket_count> buckets{};
+	};
+
+	static std::size_t bucket_index (nano::uint128_t const & amount_a);
+	void add (nano::account const & account_a, nano::uint128_t const & amount_a);
+	void remove (nano::account const & account_a, nano::uint128_t const & amount_a);
+	entry get (nano::account const & account_a) const;
+	/**
+	 * Returns false only if the account is known not to have a pending entry of at least amount_a. Always true until the summary is populated.
+	 * Entries in the same bucket as amount_a are assumed to qualify.
+	 */
+	bool may_have (nano::account const & account_a, nano::uint128_t const & amount_a) const;
+	void copy_from (receivable_summary & other_a);
+	/** Called once the summary has been generated from the pending table, until then add/remove are ignored */
+	void set_populated ();
+	bool populated () const;
+	std::size_t size () const;
+
+private:
+	mutable nano::mutex mutex;
+	std::unordered_map<nano::account, entry> entries;
+	std::atomic<bool> populated_m{ false };
+
+	friend std::unique_ptr<container_info_component> collect_container_info (receivable_summary const &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (receivable_summary const &, std::string const &);
+}
@@ -7,6 +7,11 @@ nano::error nano::rocksdb_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("enable", enable, "Whether to use the RocksDB backend for the ledger database.\ntype:bool");
 	toml.put ("memory_multiplier", memory_multiplier, "This will modify how much memory is used represented by 1 (low), 2 (medium), 3 (high). Default is 2.\ntype:uint8");
 	toml.put ("io_threads", io_threads, "Number of threads to use with the background compaction and flushing. Number of hardware threads is recommended.\ntype:uint32");
+	toml.put ("pending_profile", to_string (pending_profile), "Tuning profile for the pending table. prefix_bloom adds a bloom filter on the account prefix of each key.\ntype:string,{standard,prefix_bloom}");
+	toml.put ("blocks_profile", to_string (blocks_profile), "Tuning profile for the blocks table. point_lookup uses a ribbon filter and partitioned index and filter blocks pinned in the block cache.\ntype:string,{standard,point_lookup}");
+	toml.put ("accounts_profile", to_string (accounts_profile), "Tuning profile for the accounts table. hash_index uses a hash index for point lookups.\ntype:string,{standard,hash_index}");
+	toml.put ("confirmation_height_profile", to_string (confirmation_height_profile), "Tuning profile for the confirmation_height table. hash_index uses a hash index for point lookups.\ntype:string,{standard,hash_index}");
+	toml.put ("max_read_txn_age", max_read_txn_age.count (), "Long running readers refresh their read transaction once it has been open for longer than this duration.\ntype:milliseconds");
 	return toml.get_error ();
 }
 
@@ -15,6 +20,13 @@ nano::error nano::rocksdb_config::deserialize_toml (nano::tomlconfig & toml)
 	toml.get_optional<bool> ("enable", enable);
 	toml.get_optional<uint8_t> ("memory_multiplier", memory_multiplier);
 	toml.get_optional<unsigned> ("io_threads", io_threads);
+	deserialize_profile (toml, "pending_profile", pending_profile, table_profile::prefix_bloom);
+	deserialize_profile (toml, "blocks_profile", blocks_profile, table_profile::point_lookup);
+	deserialize_profile (toml, "accounts_profile", accounts_profile, table_profile::hash_index);
+	deserialize_profile (toml, "confirmation_height_profile", confirmation_height_profile, table_profile::hash_index);
+	auto max_read_txn_age_l = static_cast<unsigned long> (max_read_txn_age.count ());
+	toml.get_optional ("max_read_txn_age", max_read_txn_age_l);
+	max_read_txn_age = std::chrono::milliseconds (max_read_txn_age_l);
 
 	// Validate ranges
 	if (io_threads == 0)
@@ -29,6 +41,44 @@ nano::error nano::rocksdb_config::deserialize_toml (nano::tomlconfig & toml)
 	return toml.get_error ();
 }
 
+std::string nano::rocksdb_config::to_string (table_profile profile_a)
+{
+	switch (profile_a)
+	{
+		case table_profile::standard:
+			return "standard";
+		case table_profile::prefix_bloom:
+			return "prefix_bloom";
+		case table_profile::point_lookup:
+			return "point_lookup";
+		case table_profile::hash_index:
+			return "hash_index";
+	}
+	return "standard";
+}
+
+/** Each table accepts the standard profile plus the one profile suited to its access pattern */
+void nano::rocksdb_config::deserialize_profile (nano::tomlconfig & toml, std::string const & key_a, table_profile & profile_a, table_profile allowed_a)
+{
+	if (!toml.get_error ())
+	{
+		auto profile_string = to_string (profile_a);
+		toml.get_optional<std::string> (key_a, profile_string);
+		if (profile_string == to_string (table_profile::standard))
+		{
+			profile_a = table_profile::standard;
+		}
+		else if (profile_string == to_string (allowed_a))
+		{
+			profile_a = allowed_a;
+		}
+		else
+		{
+			toml.get_error ().set (key_a + " must be either standard or " + to_string (allowed_a));
+		}
+	}
+}
+
 bool nano::rocksdb_config::using_rocksdb_in_tests ()
 {
 	auto use_rocksdb_str = std::getenv ("TEST_USE_ROCKSDB");
@@ -3,6 +3,8 @@
 #include <nano/lib/errors.hpp>
 #include <nano/lib/threading.hpp>
 
+#include <chrono>
+#include <string>
 #include <thread>
 
 namespace nano
@@ -13,6 +15,19 @@ class tomlconfig;
 class rocksdb_config final
 {
 public:
+	/** Workload specific tuning applied to a column family */
+	enum class table_profile
+	{
+		/** Block based table with whole key bloom filter, shared by all active tables */
+		standard,
+		/** Prefix extractor and prefix bloom filter on the 32 byte account of the key. Applies to pending */
+		prefix_bloom,
+		/** Ribbon filter with partitioned index and filter blocks pinned in the block cache. Applies to blocks */
+		point_lookup,
+		/** Hash index over the full 32 byte key. Applies to accounts and confirmation_height */
+		hash_index
+	};
+
 	rocksdb_config () :
 		enable{ using_rocksdb_in_tests () }
 	{
@@ -26,5 +41,16 @@ public:
 	bool enable{ false };
 	uint8_t memory_multiplier{ 2 };
 	unsigned io_threads{ nano::hardware_concurrency () };
+	table_profile pending_profile{ table_profile::prefix_bloom };
+	table_profile blocks_profile{ table_profile::point_lookup };
+	table_profile accounts_profile{ table_profile::standard };
+	table_profile confirmation_height_profile{ table_profile::standard };
+	/** Staleness bound after which read_transaction::refresh_if_needed renews the snapshot of a long running reader */
+	std::chrono::milliseconds max_read_txn_age{ 500 };
+
+	static std::string to_string (table_profile);
+
+private:
+	void deserialize_profile (nano::tomlconfig & toml_a, std::string const & key_a, table_profile & profile_a, table_profile allowed_a);
 };
 }
@@ -83,6 +83,8 @@ public:
 	rpc_secure_config secure;
 	uint8_t max_json_depth{ 20 };
 	uint64_t max_request_size{ 32 * 1024 * 1024 };
+	/** HTTP/1.1 responses larger than this are sent with chunked transfer encoding in chunks of this size, 0 disables chunking */
+	uint64_t response_chunk_size{ 1024 * 1024 };
 	nano::rpc_logging_config rpc_logging;
 	/** Optional TLS config */
 	std::shared_ptr<nano::tls_config> tls_config;
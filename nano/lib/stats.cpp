@@ -6,9 +6,13 @@
 #include <boost/format.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
 #include <ctime>
 #include <fstream>
 #include <sstream>
+#include <thread>
 
 nano::error nano::stats_config::deserialize_toml (nano::tomlconfig & toml)
 {
@@ -117,6 +121,19 @@ public:
 		entries.push_back (std::make_pair ("", entry));
 	}
 
+	void write_latency (std::string const & stage, nano::latency_histogram::summary const & summary) override
+	{
+		boost::property_tree::ptree entry;
+		entry.put ("stage", stage);
+		entry.put ("count", summary.count);
+		entry.put ("mean", summary.mean);
+		entry.put ("p50", summary.p50);
+		entry.put ("p99", summary.p99);
+		entry.put ("p999", summary.p999);
+		entry.put ("max", summary.max);
+		entries.push_back (std::make_pair ("", entry));
+	}
+
 	void finalize () override
 	{
 		tree.add_child ("entries", entries);
@@ -252,6 +269,158 @@ std::vector<nano::stat_histogram::bin> nano::stat_histogram::get_bins () const
 	return bins;
 }
 
+/*
+ * latency_histogram
+ */
+
+nano::latency_histogram::latency_histogram ()
+{
+	clear ();
+}
+
+void nano::latency_histogram::add (std::chrono::steady_clock::duration duration_a)
+{
+	auto micros (std::chrono::duration_cast<std::chrono::microseconds> (duration_a).count ());
+	uint64_t value = micros > 0 ? static_cast<uint64_t> (micros) : 0;
+	buckets[index_of (value)].fetch_add (1, std::memory_order_relaxed);
+	total.fetch_add (value, std::memory_order_relaxed);
+	auto current (maximum.load (std::memory_order_relaxed));
+	while (value > current && !maximum.compare_exchange_weak (current, value, std::memory_order_relaxed))
+	{
+	}
+}
+
+nano::latency_histogram::summary nano::latency_histogram::get_summary () const
+{
+	std::array<uint64_t, bucket_count> counts;
+	summary result;
+	for (size_t i = 0; i < bucket_count; ++i)
+	{
+		counts[i] = buckets[i].load (std::memory_order_relaxed);
+		result.count += counts[i];
+	}
+	if (result.count == 0)
+	{
+		return result;
+	}
+	result.max = maximum.load (std::memory_order_relaxed);
+	result.mean = total.load (std::memory_order_relaxed) / result.count;
+	auto percentile = [&counts, &result] (double fraction_a) {
+		auto rank (std::max<uint64_t> (1, static_cast<uint64_t> (std::ceil (fraction_a * result.count))));
+		uint64_t seen{ 0 };
+		for (size_t i = 0; i < bucket_count; ++i)
+		{
+			seen += counts[i];
+			if (seen >= rank)
+			{
+				return std::min (highest_of (i), result.max);
+			}
+		}
+		return result.max;
+	};
+	result.p50 = percentile (0.5);
+	result.p99 = percentile (0.99);
+	result.p999 = percentile (0.999);
+	return result;
+}
+
+void nano::latency_histogram::clear ()
+{
+	for (auto & bucket : buckets)
+	{
+		bucket.store (0, std::memory_order_relaxed);
+	}
+	total.store (0, std::memory_order_relaxed);
+	maximum.store (0, std::memory_order_relaxed);
+}
+
+size_t nano::latency_histogram::index_of (uint64_t value_a)
+{
+	if (value_a < sub_bucket_count)
+	{
+		return static_cast<size_t> (value_a);
+	}
+	// Keep the top sub_bucket_bits bits of the value, the shift selects the power of two
+	size_t shift = std::bit_width (value_a) - sub_bucket_bits;
+	auto sub_bucket (static_cast<size_t> (value_a >> shift) - sub_bucket_count / 2);
+	return sub_bucket_count + (shift - 1) * (sub_bucket_count / 2) + sub_bucket;
+}
+
+uint64_t nano::latency_histogram::highest_of (size_t index_a)
+{
+	debug_assert (index_a < bucket_count);
+	if (index_a < sub_bucket_count)
+	{
+		return index_a;
+	}
+	auto offset (index_a - sub_bucket_count);
+	auto shift (offset / (sub_bucket_count / 2) + 1);
+	uint64_t lowest = static_cast<uint64_t> (offset % (sub_bucket_count / 2) + sub_bucket_count / 2) << shift;
+	return lowest + ((uint64_t{ 1 } << shift) - 1);
+}
+
+/*
+ * stat_counters
+ */
+
+namespace
+{
+std::atomic<size_t> next_shard{ 0 };
+/** Threads are assigned shards round robin, which spreads the node's thread pools evenly */
+thread_local size_t const thread_shard{ next_shard.fetch_add (1, std::memory_order_relaxed) };
+}
+
+nano::stat_counters::stat_counters () :
+	shard_count{ std::clamp<size_t> (std::thread::hardware_concurrency (), 1, max_shards) },
+	values{ std::make_unique<std::atomic<uint64_t>[]> (shard_count * size) }
+{
+	clear ();
+}
+
+void nano::stat_counters::add (uint32_t key_a, uint64_t value_a)
+{
+	auto shard (thread_shard % shard_count);
+	values[shard * size + index_of (key_a)].fetch_add (value_a, std::memory_order_relaxed);
+}
+
+uint64_t nano::stat_counters::get (uint32_t key_a) const
+{
+	auto index (index_of (key_a));
+	uint64_t result{ 0 };
+	for (size_t shard = 0; shard < shard_count; ++shard)
+	{
+		result += values[shard * size + index].load (std::memory_order_relaxed);
+	}
+	return result;
+}
+
+void nano::stat_counters::clear ()
+{
+	for (size_t i = 0, n = shard_count * size; i < n; ++i)
+	{
+		values[i].store (0, std::memory_order_relaxed);
+	}
+}
+
+size_t nano::stat_counters::index_of (uint32_t key_a)
+{
+	size_t type = key_a >> 16 & 0xff;
+	size_t detail = key_a >> 8 & 0xff;
+	size_t dir = key_a & 0xff;
+	debug_assert (type < static_cast<size_t> (stat::type::_last) && detail < static_cast<size_t> (stat::detail::_last) && dir < static_cast<size_t> (stat::dir::_last));
+	return (type * static_cast<size_t> (stat::detail::_last) + detail) * static_cast<size_t> (stat::dir::_last) + dir;
+}
+
+uint32_t nano::stat_counters::key_of (size_t index_a)
+{
+	debug_assert (index_a < size);
+	auto dir = index_a % static_cast<size_t> (stat::dir::_last);
+	index_a /= static_cast<size_t> (stat::dir::_last);
+	auto detail = index_a % static_cast<size_t> (stat::detail::_last);
+	auto type = index_a / static_cast<size_t> (stat::detail::_last);
+	return static_cast<uint32_t> (type << 16 | detail << 8 | dir);
+}
+
 /*
  * stats
  */
@@ -313,16 +482,31 @@ void nano::stats::log_counters_impl (stat_log_sink & sink)
 		sink.write_header ("counters", walltime);
 	}
 
-	for (auto & it : entries)
-	{
-		std::time_t time = std::chrono::system_clock::to_time_t (it.second->counter.get_timestamp ());
-		tm local_tm = *localtime (&time);
+	// Counters don't record the time of their last update, they are reported with the time they were read
+	std::time_t time = std::chrono::system_clock::to_time_t (std::chrono::system_clock::now ());
+	tm local_tm = *localtime (&time);
 
-		auto key = it.first;
-		std::string type = type_to_string (key);
-		std::string detail = detail_to_string (key);
-		std::string dir = dir_to_string (key);
-		sink.write_entry (local_tm, type, detail, dir, it.second->counter.get_value (), it.second->histogram.get ());
+	// Walk the counters and entries together, both are in key order. Counters which were never updated are skipped unless they have an entry.
+	auto entry = entries.begin ();
+	for (size_t index = 0; index < nano::stat_counters::size; ++index)
+	{
+		auto key = nano::stat_counters::key_of (index);
+		auto value = counters.get (key);
+		nano::stat_histogram * histogram = nullptr;
+		bool has_entry = false;
+		if (entry != entries.end () && entry->first == key)
+		{
+			histogram = entry->second->histogram.get ();
+			has_entry = true;
+			++entry;
+		}
+		if (value != 0 || has_entry)
+		{
+			std::string type = type_to_string (key);
+			std::string detail = detail_to_string (key);
+			std::string dir = dir_to_string (key);
+			sink.write_entry (local_tm, type, detail, dir, value, histogram);
+		}
 	}
 	sink.entries ()++;
 	sink.finalize ();
@@ -366,6 +550,23 @@ void nano::stats::log_samples_impl (stat_log_sink & sink)
 	sink.finalize ();
 }
 
+void nano::stats::log_latencies (stat_log_sink & sink)
+{
+	sink.begin ();
+	if (config.log_headers)
+	{
+		auto walltime (std::chrono::system_clock::now ());
+		sink.write_header ("latency", walltime);
+	}
+
+	for (size_t stage = 0; stage < latencies.size (); ++stage)
+	{
+		sink.write_latency (std::string{ nano::to_string (static_cast<stat::latency> (stage)) }, latencies[stage].get_summary ());
+	}
+	sink.entries ()++;
+	sink.finalize ();
+}
+
 void nano::stats::define_histogram (stat::type type, stat::detail detail, stat::dir dir, std::initializer_list<uint64_t> intervals_a, size_t bin_count_a /*=0*/)
 {
 	auto entry (get_entry (key_of (type, detail, dir)));
@@ -399,9 +600,11 @@ void nano::stats::update (uint32_t key_a, uint64_t value)
 		auto entry (get_entry_impl (key_a, config.interval, config.capacity));
 
 		// Counters
-		auto old (entry->counter.get_value ());
-		entry->counter.add (value);
-		entry->count_observers.notify (old, entry->counter.get_value ());
+		if (!entry->count_observers.empty ())
+		{
+			auto current (counters.get (key_a));
+			entry->count_observers.notify (current - value, current);
+		}
 
 		std::chrono::duration<double, std::milli> duration = now - log_last_count_writeout;
 		if (config.log_interval_counters > 0 && duration.count () > config.log_interval_counters)
@@ -469,6 +672,11 @@ std::string nano::stats::to_string (std::string type)
 		log_samples (*sink);
 		return sink->to_string ();
 	}
+	else if (type == "latency")
+	{
+		log_latencies (*sink);
+		return sink->to_string ();
+	}
 	else
 	{
 		return "type not supported: " + type;
@@ -479,6 +687,11 @@ void nano::stats::clear ()
 {
 	nano::unique_lock<nano::mutex> lock{ stat_mutex };
 	entries.clear ();
+	counters.clear ();
+	for (auto & latency : latencies)
+	{
+		latency.clear ();
+	}
 	timestamp = std::chrono::steady_clock::now ();
 }
 
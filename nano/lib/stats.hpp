@@ -7,6 +7,8 @@
 
 #include <boost/circular_buffer.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <initializer_list>
 #include <map>
@@ -138,9 +140,6 @@ public:
 	/** Value within the current sample interval */
 	stat_datapoint sample_current;
 
-	/** Counting value for this entry, including the time of last update. This is never reset and only increases. */
-	stat_datapoint counter;
-
 	/** Optional histogram for this entry */
 	std::unique_ptr<stat_histogram> histogram;
 
@@ -151,6 +150,79 @@ public:
 	nano::observer_set<uint64_t, uint64_t> count_observers;
 };
 
+/**
+ * Lock-free log-linear histogram of durations in microseconds, in the style of HdrHistogram.
+ * Values below sub_bucket_count are counted exactly. Above that, every power of two is split into sub_bucket_count / 2
+ * linear buckets, so a reported percentile is at most 1/32 above the recorded value.
+ */
+class latency_histogram final
+{
+public:
+	latency_histogram ();
+
+	void add (std::chrono::steady_clock::duration duration);
+
+	/** Percentiles and totals in microseconds, computed from a copy of the buckets */
+	class summary final
+	{
+	public:
+		uint64_t count{ 0 };
+		uint64_t mean{ 0 };
+		uint64_t p50{ 0 };
+		uint64_t p99{ 0 };
+		uint64_t p999{ 0 };
+		uint64_t max{ 0 };
+	};
+	summary get_summary () const;
+
+	void clear ();
+
+	static size_t constexpr sub_bucket_bits = 6;
+	static size_t constexpr sub_bucket_count = 1 << sub_bucket_bits;
+	static size_t constexpr bucket_count = sub_bucket_count + (64 - sub_bucket_bits) * (sub_bucket_count / 2);
+
+	static size_t index_of (uint64_t value);
+	/** Largest value counted in the bucket at \p index */
+	static uint64_t highest_of (size_t index);
+
+private:
+	std::array<std::atomic<uint64_t>, bucket_count> buckets;
+	std::atomic<uint64_t> total{ 0 };
+	std::atomic<uint64_t> maximum{ 0 };
+};
+
+/**
+ * Lock-free counters for every type/detail/dir combination, laid out as one dense array per shard.
+ * Each thread increments the shard it was assigned on first use, so concurrent increments rarely contend.
+ * Values are only aggregated across shards when read.
+ */
+class stat_counters final
+{
+public:
+	stat_counters ();
+
+	void add (uint32_t key, uint64_t value);
+
+	/** Sum of the counter over all shards */
+	uint64_t get (uint32_t key) const;
+
+	void clear ();
+
+	/** Number of counters in each shard, one for every valid key */
+	static constexpr size_t size = static_cast<size_t> (stat::type::_last) * static_cast<size_t> (stat::detail::_last) * static_cast<size_t> (stat::dir::_last);
+
+	/** Position of a key in a shard. Keys and positions sort in the same order. */
+	static size_t index_of (uint32_t key);
+	static uint32_t key_of (size_t index);
+
+private:
+	/** Shards are bounded so the memory use stays small on machines with many cores */
+	static size_t constexpr max_shards = 8;
+
+	size_t const shard_count;
+	std::unique_ptr<std::atomic<uint64_t>[]> values;
+};
+
 /** Log sink interface */
 class stat_log_sink
 {
@@ -180,6 +252,11 @@ public:
 	{
 	}
 
+	/** Write the percentiles of a latency stage. This is a no-op for sinks where latencies are not supported. */
+	virtual void write_latency (std::string const & stage, nano::latency_histogram::summary const & summary)
+	{
+	}
+
 	/** Rotates the log (e.g. empty file). This is a no-op for sinks where rotation is not supported. */
 	virtual void rotate ()
 	{
@@ -323,15 +400,30 @@ public:
 			return;
 		}
 
+		if (stopped.load (std::memory_order_relaxed))
+		{
+			return;
+		}
+
 		constexpr uint32_t no_detail_mask = 0xffff00ff;
 		uint32_t key = key_of (type, detail, dir);
 
-		update (key, value);
-
+		counters.add (key, value);
 		// Optionally update at type-level as well
-		if (!detail_only && (key & no_detail_mask) != key)
+		bool const type_level = !detail_only && (key & no_detail_mask) != key;
+		if (type_level)
+		{
+			counters.add (key & no_detail_mask, value);
+		}
+
+		// Sampling, file logging and count observers still need the entry
+		if (needs_update ())
 		{
-			update (key & no_detail_mask, value);
+			update (key, value);
+			if (type_level)
+			{
+				update (key & no_detail_mask, value);
+			}
 		}
 	}
 
@@ -359,6 +451,7 @@ public:
 	void observe_count (stat::type type, stat::detail detail, stat::dir dir, std::function<void (uint64_t, uint64_t)> observer)
 	{
 		get_entry (key_of (type, detail, dir))->count_observers.add (observer);
+		observed = true;
 	}
 
 	/** Returns a potentially empty list of the last N samples, where N is determined by the 'capacity' configuration */
@@ -376,7 +469,18 @@ public:
 	/** Returns current value for the given counter at the detail level */
 	uint64_t count (stat::type type, stat::detail detail, stat::dir dir = stat::dir::in)
 	{
-		return get_entry (key_of (type, detail, dir))->counter.get_value ();
+		return counters.get (key_of (type, detail, dir));
+	}
+
+	/** Records \p duration for a latency stage */
+	void sample (stat::latency stage, std::chrono::steady_clock::duration duration)
+	{
+		latencies[static_cast<size_t> (stage)].add (duration);
+	}
+
+	nano::latency_histogram::summary latency (stat::latency stage) const
+	{
+		return latencies[static_cast<size_t> (stage)].get_summary ();
 	}
 
 	/** Returns the number of seconds since clear() was last called, or node startup if it's never called. */
@@ -391,6 +495,9 @@ public:
 	/** Log samples to the given log sink */
 	void log_samples (stat_log_sink & sink);
 
+	/** Log latency percentiles to the given log sink */
+	void log_latencies (stat_log_sink & sink);
+
 	/** Returns a new JSON log sink */
 	std::unique_ptr<stat_log_sink> log_sink_json () const;
 
@@ -420,10 +527,16 @@ private:
 	/** Unlocked implementation of get_entry() */
 	std::shared_ptr<nano::stat_entry> get_entry_impl (uint32_t key, size_t sample_interval, size_t max_samples);
 
+	/** True if increments have to go through update(...) in addition to the counters */
+	bool needs_update () const
+	{
+		return config.sampling_enabled || config.log_interval_counters > 0 || observed.load (std::memory_order_relaxed);
+	}
+
 	/**
-	 * Update count and sample and call any observers on the key
+	 * Update sample and call any observers on the key. The counter must already include \p value.
 	 * @param key a key constructor from stat::type, stat::detail and stat::direction
-	 * @value Amount to add to the counter
+	 * @value Amount added to the counter
 	 */
 	void update (uint32_t key, uint64_t value);
 
@@ -439,13 +552,21 @@ private:
 	/** Configuration deserialized from config.json */
 	nano::stats_config config;
 
-	/** Stat entries are sorted by key to simplify processing of log output */
+	/** Counter values, these are kept outside of the entries so increments don't have to lock */
+	nano::stat_counters counters;
+
+	std::array<nano::latency_histogram, static_cast<size_t> (stat::latency::_last)> latencies;
+
+	/** Stat entries for samples, histograms and observers, sorted by key to simplify processing of log output */
 	std::map<uint32_t, std::shared_ptr<nano::stat_entry>> entries;
 	std::chrono::steady_clock::time_point log_last_count_writeout{ std::chrono::steady_clock::now () };
 	std::chrono::steady_clock::time_point log_last_sample_writeout{ std::chrono::steady_clock::now () };
 
 	/** Whether stats should be output */
-	bool stopped{ false };
+	std::atomic<bool> stopped{ false };
+
+	/** Set once a count observer is added */
+	std::atomic<bool> observed{ false };
 
 	/** All access to stat is thread safe, including calls from observers on the same thread */
 	nano::mutex stat_mutex;
@@ -18,4 +18,9 @@ std::string_view nano::to_string (nano::stat::detail detail)
 std::string_view nano::to_string (nano::stat::dir dir)
 {
 	return magic_enum::enum_name (dir);
-}
\ No newline at end of file
+}
+
+std::string_view nano::to_string (nano::stat::latency latency)
+{
+	return magic_enum::enum_name (latency);
+}
@@ -51,6 +51,11 @@ enum class type : uint8_t
 	bootstrap_ascending_connections,
 	bootstrap_ascending_thread,
 	bootstrap_ascending_accounts,
+	bootstrap_ascending_peers,
+	bootstrap_ascending_verify,
+
+	work_validation,
+	wallet_work_cache,
 
 	_last // Must be the last enum
 };
@@ -127,6 +132,7 @@ enum class detail : uint8_t
 	initiate_legacy_age,
 	initiate_lazy,
 	initiate_wallet_lazy,
+	retry,
 
 	// bootstrap specific
 	bulk_pull,
@@ -205,6 +211,7 @@ enum class detail : uint8_t
 
 	// ipc
 	invocations,
+	event_dropped,
 
 	// peering
 	handshake,
@@ -275,6 +282,8 @@ enum class detail : uint8_t
 	put,
 	satisfied,
 	trigger,
+	spill,
+	spill_drop,
 
 	// election scheduler
 	insert_manual,
@@ -328,6 +337,14 @@ enum class detail : uint8_t
 	deprioritize,
 	deprioritize_failed,
 
+	// bootstrap ascending peers
+	window_grow,
+	window_shrink,
+	throughput_idle,
+	throughput_low,
+	throughput_medium,
+	throughput_high,
+
 	// active
 	started_hinted,
 	started_optimistic,
@@ -336,6 +353,14 @@ enum class detail : uint8_t
 	pop_gap,
 	pop_leaf,
 
+	// work validation
+	work_cached,
+	work_validated,
+
+	// caches
+	hit,
+	miss,
+
 	_last // Must be the last enum
 };
 
@@ -347,6 +372,19 @@ enum class dir : uint8_t
 
 	_last // Must be the last enum
 };
+
+/** Latency stages, each measured from the hand-off into the stage until its completion */
+enum class latency : uint8_t
+{
+	block_processed, // block entered the block processor queue until the ledger processed it
+	election_started, // live block arrived from the network until an election was started for it
+	election_confirmed, // election was started until it was confirmed
+	block_cemented, // confirmed block was queued for cementing until it was cemented
+	vote_verified, // vote was queued by the vote processor until its signature was verified
+	vote_applied, // vote signature was verified until the vote was applied to elections
+
+	_last // Must be the last enum
+};
 }
 
 namespace nano
@@ -354,4 +392,5 @@ namespace nano
 std::string_view to_string (stat::type type);
 std::string_view to_string (stat::detail detail);
 std::string_view to_string (stat::dir dir);
+std::string_view to_string (stat::latency latency);
 }
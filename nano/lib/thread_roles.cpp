@@ -97,6 +97,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::optimistic_scheduler:
 			thread_role_name_string = "Optimistic";
 			break;
+		case nano::thread_role::name::work_validation:
+			thread_role_name_string = "Work validation";
+			break;
 		default:
 			debug_assert (false && "nano::thread_role::get_string unhandled thread role");
 	}
@@ -41,6 +41,7 @@ enum class name
 	ascending_bootstrap,
 	bootstrap_server_requests,
 	bootstrap_server_responses,
+	work_validation,
 };
 
 /*
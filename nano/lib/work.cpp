@@ -3,8 +3,10 @@
 #include <nano/lib/epoch.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/lib/work.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/node/xorshift.hpp>
 
+#include <array>
 #include <future>
 
 std::string nano::to_string (nano::work_version const version_a)
@@ -24,7 +26,6 @@ std::string nano::to_string (nano::work_version const version_a)
 
 nano::work_pool::work_pool (nano::network_constants & network_constants, unsigned max_threads_a, std::chrono::nanoseconds pow_rate_limiter_a, std::function<boost::optional<uint64_t> (nano::work_version const, nano::root const &, uint64_t, std::atomic<int> &)> opencl_a) :
 	network_constants{ network_constants },
-	ticket (0),
 	done (false),
 	pow_rate_limiter (pow_rate_limiter_a),
 	opencl (opencl_a)
@@ -32,6 +33,8 @@ nano::work_pool::work_pool (nano::network_constants & network_constants, unsigne
 	static_assert (ATOMIC_INT_LOCK_FREE == 2, "Atomic int needed");
 
 	auto count (network_constants.is_dev_network () ? std::min (max_threads_a, 1u) : std::min (max_threads_a, std::max (1u, nano::hardware_concurrency ())));
+	// Give every concurrent root at least two threads so a single root is not slowed down too much by sharing
+	max_concurrent = std::max (1u, count / 2);
 	if (opencl)
 	{
 		// One thread to handle OpenCL
@@ -56,6 +59,34 @@ nano::work_pool::~work_pool ()
 	}
 }
 
+std::shared_ptr<nano::work_item> nano::work_pool::select ()
+{
+	debug_assert (!mutex.try_lock ());
+	for (auto priority : { nano::work_priority::interactive, nano::work_priority::background })
+	{
+		// Oldest max_concurrent items of the highest priority class are eligible, pick the one with the fewest threads
+		std::shared_ptr<nano::work_item> result;
+		std::size_t eligible{ 0 };
+		for (auto i (pending.begin ()), n (pending.end ()); i != n && eligible < max_concurrent; ++i)
+		{
+			auto const & item (*i);
+			if (item->priority == priority)
+			{
+				++eligible;
+				if (result == nullptr || item->threads < result->threads)
+				{
+					result = item;
+				}
+			}
+		}
+		if (result != nullptr)
+		{
+			return result;
+		}
+	}
+	return nullptr;
+}
+
 void nano::work_pool::loop (uint64_t thread)
 {
 	// Quick RNG for work attempts.
@@ -63,8 +94,9 @@ void nano::work_pool::loop (uint64_t thread)
 	nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (rng.s.data ()), rng.s.size () * sizeof (decltype (rng.s)::value_type));
 	uint64_t work;
 	uint64_t output;
-	blake2b_state hash;
-	blake2b_init (&hash, sizeof (output));
+	auto const kernel = nano::work_kernel::best ();
+	std::array<uint64_t, 256> works;
+	std::array<uint64_t, 256> outputs;
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	auto pow_sleep = pow_rate_limiter;
 	while (!done)
@@ -75,39 +107,42 @@ void nano::work_pool::loop (uint64_t thread)
 			// Only work thread 0 notifies work observers
 			work_observers.notify (!empty);
 		}
-		if (!empty)
+		auto current_l (select ());
+		if (current_l != nullptr)
 		{
-			auto current_l (pending.front ());
-			int ticket_l (ticket);
+			++current_l->threads;
+			int ticket_l (current_l->ticket);
+			auto epoch_l (schedule_epoch.load ());
 			lock.unlock ();
+			work = 0;
 			output = 0;
 			boost::optional<uint64_t> opt_work;
 			if (thread == 0 && opencl)
 			{
-				opt_work = opencl (current_l.version, current_l.item, current_l.difficulty, ticket);
+				opt_work = opencl (current_l->version, current_l->item, current_l->difficulty, current_l->ticket);
 			}
 			if (opt_work.is_initialized ())
 			{
 				work = *opt_work;
-				output = network_constants.work.value (current_l.item, work);
+				output = network_constants.work.value (current_l->item, work);
 			}
 			else
 			{
-				// ticket != ticket_l indicates a different thread found a solution and we should stop
-				while (ticket == ticket_l && output < current_l.difficulty)
+				// A changed ticket indicates the item was solved by another thread or cancelled, a changed epoch that the schedule has to be reconsidered
+				while (current_l->ticket == ticket_l && schedule_epoch == epoch_l && output < current_l->difficulty)
 				{
 					// Don't query main memory every iteration in order to reduce memory bus traffic
 					// All operations here operate on stack memory
-					// Count iterations down to zero since comparing to zero is easier than comparing to another number
-					unsigned iteration (256);
-					while (iteration && output < current_l.difficulty)
+					// Attempts are evaluated in batches so the kernel can hash one nonce per SIMD lane
+					for (auto & attempt : works)
+					{
+						attempt = rng.next ();
+					}
+					nano::work_kernel::values (kernel, current_l->item, works.data (), outputs.data (), works.size ());
+					for (std::size_t i = 0; i < works.size () && output < current_l->difficulty; ++i)
 					{
-						work = rng.next ();
-						blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work), sizeof (work));
-						blake2b_update (&hash, current_l.item.bytes.data (), current_l.item.bytes.size ());
-						blake2b_final (&hash, reinterpret_cast<uint8_t *> (&output), sizeof (output));
-						blake2b_init (&hash, sizeof (output));
-						iteration -= 1;
+						work = works[i];
+						output = outputs[i];
 					}
 
 					// Add a rate limiter (if specified) to the pow calculation to save some CPUs which don't want to operate at full throttle
@@ -118,21 +153,22 @@ void nano::work_pool::loop (uint64_t thread)
 				}
 			}
 			lock.lock ();
-			if (ticket == ticket_l)
+			--current_l->threads;
+			if (current_l->ticket == ticket_l && output >= current_l->difficulty)
 			{
 				// If the ticket matches what we started with, we're the ones that found the solution
-				debug_assert (output >= current_l.difficulty);
-				debug_assert (current_l.difficulty == 0 || network_constants.work.value (current_l.item, work) == output);
+				debug_assert (current_l->difficulty == 0 || network_constants.work.value (current_l->item, work) == output);
 				// Signal other threads to stop their work next time they check ticket
-				++ticket;
-				pending.pop_front ();
+				++current_l->ticket;
+				pending.remove (current_l);
+				++schedule_epoch;
 				lock.unlock ();
-				current_l.callback (work);
+				current_l->callback (work);
 				lock.lock ();
 			}
 			else
 			{
-				// A different thread found a solution
+				// A different thread found a solution, the item was cancelled or it has been preempted
 			}
 		}
 		else
@@ -148,25 +184,21 @@ void nano::work_pool::cancel (nano::root const & root_a)
 	nano::lock_guard<nano::mutex> lock{ mutex };
 	if (!done)
 	{
-		if (!pending.empty ())
-		{
-			if (pending.front ().item == root_a)
-			{
-				++ticket;
-			}
-		}
+		// Only the items for this root are stopped, threads working on other roots are not disturbed
 		pending.remove_if ([&root_a] (decltype (pending)::value_type const & item_a) {
 			bool result{ false };
-			if (item_a.item == root_a)
+			if (item_a->item == root_a)
 			{
-				if (item_a.callback)
+				++item_a->ticket;
+				if (item_a->callback)
 				{
-					item_a.callback (boost::none);
+					item_a->callback (boost::none);
 				}
 				result = true;
 			}
 			return result;
 		});
+		++schedule_epoch;
 	}
 }
 
@@ -175,19 +207,23 @@ void nano::work_pool::stop ()
 	{
 		nano::lock_guard<nano::mutex> lock{ mutex };
 		done = true;
-		++ticket;
+		for (auto const & item : pending)
+		{
+			++item->ticket;
+		}
 	}
 	producer_condition.notify_all ();
 }
 
-void nano::work_pool::generate (nano::work_version const version_a, nano::root const & root_a, uint64_t difficulty_a, std::function<void (boost::optional<uint64_t> const &)> callback_a)
+void nano::work_pool::generate (nano::work_version const version_a, nano::root const & root_a, uint64_t difficulty_a, std::function<void (boost::optional<uint64_t> const &)> callback_a, nano::work_priority priority_a)
 {
 	debug_assert (!root_a.is_zero ());
 	if (!threads.empty ())
 	{
 		{
 			nano::lock_guard<nano::mutex> lock{ mutex };
-			pending.emplace_back (version_a, root_a, difficulty_a, callback_a);
+			pending.push_back (std::make_shared<nano::work_item> (version_a, root_a, difficulty_a, callback_a, priority_a));
+			++schedule_epoch;
 		}
 		producer_condition.notify_all ();
 	}
@@ -209,16 +245,18 @@ boost::optional<uint64_t> nano::work_pool::generate (nano::root const & root_a,
 	return generate (nano::work_version::work_1, root_a, difficulty_a);
 }
 
-boost::optional<uint64_t> nano::work_pool::generate (nano::work_version const version_a, nano::root const & root_a, uint64_t difficulty_a)
+boost::optional<uint64_t> nano::work_pool::generate (nano::work_version const version_a, nano::root const & root_a, uint64_t difficulty_a, nano::work_priority priority_a)
 {
 	boost::optional<uint64_t> result;
 	if (!threads.empty ())
 	{
 		std::promise<boost::optional<uint64_t>> work;
 		std::future<boost::optional<uint64_t>> future = work.get_future ();
-		generate (version_a, root_a, difficulty_a, [&work] (boost::optional<uint64_t> work_a) {
+		generate (
+		version_a, root_a, difficulty_a, [&work] (boost::optional<uint64_t> work_a) {
 			work.set_value (work_a);
-		});
+		},
+		priority_a);
 		result = future.get ().value ();
 	}
 	return result;
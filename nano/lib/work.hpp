@@ -10,6 +10,7 @@
 #include <boost/thread/thread.hpp>
 
 #include <atomic>
+#include <list>
 #include <memory>
 
 namespace nano
@@ -20,19 +21,39 @@ class block;
 class block_details;
 enum class block_type : uint8_t;
 
+/**
+ * Scheduling class of a work request. Interactive requests (RPC, wallet sends) always preempt background ones (wallet precaching, epoch upgrades)
+ */
+enum class work_priority : uint8_t
+{
+	interactive,
+	background
+};
+
 class opencl_work;
 class work_item final
 {
 public:
-	work_item (nano::work_version const version_a, nano::root const & item_a, uint64_t difficulty_a, std::function<void (boost::optional<uint64_t> const &)> const & callback_a) :
-		version (version_a), item (item_a), difficulty (difficulty_a), callback (callback_a)
+	work_item (nano::work_version const version_a, nano::root const & item_a, uint64_t difficulty_a, std::function<void (boost::optional<uint64_t> const &)> const & callback_a, nano::work_priority priority_a = nano::work_priority::interactive) :
+		version (version_a), item (item_a), difficulty (difficulty_a), callback (callback_a), priority (priority_a)
 	{
 	}
 	nano::work_version const version;
 	nano::root const item;
 	uint64_t const difficulty;
 	std::function<void (boost::optional<uint64_t> const &)> const callback;
+	nano::work_priority const priority;
+	// Incremented once the item is solved, cancelled or the pool is stopped, threads working on it stop when it changes
+	std::atomic<int> ticket{ 0 };
+	// Number of threads currently working on this item, protected by the work_pool mutex
+	unsigned threads{ 0 };
 };
+
+/**
+ * Generates work for several roots concurrently.
+ * Up to max_concurrent roots of the highest pending priority are worked on at once, each idle thread joins the one with the fewest threads.
+ * Threads reschedule whenever a root is added or removed so new interactive requests preempt background work straight away.
+ */
 class work_pool final
 {
 public:
@@ -41,22 +62,28 @@ public:
 	void loop (uint64_t);
 	void stop ();
 	void cancel (nano::root const &);
-	void generate (nano::work_version const, nano::root const &, uint64_t, std::function<void (boost::optional<uint64_t> const &)>);
-	boost::optional<uint64_t> generate (nano::work_version const, nano::root const &, uint64_t);
+	void generate (nano::work_version const, nano::root const &, uint64_t, std::function<void (boost::optional<uint64_t> const &)>, nano::work_priority = nano::work_priority::interactive);
+	boost::optional<uint64_t> generate (nano::work_version const, nano::root const &, uint64_t, nano::work_priority = nano::work_priority::interactive);
 	// For tests only
 	boost::optional<uint64_t> generate (nano::root const &);
 	boost::optional<uint64_t> generate (nano::root const &, uint64_t);
 	size_t size ();
 	nano::network_constants & network_constants;
-	std::atomic<int> ticket;
 	bool done;
 	std::vector<boost::thread> threads;
-	std::list<nano::work_item> pending;
+	std::list<std::shared_ptr<nano::work_item>> pending;
+	// Number of roots worked on concurrently
+	std::size_t max_concurrent{ 1 };
+	// Incremented whenever pending changes so working threads reconsider their root
+	std::atomic<uint64_t> schedule_epoch{ 0 };
 	nano::mutex mutex{ mutex_identifier (mutexes::work_pool) };
 	nano::condition_variable producer_condition;
 	std::chrono::nanoseconds pow_rate_limiter;
 	std::function<boost::optional<uint64_t> (nano::work_version const, nano::root const &, uint64_t, std::atomic<int> &)> opencl;
 	nano::observer_set<bool> work_observers;
+
+private:
+	std::shared_ptr<nano::work_item> select ();
 };
 
 std::unique_ptr<container_info_component> collect_container_info (work_pool & work_pool, std::string const & name);
@@ -0,0 +1,355 @@
+#include <nano/lib/utility.hpp>
+#include <nano/lib/work_kernel.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NANO_WORK_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+uint64_t constexpr blake2b_iv[8] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+uint8_t constexpr blake2b_sigma[12][16] = {
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+	{ 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+	{ 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+	{ 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+	{ 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+	{ 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+	{ 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+	{ 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+	{ 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 }
+};
+
+// First chaining value after applying the parameter block of an unkeyed 8 byte digest: digest length 8, fanout 1, depth 1
+uint64_t constexpr blake2b_h0 = blake2b_iv[0] ^ 0x01010008ULL;
+// The nonce and root fit in, and are the last, message block
+uint64_t constexpr input_size = sizeof (uint64_t) + sizeof (nano::root);
+
+uint64_t root_word (nano::root const & root_a, std::size_t index_a)
+{
+	uint64_t result;
+	std::memcpy (&result, root_a.bytes.data () + index_a * sizeof (result), sizeof (result));
+	return boost::endian::little_to_native (result);
+}
+
+/*
+ * The kernels share the compression function below, written in terms of per kernel V_ADD, V_XOR and V_RORn operations.
+ * Each operates on `v`, the 16 word working state, and `m`, the 16 word message block, where words are either scalars or vectors of lanes.
+ */
+#define NANO_WORK_G(r, i, a, b, c, d)                 \
+	a = V_ADD (V_ADD (a, b), m[blake2b_sigma[r][2 * i]]);     \
+	d = V_ROR32 (V_XOR (d, a));                       \
+	c = V_ADD (c, d);                                 \
+	b = V_ROR24 (V_XOR (b, c));                       \
+	a = V_ADD (V_ADD (a, b), m[blake2b_sigma[r][2 * i + 1]]); \
+	d = V_ROR16 (V_XOR (d, a));                       \
+	c = V_ADD (c, d);                                 \
+	b = V_ROR63 (V_XOR (b, c));
+
+#define NANO_WORK_ROUND(r)                          \
+	NANO_WORK_G (r, 0, v[0], v[4], v[8], v[12])     \
+	NANO_WORK_G (r, 1, v[1], v[5], v[9], v[13])     \
+	NANO_WORK_G (r, 2, v[2], v[6], v[10], v[14])    \
+	NANO_WORK_G (r, 3, v[3], v[7], v[11], v[15])    \
+	NANO_WORK_G (r, 4, v[0], v[5], v[10], v[15])    \
+	NANO_WORK_G (r, 5, v[1], v[6], v[11], v[12])    \
+	NANO_WORK_G (r, 6, v[2], v[7], v[8], v[13])     \
+	NANO_WORK_G (r, 7, v[3], v[4], v[9], v[14])
+
+#define NANO_WORK_ROUNDS  \
+	NANO_WORK_ROUND (0)   \
+	NANO_WORK_ROUND (1)   \
+	NANO_WORK_ROUND (2)   \
+	NANO_WORK_ROUND (3)   \
+	NANO_WORK_ROUND (4)   \
+	NANO_WORK_ROUND (5)   \
+	NANO_WORK_ROUND (6)   \
+	NANO_WORK_ROUND (7)   \
+	NANO_WORK_ROUND (8)   \
+	NANO_WORK_ROUND (9)   \
+	NANO_WORK_ROUND (10)  \
+	NANO_WORK_ROUND (11)
+
+uint64_t value_scalar (uint64_t const (&root_a)[4], uint64_t work_a)
+{
+#define V_ADD(a, b) ((a) + (b))
+#define V_XOR(a, b) ((a) ^ (b))
+#define V_ROR(a, n) (((a) >> (n)) | ((a) << (64 - (n))))
+#define V_ROR32(a) V_ROR (a, 32)
+#define V_ROR24(a) V_ROR (a, 24)
+#define V_ROR16(a) V_ROR (a, 16)
+#define V_ROR63(a) V_ROR (a, 63)
+	uint64_t const m[16] = { boost::endian::native_to_little (work_a), root_a[0], root_a[1], root_a[2], root_a[3] };
+	uint64_t v[16] = {
+		blake2b_h0, blake2b_iv[1], blake2b_iv[2], blake2b_iv[3], blake2b_iv[4], blake2b_iv[5], blake2b_iv[6], blake2b_iv[7],
+		blake2b_iv[0], blake2b_iv[1], blake2b_iv[2], blake2b_iv[3], blake2b_iv[4] ^ input_size, blake2b_iv[5], ~blake2b_iv[6], blake2b_iv[7]
+	};
+	NANO_WORK_ROUNDS
+	return boost::endian::little_to_native (blake2b_h0 ^ v[0] ^ v[8]);
+#undef V_ADD
+#undef V_XOR
+#undef V_ROR
+#undef V_ROR32
+#undef V_ROR24
+#undef V_ROR16
+#undef V_ROR63
+}
+
+void values_scalar (nano::root const * roots_a, std::size_t root_stride_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a)
+{
+	for (std::size_t i = 0; i < count_a; ++i)
+	{
+		auto const & root (roots_a[i * root_stride_a]);
+		uint64_t const words[4] = { root_word (root, 0), root_word (root, 1), root_word (root, 2), root_word (root, 3) };
+		values_a[i] = value_scalar (words, works_a[i]);
+	}
+}
+
+#ifdef NANO_WORK_KERNEL_X86
+/** 4 lanes, processes whole groups of lanes and returns how many nonces were evaluated */
+__attribute__ ((target ("avx2"))) std::size_t values_avx2 (nano::root const * roots_a, std::size_t root_stride_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a)
+{
+#define V_ADD(a, b) _mm256_add_epi64 (a, b)
+#define V_XOR(a, b) _mm256_xor_si256 (a, b)
+#define V_ROR32(a) _mm256_shuffle_epi32 (a, _MM_SHUFFLE (2, 3, 0, 1))
+#define V_ROR24(a) _mm256_shuffle_epi8 (a, r24)
+#define V_ROR16(a) _mm256_shuffle_epi8 (a, r16)
+#define V_ROR63(a) _mm256_or_si256 (_mm256_srli_epi64 (a, 63), _mm256_add_epi64 (a, a))
+	auto const r16 = _mm256_setr_epi8 (2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+	auto const r24 = _mm256_setr_epi8 (3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+	auto const zero = _mm256_setzero_si256 ();
+	__m256i shared_root[4];
+	for (auto word = 0; word < 4; ++word)
+	{
+		shared_root[word] = _mm256_set1_epi64x (root_word (roots_a[0], word));
+	}
+	std::size_t i = 0;
+	for (; i + 4 <= count_a; i += 4)
+	{
+		__m256i m[16];
+		m[0] = _mm256_loadu_si256 (reinterpret_cast<__m256i const *> (works_a + i));
+		for (auto word = 0; word < 4; ++word)
+		{
+			m[1 + word] = root_stride_a == 0 ? shared_root[word] : _mm256_set_epi64x (root_word (roots_a[(i + 3) * root_stride_a], word), root_word (roots_a[(i + 2) * root_stride_a], word), root_word (roots_a[(i + 1) * root_stride_a], word), root_word (roots_a[i * root_stride_a], word));
+		}
+		for (auto word = 5; word < 16; ++word)
+		{
+			m[word] = zero;
+		}
+		__m256i v[16];
+		v[0] = _mm256_set1_epi64x (blake2b_h0);
+		for (auto word = 1; word < 8; ++word)
+		{
+			v[word] = _mm256_set1_epi64x (blake2b_iv[word]);
+		}
+		for (auto word = 0; word < 8; ++word)
+		{
+			v[8 + word] = _mm256_set1_epi64x (blake2b_iv[word]);
+		}
+		v[12] = _mm256_set1_epi64x (blake2b_iv[4] ^ input_size);
+		v[14] = _mm256_set1_epi64x (~blake2b_iv[6]);
+		NANO_WORK_ROUNDS
+		auto result = V_XOR (_mm256_set1_epi64x (blake2b_h0), V_XOR (v[0], v[8]));
+		_mm256_storeu_si256 (reinterpret_cast<__m256i *> (values_a + i), result);
+	}
+	return i;
+#undef V_ADD
+#undef V_XOR
+#undef V_ROR32
+#undef V_ROR24
+#undef V_ROR16
+#undef V_ROR63
+}
+
+// GCC reports the undefined source operand used inside _mm512_ror_epi64 as maybe-uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+/** 8 lanes, processes whole groups of lanes and returns how many nonces were evaluated */
+__attribute__ ((target ("avx512f"))) std::size_t values_avx512 (nano::root const * roots_a, std::size_t root_stride_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a)
+{
+#define V_ADD(a, b) _mm512_add_epi64 (a, b)
+#define V_XOR(a, b) _mm512_xor_si512 (a, b)
+#define V_ROR32(a) _mm512_ror_epi64 (a, 32)
+#define V_ROR24(a) _mm512_ror_epi64 (a, 24)
+#define V_ROR16(a) _mm512_ror_epi64 (a, 16)
+#define V_ROR63(a) _mm512_ror_epi64 (a, 63)
+	auto const zero = _mm512_setzero_si512 ();
+	__m512i shared_root[4];
+	for (auto word = 0; word < 4; ++word)
+	{
+		shared_root[word] = _mm512_set1_epi64 (root_word (roots_a[0], word));
+	}
+	std::size_t i = 0;
+	for (; i + 8 <= count_a; i += 8)
+	{
+		__m512i m[16];
+		m[0] = _mm512_loadu_si512 (works_a + i);
+		for (auto word = 0; word < 4; ++word)
+		{
+			m[1 + word] = root_stride_a == 0 ? shared_root[word] : _mm512_set_epi64 (root_word (roots_a[(i + 7) * root_stride_a], word), root_word (roots_a[(i + 6) * root_stride_a], word), root_word (roots_a[(i + 5) * root_stride_a], word), root_word (roots_a[(i + 4) * root_stride_a], word), root_word (roots_a[(i + 3) * root_stride_a], word), root_word (roots_a[(i + 2) * root_stride_a], word), root_word (roots_a[(i + 1) * root_stride_a], word), root_word (roots_a[i * root_stride_a], word));
+		}
+		for (auto word = 5; word < 16; ++word)
+		{
+			m[word] = zero;
+		}
+		__m512i v[16];
+		v[0] = _mm512_set1_epi64 (blake2b_h0);
+		for (auto word = 1; word < 8; ++word)
+		{
+			v[word] = _mm512_set1_epi64 (blake2b_iv[word]);
+		}
+		for (auto word = 0; word < 8; ++word)
+		{
+			v[8 + word] = _mm512_set1_epi64 (blake2b_iv[word]);
+		}
+		v[12] = _mm512_set1_epi64 (blake2b_iv[4] ^ input_size);
+		v[14] = _mm512_set1_epi64 (~blake2b_iv[6]);
+		NANO_WORK_ROUNDS
+		auto result = V_XOR (_mm512_set1_epi64 (blake2b_h0), V_XOR (v[0], v[8]));
+		_mm512_storeu_si512 (values_a + i, result);
+	}
+	return i;
+#undef V_ADD
+#undef V_XOR
+#undef V_ROR32
+#undef V_ROR24
+#undef V_ROR16
+#undef V_ROR63
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+#undef NANO_WORK_ROUNDS
+#undef NANO_WORK_ROUND
+#undef NANO_WORK_G
+
+void values_impl (nano::work_kernel::type type_a, nano::root const * roots_a, std::size_t root_stride_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a)
+{
+	debug_assert (nano::work_kernel::supported (type_a));
+	std::size_t done{ 0 };
+#ifdef NANO_WORK_KERNEL_X86
+	switch (type_a)
+	{
+		case nano::work_kernel::type::avx512:
+			done = values_avx512 (roots_a, root_stride_a, works_a, values_a, count_a);
+			break;
+		case nano::work_kernel::type::avx2:
+			done = values_avx2 (roots_a, root_stride_a, works_a, values_a, count_a);
+			break;
+		case nano::work_kernel::type::scalar:
+			break;
+	}
+#endif
+	// Remaining nonces which don't fill all lanes
+	values_scalar (roots_a + done * root_stride_a, root_stride_a, works_a + done, values_a + done, count_a - done);
+}
+}
+
+nano::work_kernel::type nano::work_kernel::best ()
+{
+	static type const result = available ().back ();
+	return result;
+}
+
+bool nano::work_kernel::supported (type type_a)
+{
+	bool result{ false };
+	switch (type_a)
+	{
+		case type::scalar:
+			result = true;
+			break;
+		case type::avx2:
+#ifdef NANO_WORK_KERNEL_X86
+			result = __builtin_cpu_supports ("avx2");
+#endif
+			break;
+		case type::avx512:
+#ifdef NANO_WORK_KERNEL_X86
+			result = __builtin_cpu_supports ("avx512f");
+#endif
+			break;
+	}
+	return result;
+}
+
+std::vector<nano::work_kernel::type> nano::work_kernel::available ()
+{
+	std::vector<type> result;
+	for (auto type_l : { type::scalar, type::avx2, type::avx512 })
+	{
+		if (supported (type_l))
+		{
+			result.push_back (type_l);
+		}
+	}
+	return result;
+}
+
+std::size_t nano::work_kernel::lanes (type type_a)
+{
+	std::size_t result{ 1 };
+	switch (type_a)
+	{
+		case type::scalar:
+			result = 1;
+			break;
+		case type::avx2:
+			result = 4;
+			break;
+		case type::avx512:
+			result = 8;
+			break;
+	}
+	return result;
+}
+
+std::string nano::work_kernel::to_string (type type_a)
+{
+	std::string result;
+	switch (type_a)
+	{
+		case type::scalar:
+			result = "scalar";
+			break;
+		case type::avx2:
+			result = "avx2";
+			break;
+		case type::avx512:
+			result = "avx512";
+			break;
+	}
+	return result;
+}
+
+uint64_t nano::work_kernel::value (nano::root const & root_a, uint64_t work_a)
+{
+	uint64_t const words[4] = { root_word (root_a, 0), root_word (root_a, 1), root_word (root_a, 2), root_word (root_a, 3) };
+	return value_scalar (words, work_a);
+}
+
+void nano::work_kernel::values (type type_a, nano::root const & root_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a)
+{
+	values_impl (type_a, &root_a, 0, works_a, values_a, count_a);
+}
+
+void nano::work_kernel::values (type type_a, nano::root const * roots_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a)
+{
+	values_impl (type_a, roots_a, 1, works_a, values_a, count_a);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Blake2b specialised for proof of work, computing the 8 byte digest of an 8 byte nonce followed by a 32 byte root in a single compression.
+ * The vector kernels evaluate one nonce per 64-bit lane and are only used when the running CPU supports them.
+ */
+class work_kernel final
+{
+public:
+	enum class type
+	{
+		scalar,
+		avx2,
+		avx512
+	};
+
+	/** Widest kernel supported by the running CPU */
+	static type best ();
+	static bool supported (type);
+	/** All kernels supported by the running CPU, from narrowest to widest */
+	static std::vector<type> available ();
+	/** Number of nonces evaluated in parallel */
+	static std::size_t lanes (type);
+	static std::string to_string (type);
+
+	static uint64_t value (nano::root const & root_a, uint64_t work_a);
+	/** Computes the work value of count_a nonces against the same root */
+	static void values (type, nano::root const & root_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a);
+	/** Computes the work value of count_a independent root and nonce pairs */
+	static void values (type, nano::root const * roots_a, uint64_t const * works_a, uint64_t * values_a, std::size_t count_a);
+};
+}
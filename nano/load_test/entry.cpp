@@ -4,6 +4,7 @@
 #include <nano/boost/beast/core/flat_buffer.hpp>
 #include <nano/boost/beast/http.hpp>
 #include <nano/boost/process/child.hpp>
+#include <nano/lib/ipc_client.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/lib/tomlconfig.hpp>
 #include <nano/node/daemonconfig.hpp>
@@ -486,6 +487,73 @@ account_info account_info_rpc (boost::asio::io_context & ioc, tcp::resolver::res
 	return account_info;
 }
 
+/** Issues \p count account_info requests over JSON/HTTP, each on its own connection, and waits for all of them */
+void account_info_http (boost::asio::io_context & ioc, tcp::resolver::results_type const & results, std::string const & account, int count)
+{
+	boost::property_tree::ptree request;
+	request.put ("action", "account_info");
+	request.put ("account", account);
+
+	std::vector<std::shared_ptr<rpc_request_impl>> requests;
+	for (auto i = 0; i < count; ++i)
+	{
+		auto rpc_request = std::make_shared<rpc_request_impl> (request, ioc, results);
+		boost::asio::post (ioc, [rpc_request] () {
+			rpc_request->start ();
+		});
+		requests.push_back (std::move (rpc_request));
+	}
+	for (auto & rpc_request : requests)
+	{
+		if (rpc_request->value_get ().count ("error") > 0)
+		{
+			throw std::runtime_error ("account_info failed over JSON/HTTP");
+		}
+	}
+}
+
+/** Issues \p count account_info requests pipelined over a single multiplexed Flatbuffers IPC connection */
+void account_info_ipc (boost::asio::io_context & ioc, uint16_t port, std::string const & account, int count)
+{
+	nano::ipc::ipc_client client (ioc);
+	if (client.connect ("::1", port))
+	{
+		throw std::runtime_error ("Could not connect to IPC");
+	}
+	nanoapi::AccountInfoT request;
+	request.account = account;
+	for (auto i = 0; i < count; ++i)
+	{
+		auto buffer (nano::ipc::flatbuffer_producer::make_buffer (request, std::to_string (i)));
+		client.async_write (nano::ipc::prepare_flatbuffers_request (buffer, nano::ipc::payload_encoding::flatbuffers_multiplexed), [] (nano::error const &, size_t) {});
+	}
+	for (auto i = 0; i < count; ++i)
+	{
+		auto response (std::make_shared<std::vector<uint8_t>> ());
+		std::promise<bool> read;
+		client.async_read_message (response, std::chrono::seconds (5), [&read] (nano::error const & error_a, size_t) {
+			read.set_value (!error_a);
+		});
+		// Responses are matched by correlation id and read in place, without unpacking
+		if (!read.get_future ().get () || nanoapi::GetEnvelope (response->data ())->message_type () != nanoapi::Message::Message_AccountInfoResponse)
+		{
+			throw std::runtime_error ("account_info failed over Flatbuffers IPC");
+		}
+	}
+}
+
+/** Compares the throughput of account_info over JSON/HTTP with pipelined Flatbuffers IPC on the primary node */
+void compare_transports (boost::asio::io_context & ioc, tcp::resolver::results_type const & results, std::string const & account, int count)
+{
+	nano::timer<std::chrono::milliseconds> timer;
+	timer.start ();
+	account_info_http (ioc, results, account, count);
+	auto http_time = timer.restart ();
+	account_info_ipc (ioc, ipc_port_start, account, count);
+	auto ipc_time = timer.stop ();
+	std::cout << count << " account_info requests: JSON/HTTP " << http_time.count () << " ms, Flatbuffers IPC " << ipc_time.count () << " ms" << std::endl;
+}
+
 /** This launches a node and fires a lot of send/recieve RPC requests at it (configurable), then other nodes are tested to make sure they observe these blocks as well. */
 int main (int argc, char * const * argv)
 {
@@ -500,6 +568,7 @@ int main (int argc, char * const * argv)
 		("send_count,s", boost::program_options::value<int> ()->default_value (2000), "How many send blocks to generate")
 		("simultaneous_process_calls", boost::program_options::value<int> ()->default_value (20), "Number of simultaneous rpc sends to do")
 		("destination_count", boost::program_options::value<int> ()->default_value (2), "How many destination accounts to choose between")
+		("transport_compare_count", boost::program_options::value<int> ()->default_value (0), "Number of account_info requests used to compare JSON/HTTP with Flatbuffers IPC, 0 to skip")
 		("node_path", boost::program_options::value<std::string> (), "The path to the nano_node to test")
 		("rpc_path", boost::program_options::value<std::string> (), "The path to the nano_rpc to test");
 	// clang-format on
@@ -520,6 +589,7 @@ int main (int argc, char * const * argv)
 	auto destination_count = vm.find ("destination_count")->second.as<int> ();
 	auto send_count = vm.find ("send_count")->second.as<int> ();
 	auto simultaneous_process_calls = vm.find ("simultaneous_process_calls")->second.as<int> ();
+	auto transport_compare_count = vm.find ("transport_compare_count")->second.as<int> ();
 
 	boost::system::error_code err;
 	auto running_executable_filepath = boost::dll::program_location (err);
@@ -601,7 +671,7 @@ int main (int argc, char * const * argv)
 	tcp::resolver resolver{ ioc };
 	auto const primary_node_results = resolver.resolve ("::1", std::to_string (rpc_port_start));
 
-	std::thread t ([send_count, &ioc, &primary_node_results, &resolver, &node_count, &destination_count] () {
+	std::thread t ([send_count, &ioc, &primary_node_results, &resolver, &node_count, &destination_count, transport_compare_count] () {
 		for (int i = 0; i < node_count; ++i)
 		{
 			keepalive_rpc (ioc, primary_node_results, peering_port_start + i);
@@ -708,6 +778,11 @@ int main (int argc, char * const * argv)
 			stop_rpc (ioc, results);
 		}
 
+		if (transport_compare_count > 0)
+		{
+			compare_transports (ioc, primary_node_results, destination_accounts.front ().as_string, transport_compare_count);
+		}
+
 		// Stop main node
 		stop_rpc (ioc, primary_node_results);
 	});
@@ -1,6 +1,7 @@
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/cli.hpp>
 #include <nano/lib/utility.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/nano_node/daemon.hpp>
 #include <nano/node/cli.hpp>
 #include <nano/node/daemonconfig.hpp>
@@ -24,6 +25,7 @@
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 
+#include <array>
 #include <numeric>
 #include <sstream>
 
@@ -498,6 +500,22 @@ int main (int argc, char * const * argv)
 			nano::change_block block (0, 0, nano::keypair ().prv, 0, 0);
 			if (!result)
 			{
+				for (auto kernel : nano::work_kernel::available ())
+				{
+					// Single thread hash rate of each kernel the CPU supports, work_pool uses the widest
+					std::array<uint64_t, 256> works;
+					std::array<uint64_t, 256> values;
+					std::iota (works.begin (), works.end (), 0);
+					uint64_t const count{ 4 * 1024 * 1024 };
+					auto begin1 (std::chrono::steady_clock::now ());
+					for (uint64_t i (0); i < count; i += works.size ())
+					{
+						nano::work_kernel::values (kernel, block.root (), works.data (), values.data (), works.size ());
+						works[0] += works.size ();
+					}
+					auto total_time (std::max<int64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin1).count (), 1));
+					std::cerr << boost::str (boost::format ("Kernel %1%: %2% hashes/s per thread (last value %3$#x)\n") % nano::work_kernel::to_string (kernel) % static_cast<uint64_t> (count * 1e9 / total_time) % values.back ());
+				}
 				std::cerr << boost::str (boost::format ("Starting generation profiling. Difficulty: %1$#x (%2%x from base difficulty %3$#x)\n") % difficulty % nano::to_string (nano::difficulty::to_multiplier (difficulty, nano::work_thresholds::publish_full.base), 4) % nano::work_thresholds::publish_full.base);
 				while (!result)
 				{
@@ -525,6 +543,28 @@ int main (int argc, char * const * argv)
 			auto total_time (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - start).count ());
 			uint64_t average (total_time / count);
 			std::cout << "Average validation time: " << std::to_string (average) << " ns (" << std::to_string (static_cast<unsigned> (count * 1e9 / total_time)) << " validations/s)" << std::endl;
+			// Batched validation of independent roots as done for deserialized blocks, once per kernel the CPU supports
+			std::vector<nano::root> roots (256);
+			std::vector<uint64_t> works (roots.size ());
+			std::vector<uint64_t> values (roots.size ());
+			for (std::size_t i (0); i < roots.size (); ++i)
+			{
+				roots[i] = nano::root (i);
+				works[i] = i;
+			}
+			for (auto kernel : nano::work_kernel::available ())
+			{
+				auto begin1 (std::chrono::steady_clock::now ());
+				uint64_t valid_count{ 0 };
+				for (uint64_t i (0); i < count; i += roots.size ())
+				{
+					nano::work_kernel::values (kernel, roots.data (), works.data (), values.data (), roots.size ());
+					valid_count += values[0] > difficulty;
+					works[0] += 1;
+				}
+				auto kernel_time (std::max<int64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin1).count (), 1));
+				std::cout << "Kernel " << nano::work_kernel::to_string (kernel) << ": " << std::to_string (static_cast<uint64_t> (count * 1e9 / kernel_time)) << " validations/s (" << valid_count << " valid)" << std::endl;
+			}
 		}
 		else if (vm.count ("debug_opencl"))
 		{
@@ -421,6 +421,10 @@ nano::election_insertion_result nano::active_transactions::insert_impl (nano::un
 					cache->fill (result.election);
 				}
 				node.stats.inc (nano::stat::type::active_started, nano::to_stat_detail (election_behavior_a));
+				if (auto arrival = node.block_arrival.arrival_time (hash))
+				{
+					node.stats.sample (nano::stat::latency::election_started, std::chrono::steady_clock::now () - *arrival);
+				}
 				node.observers.active_started.notify (hash);
 				vacancy_update ();
 			}
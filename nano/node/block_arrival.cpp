@@ -20,6 +20,17 @@ bool nano::block_arrival::recent (nano::block_hash const & hash_a)
 	return arrival.get<tag_hash> ().find (hash_a) != arrival.get<tag_hash> ().end ();
 }
 
+std::optional<std::chrono::steady_clock::time_point> nano::block_arrival::arrival_time (nano::block_hash const & hash_a)
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto existing (arrival.get<tag_hash> ().find (hash_a));
+	if (existing == arrival.get<tag_hash> ().end ())
+	{
+		return std::nullopt;
+	}
+	return existing->arrival;
+}
+
 std::unique_ptr<nano::container_info_component> nano::collect_container_info (block_arrival & block_arrival, std::string const & name)
 {
 	std::size_t count = 0;
@@ -8,6 +8,7 @@
 #include <boost/multi_index_container.hpp>
 
 #include <chrono>
+#include <optional>
 
 namespace nano
 {
@@ -26,6 +27,8 @@ public:
 	// Return `true' to indicated an error if the block has already been inserted
 	bool add (nano::block_hash const &);
 	bool recent (nano::block_hash const &);
+	/** Returns when the block arrived, if it arrived recently */
+	std::optional<std::chrono::steady_clock::time_point> arrival_time (nano::block_hash const &);
 
 	// clang-format off
 	class tag_sequence {};
@@ -12,7 +12,8 @@ nano::block_processor::block_processor (nano::node & node_a, nano::write_databas
 	next_log (std::chrono::steady_clock::now ()),
 	node (node_a),
 	write_database_queue (write_database_queue_a),
-	state_block_signature_verification (node.checker, node.ledger.constants.epochs, node.config, node.logger, node.flags.block_processor_verification_size)
+	state_block_signature_verification (node.checker, node.ledger.constants.epochs, node.config, node.logger, node.flags.block_processor_verification_size),
+	work_validation (node.network_params.work, node.stats, node.config.work_validation_threads)
 {
 	batch_processed.add ([this] (auto const & items) {
 		// For every batch item: notify the 'processed' observer.
@@ -36,6 +37,10 @@ nano::block_processor::block_processor (nano::node & node_a, nano::write_databas
 			this->condition.notify_all ();
 		}
 	};
+	work_validation.blocks_validated_callback = [this] (std::deque<nano::work_validation::value_type> & items, std::vector<bool> const & insufficient) {
+		this->process_validated_work (items, insufficient);
+	};
+	work_validation.transition_inactive_callback = state_block_signature_verification.transition_inactive_callback;
 	processing_thread = std::thread ([this] () {
 		nano::thread_role::set (nano::thread_role::name::block_processing);
 		this->process_blocks ();
@@ -50,6 +55,7 @@ void nano::block_processor::stop ()
 	}
 	condition.notify_all ();
 	blocking.stop ();
+	work_validation.stop ();
 	state_block_signature_verification.stop ();
 	nano::join_or_pass (processing_thread);
 }
@@ -59,7 +65,7 @@ void nano::block_processor::flush ()
 	node.checker.flush ();
 	flushing = true;
 	nano::unique_lock<nano::mutex> lock{ mutex };
-	while (!stopped && (have_blocks () || active || state_block_signature_verification.is_active ()))
+	while (!stopped && (have_blocks () || active || state_block_signature_verification.is_active () || work_validation.is_active ()))
 	{
 		condition.wait (lock);
 	}
@@ -69,7 +75,7 @@ void nano::block_processor::flush ()
 std::size_t nano::block_processor::size ()
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
-	return (blocks.size () + state_block_signature_verification.size () + forced.size ());
+	return (blocks.size () + state_block_signature_verification.size () + work_validation.size () + forced.size ());
 }
 
 bool nano::block_processor::full ()
@@ -89,19 +95,29 @@ void nano::block_processor::add (std::shared_ptr<nano::block> const & block)
 		node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::overfill);
 		return;
 	}
-	if (node.network_params.work.validate_entry (*block)) // true => error
+	// Stamped here so the block_processed latency includes the time spent in work validation
+	work_validation.add ({ block, std::chrono::steady_clock::now () });
+}
+
+void nano::block_processor::add (std::vector<std::shared_ptr<nano::block>> const & blocks_a)
+{
+	// Work is checked once by work_validation, blocks whose work value is already cached are not hashed again
+	auto now (std::chrono::steady_clock::now ());
+	for (auto const & block : blocks_a)
 	{
-		node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::insufficient_work);
-		return;
+		if (full ())
+		{
+			node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::overfill);
+			continue;
+		}
+		work_validation.add ({ block, now });
 	}
-	add_impl (block);
-	return;
 }
 
 std::optional<nano::process_return> nano::block_processor::add_blocking (std::shared_ptr<nano::block> const & block)
 {
 	auto future = blocking.insert (block);
-	add_impl (block);
+	add_impl (block, std::chrono::steady_clock::now ());
 	condition.notify_all ();
 	std::optional<nano::process_return> result;
 	try
@@ -127,7 +143,7 @@ void nano::block_processor::force (std::shared_ptr<nano::block> const & block_a)
 {
 	{
 		nano::lock_guard<nano::mutex> lock{ mutex };
-		forced.push_back (block_a);
+		forced.emplace_back (block_a, std::chrono::steady_clock::now ());
 	}
 	condition.notify_all ();
 }
@@ -178,6 +194,23 @@ bool nano::block_processor::have_blocks ()
 	return have_blocks_ready () || state_block_signature_verification.size () != 0;
 }
 
+void nano::block_processor::process_validated_work (std::deque<nano::work_validation::value_type> & items, std::vector<bool> const & insufficient)
+{
+	debug_assert (items.size () == insufficient.size ());
+	for (std::size_t i = 0; i < items.size (); ++i)
+	{
+		if (insufficient[i]) // true => error
+		{
+			node.stats.inc (nano::stat::type::blockprocessor, nano::stat::detail::insufficient_work);
+		}
+		else
+		{
+			auto const & [block, added] = items[i];
+			add_impl (block, added);
+		}
+	}
+}
+
 void nano::block_processor::process_verified_state_blocks (std::deque<nano::state_block_signature_verification::value_type> & items, std::vector<int> const & verifications, std::vector<nano::block_hash> const & hashes, std::vector<nano::signature> const & blocks_signatures)
 {
 	{
@@ -186,24 +219,24 @@ void nano::block_processor::process_verified_state_blocks (std::deque<nano::stat
 		{
 			debug_assert (verifications[i] == 1 || verifications[i] == 0);
 			auto & item = items.front ();
-			auto & [block] = item;
+			auto & [block, added] = item;
 			if (!block->link ().is_zero () && node.ledger.is_epoch_link (block->link ()))
 			{
 				// Epoch blocks
 				if (verifications[i] == 1)
 				{
-					blocks.emplace_back (block);
+					blocks.emplace_back (block, added);
 				}
 				else
 				{
 					// Possible regular state blocks with epoch link (send subtype)
-					blocks.emplace_back (block);
+					blocks.emplace_back (block, added);
 				}
 			}
 			else if (verifications[i] == 1)
 			{
 				// Non epoch blocks
-				blocks.emplace_back (block);
+				blocks.emplace_back (block, added);
 			}
 			items.pop_front ();
 		}
@@ -211,17 +244,17 @@ void nano::block_processor::process_verified_state_blocks (std::deque<nano::stat
 	condition.notify_all ();
 }
 
-void nano::block_processor::add_impl (std::shared_ptr<nano::block> block)
+void nano::block_processor::add_impl (std::shared_ptr<nano::block> block, std::chrono::steady_clock::time_point added)
 {
 	if (block->type () == nano::block_type::state || block->type () == nano::block_type::open)
 	{
-		state_block_signature_verification.add ({ block });
+		state_block_signature_verification.add ({ block, added });
 	}
 	else
 	{
 		{
 			nano::lock_guard<nano::mutex> guard{ mutex };
-			blocks.emplace_back (block);
+			blocks.emplace_back (block, added);
 		}
 		condition.notify_all ();
 	}
@@ -247,17 +280,18 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 			node.logger.always_log (boost::str (boost::format ("%1% blocks (+ %2% state blocks) (+ %3% forced) in processing queue") % blocks.size () % state_block_signature_verification.size () % forced.size ()));
 		}
 		std::shared_ptr<nano::block> block;
+		std::chrono::steady_clock::time_point added;
 		nano::block_hash hash (0);
 		bool force (false);
 		if (forced.empty ())
 		{
-			block = blocks.front ();
+			std::tie (block, added) = blocks.front ();
 			blocks.pop_front ();
 			hash = block->hash ();
 		}
 		else
 		{
-			block = forced.front ();
+			std::tie (block, added) = forced.front ();
 			forced.pop_front ();
 			hash = block->hash ();
 			force = true;
@@ -298,6 +332,7 @@ auto nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 		}
 		number_of_blocks_processed++;
 		auto result = process_one (transaction, block, force);
+		node.stats.sample (nano::stat::latency::block_processed, std::chrono::steady_clock::now () - added);
 		processed.emplace_back (result, block);
 		lock_a.lock ();
 	}
@@ -475,6 +510,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (bl
 
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (collect_container_info (block_processor.state_block_signature_verification, "state_block_signature_verification"));
+	composite->add_component (collect_container_info (block_processor.work_validation, "work_validation"));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", blocks_count, sizeof (decltype (block_processor.blocks)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "forced", forced_count, sizeof (decltype (block_processor.forced)::value_type) }));
 	return composite;
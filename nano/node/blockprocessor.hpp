@@ -3,6 +3,7 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/node/blocking_observer.hpp>
 #include <nano/node/state_block_signature_verification.hpp>
+#include <nano/node/work_validation.hpp>
 #include <nano/secure/common.hpp>
 
 #include <chrono>
@@ -32,6 +33,8 @@ public:
 	bool full ();
 	bool half_full ();
 	void add (std::shared_ptr<nano::block> const &);
+	/** Adds a batch of blocks, stamped with a single arrival time */
+	void add (std::vector<std::shared_ptr<nano::block>> const &);
 	std::optional<nano::process_return> add_blocking (std::shared_ptr<nano::block> const & block);
 	void force (std::shared_ptr<nano::block> const &);
 	bool should_log ();
@@ -58,17 +61,21 @@ private:
 	void queue_unchecked (nano::write_transaction const &, nano::hash_or_account const &);
 	std::deque<processed_t> process_batch (nano::unique_lock<nano::mutex> &);
 	void process_verified_state_blocks (std::deque<nano::state_block_signature_verification::value_type> &, std::vector<int> const &, std::vector<nano::block_hash> const &, std::vector<nano::signature> const &);
-	void add_impl (std::shared_ptr<nano::block> block);
+	void add_impl (std::shared_ptr<nano::block> block, std::chrono::steady_clock::time_point added);
+	void process_validated_work (std::deque<nano::work_validation::value_type> &, std::vector<bool> const &);
 	bool stopped{ false };
 	bool active{ false };
 	std::chrono::steady_clock::time_point next_log;
-	std::deque<std::shared_ptr<nano::block>> blocks;
-	std::deque<std::shared_ptr<nano::block>> forced;
+	/** Queued block and the time it was handed to the block processor */
+	using entry_t = std::pair<std::shared_ptr<nano::block>, std::chrono::steady_clock::time_point>;
+	std::deque<entry_t> blocks;
+	std::deque<entry_t> forced;
 	nano::condition_variable condition;
 	nano::node & node;
 	nano::write_database_queue & write_database_queue;
 	nano::mutex mutex{ mutex_identifier (mutexes::block_processor) };
 	nano::state_block_signature_verification state_block_signature_verification;
+	nano::work_validation work_validation;
 	std::thread processing_thread;
 
 	friend std::unique_ptr<container_info_component> collect_container_info (block_processor & block_processor, std::string const & name);
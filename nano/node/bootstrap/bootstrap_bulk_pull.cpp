@@ -443,29 +443,59 @@ void nano::bulk_pull_server::send_next ()
 	{
 		return;
 	}
-	auto block = get_next ();
-	if (block != nullptr)
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto const batch_size = std::max (1u, node->config.bootstrap_serving_batch_size);
+	auto const max_in_flight = std::max (1u, node->config.bootstrap_serving_max_in_flight);
+	while (!finished && in_flight < max_in_flight)
 	{
 		std::vector<uint8_t> send_buffer;
 		{
+			auto transaction (node->store.tx_begin_read ());
 			nano::vectorstream stream (send_buffer);
-			nano::serialize_block (stream, *block);
+			for (auto i = 0u; i < batch_size && !finished; ++i)
+			{
+				auto block = get_next (transaction);
+				if (block != nullptr)
+				{
+					if (node->config.logging.bulk_pull_logging ())
+					{
+						node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
+					}
+					nano::serialize_block (stream, *block);
+				}
+				else
+				{
+					finished = true;
+				}
+			}
 		}
-		if (node->config.logging.bulk_pull_logging ())
+		if (!send_buffer.empty ())
 		{
-			node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block->hash ().to_string ()));
+			++in_flight;
+			connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l = shared_from_this ()] (boost::system::error_code const & ec, std::size_t size_a) {
+				this_l->sent_action (ec, size_a);
+			});
+		}
+		if (finished)
+		{
+			// Socket writes complete in order, so the terminator follows the chunks still in flight
+			send_finished ();
 		}
-		connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l = shared_from_this ()] (boost::system::error_code const & ec, std::size_t size_a) {
-			this_l->sent_action (ec, size_a);
-		});
 	}
-	else
+}
+
+std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
+{
+	auto node = connection->node.lock ();
+	if (!node)
 	{
-		send_finished ();
+		return nullptr;
 	}
+	auto transaction (node->store.tx_begin_read ());
+	return get_next (transaction);
 }
 
-std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
+std::shared_ptr<nano::block> nano::bulk_pull_server::get_next (nano::transaction const & transaction_a)
 {
 	auto node = connection->node.lock ();
 	if (!node)
@@ -511,7 +541,7 @@ std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
 
 	if (send_current)
 	{
-		result = node->block (current);
+		result = node->store.block.get (transaction_a, current);
 		if (result != nullptr && set_current_to_end == false)
 		{
 			auto next = ascending () ? result->sideband ().successor : result->previous ();
@@ -550,12 +580,20 @@ void nano::bulk_pull_server::sent_action (boost::system::error_code const & ec,
 	}
 	if (!ec)
 	{
+		{
+			nano::lock_guard<nano::mutex> lock{ mutex };
+			--in_flight;
+		}
 		node->bootstrap_workers.push_task ([this_l = shared_from_this ()] () {
 			this_l->send_next ();
 		});
 	}
 	else
 	{
+		{
+			nano::lock_guard<nano::mutex> lock{ mutex };
+			finished = true;
+		}
 		if (node->config.logging.bulk_pull_logging ())
 		{
 			node->logger.try_log (boost::str (boost::format ("Unable to bulk send block: %1%") % ec.message ()));
@@ -697,6 +735,10 @@ void nano::bulk_pull_account_server::send_frontier ()
 		}
 
 		// Send the buffer to the requestor
+		{
+			nano::lock_guard<nano::mutex> lock{ mutex };
+			++in_flight;
+		}
 		auto this_l (shared_from_this ());
 		connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
 			this_l->sent_action (ec, size_a);
@@ -706,78 +748,100 @@ void nano::bulk_pull_account_server::send_frontier ()
 
 void nano::bulk_pull_account_server::send_next_block ()
 {
-	/*
-	 * Get the next item from the queue, it is a tuple with the key (which
-	 * contains the account and hash) and data (which contains the amount)
-	 */
 	auto node = connection->node.lock ();
 	if (!node)
 	{
 		return;
 	}
-	auto block_data (get_next ());
-	auto block_info_key (block_data.first.get ());
-	auto block_info (block_data.second.get ());
-
-	if (block_info_key != nullptr)
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto const batch_size = std::max (1u, node->config.bootstrap_serving_batch_size);
+	auto const max_in_flight = std::max (1u, node->config.bootstrap_serving_max_in_flight);
+	while (!finished && in_flight < max_in_flight)
 	{
-		/*
-		 * If we have a new item, emit it to the socket
-		 */
-
 		std::vector<uint8_t> send_buffer;
-		if (pending_address_only)
 		{
+			auto transaction (node->store.tx_begin_read ());
 			nano::vectorstream output_stream (send_buffer);
-
-			if (node->config.logging.bulk_pull_logging ())
+			for (auto i = 0u; i < batch_size && !finished; ++i)
 			{
-				node->logger.try_log (boost::str (boost::format ("Sending address: %1%") % block_info->source.to_string ()));
-			}
+				/*
+				 * Get the next item from the queue, it is a tuple with the key (which
+				 * contains the account and hash) and data (which contains the amount)
+				 */
+				auto block_data (get_next (transaction));
+				auto block_info_key (block_data.first.get ());
+				auto block_info (block_data.second.get ());
 
-			write (output_stream, block_info->source.bytes);
-		}
-		else
-		{
-			nano::vectorstream output_stream (send_buffer);
+				if (block_info_key == nullptr)
+				{
+					finished = true;
+				}
+				else if (pending_address_only)
+				{
+					if (node->config.logging.bulk_pull_logging ())
+					{
+						node->logger.try_log (boost::str (boost::format ("Sending address: %1%") % block_info->source.to_string ()));
+					}
 
-			if (node->config.logging.bulk_pull_logging ())
-			{
-				node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block_info_key->hash.to_string ()));
-			}
+					write (output_stream, block_info->source.bytes);
+				}
+				else
+				{
+					if (node->config.logging.bulk_pull_logging ())
+					{
+						node->logger.try_log (boost::str (boost::format ("Sending block: %1%") % block_info_key->hash.to_string ()));
+					}
 
-			write (output_stream, block_info_key->hash.bytes);
-			write (output_stream, block_info->amount.bytes);
+					write (output_stream, block_info_key->hash.bytes);
+					write (output_stream, block_info->amount.bytes);
 
-			if (pending_include_address)
-			{
-				/**
-				 ** Write the source address as well, if requested
-				 **/
-				write (output_stream, block_info->source.bytes);
+					if (pending_include_address)
+					{
+						/**
+						 ** Write the source address as well, if requested
+						 **/
+						write (output_stream, block_info->source.bytes);
+					}
+				}
 			}
 		}
 
-		auto this_l (shared_from_this ());
-		connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
-			this_l->sent_action (ec, size_a);
-		});
-	}
-	else
-	{
-		/*
-		 * Otherwise, finalize the connection
-		 */
-		if (node->config.logging.bulk_pull_logging ())
+		if (!send_buffer.empty ())
 		{
-			node->logger.try_log (boost::str (boost::format ("Done sending blocks")));
+			++in_flight;
+			auto this_l (shared_from_this ());
+			connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
+				this_l->sent_action (ec, size_a);
+			});
 		}
 
-		send_finished ();
+		if (finished)
+		{
+			/*
+			 * Finalize the connection, the terminator is written after the chunks still in flight
+			 */
+			if (node->config.logging.bulk_pull_logging ())
+			{
+				node->logger.try_log (boost::str (boost::format ("Done sending blocks")));
+			}
+
+			send_finished ();
+		}
 	}
 }
 
 std::pair<std::unique_ptr<nano::pending_key>, std::unique_ptr<nano::pending_info>> nano::bulk_pull_account_server::get_next ()
+{
+	auto node = connection->node.lock ();
+	if (!node)
+	{
+		return { nullptr, nullptr };
+	}
+	auto transaction (node->store.tx_begin_read ());
+	return get_next (transaction);
+}
+
+std::pair<std::unique_ptr<nano::pending_key>, std::unique_ptr<nano::pending_info>> nano::bulk_pull_account_server::get_next (nano::transaction const & stream_transaction)
 {
 	auto node = connection->node.lock ();
 	if (!node)
@@ -789,11 +853,10 @@ std::pair<std::unique_ptr<nano::pending_key>, std::unique_ptr<nano::pending_info
 	while (true)
 	{
 		/*
-		 * For each iteration of this loop, establish and then
-		 * destroy a database transaction, to avoid locking the
-		 * database for a prolonged period.
+		 * The transaction is held for a single chunk of entries by
+		 * the caller, to avoid locking the database for a prolonged
+		 * period.
 		 */
-		auto stream_transaction (node->store.tx_begin_read ());
 		auto stream (node->store.pending.begin (stream_transaction, current_key));
 
 		if (stream == nano::store_iterator<nano::pending_key, nano::pending_info> (nullptr))
@@ -870,12 +933,20 @@ void nano::bulk_pull_account_server::sent_action (boost::system::error_code cons
 	}
 	if (!ec)
 	{
+		{
+			nano::lock_guard<nano::mutex> lock{ mutex };
+			--in_flight;
+		}
 		node->bootstrap_workers.push_task ([this_l = shared_from_this ()] () {
 			this_l->send_next_block ();
 		});
 	}
 	else
 	{
+		{
+			nano::lock_guard<nano::mutex> lock{ mutex };
+			finished = true;
+		}
 		if (node->config.logging.bulk_pull_logging ())
 		{
 			node->logger.try_log (boost::str (boost::format ("Unable to bulk send block: %1%") % ec.message ()));
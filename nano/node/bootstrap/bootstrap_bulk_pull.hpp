@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/lib/locks.hpp>
 #include <nano/node/messages.hpp>
 #include <nano/node/transport/socket.hpp>
 
@@ -97,6 +98,8 @@ class bulk_pull;
  * Server side of a bulk_pull request. Created when tcp_server receives a bulk_pull message and is exited after the contents
  * have been sent. If the 'start' in the bulk_pull message is an account, send blocks for that account down to 'end'. If the 'start'
  * is a block hash, send blocks for that chain down to 'end'. If end doesn't exist, send all accounts in the chain.
+ * Blocks are sent in chunks of up to `bootstrap_serving_batch_size` blocks, each read under one transaction and sent with one socket write.
+ * Up to `bootstrap_serving_max_in_flight` chunks are written at the same time.
  */
 class bulk_pull_server final : public std::enable_shared_from_this<nano::bulk_pull_server>
 {
@@ -104,6 +107,7 @@ public:
 	bulk_pull_server (std::shared_ptr<nano::transport::tcp_server> const &, std::unique_ptr<nano::bulk_pull>);
 	void set_current_end ();
 	std::shared_ptr<nano::block> get_next ();
+	std::shared_ptr<nano::block> get_next (nano::transaction const &);
 	void send_next ();
 	void sent_action (boost::system::error_code const &, std::size_t);
 	void send_finished ();
@@ -115,14 +119,24 @@ public:
 	bool include_start;
 	nano::bulk_pull::count_t max_count;
 	nano::bulk_pull::count_t sent_count;
+
+private:
+	/** Chunks can be produced on several bootstrap workers at once, guards the cursor and the in flight count */
+	nano::mutex mutex;
+	unsigned in_flight{ 0 };
+	bool finished{ false };
 };
 class bulk_pull_account;
+/**
+ * Serves a bulk_pull_account request, sending receivable entries in chunks the same way as `bulk_pull_server`
+ */
 class bulk_pull_account_server final : public std::enable_shared_from_this<nano::bulk_pull_account_server>
 {
 public:
 	bulk_pull_account_server (std::shared_ptr<nano::transport::tcp_server> const &, std::unique_ptr<nano::bulk_pull_account>);
 	void set_params ();
 	std::pair<std::unique_ptr<nano::pending_key>, std::unique_ptr<nano::pending_info>> get_next ();
+	std::pair<std::unique_ptr<nano::pending_key>, std::unique_ptr<nano::pending_info>> get_next (nano::transaction const &);
 	void send_frontier ();
 	void send_next_block ();
 	void sent_action (boost::system::error_code const &, std::size_t);
@@ -135,5 +149,10 @@ public:
 	bool pending_address_only;
 	bool pending_include_address;
 	bool invalid_request;
+
+private:
+	nano::mutex mutex;
+	unsigned in_flight{ 0 };
+	bool finished{ false };
 };
 }
@@ -26,13 +26,15 @@ public:
 	nano::error deserialize (nano::tomlconfig & toml);
 	nano::error serialize (nano::tomlconfig & toml) const;
 
-	// Maximum number of un-responded requests per channel
+	// Maximum number of un-responded requests per channel, caps the window sized from the round trip time and throughput of each channel
 	std::size_t requests_limit{ 64 };
 	std::size_t database_requests_limit{ 1024 };
 	std::size_t pull_count{ nano::bootstrap_server::max_blocks };
 	nano::millis_t timeout{ 1000 * 3 };
 	std::size_t throttle_coefficient{ 16 };
 	nano::millis_t throttle_wait{ 100 };
+	// Number of threads selecting accounts and sending requests
+	std::size_t threads{ 2 };
 
 	nano::account_sets_config account_sets;
 };
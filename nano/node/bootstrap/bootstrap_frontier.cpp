@@ -281,29 +281,46 @@ void nano::frontier_req_server::send_next ()
 	{
 		return;
 	}
-	if (!current.is_zero () && count < request->count)
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto const batch_size = std::max (1u, node->config.bootstrap_serving_batch_size);
+	auto const max_in_flight = std::max (1u, node->config.bootstrap_serving_max_in_flight);
+	while (!finished && in_flight < max_in_flight)
 	{
 		std::vector<uint8_t> send_buffer;
 		{
 			nano::vectorstream stream (send_buffer);
-			write (stream, current.bytes);
-			write (stream, frontier.bytes);
-			debug_assert (!current.is_zero ());
-			debug_assert (!frontier.is_zero ());
+			for (auto i = 0u; i < batch_size && !finished; ++i)
+			{
+				if (!current.is_zero () && count < request->count)
+				{
+					write (stream, current.bytes);
+					write (stream, frontier.bytes);
+					debug_assert (!frontier.is_zero ());
+					if (node->config.logging.bulk_pull_logging ())
+					{
+						node->logger.try_log (boost::str (boost::format ("Sending frontier for %1% %2%") % current.to_account () % frontier.to_string ()));
+					}
+					++count;
+					next ();
+				}
+				else
+				{
+					finished = true;
+				}
+			}
 		}
-		auto this_l (shared_from_this ());
-		if (node->config.logging.bulk_pull_logging ())
+		if (!send_buffer.empty ())
 		{
-			node->logger.try_log (boost::str (boost::format ("Sending frontier for %1% %2%") % current.to_account () % frontier.to_string ()));
+			++in_flight;
+			auto this_l (shared_from_this ());
+			connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
+				this_l->sent_action (ec, size_a);
+			});
+		}
+		if (finished)
+		{
+			send_finished ();
 		}
-		next ();
-		connection->socket->async_write (nano::shared_const_buffer (std::move (send_buffer)), [this_l] (boost::system::error_code const & ec, std::size_t size_a) {
-			this_l->sent_action (ec, size_a);
-		});
-	}
-	else
-	{
-		send_finished ();
 	}
 }
 
@@ -360,14 +377,20 @@ void nano::frontier_req_server::sent_action (boost::system::error_code const & e
 	}
 	if (!ec)
 	{
-		count++;
-
+		{
+			nano::lock_guard<nano::mutex> lock{ mutex };
+			--in_flight;
+		}
 		node->bootstrap_workers.push_task ([this_l = shared_from_this ()] () {
 			this_l->send_next ();
 		});
 	}
 	else
 	{
+		{
+			nano::lock_guard<nano::mutex> lock{ mutex };
+			finished = true;
+		}
 		if (node->config.logging.network_logging ())
 		{
 			node->logger.try_log (boost::str (boost::format ("Error sending frontier pair: %1%") % ec.message ()));
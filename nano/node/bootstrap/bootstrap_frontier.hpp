@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/lib/locks.hpp>
 #include <nano/node/common.hpp>
 
 #include <deque>
@@ -47,6 +48,7 @@ class frontier_req;
 
 /**
  * Server side of a frontier request. Created when a tcp_server receives a frontier_req message and exited when end-of-list is reached.
+ * Frontiers are sent in chunks the same way as `bulk_pull_server`.
  */
 class frontier_req_server final : public std::enable_shared_from_this<nano::frontier_req_server>
 {
@@ -64,5 +66,10 @@ public:
 	std::unique_ptr<nano::frontier_req> request;
 	std::size_t count;
 	std::deque<std::pair<nano::account, nano::block_hash>> accounts;
+
+private:
+	nano::mutex mutex;
+	unsigned in_flight{ 0 };
+	bool finished{ false };
 };
 }
@@ -162,7 +162,6 @@ bool nano::bootstrap_attempt_lazy::lazy_finished ()
 		return true;
 	}
 	bool result (true);
-	uint64_t read_count (0);
 	auto transaction (node->store.tx_begin_read ());
 	for (auto it (lazy_keys.begin ()), end (lazy_keys.end ()); it != end && !stopped;)
 	{
@@ -177,11 +176,7 @@ bool nano::bootstrap_attempt_lazy::lazy_finished ()
 			// No need to increment `it` as we break above.
 		}
 		// We don't want to open read transactions for too long
-		++read_count;
-		if (read_count % batch_read_size == 0)
-		{
-			transaction.refresh ();
-		}
+		transaction.refresh_if_needed ();
 	}
 	// Finish lazy bootstrap without lazy pulls (in combination with still_pulling ())
 	if (!result && lazy_pulls.empty () && lazy_state_backlog.empty ())
@@ -416,7 +411,6 @@ void nano::bootstrap_attempt_lazy::lazy_backlog_cleanup ()
 	{
 		return;
 	}
-	uint64_t read_count (0);
 	auto transaction (node->store.tx_begin_read ());
 	for (auto it (lazy_state_backlog.begin ()), end (lazy_state_backlog.end ()); it != end && !stopped;)
 	{
@@ -444,11 +438,7 @@ void nano::bootstrap_attempt_lazy::lazy_backlog_cleanup ()
 			++it;
 		}
 		// We don't want to open read transactions for too long
-		++read_count;
-		if (read_count % batch_read_size == 0)
-		{
-			transaction.refresh ();
-		}
+		transaction.refresh_if_needed ();
 	}
 }
 
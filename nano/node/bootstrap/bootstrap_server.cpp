@@ -107,7 +107,7 @@ void nano::bootstrap_server::respond (nano::asc_pull_ack & response, std::shared
 		void operator() (nano::asc_pull_ack::blocks_payload const & pld)
 		{
 			stats.inc (nano::stat::type::bootstrap_server, nano::stat::detail::response_blocks, nano::stat::dir::out);
-			stats.add (nano::stat::type::bootstrap_server, nano::stat::detail::blocks, nano::stat::dir::out, pld.blocks.size ());
+			stats.add (nano::stat::type::bootstrap_server, nano::stat::detail::blocks, nano::stat::dir::out, pld.count ());
 		}
 		void operator() (nano::asc_pull_ack::account_info_payload const & pld)
 		{
@@ -203,16 +203,14 @@ nano::asc_pull_ack nano::bootstrap_server::prepare_response (nano::transaction c
 {
 	debug_assert (count <= max_blocks);
 
-	auto blocks = prepare_blocks (transaction, start_block, count);
-	debug_assert (blocks.size () <= count);
-
 	nano::asc_pull_ack response{ network_constants };
 	response.id = id;
 	response.type = nano::asc_pull_type::blocks;
 
 	nano::asc_pull_ack::blocks_payload response_payload;
-	response_payload.blocks = blocks;
-	response.payload = response_payload;
+	prepare_blocks (transaction, start_block, count, response_payload);
+	debug_assert (response_payload.count () <= count);
+	response.payload = std::move (response_payload);
 
 	response.update_header ();
 	return response;
@@ -231,23 +229,79 @@ nano::asc_pull_ack nano::bootstrap_server::prepare_empty_blocks_response (nano::
 	return response;
 }
 
-std::vector<std::shared_ptr<nano::block>> nano::bootstrap_server::prepare_blocks (nano::transaction const & transaction, nano::block_hash start_block, std::size_t count) const
+void nano::bootstrap_server::prepare_blocks (nano::transaction const & transaction, nano::block_hash start_block, std::size_t count, nano::asc_pull_ack::blocks_payload & payload)
 {
 	debug_assert (count <= max_blocks);
 
-	std::vector<std::shared_ptr<nano::block>> result;
-	if (!start_block.is_zero ())
+	if (start_block.is_zero () || !cache_get (transaction, start_block, count, payload))
 	{
-		std::shared_ptr<nano::block> current = store.block.get (transaction, start_block);
-		while (current && result.size () < count)
+		return;
+	}
+
+	cache_entry entry{ start_block };
+	auto current = start_block;
+	while (!current.is_zero () && entry.blocks.size () < count)
+	{
+		nano::block_hash successor{ 0 };
+		if (store.block.get_serialized (transaction, current, entry.serialized, successor))
 		{
-			result.push_back (current);
+			break;
+		}
+		entry.blocks.emplace_back (current, entry.serialized.size ());
+		current = successor;
+	}
 
-			auto successor = current->sideband ().successor;
-			current = store.block.get (transaction, successor);
+	payload.serialized = entry.serialized;
+	payload.serialized_count = entry.blocks.size ();
+
+	// A shorter segment ended at the account frontier, which moves as new blocks arrive
+	if (entry.blocks.size () == count)
+	{
+		cache_put (std::move (entry));
+	}
+}
+
+bool nano::bootstrap_server::cache_get (nano::transaction const & transaction, nano::block_hash const & start_block, std::size_t count, nano::asc_pull_ack::blocks_payload & payload)
+{
+	nano::lock_guard<nano::mutex> lock{ cache_mutex };
+	auto existing = cache.get<tag_start> ().find (start_block);
+	if (existing == cache.get<tag_start> ().end () || existing->blocks.size () < count)
+	{
+		stats.inc (nano::stat::type::bootstrap_server, nano::stat::detail::miss);
+		return true;
+	}
+	// Blocks of a chain are only removed from its end, so the segment is intact as long as its last block is still present
+	auto const & [last, end] = existing->blocks[count - 1];
+	if (!store.block.exists (transaction, last))
+	{
+		cache.get<tag_start> ().erase (existing);
+		stats.inc (nano::stat::type::bootstrap_server, nano::stat::detail::miss);
+		return true;
+	}
+	payload.serialized.assign (existing->serialized.begin (), existing->serialized.begin () + end);
+	payload.serialized_count = count;
+	cache.relocate (cache.begin (), cache.project<tag_sequenced> (existing));
+	stats.inc (nano::stat::type::bootstrap_server, nano::stat::detail::hit);
+	return false;
+}
+
+void nano::bootstrap_server::cache_put (cache_entry && entry)
+{
+	nano::lock_guard<nano::mutex> lock{ cache_mutex };
+	auto existing = cache.get<tag_start> ().find (entry.start);
+	if (existing != cache.get<tag_start> ().end ())
+	{
+		cache.get<tag_start> ().replace (existing, std::move (entry));
+		cache.relocate (cache.begin (), cache.project<tag_sequenced> (existing));
+	}
+	else
+	{
+		cache.push_front (std::move (entry));
+		if (cache.size () > max_cache)
+		{
+			cache.pop_back ();
 		}
 	}
-	return result;
 }
 
 /*
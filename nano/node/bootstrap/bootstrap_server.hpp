@@ -1,12 +1,20 @@
 #pragma once
 
+#include <nano/lib/locks.hpp>
 #include <nano/lib/observer_set.hpp>
 #include <nano/lib/processing_queue.hpp>
 #include <nano/node/messages.hpp>
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
 #include <memory>
 #include <utility>
 
+namespace mi = boost::multi_index;
+
 namespace nano
 {
 class ledger;
@@ -21,6 +29,9 @@ namespace transport
  * In order to ensure maximum throughput, there are two internal processing queues:
  * - One for doing ledger lookups and preparing responses (`request_queue`)
  * - One for sending back those responses over the network (`response_queue`)
+ *
+ * Blocks are copied from the store into responses as serialized bytes, without deserializing them.
+ * Recently served chain segments are kept in a small LRU cache, as many clients bootstrapping at the same time tend to pull the same accounts.
  */
 class bootstrap_server final
 {
@@ -57,7 +68,7 @@ private:
 	nano::asc_pull_ack process (nano::transaction const &, nano::asc_pull_req::id_t id, nano::asc_pull_req::blocks_payload const & request);
 	nano::asc_pull_ack prepare_response (nano::transaction const &, nano::asc_pull_req::id_t id, nano::block_hash start_block, std::size_t count);
 	nano::asc_pull_ack prepare_empty_blocks_response (nano::asc_pull_req::id_t id);
-	std::vector<std::shared_ptr<nano::block>> prepare_blocks (nano::transaction const &, nano::block_hash start_block, std::size_t count) const;
+	void prepare_blocks (nano::transaction const &, nano::block_hash start_block, std::size_t count, nano::asc_pull_ack::blocks_payload &);
 
 	/*
 	 * Account info response
@@ -70,6 +81,23 @@ private:
 	bool verify (nano::asc_pull_req const & message) const;
 	bool verify_request_type (nano::asc_pull_type) const;
 
+	/*
+	 * Cache of recently served chain segments
+	 */
+	class cache_entry final
+	{
+	public:
+		nano::block_hash start;
+		/** Blocks serialized back to back */
+		std::vector<uint8_t> serialized;
+		/** Hash of each block and the offset in `serialized` where it ends */
+		std::vector<std::pair<nano::block_hash, std::size_t>> blocks;
+	};
+
+	/** Fills the payload from the cache, returns true if the segment was not cached */
+	bool cache_get (nano::transaction const &, nano::block_hash const & start_block, std::size_t count, nano::asc_pull_ack::blocks_payload &);
+	void cache_put (cache_entry &&);
+
 private: // Dependencies
 	nano::store & store;
 	nano::ledger & ledger;
@@ -79,8 +107,25 @@ private: // Dependencies
 private:
 	processing_queue<request_t> request_queue;
 
+	// clang-format off
+	class tag_sequenced {};
+	class tag_start {};
+
+	using ordered_cache = boost::multi_index_container<cache_entry,
+	mi::indexed_by<
+		mi::sequenced<mi::tag<tag_sequenced>>,
+		mi::hashed_unique<mi::tag<tag_start>,
+			mi::member<cache_entry, nano::block_hash, &cache_entry::start>>
+	>>;
+	// clang-format on
+
+	ordered_cache cache;
+	nano::mutex cache_mutex;
+
 public: // Config
 	/** Maximum number of blocks to send in a single response, cannot be higher than capacity of a single `asc_pull_ack` message */
 	constexpr static std::size_t max_blocks = nano::asc_pull_ack::blocks_payload::max_blocks;
+	/** Maximum number of chain segments kept in the cache, each at most the size of a single `asc_pull_ack` message */
+	constexpr static std::size_t max_cache = 256;
 };
 }
\ No newline at end of file
@@ -1,14 +1,20 @@
+#include <nano/lib/stats.hpp>
+#include <nano/lib/utility.hpp>
 #include <nano/node/bootstrap/bootstrap_config.hpp>
 #include <nano/node/bootstrap_ascending/peer_scoring.hpp>
 #include <nano/node/transport/channel.hpp>
 
+#include <algorithm>
+#include <limits>
+
 /*
  * peer_scoring
  */
 
-nano::bootstrap_ascending::peer_scoring::peer_scoring (nano::bootstrap_ascending_config & config, nano::network_constants const & network_constants) :
+nano::bootstrap_ascending::peer_scoring::peer_scoring (nano::bootstrap_ascending_config & config, nano::network_constants const & network_constants, nano::stats & stats) :
 	network_constants{ network_constants },
-	config{ config }
+	config{ config },
+	stats{ stats }
 {
 }
 
@@ -22,7 +28,7 @@ bool nano::bootstrap_ascending::peer_scoring::try_send_message (std::shared_ptr<
 	}
 	else
 	{
-		if (existing->outstanding < config.requests_limit)
+		if (existing->outstanding < existing->window)
 		{
 			[[maybe_unused]] auto success = index.modify (existing, [] (auto & score) {
 				++score.outstanding;
@@ -38,21 +44,36 @@ bool nano::bootstrap_ascending::peer_scoring::try_send_message (std::shared_ptr<
 	return false;
 }
 
-void nano::bootstrap_ascending::peer_scoring::received_message (std::shared_ptr<nano::transport::channel> channel)
+void nano::bootstrap_ascending::peer_scoring::received_message (std::shared_ptr<nano::transport::channel> channel, nano::millis_t rtt)
 {
 	auto & index = scoring.get<tag_channel> ();
 	auto existing = index.find (channel.get ());
 	if (existing != index.end ())
 	{
-		if (existing->outstanding > 1)
-		{
-			[[maybe_unused]] auto success = index.modify (existing, [] (auto & score) {
-				--score.outstanding;
-				++score.response_count_total;
-			});
-			debug_assert (success);
-		}
+		[[maybe_unused]] auto success = index.modify (existing, [rtt] (auto & score) {
+			score.outstanding = score.outstanding > 0 ? score.outstanding - 1 : 0;
+			++score.response_count_total;
+			score.rtt = score.rtt == 0 ? rtt : (score.rtt * 7 + rtt) / 8;
+		});
+		debug_assert (success);
+	}
+}
+
+void nano::bootstrap_ascending::peer_scoring::timed_out (std::shared_ptr<nano::transport::channel> channel)
+{
+	auto & index = scoring.get<tag_channel> ();
+	auto existing = index.find (channel.get ());
+	if (existing != index.end ())
+	{
+		auto const window = std::max<uint64_t> (1, existing->window / 2);
+		count_window_change (existing->window, window);
+		[[maybe_unused]] auto success = index.modify (existing, [window] (auto & score) {
+			score.outstanding = score.outstanding > 0 ? score.outstanding - 1 : 0;
+			score.window = window;
+		});
+		debug_assert (success);
 	}
+	stats.inc (nano::stat::type::bootstrap_ascending_peers, nano::stat::detail::timeout);
 }
 
 std::shared_ptr<nano::transport::channel> nano::bootstrap_ascending::peer_scoring::channel ()
@@ -94,14 +115,55 @@ void nano::bootstrap_ascending::peer_scoring::timeout ()
 		}
 		score = index.erase (score);
 	}
+	auto now = std::chrono::steady_clock::now ();
 	for (auto score = scoring.begin (), n = scoring.end (); score != n; ++score)
 	{
-		scoring.modify (score, [] (auto & score_a) {
-			score_a.decay ();
+		scoring.modify (score, [this, now] (auto & score_a) {
+			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (now - score_a.window_updated).count ();
+			if (elapsed > 0)
+			{
+				auto rate = (score_a.response_count_total - score_a.response_count_last) * 1000.0 / elapsed;
+				score_a.throughput = (score_a.throughput * 3 + rate) / 4;
+				score_a.response_count_last = score_a.response_count_total;
+				score_a.window_updated = now;
+				auto const window = compute_window (score_a);
+				count_window_change (score_a.window, window);
+				score_a.window = window;
+			}
 		});
+		// Responses per second
+		auto const throughput = score->throughput;
+		auto const detail = throughput < 1 ? nano::stat::detail::throughput_idle : throughput < 10 ? nano::stat::detail::throughput_low : throughput < 100 ? nano::stat::detail::throughput_medium : nano::stat::detail::throughput_high;
+		stats.inc (nano::stat::type::bootstrap_ascending_peers, detail);
 	}
 }
 
+void nano::bootstrap_ascending::peer_scoring::count_window_change (uint64_t old_window, uint64_t new_window)
+{
+	if (new_window > old_window)
+	{
+		stats.inc (nano::stat::type::bootstrap_ascending_peers, nano::stat::detail::window_grow);
+	}
+	else if (new_window < old_window)
+	{
+		stats.inc (nano::stat::type::bootstrap_ascending_peers, nano::stat::detail::window_shrink);
+	}
+}
+
+uint64_t nano::bootstrap_ascending::peer_scoring::compute_window (peer_score const & score) const
+{
+	uint64_t const limit = config.requests_limit == 0 ? std::numeric_limits<uint64_t>::max () : config.requests_limit;
+	if (score.rtt == 0 || score.throughput == 0)
+	{
+		// Nothing measured yet
+		return std::min (score.window, limit);
+	}
+	// Requests needed to keep the peer busy for a whole round trip, with headroom so the window can grow while the peer keeps up
+	auto const needed = static_cast<uint64_t> (score.throughput * score.rtt / 1000.0);
+	auto const headroom = std::max<uint64_t> (2, needed / 4);
+	return std::clamp<uint64_t> (needed + headroom, 1, limit);
+}
+
 void nano::bootstrap_ascending::peer_scoring::sync (std::deque<std::shared_ptr<nano::transport::channel>> const & list)
 {
 	auto & index = scoring.get<tag_channel> ();
@@ -120,6 +182,25 @@ void nano::bootstrap_ascending::peer_scoring::sync (std::deque<std::shared_ptr<n
 	}
 }
 
+std::unique_ptr<nano::container_info_component> nano::bootstrap_ascending::peer_scoring::collect_container_info (std::string const & name)
+{
+	uint64_t outstanding = 0;
+	uint64_t window = 0;
+	double throughput = 0;
+	for (auto const & score : scoring)
+	{
+		outstanding += score.outstanding;
+		window += score.window;
+		throughput += score.throughput;
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "peers", scoring.size (), sizeof (decltype (scoring)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "outstanding", outstanding, 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "window", window, 0 }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "responses_per_second", static_cast<std::size_t> (throughput), 0 }));
+	return composite;
+}
+
 /*
  * peer_score
  */
@@ -130,6 +211,7 @@ std::shared_ptr<nano::transport::channel> const & channel_a, uint64_t outstandin
 	channel_ptr{ channel_a.get () },
 	outstanding{ outstanding_a },
 	request_count_total{ request_count_total_a },
-	response_count_total{ response_count_total_a }
+	response_count_total{ response_count_total_a },
+	window{ window_initial }
 {
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/lib/timer.hpp>
 #include <nano/node/common.hpp>
 
 #include <boost/multi_index/hashed_index.hpp>
@@ -7,15 +8,19 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <chrono>
 #include <deque>
 #include <memory>
+#include <string>
 
 namespace mi = boost::multi_index;
 
 namespace nano
 {
 class bootstrap_ascending_config;
+class container_info_component;
 class network_constants;
+class stats;
 namespace transport
 {
 	class channel;
@@ -23,19 +28,27 @@ namespace transport
 namespace bootstrap_ascending
 {
 	// Container for tracking and scoring peers with respect to bootstrapping
+	// Each peer gets a window of outstanding requests sized from its measured round trip time and response throughput
 	class peer_scoring
 	{
 	public:
-		peer_scoring (nano::bootstrap_ascending_config & config, nano::network_constants const & network_constants);
+		peer_scoring (nano::bootstrap_ascending_config & config, nano::network_constants const & network_constants, nano::stats & stats);
 		// Returns true if channel limit has been exceeded
 		bool try_send_message (std::shared_ptr<nano::transport::channel> channel);
-		void received_message (std::shared_ptr<nano::transport::channel> channel);
+		void received_message (std::shared_ptr<nano::transport::channel> channel, nano::millis_t rtt);
+		// Releases the slot of a request that timed out and shrinks the window of the peer
+		void timed_out (std::shared_ptr<nano::transport::channel> channel);
 		std::shared_ptr<nano::transport::channel> channel ();
 		[[nodiscard]] std::size_t size () const;
 		// Cleans up scores for closed channels
-		// Decays scores which become inaccurate over time due to message drops
+		// Resizes windows from the responses received since the previous call
+		// Each peer's throughput is counted in one of the bootstrap_ascending_peers throughput stats per call
 		void timeout ();
 		void sync (std::deque<std::shared_ptr<nano::transport::channel>> const & list);
+		std::unique_ptr<nano::container_info_component> collect_container_info (std::string const & name);
+
+		// Window of a peer before its round trip time and throughput are known
+		static uint64_t constexpr window_initial{ 8 };
 
 	private:
 		class peer_score
@@ -56,17 +69,25 @@ namespace bootstrap_ascending
 				}
 				return result;
 			}
-			void decay ()
-			{
-				outstanding = outstanding > 0 ? outstanding - 1 : 0;
-			}
 			// Number of outstanding requests to a peer
 			uint64_t outstanding{ 0 };
 			uint64_t request_count_total{ 0 };
 			uint64_t response_count_total{ 0 };
+			// Number of outstanding requests allowed for a peer
+			uint64_t window{ 0 };
+			// Moving average of the round trip time of requests
+			nano::millis_t rtt{ 0 };
+			// Moving average of responses per second
+			double throughput{ 0 };
+			// Response count and time at the previous window update
+			uint64_t response_count_last{ 0 };
+			std::chrono::steady_clock::time_point window_updated{ std::chrono::steady_clock::now () };
 		};
+		uint64_t compute_window (peer_score const &) const;
+		void count_window_change (uint64_t old_window, uint64_t new_window);
 		nano::network_constants const & network_constants;
 		nano::bootstrap_ascending_config & config;
+		nano::stats & stats;
 
 		// clang-format off
 		// Indexes scores by their shared channel pointer
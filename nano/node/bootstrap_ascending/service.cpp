@@ -1,3 +1,4 @@
+#include <nano/lib/logger_mt.hpp>
 #include <nano/lib/stats_enums.hpp>
 #include <nano/node/blockprocessor.hpp>
 #include <nano/node/bootstrap_ascending/service.hpp>
@@ -8,23 +9,28 @@
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/store.hpp>
 
+#include <boost/format.hpp>
+
+#include <algorithm>
+
 using namespace std::chrono_literals;
 
 /*
  * bootstrap_ascending
  */
 
-nano::bootstrap_ascending::service::service (nano::node_config & config_a, nano::block_processor & block_processor_a, nano::ledger & ledger_a, nano::network & network_a, nano::stats & stat_a) :
+nano::bootstrap_ascending::service::service (nano::node_config & config_a, nano::block_processor & block_processor_a, nano::ledger & ledger_a, nano::network & network_a, nano::stats & stat_a, nano::logger_mt & logger_a) :
 	config{ config_a },
 	network_consts{ config.network_params.network },
 	block_processor{ block_processor_a },
 	ledger{ ledger_a },
 	network{ network_a },
 	stats{ stat_a },
+	logger{ logger_a },
 	accounts{ stats },
 	iterator{ ledger.store },
 	throttle{ compute_throttle_size () },
-	scoring{ config.bootstrap_ascending, config.network_params.network },
+	scoring{ config.bootstrap_ascending, config.network_params.network, stats },
 	database_limiter{ config.bootstrap_ascending.database_requests_limit, 1.0 }
 {
 	// TODO: This is called from a very congested blockprocessor thread. Offload this work to a dedicated processing thread
@@ -48,19 +54,23 @@ nano::bootstrap_ascending::service::service (nano::node_config & config_a, nano:
 nano::bootstrap_ascending::service::~service ()
 {
 	// All threads must be stopped before destruction
-	debug_assert (!thread.joinable ());
+	debug_assert (threads.empty ());
 	debug_assert (!timeout_thread.joinable ());
 }
 
 void nano::bootstrap_ascending::service::start ()
 {
-	debug_assert (!thread.joinable ());
+	debug_assert (threads.empty ());
 	debug_assert (!timeout_thread.joinable ());
 
-	thread = std::thread ([this] () {
-		nano::thread_role::set (nano::thread_role::name::ascending_bootstrap);
-		run ();
-	});
+	// Several threads select accounts and send requests, so requests to different peers are not serialized behind ledger lookups
+	for (auto i = 0u; i < std::max<std::size_t> (1, config.bootstrap_ascending.threads); ++i)
+	{
+		threads.emplace_back ([this] () {
+			nano::thread_role::set (nano::thread_role::name::ascending_bootstrap);
+			run ();
+		});
+	}
 
 	timeout_thread = std::thread ([this] () {
 		nano::thread_role::set (nano::thread_role::name::ascending_bootstrap);
@@ -74,7 +84,11 @@ void nano::bootstrap_ascending::service::stop ()
 	stopped = true;
 	lock.unlock ();
 	condition.notify_all ();
-	nano::join_or_pass (thread);
+	for (auto & thread : threads)
+	{
+		nano::join_or_pass (thread);
+	}
+	threads.clear ();
 	nano::join_or_pass (timeout_thread);
 }
 
@@ -195,7 +209,8 @@ void nano::bootstrap_ascending::service::wait_blockprocessor ()
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	while (!stopped && block_processor.half_full ())
 	{
-		condition.wait_for (lock, 500ms, [this] () { return stopped; }); // Blockprocessor is relatively slow, sleeping here instead of using conditions
+		// Processed batches notify the condition, so requesting resumes as soon as the blockprocessor drains below half
+		condition.wait_for (lock, 500ms, [this] () { return stopped || !block_processor.half_full (); });
 	}
 }
 
@@ -210,8 +225,9 @@ std::shared_ptr<nano::transport::channel> nano::bootstrap_ascending::service::wa
 	return channel;
 }
 
-nano::account nano::bootstrap_ascending::service::available_account ()
+nano::account nano::bootstrap_ascending::service::available_account (nano::unique_lock<nano::mutex> & lock)
 {
+	debug_assert (lock.owns_lock ());
 	{
 		auto account = accounts.next ();
 		if (!account.is_zero ())
@@ -223,7 +239,14 @@ nano::account nano::bootstrap_ascending::service::available_account ()
 
 	if (database_limiter.should_pass (1))
 	{
-		auto account = iterator.next ();
+		// Refilling the iterator buffer reads from the ledger, do that without holding the main mutex
+		lock.unlock ();
+		nano::account account{ 0 };
+		{
+			nano::lock_guard<nano::mutex> database_lock{ database_mutex };
+			account = iterator.next ();
+		}
+		lock.lock ();
 		if (!account.is_zero ())
 		{
 			stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::next_database);
@@ -240,7 +263,7 @@ nano::account nano::bootstrap_ascending::service::wait_available_account ()
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	while (!stopped)
 	{
-		auto account = available_account ();
+		auto account = available_account (lock);
 		if (!account.is_zero ())
 		{
 			accounts.timestamp (account);
@@ -260,6 +283,7 @@ bool nano::bootstrap_ascending::service::request (nano::account & account, std::
 	tag.id = nano::bootstrap_ascending::generate_id ();
 	tag.account = account;
 	tag.time = nano::milliseconds_since_epoch ();
+	tag.channel = channel;
 
 	// Check if the account picked has blocks, if it does, start the pull from the highest block
 	auto info = ledger.store.account.get (ledger.store.tx_begin_read (), account);
@@ -308,7 +332,12 @@ bool nano::bootstrap_ascending::service::run_one ()
 void nano::bootstrap_ascending::service::throttle_if_needed (nano::unique_lock<nano::mutex> & lock)
 {
 	debug_assert (lock.owns_lock ());
-	if (!iterator.warmup () && throttle.throttled ())
+	bool warmup = false;
+	{
+		nano::lock_guard<nano::mutex> database_lock{ database_mutex };
+		warmup = iterator.warmup ();
+	}
+	if (!warmup && throttle.throttled ())
 	{
 		stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::throttled);
 		condition.wait_for (lock, std::chrono::milliseconds{ config.bootstrap_ascending.throttle_wait }, [this] () { return stopped; });
@@ -341,6 +370,10 @@ void nano::bootstrap_ascending::service::run_timeouts ()
 		{
 			auto tag = tags_by_order.front ();
 			tags_by_order.pop_front ();
+			if (auto channel = tag.channel.lock ())
+			{
+				scoring.timed_out (channel);
+			}
 			on_timeout.notify (tag);
 			stats.inc (nano::stat::type::bootstrap_ascending, nano::stat::detail::timeout);
 		}
@@ -359,7 +392,7 @@ void nano::bootstrap_ascending::service::process (nano::asc_pull_ack const & mes
 		auto iterator = tags_by_id.find (message.id);
 		auto tag = *iterator;
 		tags_by_id.erase (iterator);
-		scoring.received_message (channel);
+		scoring.received_message (channel, nano::time_difference (tag.time, nano::milliseconds_since_epoch ()));
 
 		lock.unlock ();
 
@@ -384,10 +417,7 @@ void nano::bootstrap_ascending::service::process (const nano::asc_pull_ack::bloc
 		{
 			stats.add (nano::stat::type::bootstrap_ascending, nano::stat::detail::blocks, nano::stat::dir::in, response.blocks.size ());
 
-			for (auto & block : response.blocks)
-			{
-				block_processor.add (block);
-			}
+			block_processor.add (response.blocks);
 			nano::lock_guard<nano::mutex> lock{ mutex };
 			throttle.add (true);
 		}
@@ -473,6 +503,20 @@ nano::bootstrap_ascending::service::verify_result nano::bootstrap_ascending::ser
 		previous_hash = block->hash ();
 	}
 
+	// Verify work for the whole response at once, a single block with insufficient work discards the reply
+	// Work values are cached on the blocks, so the block processor does not hash them again
+	auto insufficient = network_consts.work.validate_entry (blocks);
+	auto error = std::find (insufficient.begin (), insufficient.end (), true);
+	if (error != insufficient.end ())
+	{
+		stats.inc (nano::stat::type::bootstrap_ascending_verify, nano::stat::detail::insufficient_work);
+		if (config.logging.insufficient_work_logging ())
+		{
+			logger.try_log (boost::str (boost::format ("Discarding ascending bootstrap reply, block %1% has insufficient work") % blocks[std::distance (insufficient.begin (), error)]->hash ().to_string ()));
+		}
+		return verify_result::invalid;
+	}
+
 	return verify_result::ok;
 }
 
@@ -506,5 +550,6 @@ std::unique_ptr<nano::container_info_component> nano::bootstrap_ascending::servi
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "tags", tags.size (), sizeof (decltype (tags)::value_type) }));
 	composite->add_component (accounts.collect_container_info ("accounts"));
+	composite->add_component (scoring.collect_container_info ("scoring"));
 	return composite;
 }
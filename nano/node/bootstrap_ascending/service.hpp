@@ -18,6 +18,7 @@
 #include <boost/multi_index_container.hpp>
 
 #include <thread>
+#include <vector>
 
 namespace mi = boost::multi_index;
 
@@ -25,6 +26,7 @@ namespace nano
 {
 class block_processor;
 class ledger;
+class logger_mt;
 class network;
 class node_config;
 class transaction;
@@ -39,7 +41,7 @@ namespace bootstrap_ascending
 	class service
 	{
 	public:
-		service (nano::node_config &, nano::block_processor &, nano::ledger &, nano::network &, nano::stats &);
+		service (nano::node_config &, nano::block_processor &, nano::ledger &, nano::network &, nano::stats &, nano::logger_mt &);
 		~service ();
 
 		void start ();
@@ -63,6 +65,7 @@ namespace bootstrap_ascending
 		nano::ledger & ledger;
 		nano::network & network;
 		nano::stats & stats;
+		nano::logger_mt & logger;
 
 	public: // async_tag
 		struct async_tag
@@ -80,6 +83,7 @@ namespace bootstrap_ascending
 			nano::hash_or_account start{ 0 };
 			nano::millis_t time{ 0 };
 			nano::account account{ 0 };
+			std::weak_ptr<nano::transport::channel> channel;
 		};
 
 	public: // Events
@@ -101,7 +105,7 @@ namespace bootstrap_ascending
 		/* Waits for channel with free capacity for bootstrap messages */
 		std::shared_ptr<nano::transport::channel> wait_available_channel ();
 		/* Waits until a suitable account outside of cool down period is available */
-		nano::account available_account ();
+		nano::account available_account (nano::unique_lock<nano::mutex> &);
 		nano::account wait_available_account ();
 
 		bool request (nano::account &, std::shared_ptr<nano::transport::channel> &);
@@ -161,7 +165,9 @@ namespace bootstrap_ascending
 		bool stopped{ false };
 		mutable nano::mutex mutex;
 		mutable nano::condition_variable condition;
-		std::thread thread;
+		/** Guards the database iterator, so reading accounts from the ledger does not hold up the other request threads and reply processing */
+		mutable nano::mutex database_mutex;
+		std::vector<std::thread> threads;
 		std::thread timeout_thread;
 	};
 }
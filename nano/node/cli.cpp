@@ -1,10 +1,12 @@
 #include <nano/lib/cli.hpp>
+#include <nano/lib/timer.hpp>
 #include <nano/lib/tlsconfig.hpp>
 #include <nano/lib/tomlconfig.hpp>
 #include <nano/node/cli.hpp>
 #include <nano/node/common.hpp>
 #include <nano/node/daemonconfig.hpp>
 #include <nano/node/node.hpp>
+#include <nano/secure/ledger_snapshot.hpp>
 
 #include <boost/format.hpp>
 
@@ -57,6 +59,8 @@ void nano::add_node_options (boost::program_options::options_description & descr
 	("final_vote_clear", "Clear final votes")
 	("rebuild_database", "Rebuild LMDB database with vacuum for best compaction")
 	("migrate_database_lmdb_to_rocksdb", "Migrates LMDB database to RocksDB")
+	("snapshot_export", boost::program_options::value<std::string> (), "Write a consistent per-table snapshot of the ledger to <directory>. Can be run while the node is running")
+	("snapshot_import", boost::program_options::value<std::string> (), "Bulk load a ledger snapshot from <directory> into a freshly initialized database")
 	("diagnostics", "Run internal diagnostics")
 	("generate_config", boost::program_options::value<std::string> (), "Write configuration to stdout, populated with defaults suitable for this system. Pass the configuration type node, rpc or tls. See also use_defaults.")
 	("key_create", "Generates a adhoc random keypair and prints it to stdout")
@@ -100,6 +104,7 @@ void nano::add_node_flag_options (boost::program_options::options_description &
 		("disable_bootstrap_listener", "Disables bootstrap processing for TCP listener (not including realtime network TCP connections)")
 		("disable_unchecked_cleanup", "Disables periodic cleanup of old records from unchecked table")
 		("disable_unchecked_drop", "Disables drop of unchecked table at startup")
+		("disable_unchecked_spill", "Drops the oldest unchecked blocks once the in-memory limit is reached instead of spilling them to disk")
 		("disable_providing_telemetry_metrics", "Disable using any node information in the telemetry_ack messages.")
 		("disable_block_processor_unchecked_deletion", "Disable deletion of unchecked blocks after processing")
 		("enable_pruning", "Enable experimental ledger pruning")
@@ -133,6 +138,7 @@ std::error_code nano::update_flags (nano::node_flags & flags_a, boost::program_o
 	flags_a.disable_providing_telemetry_metrics = (vm.count ("disable_providing_telemetry_metrics") > 0);
 	flags_a.disable_unchecked_cleanup = (vm.count ("disable_unchecked_cleanup") > 0);
 	flags_a.disable_unchecked_drop = (vm.count ("disable_unchecked_drop") > 0);
+	flags_a.disable_unchecked_spill = (vm.count ("disable_unchecked_spill") > 0);
 	flags_a.disable_block_processor_unchecked_deletion = (vm.count ("disable_block_processor_unchecked_deletion") > 0);
 	flags_a.enable_pruning = (vm.count ("enable_pruning") > 0);
 	flags_a.allow_bootstrap_peers_duplicates = (vm.count ("allow_bootstrap_peers_duplicates") > 0);
@@ -467,7 +473,11 @@ std::error_code nano::handle_node_options (boost::program_options::variables_map
 		if (!node.node->init_error ())
 		{
 			std::cout << "Migrating LMDB database to RocksDB, might take a while..." << std::endl;
-			error = node.node->ledger.migrate_lmdb_to_rocksdb (data_path);
+			nano::timer<std::chrono::milliseconds> timer (nano::timer_state::started);
+			error = node.node->ledger.migrate_lmdb_to_rocksdb (data_path, [&timer] (std::string const & table_a, uint64_t count_a) {
+				auto elapsed = std::max<uint64_t> (timer.restart ().count (), 1);
+				std::cout << boost::str (boost::format ("Migrated %1% %2% records in %3% ms (%4% records/s)") % count_a % table_a % elapsed % (count_a * 1000 / elapsed)) << std::endl;
+			});
 		}
 		else
 		{
@@ -483,6 +493,65 @@ std::error_code nano::handle_node_options (boost::program_options::variables_map
 			std::cerr << "There was an error migrating" << std::endl;
 		}
 	}
+	else if (vm.count ("snapshot_export"))
+	{
+		boost::filesystem::path snapshot_path (vm["snapshot_export"].as<std::string> ());
+		auto node_flags = nano::inactive_node_flag_defaults ();
+		node_flags.read_only = true;
+		nano::update_flags (node_flags, vm);
+		nano::inactive_node node (data_path, node_flags);
+		auto error (node.node->init_error ());
+		if (!error)
+		{
+			std::cout << "Exporting ledger snapshot to " << snapshot_path << ", might take a while..." << std::endl;
+			nano::ledger_snapshot snapshot{ node.node->store };
+			snapshot.progress = [] (std::string const & table_a, uint64_t count_a) {
+				std::cout << boost::str (boost::format ("Exported %1% %2% records") % count_a % table_a) << std::endl;
+			};
+			nano::timer<std::chrono::seconds> timer (nano::timer_state::started);
+			error = snapshot.export_to (snapshot_path);
+			if (!error)
+			{
+				std::cout << boost::str (boost::format ("Snapshot export completed in %1% seconds") % timer.stop ().count ()) << std::endl;
+			}
+		}
+		if (error)
+		{
+			std::cerr << "There was an error exporting the ledger snapshot" << std::endl;
+			ec = nano::error_cli::generic;
+		}
+	}
+	else if (vm.count ("snapshot_import"))
+	{
+		boost::filesystem::path snapshot_path (vm["snapshot_import"].as<std::string> ());
+		auto node_flags = nano::inactive_node_flag_defaults ();
+		node_flags.read_only = false;
+		nano::update_flags (node_flags, vm);
+		nano::inactive_node node (data_path, node_flags);
+		if (!node.node->init_error ())
+		{
+			std::cout << "Importing ledger snapshot from " << snapshot_path << ", might take a while..." << std::endl;
+			nano::ledger_snapshot snapshot{ node.node->store };
+			snapshot.parallel_import = node.node->config.rocksdb_config.enable;
+			snapshot.progress = [] (std::string const & table_a, uint64_t count_a) {
+				std::cout << boost::str (boost::format ("Imported %1% %2% records") % count_a % table_a) << std::endl;
+			};
+			nano::timer<std::chrono::seconds> timer (nano::timer_state::started);
+			if (!snapshot.import_from (snapshot_path))
+			{
+				std::cout << boost::str (boost::format ("Snapshot import completed in %1% seconds") % timer.stop ().count ()) << std::endl;
+			}
+			else
+			{
+				std::cerr << "There was an error importing the ledger snapshot, the database must only contain the genesis block and match the snapshot version" << std::endl;
+				ec = nano::error_cli::generic;
+			}
+		}
+		else
+		{
+			database_write_lock_error (ec);
+		}
+	}
 	else if (vm.count ("unchecked_clear"))
 	{
 		boost::filesystem::path data_path = vm.count ("data_path") ? boost::filesystem::path (vm["data_path"].as<std::string> ()) : nano::working_path ();
@@ -1,5 +1,6 @@
 #include <nano/lib/logger_mt.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/stats.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/confirmation_height_processor.hpp>
@@ -168,8 +169,9 @@ void nano::confirmation_height_processor::set_next_hash ()
 {
 	nano::lock_guard<nano::mutex> guard (mutex);
 	debug_assert (!awaiting_processing.empty ());
-	original_block = awaiting_processing.get<tag_sequence> ().front ().block;
-	original_hashes_pending.insert (original_block->hash ());
+	auto const & front (awaiting_processing.get<tag_sequence> ().front ());
+	original_block = front.block;
+	original_hashes_pending.emplace (original_block->hash (), front.added);
 	awaiting_processing.get<tag_sequence> ().pop_front ();
 }
 
@@ -187,6 +189,19 @@ void nano::confirmation_height_processor::add_block_already_cemented_observer (s
 
 void nano::confirmation_height_processor::notify_cemented (std::vector<std::shared_ptr<nano::block>> const & cemented_blocks)
 {
+	// Latency is tracked for the blocks which were added, not for the dependents cemented along with them
+	{
+		auto now (std::chrono::steady_clock::now ());
+		nano::lock_guard<nano::mutex> guard (mutex);
+		for (auto const & block : cemented_blocks)
+		{
+			auto existing (original_hashes_pending.find (block->hash ()));
+			if (existing != original_hashes_pending.end ())
+			{
+				ledger.stats.sample (nano::stat::latency::block_cemented, now - existing->second);
+			}
+		}
+	}
 	for (auto const & block_callback_data : cemented_blocks)
 	{
 		for (auto const & observer : cemented_observers)
@@ -14,7 +14,7 @@
 
 #include <condition_variable>
 #include <thread>
-#include <unordered_set>
+#include <unordered_map>
 
 namespace mi = boost::multi_index;
 namespace boost
@@ -60,7 +60,8 @@ private:
 	struct block_wrapper
 	{
 		explicit block_wrapper (std::shared_ptr<nano::block> const & block_a) :
-			block (block_a)
+			block (block_a),
+			added (std::chrono::steady_clock::now ())
 		{
 		}
 
@@ -70,6 +71,7 @@ private:
 		}
 
 		std::shared_ptr<nano::block> block;
+		std::chrono::steady_clock::time_point added;
 	};
 	// clang-format off
 	class tag_sequence {};
@@ -81,8 +83,8 @@ private:
 			mi::const_mem_fun<block_wrapper, std::reference_wrapper<nano::block_hash const>, &block_wrapper::hash>>>> awaiting_processing;
 	// clang-format on
 
-	// Hashes which have been added and processed, but have not been cemented
-	std::unordered_set<nano::block_hash> original_hashes_pending;
+	// Hashes which have been added and processed, but have not been cemented, along with the time they were added
+	std::unordered_map<nano::block_hash, std::chrono::steady_clock::time_point> original_hashes_pending;
 	bool paused{ false };
 
 	/** This is the last block popped off the confirmation height pending collection */
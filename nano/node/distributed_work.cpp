@@ -106,7 +106,8 @@ void nano::distributed_work::start_local ()
 {
 	auto this_l (shared_from_this ());
 	local_generation_started = true;
-	node.work.generate (request.version, request.root, request.difficulty, [this_l] (boost::optional<uint64_t> const & work_a) {
+	node.work.generate (
+	request.version, request.root, request.difficulty, [this_l] (boost::optional<uint64_t> const & work_a) {
 		if (work_a.is_initialized ())
 		{
 			this_l->set_once (*work_a);
@@ -120,7 +121,8 @@ void nano::distributed_work::start_local ()
 			}
 		}
 		this_l->stop_once (false);
-	});
+	},
+	request.priority);
 }
 
 void nano::distributed_work::do_request (nano::tcp_endpoint const & endpoint_a)
@@ -31,6 +31,7 @@ struct work_request final
 	boost::optional<nano::account> const account;
 	std::function<void (boost::optional<uint64_t>)> callback;
 	std::vector<std::pair<std::string, uint16_t>> const peers;
+	nano::work_priority priority{ nano::work_priority::interactive };
 };
 
 /**
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/work.hpp>
 
 #include <atomic>
 #include <functional>
@@ -20,7 +21,7 @@ class distributed_work_factory final
 public:
 	distributed_work_factory (nano::node &);
 	~distributed_work_factory ();
-	bool make (nano::work_version const, nano::root const &, std::vector<std::pair<std::string, uint16_t>> const &, uint64_t, std::function<void (boost::optional<uint64_t>)> const &, boost::optional<nano::account> const & = boost::none);
+	bool make (nano::work_version const, nano::root const &, std::vector<std::pair<std::string, uint16_t>> const &, uint64_t, std::function<void (boost::optional<uint64_t>)> const &, boost::optional<nano::account> const & = boost::none, nano::work_priority const = nano::work_priority::interactive);
 	bool make (std::chrono::seconds const &, nano::work_request const &);
 	void cancel (nano::root const &);
 	void cleanup_finished ();
@@ -42,7 +42,9 @@ void nano::election::confirm_once (nano::unique_lock<nano::mutex> & lock_a, nano
 		node.active.election_winner_details.emplace (status.winner->hash (), shared_from_this ());
 		election_winners_lk.unlock ();
 		status.election_end = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::system_clock::now ().time_since_epoch ());
-		status.election_duration = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - election_start);
+		auto const duration = std::chrono::steady_clock::now () - election_start;
+		node.stats.sample (nano::stat::latency::election_confirmed, duration);
+		status.election_duration = std::chrono::duration_cast<std::chrono::milliseconds> (duration);
 		status.confirmation_request_count = confirmation_request_count;
 		status.block_count = nano::narrow_cast<decltype (status.block_count)> (last_blocks.size ());
 		status.voter_count = nano::narrow_cast<decltype (status.voter_count)> (last_votes.size ());
@@ -0,0 +1,314 @@
+#include <nano/boost/asio/connect.hpp>
+#include <nano/boost/asio/post.hpp>
+#include <nano/boost/asio/steady_timer.hpp>
+#include <nano/lib/logger_mt.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/node/http_callbacks.hpp>
+#include <nano/node/nodeconfig.hpp>
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+
+nano::http_callbacks::connection::connection (boost::asio::io_context & io_ctx_a) :
+	socket{ io_ctx_a }
+{
+}
+
+nano::http_callbacks::http_callbacks (nano::node_config const & config_a, boost::asio::io_context & io_ctx_a, nano::stats & stats_a, nano::logger_mt & logger_a) :
+	config{ config_a },
+	io_ctx{ io_ctx_a },
+	stats{ stats_a },
+	logger{ logger_a }
+{
+	// Milliseconds from queueing an event until the request carrying it succeeded
+	stats.define_histogram (nano::stat::type::http_callback, nano::stat::detail::initiate, nano::stat::dir::out, { 0, 10, 50, 100, 500, 1000, 5000, 30000, 60000 });
+}
+
+void nano::http_callbacks::stop ()
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	stopped = true;
+	queue.clear ();
+	for (auto const & connection : connections)
+	{
+		// Sockets are only touched from io threads
+		boost::asio::post (io_ctx, [connection] () {
+			boost::system::error_code ignored;
+			connection->socket.close (ignored);
+		});
+	}
+}
+
+bool nano::http_callbacks::add (std::string const & event_a)
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	if (stopped)
+	{
+		return true;
+	}
+	if (queue.size () >= config.callback_queue_max)
+	{
+		lock.unlock ();
+		stats.inc (nano::stat::type::http_callback, nano::stat::detail::overfill, nano::stat::dir::out);
+		return true;
+	}
+	queue.push_back ({ event_a, std::chrono::steady_clock::now () });
+	stats.inc (nano::stat::type::http_callback, nano::stat::detail::queue, nano::stat::dir::out);
+	dispatch (lock);
+	return false;
+}
+
+void nano::http_callbacks::dispatch (nano::unique_lock<nano::mutex> & lock_a)
+{
+	debug_assert (lock_a.owns_lock ());
+	if (stopped || queue.empty ())
+	{
+		return;
+	}
+	if (endpoints.empty ())
+	{
+		if (!resolving)
+		{
+			resolving = true;
+			boost::asio::post (io_ctx, [this_l = shared_from_this ()] () {
+				this_l->resolve ();
+			});
+		}
+		return;
+	}
+	auto const batch_max = std::max<std::size_t> (config.callback_batch_max, 1);
+	while (!queue.empty ())
+	{
+		auto existing = std::find_if (connections.begin (), connections.end (), [] (auto const & connection) { return !connection->busy; });
+		std::shared_ptr<connection> connection_l;
+		if (existing != connections.end ())
+		{
+			connection_l = *existing;
+		}
+		else if (connections.size () < std::max (config.callback_connections, 1u))
+		{
+			connection_l = connections.emplace_back (std::make_shared<connection> (io_ctx));
+		}
+		else
+		{
+			break;
+		}
+		auto count = std::min (queue.size (), batch_max);
+		connection_l->events.assign (std::make_move_iterator (queue.begin ()), std::make_move_iterator (queue.begin () + count));
+		queue.erase (queue.begin (), queue.begin () + count);
+		connection_l->busy = true;
+		boost::asio::post (io_ctx, [this_l = shared_from_this (), connection_l] () {
+			this_l->send (connection_l);
+		});
+	}
+}
+
+void nano::http_callbacks::resolve ()
+{
+	auto resolver (std::make_shared<boost::asio::ip::tcp::resolver> (io_ctx));
+	resolver->async_resolve (config.callback_address, std::to_string (config.callback_port), [this_l = shared_from_this (), resolver] (boost::system::error_code const & ec, boost::asio::ip::tcp::resolver::results_type results) {
+		nano::unique_lock<nano::mutex> lock{ this_l->mutex };
+		this_l->resolving = false;
+		if (!ec && !results.empty ())
+		{
+			this_l->endpoints.clear ();
+			for (auto const & entry : results)
+			{
+				this_l->endpoints.push_back (entry.endpoint ());
+			}
+			this_l->dispatch (lock);
+		}
+		else
+		{
+			// Nothing can be delivered until the address resolves, the queued events back off together
+			std::vector<event> events (std::make_move_iterator (this_l->queue.begin ()), std::make_move_iterator (this_l->queue.end ()));
+			this_l->queue.clear ();
+			lock.unlock ();
+			if (this_l->config.logging.callback_logging ())
+			{
+				this_l->logger.always_log (boost::str (boost::format ("Error resolving callback: %1%:%2%: %3%") % this_l->config.callback_address % this_l->config.callback_port % ec.message ()));
+			}
+			this_l->retry (std::move (events));
+		}
+	});
+}
+
+void nano::http_callbacks::send (std::shared_ptr<connection> const & connection_a)
+{
+	if (connection_a->socket.is_open ())
+	{
+		write (connection_a);
+		return;
+	}
+	decltype (endpoints) endpoints_l;
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		endpoints_l = endpoints;
+	}
+	boost::asio::async_connect (connection_a->socket, endpoints_l, [this_l = shared_from_this (), connection_a] (boost::system::error_code const & ec, boost::asio::ip::tcp::endpoint const &) {
+		if (!ec)
+		{
+			this_l->write (connection_a);
+		}
+		else
+		{
+			{
+				// The address may have moved, resolve it again before the next attempt
+				nano::lock_guard<nano::mutex> lock{ this_l->mutex };
+				this_l->endpoints.clear ();
+			}
+			this_l->completed (connection_a, boost::str (boost::format ("Unable to connect: %1%") % ec.message ()));
+		}
+	});
+}
+
+void nano::http_callbacks::write (std::shared_ptr<connection> const & connection_a)
+{
+	auto & request (connection_a->request);
+	request = {};
+	request.method (boost::beast::http::verb::post);
+	request.target (config.callback_target);
+	request.version (11);
+	request.keep_alive (true);
+	request.insert (boost::beast::http::field::host, config.callback_address);
+	request.insert (boost::beast::http::field::content_type, "application/json");
+	if (config.callback_batch_max <= 1)
+	{
+		debug_assert (connection_a->events.size () == 1);
+		request.body () = connection_a->events.front ().body;
+	}
+	else
+	{
+		auto & body (request.body ());
+		body.push_back ('[');
+		for (auto const & event : connection_a->events)
+		{
+			if (body.size () > 1)
+			{
+				body.push_back (',');
+			}
+			body.append (event.body);
+		}
+		body.push_back (']');
+	}
+	request.prepare_payload ();
+	boost::beast::http::async_write (connection_a->socket, request, [this_l = shared_from_this (), connection_a] (boost::system::error_code const & ec, std::size_t) {
+		if (ec)
+		{
+			this_l->completed (connection_a, boost::str (boost::format ("Unable to send: %1%") % ec.message ()));
+			return;
+		}
+		connection_a->response = {};
+		boost::beast::http::async_read (connection_a->socket, connection_a->buffer, connection_a->response, [this_l, connection_a] (boost::system::error_code const & ec, std::size_t) {
+			if (ec)
+			{
+				this_l->completed (connection_a, boost::str (boost::format ("Unable to complete: %1%") % ec.message ()));
+			}
+			else if (boost::beast::http::to_status_class (connection_a->response.result ()) != boost::beast::http::status_class::successful)
+			{
+				this_l->completed (connection_a, boost::str (boost::format ("Failed with status: %1%") % connection_a->response.result ()));
+			}
+			else
+			{
+				this_l->completed (connection_a, "");
+			}
+		});
+	});
+}
+
+void nano::http_callbacks::completed (std::shared_ptr<connection> const & connection_a, std::string const & error_a)
+{
+	auto events (std::move (connection_a->events));
+	connection_a->events.clear ();
+	if (error_a.empty ())
+	{
+		auto now (std::chrono::steady_clock::now ());
+		for (auto const & event : events)
+		{
+			stats.update_histogram (nano::stat::type::http_callback, nano::stat::detail::initiate, nano::stat::dir::out, std::chrono::duration_cast<std::chrono::milliseconds> (now - event.added).count ());
+		}
+		stats.add (nano::stat::type::http_callback, nano::stat::detail::initiate, nano::stat::dir::out, events.size ());
+		if (!connection_a->response.keep_alive ())
+		{
+			boost::system::error_code ignored;
+			connection_a->socket.close (ignored);
+		}
+	}
+	else
+	{
+		if (config.logging.callback_logging ())
+		{
+			logger.try_log (boost::str (boost::format ("Callback to %1%:%2% failed: %3%") % config.callback_address % config.callback_port % error_a));
+		}
+		boost::system::error_code ignored;
+		connection_a->socket.close (ignored);
+		connection_a->buffer.clear ();
+		retry (std::move (events));
+	}
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	connection_a->busy = false;
+	dispatch (lock);
+}
+
+void nano::http_callbacks::retry (std::vector<event> events_a)
+{
+	std::vector<event> retried;
+	std::size_t dropped{ 0 };
+	unsigned attempts{ 0 };
+	for (auto & event : events_a)
+	{
+		if (++event.attempts > config.callback_retries)
+		{
+			++dropped;
+		}
+		else
+		{
+			attempts = std::max (attempts, event.attempts);
+			retried.push_back (std::move (event));
+		}
+	}
+	stats.add (nano::stat::type::error, nano::stat::detail::http_callback, nano::stat::dir::out, dropped);
+	if (retried.empty ())
+	{
+		return;
+	}
+	stats.add (nano::stat::type::http_callback, nano::stat::detail::retry, nano::stat::dir::out, retried.size ());
+	auto delay (std::min<std::chrono::milliseconds> (backoff_max, backoff_initial * (1u << std::min (attempts - 1, 16u))));
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		if (stopped)
+		{
+			return;
+		}
+		retrying += retried.size ();
+	}
+	auto timer (std::make_shared<boost::asio::steady_timer> (io_ctx, delay));
+	timer->async_wait ([this_l = shared_from_this (), timer, events = std::move (retried)] (boost::system::error_code const &) mutable {
+		nano::unique_lock<nano::mutex> lock{ this_l->mutex };
+		this_l->retrying -= events.size ();
+		if (!this_l->stopped)
+		{
+			// Retried events are the oldest, they go first
+			this_l->queue.insert (this_l->queue.begin (), std::make_move_iterator (events.begin ()), std::make_move_iterator (events.end ()));
+			this_l->dispatch (lock);
+		}
+	});
+}
+
+std::size_t nano::http_callbacks::size ()
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	return queue.size () + retrying;
+}
+
+std::unique_ptr<nano::container_info_component> nano::http_callbacks::collect_container_info (std::string const & name)
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "queue", queue.size (), sizeof (decltype (queue)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "retrying", retrying, sizeof (decltype (queue)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "connections", connections.size (), sizeof (connection) }));
+	return composite;
+}
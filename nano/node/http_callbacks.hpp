@@ -0,0 +1,82 @@
+#pragma once
+
+#include <nano/boost/asio/ip/tcp.hpp>
+#include <nano/boost/beast/core.hpp>
+#include <nano/boost/beast/http.hpp>
+#include <nano/lib/locks.hpp>
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nano
+{
+class container_info_component;
+class logger_mt;
+class node_config;
+class stats;
+
+/**
+ * Delivers HTTP callbacks over a small pool of keep-alive connections to the configured callback address.
+ * The address is resolved once and only resolved again after connecting to it failed.
+ * Events are sent one per request, or as a JSON array of up to `callback_batch_max` events, and failed requests are retried with exponential backoff.
+ */
+class http_callbacks final : public std::enable_shared_from_this<nano::http_callbacks>
+{
+public:
+	http_callbacks (nano::node_config const &, boost::asio::io_context &, nano::stats &, nano::logger_mt &);
+	void stop ();
+	/** Queues a JSON object for delivery, returns true if the queue was full and the event was dropped */
+	bool add (std::string const & event);
+	std::size_t size ();
+	std::unique_ptr<nano::container_info_component> collect_container_info (std::string const & name);
+
+	static std::chrono::milliseconds constexpr backoff_initial{ 100 };
+	static std::chrono::milliseconds constexpr backoff_max{ 10 * 1000 };
+
+private:
+	class event final
+	{
+	public:
+		std::string body;
+		std::chrono::steady_clock::time_point added;
+		unsigned attempts{ 0 };
+	};
+
+	class connection final
+	{
+	public:
+		explicit connection (boost::asio::io_context &);
+		boost::asio::ip::tcp::socket socket;
+		boost::beast::flat_buffer buffer;
+		boost::beast::http::request<boost::beast::http::string_body> request;
+		boost::beast::http::response<boost::beast::http::string_body> response;
+		std::vector<event> events;
+		bool busy{ false };
+	};
+
+	void dispatch (nano::unique_lock<nano::mutex> &);
+	void resolve ();
+	void send (std::shared_ptr<connection> const &);
+	void write (std::shared_ptr<connection> const &);
+	/** Called once per request, an empty error_a means the request succeeded */
+	void completed (std::shared_ptr<connection> const &, std::string const & error_a);
+	void retry (std::vector<event>);
+
+	nano::node_config const & config;
+	boost::asio::io_context & io_ctx;
+	nano::stats & stats;
+	nano::logger_mt & logger;
+	nano::mutex mutex;
+	bool stopped{ false };
+	std::deque<event> queue;
+	std::vector<std::shared_ptr<connection>> connections;
+	/** Resolved callback address, cleared when connecting fails */
+	std::vector<boost::asio::ip::tcp::endpoint> endpoints;
+	bool resolving{ false };
+	/** Events waiting for their backoff to expire */
+	std::size_t retrying{ 0 };
+};
+}
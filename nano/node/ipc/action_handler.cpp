@@ -2,9 +2,12 @@
 #include <nano/lib/errors.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/node/ipc/action_handler.hpp>
+#include <nano/node/ipc/flatbuffers_util.hpp>
 #include <nano/node/ipc/ipc_server.hpp>
 #include <nano/node/node.hpp>
 
+#include <limits>
+
 namespace
 {
 nano::account parse_account (std::string const & account, bool & out_is_deprecated_format)
@@ -26,6 +29,39 @@ nano::account parse_account (std::string const & account, bool & out_is_deprecat
 
 	return result;
 }
+/** Maps unsuccessful block processing results to the errors reported by the process RPC */
+nano::error_process process_error (nano::process_result result_a)
+{
+	switch (result_a)
+	{
+		case nano::process_result::gap_previous:
+			return nano::error_process::gap_previous;
+		case nano::process_result::gap_source:
+			return nano::error_process::gap_source;
+		case nano::process_result::gap_epoch_open_pending:
+			return nano::error_process::gap_epoch_open_pending;
+		case nano::process_result::old:
+			return nano::error_process::old;
+		case nano::process_result::bad_signature:
+			return nano::error_process::bad_signature;
+		case nano::process_result::negative_spend:
+			return nano::error_process::negative_spend;
+		case nano::process_result::fork:
+			return nano::error_process::fork;
+		case nano::process_result::unreceivable:
+			return nano::error_process::unreceivable;
+		case nano::process_result::balance_mismatch:
+			return nano::error_process::balance_mismatch;
+		case nano::process_result::block_position:
+			return nano::error_process::block_position;
+		case nano::process_result::insufficient_work:
+			return nano::error_process::insufficient_work;
+		case nano::process_result::opened_burn_account:
+			return nano::error_process::opened_burn_account;
+		default:
+			return nano::error_process::other;
+	}
+}
 /** Returns the message as a Flatbuffers ObjectAPI type, managed by a unique_ptr */
 template <typename T>
 auto get_message (nanoapi::Envelope const & envelope)
@@ -50,16 +86,43 @@ auto nano::ipc::action_handler::handler_map () -> std::unordered_map<nanoapi::Me
 		handlers.emplace (nanoapi::Message::Message_ServiceRegister, &nano::ipc::action_handler::on_service_register);
 		handlers.emplace (nanoapi::Message::Message_ServiceStop, &nano::ipc::action_handler::on_service_stop);
 		handlers.emplace (nanoapi::Message::Message_TopicServiceStop, &nano::ipc::action_handler::on_topic_service_stop);
+		handlers.emplace (nanoapi::Message::Message_AccountInfo, &nano::ipc::action_handler::on_account_info);
+		handlers.emplace (nanoapi::Message::Message_BlocksInfo, &nano::ipc::action_handler::on_blocks_info);
+		handlers.emplace (nanoapi::Message::Message_Process, &nano::ipc::action_handler::on_process);
+		handlers.emplace (nanoapi::Message::Message_Receivable, &nano::ipc::action_handler::on_receivable);
+		handlers.emplace (nanoapi::Message::Message_WorkGenerate, &nano::ipc::action_handler::on_work_generate);
+		handlers.emplace (nanoapi::Message::Message_TopicVote, &nano::ipc::action_handler::on_topic_vote);
+		handlers.emplace (nanoapi::Message::Message_TopicStartedElection, &nano::ipc::action_handler::on_topic_started_election);
+		handlers.emplace (nanoapi::Message::Message_TopicStoppedElection, &nano::ipc::action_handler::on_topic_stopped_election);
+		handlers.emplace (nanoapi::Message::Message_TopicNewUnconfirmedBlock, &nano::ipc::action_handler::on_topic_new_unconfirmed_block);
 	}
 	return handlers;
 }
 
-nano::ipc::action_handler::action_handler (nano::node & node_a, nano::ipc::ipc_server & server_a, std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<flatbuffers::FlatBufferBuilder> const & builder_a) :
+nano::ipc::action_handler::action_handler (nano::node & node_a, nano::ipc::ipc_server & server_a, std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<flatbuffers::FlatBufferBuilder> const & builder_a, std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & response_handler_a) :
 	flatbuffer_producer (builder_a),
 	node (node_a),
 	ipc_server (server_a),
-	subscriber (subscriber_a)
+	subscriber (subscriber_a),
+	response_handler (response_handler_a)
+{
+}
+
+std::function<void ()> nano::ipc::action_handler::defer ()
+{
+	if (!response_handler)
+	{
+		throw nano::error ("Asynchronous requests are not supported by this transport");
+	}
+	deferred = true;
+	return [this_l = shared_from_this ()] () {
+		this_l->response_handler (this_l->get_shared_flatbuffer ());
+	};
+}
+
+bool nano::ipc::action_handler::is_deferred () const
 {
+	return deferred;
 }
 
 void nano::ipc::action_handler::on_topic_confirmation (nanoapi::Envelope const & envelope_a)
@@ -103,6 +166,38 @@ void nano::ipc::action_handler::on_topic_service_stop (nanoapi::Envelope const &
 	create_response (ack);
 }
 
+void nano::ipc::action_handler::on_topic_vote (nanoapi::Envelope const & envelope_a)
+{
+	auto topic (get_message<nanoapi::TopicVote> (envelope_a));
+	ipc_server.get_broker ()->subscribe (subscriber, std::move (topic));
+	nanoapi::EventAckT ack;
+	create_response (ack);
+}
+
+void nano::ipc::action_handler::on_topic_started_election (nanoapi::Envelope const & envelope_a)
+{
+	auto topic (get_message<nanoapi::TopicStartedElection> (envelope_a));
+	ipc_server.get_broker ()->subscribe (subscriber, std::move (topic));
+	nanoapi::EventAckT ack;
+	create_response (ack);
+}
+
+void nano::ipc::action_handler::on_topic_stopped_election (nanoapi::Envelope const & envelope_a)
+{
+	auto topic (get_message<nanoapi::TopicStoppedElection> (envelope_a));
+	ipc_server.get_broker ()->subscribe (subscriber, std::move (topic));
+	nanoapi::EventAckT ack;
+	create_response (ack);
+}
+
+void nano::ipc::action_handler::on_topic_new_unconfirmed_block (nanoapi::Envelope const & envelope_a)
+{
+	auto topic (get_message<nanoapi::TopicNewUnconfirmedBlock> (envelope_a));
+	ipc_server.get_broker ()->subscribe (subscriber, std::move (topic));
+	nanoapi::EventAckT ack;
+	create_response (ack);
+}
+
 void nano::ipc::action_handler::on_account_weight (nanoapi::Envelope const & envelope_a)
 {
 	require_oneof (envelope_a, { nano::ipc::access_permission::api_account_weight, nano::ipc::access_permission::account_query });
@@ -115,6 +210,207 @@ void nano::ipc::action_handler::on_account_weight (nanoapi::Envelope const & env
 	create_response (response);
 }
 
+void nano::ipc::action_handler::on_account_info (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_account_info, nano::ipc::access_permission::account_query });
+	bool is_deprecated_format{ false };
+	auto query (get_message<nanoapi::AccountInfo> (envelope_a));
+	auto account (parse_account (query->account, is_deprecated_format));
+	auto transaction (node.store.tx_begin_read ());
+	auto info (node.ledger.account_info (transaction, account));
+	if (!info)
+	{
+		throw nano::error (nano::error_common::account_not_found);
+	}
+	nano::confirmation_height_info confirmation_height_info;
+	node.store.confirmation_height.get (transaction, account, confirmation_height_info);
+
+	nanoapi::AccountInfoResponseT response;
+	response.frontier = info->head.to_string ();
+	response.open_block = info->open_block.to_string ();
+	response.representative_block = node.ledger.representative (transaction, info->head).to_string ();
+	response.balance = info->balance.to_string_dec ();
+	response.modified_timestamp = info->modified;
+	response.block_count = info->block_count;
+	response.account_version = nano::normalized_epoch (info->epoch ());
+	response.confirmation_height = confirmation_height_info.height;
+	response.confirmation_height_frontier = confirmation_height_info.frontier.to_string ();
+	if (query->representative)
+	{
+		response.representative = info->representative.to_account ();
+	}
+	if (query->weight)
+	{
+		response.weight = node.ledger.weight (account).convert_to<std::string> ();
+	}
+	if (query->receivable)
+	{
+		response.receivable = node.ledger.account_receivable (transaction, account).convert_to<std::string> ();
+	}
+	create_response (response);
+}
+
+void nano::ipc::action_handler::on_blocks_info (nanoapi::Envelope const & envelope_a)
+{
+	require (envelope_a, nano::ipc::access_permission::api_blocks_info);
+	auto query (get_message<nanoapi::BlocksInfo> (envelope_a));
+	nanoapi::BlocksInfoResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	for (auto const & hash_text : query->hashes)
+	{
+		nano::block_hash hash;
+		if (hash.decode_hex (hash_text))
+		{
+			throw nano::error (nano::error_blocks::bad_hash_number);
+		}
+		auto block (node.store.block.get (transaction, hash));
+		if (block == nullptr)
+		{
+			response.not_found.push_back (hash_text);
+			continue;
+		}
+		auto const & sideband (block->sideband ());
+		bool error_or_pruned (false);
+		nano::amount amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
+		auto info (std::make_unique<nanoapi::BlockInfoT> ());
+		info->block = nano::ipc::flatbuffers_builder::block_to_union (*block, amount, sideband.details.is_send, sideband.details.is_epoch);
+		info->account = (block->account ().is_zero () ? sideband.account : block->account ()).to_account ();
+		if (!error_or_pruned)
+		{
+			info->amount = amount.to_string_dec ();
+		}
+		info->balance = nano::amount (node.ledger.balance (transaction, hash)).to_string_dec ();
+		info->height = sideband.height;
+		info->local_timestamp = sideband.timestamp;
+		info->confirmed = node.ledger.block_confirmed (transaction, hash);
+		response.blocks.push_back (std::move (info));
+	}
+	create_response (response);
+}
+
+void nano::ipc::action_handler::on_process (nanoapi::Envelope const & envelope_a)
+{
+	require (envelope_a, nano::ipc::access_permission::api_process);
+	auto query (get_message<nanoapi::Process> (envelope_a));
+	auto block (nano::ipc::flatbuffers_builder::block_from (query->block));
+	if (block == nullptr)
+	{
+		throw nano::error (nano::error_blocks::invalid_block);
+	}
+	if (node.network_params.work.validate_entry (*block))
+	{
+		throw nano::error (nano::error_blocks::work_low);
+	}
+	// Processing waits for the block processor, which must not hold up IPC threads
+	auto done (defer ());
+	node.workers.push_task ([this_l = shared_from_this (), block, done] () {
+		try
+		{
+			auto result (this_l->node.process_local (block));
+			if (!result)
+			{
+				throw nano::error (nano::error_rpc::stopped);
+			}
+			if (result->code != nano::process_result::progress)
+			{
+				throw nano::error (process_error (result->code));
+			}
+			nanoapi::ProcessResponseT response;
+			response.hash = block->hash ().to_string ();
+			this_l->create_response (response);
+		}
+		catch (nano::error const & err)
+		{
+			this_l->make_error (err.error_code_as_int (), err.get_message ());
+		}
+		done ();
+	});
+}
+
+void nano::ipc::action_handler::on_receivable (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_receivable, nano::ipc::access_permission::account_query });
+	bool is_deprecated_format{ false };
+	auto query (get_message<nanoapi::Receivable> (envelope_a));
+	auto account (parse_account (query->account, is_deprecated_format));
+	nano::amount threshold (0);
+	if (!query->threshold.empty () && threshold.decode_dec (query->threshold))
+	{
+		throw nano::error (nano::error_common::bad_threshold);
+	}
+	auto count (query->count == 0 ? std::numeric_limits<uint64_t>::max () : query->count);
+	nanoapi::ReceivableResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	auto i (node.ledger.cache.receivable.may_have (account, threshold.number ()) ? node.store.pending.begin (transaction, account) : node.store.pending.end ());
+	for (auto n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && response.blocks.size () < count; ++i)
+	{
+		nano::pending_key const & key (i->first);
+		nano::pending_info const & info (i->second);
+		if (info.amount.number () < threshold.number () || (query->include_only_confirmed && !node.ledger.block_confirmed (transaction, key.hash)))
+		{
+			continue;
+		}
+		auto entry (std::make_unique<nanoapi::ReceivableEntryT> ());
+		entry->hash = key.hash.to_string ();
+		entry->amount = info.amount.to_string_dec ();
+		entry->source = info.source.to_account ();
+		response.blocks.push_back (std::move (entry));
+	}
+	create_response (response);
+}
+
+void nano::ipc::action_handler::on_work_generate (nanoapi::Envelope const & envelope_a)
+{
+	require (envelope_a, nano::ipc::access_permission::api_work_generate);
+	auto query (get_message<nanoapi::WorkGenerate> (envelope_a));
+	nano::block_hash hash;
+	if (hash.decode_hex (query->hash))
+	{
+		throw nano::error (nano::error_blocks::bad_hash_number);
+	}
+	auto version (nano::work_version::work_1);
+	auto difficulty (node.default_difficulty (version));
+	if (!query->difficulty.empty () && nano::from_string_hex (query->difficulty, difficulty))
+	{
+		throw nano::error (nano::error_rpc::bad_difficulty_format);
+	}
+	if (difficulty > node.max_work_generate_difficulty (version) || difficulty < node.network_params.work.threshold_entry (version, nano::block_type::state))
+	{
+		throw nano::error (nano::error_rpc::difficulty_limit);
+	}
+	boost::optional<nano::account> account;
+	if (!query->account.empty ())
+	{
+		bool is_deprecated_format{ false };
+		account = parse_account (query->account, is_deprecated_format);
+	}
+	if (!node.work_generation_enabled ())
+	{
+		throw nano::error (nano::error_common::disabled_work_generation);
+	}
+	auto done (defer ());
+	node.work_generate (
+	version, hash, difficulty, [this_l = shared_from_this (), hash, version, done] (boost::optional<uint64_t> work_a) {
+		if (work_a)
+		{
+			auto difficulty_l (this_l->node.network_params.work.difficulty (version, hash, *work_a));
+			nanoapi::WorkGenerateResponseT response;
+			response.hash = hash.to_string ();
+			response.work = nano::to_string_hex (*work_a);
+			response.difficulty = nano::to_string_hex (difficulty_l);
+			response.multiplier = nano::to_string (nano::difficulty::to_multiplier (difficulty_l, this_l->node.default_difficulty (version)));
+			this_l->create_response (response);
+		}
+		else
+		{
+			nano::error err ("Cancelled");
+			this_l->make_error (err.error_code_as_int (), err.get_message ());
+		}
+		done ();
+	},
+	account);
+}
+
 void nano::ipc::action_handler::on_is_alive (nanoapi::Envelope const & envelope)
 {
 	nanoapi::IsAliveT alive;
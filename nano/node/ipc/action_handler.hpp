@@ -30,9 +30,14 @@ namespace ipc
 	class action_handler final : public flatbuffer_producer, public std::enable_shared_from_this<action_handler>
 	{
 	public:
-		action_handler (nano::node & node, nano::ipc::ipc_server & server, std::weak_ptr<nano::ipc::subscriber> const & subscriber, std::shared_ptr<flatbuffers::FlatBufferBuilder> const & builder);
+		action_handler (nano::node & node, nano::ipc::ipc_server & server, std::weak_ptr<nano::ipc::subscriber> const & subscriber, std::shared_ptr<flatbuffers::FlatBufferBuilder> const & builder, std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & response_handler = nullptr);
 
+		void on_account_info (nanoapi::Envelope const & envelope);
 		void on_account_weight (nanoapi::Envelope const & envelope);
+		void on_blocks_info (nanoapi::Envelope const & envelope);
+		void on_process (nanoapi::Envelope const & envelope);
+		void on_receivable (nanoapi::Envelope const & envelope);
+		void on_work_generate (nanoapi::Envelope const & envelope);
 		void on_is_alive (nanoapi::Envelope const & envelope);
 		void on_topic_confirmation (nanoapi::Envelope const & envelope);
 
@@ -45,6 +50,19 @@ namespace ipc
 		/** Subscribe to the ServiceStop event. The service must first have registered itself on the same session. */
 		void on_topic_service_stop (nanoapi::Envelope const & envelope);
 
+		/** Subscribe to node events. Events are queued per session, and the oldest are dropped if the client does not keep up. */
+		void on_topic_vote (nanoapi::Envelope const & envelope);
+		void on_topic_started_election (nanoapi::Envelope const & envelope);
+		void on_topic_stopped_election (nanoapi::Envelope const & envelope);
+		void on_topic_new_unconfirmed_block (nanoapi::Envelope const & envelope);
+
+		/**
+		 * Called by handlers which complete asynchronously. The response is then sent when the returned function is
+		 * called, rather than when the handler returns. Requires a response handler.
+		 */
+		std::function<void ()> defer ();
+		bool is_deferred () const;
+
 		/** Returns a mapping from api message types to handler functions */
 		static auto handler_map () -> std::unordered_map<nanoapi::Message, std::function<void (action_handler *, nanoapi::Envelope const &)>, nano::ipc::enum_hash>;
 
@@ -59,6 +77,8 @@ namespace ipc
 		nano::node & node;
 		nano::ipc::ipc_server & ipc_server;
 		std::weak_ptr<nano::ipc::subscriber> subscriber;
+		std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> response_handler;
+		bool deferred{ false };
 	};
 }
 }
@@ -98,10 +98,11 @@ std::function<void (std::shared_ptr<std::string> const &)> const & response_hand
 		{
 			process (parser->builder_.GetBufferPointer (), parser->builder_.GetSize (), [parser = parser, response_handler] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb) {
 				// Convert response to JSON
+				// Not thrown, as deferred actions call this after process () has returned
 				auto json (std::make_shared<std::string> ());
 				if (!flatbuffers::GenerateText (*parser, fbb->GetBufferPointer (), json.get ()))
 				{
-					throw nano::error ("Couldn't serialize response to JSON");
+					json = std::make_shared<std::string> (make_error_response ("Couldn't serialize response to JSON"));
 				}
 
 				response_handler (json);
@@ -135,7 +136,7 @@ void nano::ipc::flatbuffers_handler::process (uint8_t const * message_buffer_a,
 std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & response_handler)
 {
 	auto buffer_l (std::make_shared<flatbuffers::FlatBufferBuilder> ());
-	auto actionhandler (std::make_shared<action_handler> (node, ipc_server, subscriber, buffer_l));
+	auto actionhandler (std::make_shared<action_handler> (node, ipc_server, subscriber, buffer_l, response_handler));
 	std::string correlationId = "";
 
 	// Find and call the action handler
@@ -181,5 +182,9 @@ std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> co
 		actionhandler->make_error (err.error_code_as_int (), err.get_message ());
 	}
 
-	response_handler (buffer_l);
+	// Deferred handlers respond once their asynchronous operation completes
+	if (!actionhandler->is_deferred ())
+	{
+		response_handler (buffer_l);
+	}
 }
@@ -23,7 +23,7 @@ namespace ipc
 	 * Flatbuffers in binary and json formats into high level message objects. These messages are
 	 * then used to dispatch the correct action handler.
 	 * @throws Methods of this class throw nano::error on failure.
-	 * @note This class is not thread safe; use one instance per session/thread.
+	 * @note process() may be called concurrently, process_json() is not thread safe; use one instance per session/thread.
 	 */
 	class flatbuffers_handler final : public std::enable_shared_from_this<flatbuffers_handler>
 	{
@@ -39,6 +39,7 @@ namespace ipc
 		/**
 		 * Deserialize flatbuffer message, look up and call the action handler, then call the response handler with a
 		 * FlatBufferBuilder to allow for zero-copy transfers of data.
+		 * The response handler may be called after this returns, from another thread, if the action completes asynchronously.
 		 * @param response_handler Receives a shared pointer to the flatbuffer builder, from which the buffer and size can be queried
 		 * @throw Throws std:runtime_error on deserialization or processing errors
 		 */
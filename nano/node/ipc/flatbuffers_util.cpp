@@ -3,6 +3,8 @@
 #include <nano/node/ipc/flatbuffers_util.hpp>
 #include <nano/secure/common.hpp>
 
+#include <boost/property_tree/ptree.hpp>
+
 std::unique_ptr<nanoapi::BlockStateT> nano::ipc::flatbuffers_builder::from (nano::state_block const & block_a, nano::amount const & amount_a, bool is_state_send_a, bool is_state_epoch_a)
 {
 	auto block (std::make_unique<nanoapi::BlockStateT> ());
@@ -117,3 +119,78 @@ nanoapi::BlockUnion nano::ipc::flatbuffers_builder::block_to_union (nano::block
 	}
 	return u;
 }
+
+std::shared_ptr<nano::block> nano::ipc::flatbuffers_builder::block_from (nanoapi::BlockUnion const & block_a)
+{
+	// Field names and encodings match the JSON block format, which also performs the validation
+	boost::property_tree::ptree tree;
+	switch (block_a.type)
+	{
+		case nanoapi::Block::Block_BlockState:
+		{
+			auto const & block (*block_a.AsBlockState ());
+			tree.put ("type", "state");
+			tree.put ("account", block.account);
+			tree.put ("previous", block.previous);
+			tree.put ("representative", block.representative);
+			tree.put ("balance", block.balance);
+			tree.put ("link", block.link);
+			tree.put ("signature", block.signature);
+			tree.put ("work", block.work);
+			break;
+		}
+		case nanoapi::Block::Block_BlockSend:
+		{
+			auto const & block (*block_a.AsBlockSend ());
+			// Send blocks carry a decimal balance here, the JSON format uses hex
+			nano::amount balance;
+			if (balance.decode_dec (block.balance))
+			{
+				return nullptr;
+			}
+			std::string balance_hex;
+			balance.encode_hex (balance_hex);
+			tree.put ("type", "send");
+			tree.put ("previous", block.previous);
+			tree.put ("destination", block.destination);
+			tree.put ("balance", balance_hex);
+			tree.put ("signature", block.signature);
+			tree.put ("work", block.work);
+			break;
+		}
+		case nanoapi::Block::Block_BlockReceive:
+		{
+			auto const & block (*block_a.AsBlockReceive ());
+			tree.put ("type", "receive");
+			tree.put ("previous", block.previous);
+			tree.put ("source", block.source);
+			tree.put ("signature", block.signature);
+			tree.put ("work", block.work);
+			break;
+		}
+		case nanoapi::Block::Block_BlockOpen:
+		{
+			auto const & block (*block_a.AsBlockOpen ());
+			tree.put ("type", "open");
+			tree.put ("source", block.source);
+			tree.put ("representative", block.representative);
+			tree.put ("account", block.account);
+			tree.put ("signature", block.signature);
+			tree.put ("work", block.work);
+			break;
+		}
+		case nanoapi::Block::Block_BlockChange:
+		{
+			auto const & block (*block_a.AsBlockChange ());
+			tree.put ("type", "change");
+			tree.put ("previous", block.previous);
+			tree.put ("representative", block.representative);
+			tree.put ("signature", block.signature);
+			tree.put ("work", block.work);
+			break;
+		}
+		default:
+			return nullptr;
+	}
+	return nano::deserialize_block_json (tree);
+}
@@ -27,6 +27,8 @@ namespace ipc
 		static std::unique_ptr<nanoapi::BlockReceiveT> from (nano::receive_block const & block_a);
 		static std::unique_ptr<nanoapi::BlockOpenT> from (nano::open_block const & block_a);
 		static std::unique_ptr<nanoapi::BlockChangeT> from (nano::change_block const & block_a);
+		/** Returns the block described by \p block_a, or nullptr if it is incomplete or invalid */
+		static std::shared_ptr<nano::block> block_from (nanoapi::BlockUnion const & block_a);
 	};
 }
 }
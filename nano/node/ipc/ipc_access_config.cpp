@@ -20,6 +20,16 @@ nano::ipc::access_permission from_string (std::string permission)
 		return nano::ipc::access_permission::api_topic_service_stop;
 	if (permission == "api_topic_confirmation")
 		return nano::ipc::access_permission::api_topic_confirmation;
+	if (permission == "api_account_info")
+		return nano::ipc::access_permission::api_account_info;
+	if (permission == "api_blocks_info")
+		return nano::ipc::access_permission::api_blocks_info;
+	if (permission == "api_process")
+		return nano::ipc::access_permission::api_process;
+	if (permission == "api_receivable")
+		return nano::ipc::access_permission::api_receivable;
+	if (permission == "api_work_generate")
+		return nano::ipc::access_permission::api_work_generate;
 	if (permission == "account_query")
 		return nano::ipc::access_permission::account_query;
 	if (permission == "epoch_upgrade")
@@ -88,6 +98,11 @@ void nano::ipc::access::clear ()
 	// The default set of permissions. A new insert should be made as new safe
 	// api's or resource permissions are made.
 	default_user.permissions.insert (nano::ipc::access_permission::api_account_weight);
+	default_user.permissions.insert (nano::ipc::access_permission::api_account_info);
+	default_user.permissions.insert (nano::ipc::access_permission::api_blocks_info);
+	default_user.permissions.insert (nano::ipc::access_permission::api_process);
+	default_user.permissions.insert (nano::ipc::access_permission::api_receivable);
+	default_user.permissions.insert (nano::ipc::access_permission::api_work_generate);
 }
 
 nano::error nano::ipc::access::deserialize_toml (nano::tomlconfig & toml)
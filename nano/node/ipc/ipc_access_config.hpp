@@ -53,6 +53,11 @@ namespace ipc
 		api_service_stop,
 		api_topic_service_stop,
 		api_topic_confirmation,
+		api_account_info,
+		api_blocks_info,
+		api_process,
+		api_receivable,
+		api_work_generate,
 		/** Query account information */
 		account_query,
 		/** Epoch upgrade */
@@ -1,3 +1,5 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/node/blockprocessor.hpp>
 #include <nano/node/election.hpp>
 #include <nano/node/ipc/action_handler.hpp>
 #include <nano/node/ipc/flatbuffers_handler.hpp>
@@ -6,6 +8,9 @@
 #include <nano/node/ipc/ipc_server.hpp>
 #include <nano/node/node.hpp>
 
+#include <array>
+#include <optional>
+
 nano::ipc::broker::broker (nano::node & node_a) :
 	node (node_a)
 {
@@ -13,6 +18,7 @@ nano::ipc::broker::broker (nano::node & node_a) :
 
 std::shared_ptr<flatbuffers::Parser> nano::ipc::subscriber::get_parser (nano::ipc::ipc_config const & ipc_config_a)
 {
+	nano::lock_guard<nano::mutex> guard{ parser_mutex };
 	if (!parser)
 	{
 		parser = nano::ipc::flatbuffers_handler::make_flatbuffers_parser (ipc_config_a);
@@ -20,6 +26,80 @@ std::shared_ptr<flatbuffers::Parser> nano::ipc::subscriber::get_parser (nano::ip
 	return parser;
 }
 
+nano::ipc::event_payloads::event_payloads (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a) :
+	flatbuffer (flatbuffer_a)
+{
+}
+
+std::optional<nano::ipc::event_payload> nano::ipc::event_payloads::get (nano::ipc::subscriber & subscriber_a, nano::ipc::ipc_config const & ipc_config_a)
+{
+	if (subscriber_a.get_active_encoding () != nano::ipc::payload_encoding::flatbuffers_json)
+	{
+		return nano::ipc::event_payload{ flatbuffer, flatbuffer->GetBufferPointer (), flatbuffer->GetSize () };
+	}
+	if (!json)
+	{
+		auto json_l (std::make_shared<std::string> ());
+		if (!flatbuffers::GenerateText (*subscriber_a.get_parser (ipc_config_a), flatbuffer->GetBufferPointer (), json_l.get ()))
+		{
+			return std::nullopt;
+		}
+		json = json_l;
+	}
+	return nano::ipc::event_payload{ json, reinterpret_cast<uint8_t const *> (json->data ()), json->size () };
+}
+
+nano::ipc::event_filter::event_filter (std::vector<std::string> const & accounts_a, std::string const & min_amount_a)
+{
+	for (auto const & account_text : accounts_a)
+	{
+		nano::account account_l;
+		if (account_l.decode_account (account_text))
+		{
+			throw nano::error (nano::error_common::bad_account_number);
+		}
+		accounts.insert (account_l);
+	}
+	if (!min_amount_a.empty ())
+	{
+		nano::amount amount_l;
+		if (amount_l.decode_dec (min_amount_a))
+		{
+			throw nano::error (nano::error_common::invalid_amount);
+		}
+		min_amount = amount_l.number ();
+	}
+}
+
+bool nano::ipc::event_filter::match_accounts (nano::account const & account_a, nano::account const & other_a) const
+{
+	return accounts.empty () || accounts.count (account_a) > 0 || accounts.count (other_a) > 0;
+}
+
+bool nano::ipc::event_filter::match_amount (nano::uint128_t const & amount_a) const
+{
+	return amount_a >= min_amount;
+}
+
+/** Calls \p action_a for each live subscriber, evicting subscriptions of closed sessions. The collection must be locked by the caller. */
+template <typename COLL, typename ACTION>
+void for_each_subscriber (COLL & subscriber_collection, ACTION const & action_a)
+{
+	auto itr (subscriber_collection.begin ());
+	while (itr != subscriber_collection.end ())
+	{
+		if (auto subscriber_l = itr->subscriber.lock ())
+		{
+			action_a (*subscriber_l, *itr);
+			++itr;
+		}
+		else
+		{
+			itr = subscriber_collection.erase (itr);
+		}
+	}
+}
+
 void nano::ipc::broker::start ()
 {
 	node.observers.blocks.add ([this_l = shared_from_this ()] (nano::election_status const & status_a, std::vector<nano::vote_with_weight_info> const & votes_a, nano::account const & account_a, nano::amount const & amount_a, bool is_state_send_a, bool is_state_epoch_a) {
@@ -60,7 +140,7 @@ void nano::ipc::broker::start ()
 				confirmation->election_info->voter_count = status_a.voter_count;
 				confirmation->election_info->request_count = status_a.confirmation_request_count;
 
-				this_l->broadcast (confirmation);
+				this_l->broadcast (confirmation, account_a, status_a.winner->link ().as_account (), amount_a);
 			}
 		}
 		catch (nano::error const & err)
@@ -68,10 +148,74 @@ void nano::ipc::broker::start ()
 			this_l->node.logger.always_log ("IPC: could not broadcast message: ", err.get_message ());
 		}
 	});
+
+	node.observers.vote.add ([this_l = shared_from_this ()] (std::shared_ptr<nano::vote> vote_a, std::shared_ptr<nano::transport::channel> const & channel_a, nano::vote_code code_a) {
+		if (code_a != nano::vote_code::invalid && !this_l->vote_subscribers->empty ())
+		{
+			this_l->broadcast (vote_a, code_a);
+		}
+	});
+
+	node.observers.active_started.add ([this_l = shared_from_this ()] (nano::block_hash const & hash_a) {
+		auto subscribers = this_l->started_election_subscribers.lock ();
+		if (!subscribers->empty ())
+		{
+			nanoapi::EventStartedElectionT event;
+			event.hash = hash_a.to_string ();
+			std::optional<nano::ipc::event_payloads> payloads;
+			for_each_subscriber (subscribers.get (), [&this_l, &event, &payloads] (auto & subscriber_a, auto const &) {
+				this_l->send_event (subscriber_a, event, payloads);
+			});
+		}
+	});
+
+	node.observers.active_stopped.add ([this_l = shared_from_this ()] (nano::block_hash const & hash_a) {
+		auto subscribers = this_l->stopped_election_subscribers.lock ();
+		if (!subscribers->empty ())
+		{
+			nanoapi::EventStoppedElectionT event;
+			event.hash = hash_a.to_string ();
+			std::optional<nano::ipc::event_payloads> payloads;
+			for_each_subscriber (subscribers.get (), [&this_l, &event, &payloads] (auto & subscriber_a, auto const &) {
+				this_l->send_event (subscriber_a, event, payloads);
+			});
+		}
+	});
+
+	node.block_processor.batch_processed.add ([this_l = shared_from_this ()] (auto const & batch_a) {
+		if (!this_l->new_unconfirmed_block_subscribers->empty ())
+		{
+			for (auto const & [result, block] : batch_a)
+			{
+				if (result.code == nano::process_result::progress)
+				{
+					this_l->broadcast_new_unconfirmed_block (*block);
+				}
+			}
+		}
+	});
+}
+
+template <typename EventType>
+void nano::ipc::broker::send_event (nano::ipc::subscriber & subscriber_a, EventType & event_a, std::optional<nano::ipc::event_payloads> & payloads_a)
+{
+	if (!payloads_a)
+	{
+		payloads_a.emplace (nano::ipc::flatbuffer_producer::make_buffer (event_a));
+	}
+	// This is called from node threads, so failures are logged rather than thrown
+	if (auto payload = payloads_a->get (subscriber_a, node.config.ipc_config))
+	{
+		subscriber_a.async_send_event (*payload);
+	}
+	else
+	{
+		node.logger.always_log ("IPC: could not serialize event to JSON");
+	}
 }
 
 template <typename COLL, typename TOPIC_TYPE>
-void subscribe_or_unsubscribe (nano::logger_mt & logger, COLL & subscriber_collection, std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, TOPIC_TYPE topic_a)
+void subscribe_or_unsubscribe (nano::logger_mt & logger, COLL & subscriber_collection, std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, TOPIC_TYPE topic_a, nano::ipc::event_filter const & filter_a = {})
 {
 	// Evict subscribers from dead sessions. Also remove current subscriber if unsubscribing.
 	subscriber_collection.erase (std::remove_if (subscriber_collection.begin (), subscriber_collection.end (),
@@ -99,109 +243,88 @@ void subscribe_or_unsubscribe (nano::logger_mt & logger, COLL & subscriber_colle
 
 	if (!topic_a->unsubscribe)
 	{
-		subscriber_collection.emplace_back (subscriber_a, topic_a);
+		subscriber_collection.emplace_back (subscriber_a, topic_a, filter_a);
 	}
 }
 
 void nano::ipc::broker::subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicConfirmationT> const & confirmation_a)
 {
+	nano::ipc::event_filter filter;
+	if (confirmation_a->options && !confirmation_a->unsubscribe)
+	{
+		filter = nano::ipc::event_filter (confirmation_a->options->accounts, confirmation_a->options->min_amount);
+	}
 	auto subscribers = confirmation_subscribers.lock ();
-	subscribe_or_unsubscribe (node.logger, subscribers.get (), subscriber_a, confirmation_a);
+	subscribe_or_unsubscribe (node.logger, subscribers.get (), subscriber_a, confirmation_a, filter);
 }
 
-void nano::ipc::broker::broadcast (std::shared_ptr<nanoapi::EventConfirmationT> const & confirmation_a)
+void nano::ipc::broker::broadcast (std::shared_ptr<nanoapi::EventConfirmationT> const & confirmation_a, nano::account const & account_a, nano::account const & destination_a, nano::uint128_t const & amount_a)
 {
 	using Filter = nanoapi::TopicConfirmationTypeFilter;
 	decltype (confirmation_a->election_info) election_info;
 	nanoapi::BlockUnion block;
-	auto itr (confirmation_subscribers->begin ());
-	while (itr != confirmation_subscribers->end ())
-	{
-		if (auto subscriber_l = itr->subscriber.lock ())
-		{
-			auto should_filter = [this, &itr, confirmation_a] () {
-				debug_assert (itr->topic->options != nullptr);
-				auto conf_filter (itr->topic->options->confirmation_type_filter);
+	auto is_state (confirmation_a->block.AsBlockState () != nullptr);
+	// Subscriptions may leave out the election info and the block, each combination is serialized once
+	std::array<std::optional<nano::ipc::event_payloads>, 4> payloads;
+	auto subscribers = confirmation_subscribers.lock ();
+	for_each_subscriber (subscribers.get (), [this, &confirmation_a, &election_info, &block, &account_a, &destination_a, &amount_a, is_state, &payloads] (nano::ipc::subscriber & subscriber_a, auto const & subscription_a) {
+		auto should_filter = [this, &subscription_a, &confirmation_a, &account_a, &destination_a, &amount_a, is_state] () {
+			debug_assert (subscription_a.topic->options != nullptr);
+			auto conf_filter (subscription_a.topic->options->confirmation_type_filter);
 
-				bool should_filter_conf_type_l (true);
-				bool all_filter = conf_filter == Filter::TopicConfirmationTypeFilter_all;
-				bool inactive_filter = conf_filter == Filter::TopicConfirmationTypeFilter_inactive;
-				bool active_filter = conf_filter == Filter::TopicConfirmationTypeFilter_active || conf_filter == Filter::TopicConfirmationTypeFilter_active_quorum || conf_filter == Filter::TopicConfirmationTypeFilter_active_confirmation_height;
+			bool should_filter_conf_type_l (true);
+			bool all_filter = conf_filter == Filter::TopicConfirmationTypeFilter_all;
+			bool inactive_filter = conf_filter == Filter::TopicConfirmationTypeFilter_inactive;
+			bool active_filter = conf_filter == Filter::TopicConfirmationTypeFilter_active || conf_filter == Filter::TopicConfirmationTypeFilter_active_quorum || conf_filter == Filter::TopicConfirmationTypeFilter_active_confirmation_height;
 
-				if ((confirmation_a->confirmation_type == nanoapi::TopicConfirmationType::TopicConfirmationType_active_quorum || confirmation_a->confirmation_type == nanoapi::TopicConfirmationType::TopicConfirmationType_active_confirmation_height) && (all_filter || active_filter))
-				{
-					should_filter_conf_type_l = false;
-				}
-				else if (confirmation_a->confirmation_type == nanoapi::TopicConfirmationType::TopicConfirmationType_inactive && (all_filter || inactive_filter))
-				{
-					should_filter_conf_type_l = false;
-				}
+			if ((confirmation_a->confirmation_type == nanoapi::TopicConfirmationType::TopicConfirmationType_active_quorum || confirmation_a->confirmation_type == nanoapi::TopicConfirmationType::TopicConfirmationType_active_confirmation_height) && (all_filter || active_filter))
+			{
+				should_filter_conf_type_l = false;
+			}
+			else if (confirmation_a->confirmation_type == nanoapi::TopicConfirmationType::TopicConfirmationType_inactive && (all_filter || inactive_filter))
+			{
+				should_filter_conf_type_l = false;
+			}
 
-				bool should_filter_account_l (itr->topic->options->all_local_accounts || !itr->topic->options->accounts.empty ());
-				auto state (confirmation_a->block.AsBlockState ());
-				if (state && !should_filter_conf_type_l)
+			auto const & filter (subscription_a.filter);
+			bool should_filter_account_l (subscription_a.topic->options->all_local_accounts || !filter.accounts.empty ());
+			if (is_state && !should_filter_conf_type_l)
+			{
+				if (subscription_a.topic->options->all_local_accounts)
 				{
-					if (itr->topic->options->all_local_accounts)
-					{
-						auto transaction_l (this->node.wallets.tx_begin_read ());
-						nano::account source_l{};
-						nano::account destination_l{};
-						auto decode_source_ok_l (!source_l.decode_account (state->account));
-						auto decode_destination_ok_l (!destination_l.decode_account (state->link_as_account));
-						(void)decode_source_ok_l;
-						(void)decode_destination_ok_l;
-						debug_assert (decode_source_ok_l && decode_destination_ok_l);
-						if (this->node.wallets.exists (transaction_l, source_l) || this->node.wallets.exists (transaction_l, destination_l))
-						{
-							should_filter_account_l = false;
-						}
-					}
-
-					if (std::find (itr->topic->options->accounts.begin (), itr->topic->options->accounts.end (), state->account) != itr->topic->options->accounts.end () || std::find (itr->topic->options->accounts.begin (), itr->topic->options->accounts.end (), state->link_as_account) != itr->topic->options->accounts.end ())
+					auto transaction_l (this->node.wallets.tx_begin_read ());
+					if (this->node.wallets.exists (transaction_l, account_a) || this->node.wallets.exists (transaction_l, destination_a))
 					{
 						should_filter_account_l = false;
 					}
 				}
 
-				return should_filter_conf_type_l || should_filter_account_l;
-			};
-			// Apply any filters
-			auto & options (itr->topic->options);
-			if (options)
-			{
-				if (!options->include_election_info)
+				if (!filter.accounts.empty () && filter.match_accounts (account_a, destination_a))
 				{
-					election_info = std::move (confirmation_a->election_info);
-					confirmation_a->election_info = nullptr;
-				}
-				if (!options->include_block)
-				{
-					block = confirmation_a->block;
-					confirmation_a->block.Reset ();
+					should_filter_account_l = false;
 				}
 			}
-			if (!options || !should_filter ())
-			{
-				auto fb (nano::ipc::flatbuffer_producer::make_buffer (*confirmation_a));
-
-				if (subscriber_l->get_active_encoding () == nano::ipc::payload_encoding::flatbuffers_json)
-				{
-					auto parser (subscriber_l->get_parser (node.config.ipc_config));
-
-					// Convert response to JSON
-					auto json (std::make_shared<std::string> ());
-					if (!flatbuffers::GenerateText (*parser, fb->GetBufferPointer (), json.get ()))
-					{
-						throw nano::error ("Couldn't serialize response to JSON");
-					}
 
-					subscriber_l->async_send_message (reinterpret_cast<uint8_t const *> (json->data ()), json->size (), [json] (nano::error const & err) {});
-				}
-				else
-				{
-					subscriber_l->async_send_message (fb->GetBufferPointer (), fb->GetSize (), [fb] (nano::error const & err) {});
-				}
+			return should_filter_conf_type_l || should_filter_account_l || !filter.match_amount (amount_a);
+		};
+		// Apply any filters
+		auto & options (subscription_a.topic->options);
+		if (!options || !should_filter ())
+		{
+			auto include_election_info (!options || options->include_election_info);
+			auto include_block (!options || options->include_block);
+			if (!include_election_info)
+			{
+				election_info = std::move (confirmation_a->election_info);
+				confirmation_a->election_info = nullptr;
 			}
+			if (!include_block)
+			{
+				block = confirmation_a->block;
+				confirmation_a->block.Reset ();
+			}
+
+			send_event (subscriber_a, *confirmation_a, payloads[(include_election_info ? 2 : 0) + (include_block ? 1 : 0)]);
 
 			// Restore full object, the next subscriber may request it
 			if (election_info)
@@ -211,15 +334,103 @@ void nano::ipc::broker::broadcast (std::shared_ptr<nanoapi::EventConfirmationT>
 			if (block.type != nanoapi::Block::Block_NONE)
 			{
 				confirmation_a->block = block;
+				block.Reset ();
 			}
+		}
+	});
+}
 
-			++itr;
+void nano::ipc::broker::broadcast (std::shared_ptr<nano::vote> const & vote_a, nano::vote_code code_a)
+{
+	std::optional<nanoapi::EventVoteT> event;
+	std::optional<nano::ipc::event_payloads> payloads;
+	std::optional<nano::uint128_t> weight;
+	auto subscribers = vote_subscribers.lock ();
+	for_each_subscriber (subscribers.get (), [this, &vote_a, code_a, &event, &payloads, &weight] (nano::ipc::subscriber & subscriber_a, auto const & subscription_a) {
+		auto const & options (subscription_a.topic->options);
+		auto const & filter (subscription_a.filter);
+		if (options && ((code_a == nano::vote_code::replay && !options->include_replays) || (code_a == nano::vote_code::indeterminate && !options->include_indeterminate)))
+		{
+			return;
 		}
-		else
+		if (!filter.match_accounts (vote_a->account, vote_a->account))
 		{
-			itr = confirmation_subscribers->erase (itr);
+			return;
 		}
-	}
+		if (filter.min_amount > 0)
+		{
+			if (!weight)
+			{
+				weight = node.ledger.weight (vote_a->account);
+			}
+			if (!filter.match_amount (*weight))
+			{
+				return;
+			}
+		}
+		// Built once for the first subscriber accepting the vote
+		if (!event)
+		{
+			event.emplace ();
+			switch (code_a)
+			{
+				case nano::vote_code::vote:
+					event->type = nanoapi::VoteType::VoteType_vote;
+					break;
+				case nano::vote_code::replay:
+					event->type = nanoapi::VoteType::VoteType_replay;
+					break;
+				default:
+					event->type = nanoapi::VoteType::VoteType_indeterminate;
+					break;
+			}
+			event->account = vote_a->account.to_account ();
+			event->signature = vote_a->signature.to_string ();
+			event->timestamp = vote_a->timestamp ();
+			event->duration = vote_a->duration ().count ();
+			for (auto const & hash : vote_a->hashes)
+			{
+				event->hashes.push_back (hash.to_string ());
+			}
+		}
+		send_event (subscriber_a, *event, payloads);
+	});
+}
+
+void nano::ipc::broker::broadcast_new_unconfirmed_block (nano::block const & block_a)
+{
+	auto account (block_a.account ().is_zero () ? block_a.sideband ().account : block_a.account ());
+	auto destination (block_a.type () == nano::block_type::state ? block_a.link ().as_account () : block_a.destination ());
+	std::optional<nanoapi::EventNewUnconfirmedBlockT> event;
+	nanoapi::BlockUnion block;
+	// Serialized once with and once without the block
+	std::array<std::optional<nano::ipc::event_payloads>, 2> payloads;
+	auto subscribers = new_unconfirmed_block_subscribers.lock ();
+	for_each_subscriber (subscribers.get (), [this, &block_a, &account, &destination, &event, &block, &payloads] (nano::ipc::subscriber & subscriber_a, auto const & subscription_a) {
+		if (!subscription_a.filter.match_accounts (account, destination))
+		{
+			return;
+		}
+		if (!event)
+		{
+			event.emplace ();
+			event->account = account.to_account ();
+			event->hash = block_a.hash ().to_string ();
+			event->block = nano::ipc::flatbuffers_builder::block_to_union (block_a, nano::amount (0), block_a.sideband ().details.is_send, block_a.sideband ().details.is_epoch);
+		}
+		auto include_block (!subscription_a.topic->options || subscription_a.topic->options->include_block);
+		if (!include_block)
+		{
+			block = event->block;
+			event->block.Reset ();
+		}
+		send_event (subscriber_a, *event, payloads[include_block ? 1 : 0]);
+		if (!include_block)
+		{
+			event->block = block;
+			block.Reset ();
+		}
+	});
 }
 
 std::size_t nano::ipc::broker::confirmation_subscriber_count () const
@@ -259,3 +470,37 @@ void nano::ipc::broker::subscribe (std::weak_ptr<nano::ipc::subscriber> const &
 	auto subscribers = service_stop_subscribers.lock ();
 	subscribe_or_unsubscribe (node.logger, subscribers.get (), subscriber_a, service_stop_a);
 }
+
+void nano::ipc::broker::subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicVoteT> const & vote_a)
+{
+	nano::ipc::event_filter filter;
+	if (vote_a->options && !vote_a->unsubscribe)
+	{
+		filter = nano::ipc::event_filter (vote_a->options->representatives, vote_a->options->min_weight);
+	}
+	auto subscribers = vote_subscribers.lock ();
+	subscribe_or_unsubscribe (node.logger, subscribers.get (), subscriber_a, vote_a, filter);
+}
+
+void nano::ipc::broker::subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicStartedElectionT> const & started_election_a)
+{
+	auto subscribers = started_election_subscribers.lock ();
+	subscribe_or_unsubscribe (node.logger, subscribers.get (), subscriber_a, started_election_a);
+}
+
+void nano::ipc::broker::subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicStoppedElectionT> const & stopped_election_a)
+{
+	auto subscribers = stopped_election_subscribers.lock ();
+	subscribe_or_unsubscribe (node.logger, subscribers.get (), subscriber_a, stopped_election_a);
+}
+
+void nano::ipc::broker::subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicNewUnconfirmedBlockT> const & new_unconfirmed_block_a)
+{
+	nano::ipc::event_filter filter;
+	if (new_unconfirmed_block_a->options && !new_unconfirmed_block_a->unsubscribe)
+	{
+		filter = nano::ipc::event_filter (new_unconfirmed_block_a->options->accounts, {});
+	}
+	auto subscribers = new_unconfirmed_block_subscribers.lock ();
+	subscribe_or_unsubscribe (node.logger, subscribers.get (), subscriber_a, new_unconfirmed_block_a, filter);
+}
@@ -3,9 +3,13 @@
 #include <nano/ipc_flatbuffers_lib/generated/flatbuffers/nanoapi_generated.h>
 #include <nano/lib/ipc.hpp>
 #include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
 #include <nano/node/ipc/ipc_broker.hpp>
 #include <nano/node/node_rpc_config.hpp>
 
+#include <optional>
+#include <unordered_set>
+
 namespace flatbuffers
 {
 class Parser;
@@ -14,9 +18,40 @@ namespace nano
 {
 class node;
 class error;
+class block;
+class vote;
+enum class vote_code;
 namespace ipc
 {
 	class ipc_config;
+
+	/** A serialized event. The owner keeps the data alive until the event is written or dropped. */
+	class event_payload final
+	{
+	public:
+		std::shared_ptr<void> owner;
+		uint8_t const * data{ nullptr };
+		std::size_t size{ 0 };
+	};
+
+	class subscriber;
+
+	/**
+	 * The serialized forms of one event. Each encoding is produced at most once and shared by every session
+	 * receiving the event, so broadcasting does not serialize the event again for each subscriber.
+	 */
+	class event_payloads final
+	{
+	public:
+		explicit event_payloads (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a);
+		/** Returns the event in the encoding of \p subscriber_a, or an empty optional if it cannot be converted to JSON */
+		std::optional<nano::ipc::event_payload> get (nano::ipc::subscriber & subscriber_a, nano::ipc::ipc_config const & ipc_config_a);
+
+	private:
+		std::shared_ptr<flatbuffers::FlatBufferBuilder> flatbuffer;
+		std::shared_ptr<std::string> json;
+	};
+
 	/**
 	 * A subscriber represents a live session, and is weakly referenced nano::ipc::subscription whenever a subscription is made.
 	 * This construction helps making the session implementation opaque to clients.
@@ -41,14 +76,39 @@ namespace ipc
 		virtual void set_service_name (std::string const & service_name_a) = 0;
 		/** Returns the session's active payload encoding */
 		virtual nano::ipc::payload_encoding get_active_encoding () const = 0;
+		/**
+		 * Queue an event for the client without waiting for the write. Events are held in a bounded queue per session,
+		 * and the oldest queued event is dropped when the client does not keep up.
+		 */
+		virtual void async_send_event (nano::ipc::event_payload const & event_a) = 0;
 
 		/** Get flatbuffer parser instance for this subscriber; create it if necessary */
 		std::shared_ptr<flatbuffers::Parser> get_parser (nano::ipc::ipc_config const & ipc_config_a);
 
 	private:
+		/** Broadcasts and the session both convert events to JSON */
+		nano::mutex parser_mutex;
 		std::shared_ptr<flatbuffers::Parser> parser;
 	};
 
+	/**
+	 * Account and amount filters of a subscription. These are decoded once when subscribing, so events
+	 * are matched against native values rather than strings.
+	 */
+	class event_filter final
+	{
+	public:
+		event_filter () = default;
+		/** Throws nano::error if an account or the amount cannot be decoded */
+		event_filter (std::vector<std::string> const & accounts_a, std::string const & min_amount_a);
+		/** True if no accounts are filtered on, or if either account is in the set */
+		bool match_accounts (nano::account const & account_a, nano::account const & other_a) const;
+		bool match_amount (nano::uint128_t const & amount_a) const;
+
+		std::unordered_set<nano::account> accounts;
+		nano::uint128_t min_amount{ 0 };
+	};
+
 	/**
 	 * Subscriptions are added to the broker whenever a topic message is sent from a client.
 	 * The subscription is removed when the client unsubscribes, or lazily removed after the
@@ -58,13 +118,14 @@ namespace ipc
 	class subscription final
 	{
 	public:
-		subscription (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<TopicType> const & topic_a) :
-			subscriber (subscriber_a), topic (topic_a)
+		subscription (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<TopicType> const & topic_a, nano::ipc::event_filter const & filter_a = {}) :
+			subscriber (subscriber_a), topic (topic_a), filter (filter_a)
 		{
 		}
 
 		std::weak_ptr<nano::ipc::subscriber> subscriber;
 		std::shared_ptr<TopicType> topic;
+		nano::ipc::event_filter filter;
 	};
 
 	/**
@@ -81,6 +142,14 @@ namespace ipc
 		void subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicConfirmationT> const & confirmation_a);
 		/** Subscribe to EventServiceStop notifications for \p subscriber_a. The subscriber must first have called ServiceRegister. */
 		void subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicServiceStopT> const & service_stop_a);
+		/** Subscribe to processed votes */
+		void subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicVoteT> const & vote_a);
+		/** Subscribe to elections being started */
+		void subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicStartedElectionT> const & started_election_a);
+		/** Subscribe to elections being stopped */
+		void subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicStoppedElectionT> const & stopped_election_a);
+		/** Subscribe to blocks added to the ledger */
+		void subscribe (std::weak_ptr<nano::ipc::subscriber> const & subscriber_a, std::shared_ptr<nanoapi::TopicNewUnconfirmedBlockT> const & new_unconfirmed_block_a);
 
 		/** Returns the number of confirmation subscribers */
 		std::size_t confirmation_subscriber_count () const;
@@ -90,12 +159,21 @@ namespace ipc
 		void service_stop (std::string const & service_name_a);
 
 	private:
-		/** Broadcast block confirmations */
-		void broadcast (std::shared_ptr<nanoapi::EventConfirmationT> const & confirmation_a);
+		/** Broadcast block confirmations. The accounts and amount are used for filtering. */
+		void broadcast (std::shared_ptr<nanoapi::EventConfirmationT> const & confirmation_a, nano::account const & account_a, nano::account const & destination_a, nano::uint128_t const & amount_a);
+		void broadcast (std::shared_ptr<nano::vote> const & vote_a, nano::vote_code code_a);
+		void broadcast_new_unconfirmed_block (nano::block const & block_a);
+		/** Queue the event for the subscriber. \p event_a is only serialized if \p payloads_a is empty, later subscribers share the payloads. */
+		template <typename EventType>
+		void send_event (nano::ipc::subscriber & subscriber_a, EventType & event_a, std::optional<nano::ipc::event_payloads> & payloads_a);
 
 		nano::node & node;
 		mutable nano::locked<std::vector<subscription<nanoapi::TopicConfirmationT>>> confirmation_subscribers;
 		mutable nano::locked<std::vector<subscription<nanoapi::TopicServiceStopT>>> service_stop_subscribers;
+		mutable nano::locked<std::vector<subscription<nanoapi::TopicVoteT>>> vote_subscribers;
+		mutable nano::locked<std::vector<subscription<nanoapi::TopicStartedElectionT>>> started_election_subscribers;
+		mutable nano::locked<std::vector<subscription<nanoapi::TopicStoppedElectionT>>> stopped_election_subscribers;
+		mutable nano::locked<std::vector<subscription<nanoapi::TopicNewUnconfirmedBlockT>>> new_unconfirmed_block_subscribers;
 	};
 }
 }
@@ -29,6 +29,7 @@ nano::error nano::ipc::ipc_config::serialize_toml (nano::tomlconfig & toml) cons
 	nano::tomlconfig flatbuffers_l;
 	flatbuffers_l.put ("skip_unexpected_fields_in_json", flatbuffers.skip_unexpected_fields_in_json, "Allow client to send unknown fields in json messages. These will be ignored.\ntype:bool");
 	flatbuffers_l.put ("verify_buffers", flatbuffers.verify_buffers, "Verify that the buffer is valid before parsing. This is recommended when receiving data from untrusted sources.\ntype:bool");
+	flatbuffers_l.put ("event_queue_size", flatbuffers.event_queue_size, "Maximum number of events queued per session for subscribers. When a client does not keep up, the oldest queued events are dropped.\ntype:uint64");
 	toml.put_child ("flatbuffers", flatbuffers_l);
 
 	return toml.get_error ();
@@ -61,6 +62,7 @@ nano::error nano::ipc::ipc_config::deserialize_toml (nano::tomlconfig & toml)
 	{
 		flatbuffers_l->get<bool> ("skip_unexpected_fields_in_json", flatbuffers.skip_unexpected_fields_in_json);
 		flatbuffers_l->get<bool> ("verify_buffers", flatbuffers.verify_buffers);
+		flatbuffers_l->get<std::size_t> ("event_queue_size", flatbuffers.event_queue_size);
 	}
 
 	return toml.get_error ();
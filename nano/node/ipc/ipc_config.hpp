@@ -29,6 +29,7 @@ namespace ipc
 	public:
 		bool skip_unexpected_fields_in_json{ true };
 		bool verify_buffers{ true };
+		std::size_t event_queue_size{ 1024 };
 	};
 
 	/** Domain socket specific transport config */
@@ -2,6 +2,7 @@
 #include <nano/boost/asio/local/stream_protocol.hpp>
 #include <nano/boost/asio/read.hpp>
 #include <nano/boost/asio/strand.hpp>
+#include <nano/ipc_flatbuffers_lib/flatbuffer_producer.hpp>
 #include <nano/lib/config.hpp>
 #include <nano/lib/ipc.hpp>
 #include <nano/lib/locks.hpp>
@@ -17,6 +18,7 @@
 #include <boost/endian/conversion.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 
@@ -73,13 +75,15 @@ public:
 						boost::asio::buffer (data_a, length_a)
 					};
 
-					session_l->queued_write (buffers, [broadcast_completion_handler_a, big_endian_length] (boost::system::error_code const & ec_a, std::size_t size_a) {
+					session_l->queued_write (
+					buffers, [broadcast_completion_handler_a, big_endian_length] (boost::system::error_code const & ec_a, std::size_t size_a) {
 						if (broadcast_completion_handler_a)
 						{
 							nano::error error_l (ec_a);
 							broadcast_completion_handler_a (error_l);
 						}
-					});
+					},
+					true);
 				}
 			}
 
@@ -121,6 +125,14 @@ public:
 				return encoding;
 			}
 
+			void async_send_event (nano::ipc::event_payload const & event_a) override
+			{
+				if (auto session_l = session_m.lock ())
+				{
+					session_l->queue_event (event_a);
+				}
+			}
+
 		private:
 			std::weak_ptr<session> session_m;
 		};
@@ -135,15 +147,18 @@ public:
 		return subscriber;
 	}
 
-	/** Write a fixed array of buffers through the queue. Once the last item is completed, the callback is invoked */
+	/**
+	 * Write a fixed array of buffers through the queue. Once the last item is completed, the callback is invoked.
+	 * Only broadcasts are \p droppable_a, they are discarded along with their callback while the queue is full. Responses are always written.
+	 */
 	template <std::size_t N>
-	void queued_write (boost::array<boost::asio::const_buffer, N> & buffers, std::function<void (boost::system::error_code const &, std::size_t)> callback_a)
+	void queued_write (boost::array<boost::asio::const_buffer, N> & buffers, std::function<void (boost::system::error_code const &, std::size_t)> callback_a, bool const droppable_a = false)
 	{
 		auto this_l (this->shared_from_this ());
-		boost::asio::post (strand, boost::asio::bind_executor (strand, [buffers, callback_a, this_l] () {
+		boost::asio::post (strand, boost::asio::bind_executor (strand, [buffers, callback_a, droppable_a, this_l] () {
 			bool write_in_progress = !this_l->send_queue.empty ();
 			auto queue_size = this_l->send_queue.size ();
-			if (queue_size < this_l->queue_size_max)
+			if (!droppable_a || queue_size < this_l->queue_size_max)
 			{
 				for (std::size_t i = 0; i < N - 1; i++)
 				{
@@ -158,6 +173,81 @@ public:
 		}));
 	}
 
+	/**
+	 * Queue an event for writing. Only one event at a time is passed on to the send queue, so that events waiting
+	 * for a slow client stay in the bounded event queue where the oldest can be dropped. Callers are never blocked.
+	 */
+	void queue_event (nano::ipc::event_payload const & event_a)
+	{
+		auto this_l (this->shared_from_this ());
+		boost::asio::post (strand, boost::asio::bind_executor (strand, [event_a, this_l] () {
+			if (this_l->event_queue.size () >= std::max<std::size_t> (this_l->node.config.ipc_config.flatbuffers.event_queue_size, 1))
+			{
+				this_l->event_queue.pop_front ();
+				++this_l->events_dropped;
+				this_l->node.stats.inc (nano::stat::type::ipc, nano::stat::detail::event_dropped);
+			}
+			this_l->event_queue.push_back (event_a);
+			if (!this_l->event_write_in_progress)
+			{
+				this_l->write_next_event ();
+			}
+		}));
+	}
+
+	/** Must be called through the strand */
+	void write_next_event ()
+	{
+		auto event (event_queue.front ());
+		event_queue.pop_front ();
+		event_write_in_progress = true;
+		// Events are shared by all subscribers, so the dropped count of this session is sent as a notice of its own
+		if (events_dropped != events_dropped_reported)
+		{
+			events_dropped_reported = events_dropped;
+			nanoapi::EventDroppedT dropped;
+			dropped.count = events_dropped;
+			nano::ipc::event_payloads payloads (nano::ipc::flatbuffer_producer::make_buffer (dropped));
+			if (auto notice = payloads.get (*get_subscriber (), node.config.ipc_config))
+			{
+				append_event (*notice, nullptr);
+			}
+		}
+		std::weak_ptr<session> this_w (this->shared_from_this ());
+		append_event (event, [this_w] (boost::system::error_code const & ec_a, std::size_t size_a) {
+			// Write completions are invoked through the strand
+			if (auto this_l = this_w.lock ())
+			{
+				this_l->event_write_in_progress = false;
+				if (!ec_a && !this_l->event_queue.empty ())
+				{
+					this_l->write_next_event ();
+				}
+			}
+		});
+	}
+
+	/**
+	 * Append a length prefixed event to the send queue, keeping the payload alive until it is written. Must be called through the strand.
+	 * Events are appended directly rather than through queued_write, as this already runs through the strand.
+	 */
+	void append_event (nano::ipc::event_payload const & event_a, std::function<void (boost::system::error_code const &, std::size_t)> completion_a)
+	{
+		auto big_endian_length = std::make_shared<uint32_t> (boost::endian::native_to_big (static_cast<uint32_t> (event_a.size)));
+		bool write_in_progress = !send_queue.empty ();
+		send_queue.emplace_back (queue_item{ boost::asio::buffer (big_endian_length.get (), sizeof (std::uint32_t)), nullptr });
+		send_queue.emplace_back (queue_item{ boost::asio::buffer (event_a.data, event_a.size), [event_a, big_endian_length, completion_a] (boost::system::error_code const & ec_a, std::size_t size_a) {
+												if (completion_a)
+												{
+													completion_a (ec_a, size_a);
+												}
+											} });
+		if (!write_in_progress)
+		{
+			write_queued_messages ();
+		}
+	}
+
 	/**
 	 * Write to underlying socket. Writes goes through a queue protected by the strand. Thus, this function
 	 * can be called concurrently with other writes.
@@ -169,11 +259,7 @@ public:
 		auto this_l (this->shared_from_this ());
 		boost::asio::post (strand, boost::asio::bind_executor (strand, [buffer_a, callback_a, this_l] () {
 			bool write_in_progress = !this_l->send_queue.empty ();
-			auto queue_size = this_l->send_queue.size ();
-			if (queue_size < this_l->queue_size_max)
-			{
-				this_l->send_queue.emplace_back (queue_item{ buffer_a, callback_a });
-			}
+			this_l->send_queue.emplace_back (queue_item{ buffer_a, callback_a });
 			if (!write_in_progress)
 			{
 				this_l->write_queued_messages ();
@@ -185,13 +271,13 @@ public:
 	{
 		std::weak_ptr<session> this_w (this->shared_from_this ());
 		auto msg (send_queue.front ());
-		timer_start (std::chrono::seconds (config_transport.io_timeout));
+		timer_start (timer_type::write, std::chrono::seconds (config_transport.io_timeout));
 		nano::unsafe_async_write (socket, msg.buffer,
 		boost::asio::bind_executor (strand,
 		[msg, this_w] (boost::system::error_code ec, std::size_t size_a) {
 			if (auto this_l = this_w.lock ())
 			{
-				this_l->timer_cancel ();
+				this_l->timer_cancel (timer_type::write);
 
 				if (msg.callback)
 				{
@@ -223,14 +309,14 @@ public:
 	 */
 	void async_read_exactly (void * buff_a, std::size_t size_a, std::chrono::seconds timeout_a, std::function<void ()> const & callback_a)
 	{
-		timer_start (timeout_a);
+		timer_start (timer_type::read, timeout_a);
 		auto this_l (this->shared_from_this ());
 		boost::asio::async_read (socket,
 		boost::asio::buffer (buff_a, size_a),
 		boost::asio::transfer_exactly (size_a),
 		boost::asio::bind_executor (strand,
 		[this_l, callback_a] (boost::system::error_code const & ec, std::size_t bytes_transferred_a) {
-			this_l->timer_cancel ();
+			this_l->timer_cancel (timer_type::read);
 			if (ec == boost::asio::error::broken_pipe || ec == boost::asio::error::connection_aborted || ec == boost::asio::error::connection_reset || ec == boost::asio::error::connection_refused)
 			{
 				if (this_l->node.config.logging.log_ipc ())
@@ -264,9 +350,9 @@ public:
 				this_l->node.logger.always_log (boost::str (boost::format ("IPC/RPC request %1% completed in: %2% %3%") % request_id_l % this_l->session_timer.stop ().count () % this_l->session_timer.unit ()));
 			}
 
-			this_l->timer_start (std::chrono::seconds (this_l->config_transport.io_timeout));
+			this_l->timer_start (timer_type::write, std::chrono::seconds (this_l->config_transport.io_timeout));
 			this_l->queued_write (boost::asio::buffer (buffer->data (), buffer->size ()), [this_l, buffer] (boost::system::error_code const & error_a, std::size_t size_a) {
-				this_l->timer_cancel ();
+				this_l->timer_cancel (timer_type::write);
 				if (!error_a)
 				{
 					this_l->read_next_request ();
@@ -294,6 +380,65 @@ public:
 		handler->process_request (allow_unsafe && config_transport.allow_unsafe);
 	}
 
+	/**
+	 * Handler for payload_encoding::flatbuffers_multiplexed. The next request is read while this one is processed,
+	 * responses are written as they complete. Called through the strand.
+	 * Once multiplexed_in_flight_max requests await their response, reading pauses until one of the responses is written.
+	 */
+	void handle_multiplexed_request ()
+	{
+		if (!flatbuffers_handler)
+		{
+			flatbuffers_handler = std::make_shared<nano::ipc::flatbuffers_handler> (node, server, get_subscriber (), node.config.ipc_config);
+		}
+		// The payload is moved out as the session buffer receives the next request
+		auto request (std::make_shared<std::vector<uint8_t>> (std::move (buffer)));
+		auto handler (flatbuffers_handler);
+		if (++multiplexed_in_flight < multiplexed_in_flight_max)
+		{
+			read_next_request ();
+		}
+		else
+		{
+			read_paused = true;
+		}
+
+		// Handlers read the ledger, so they run on the node workers rather than the IO threads serving the sockets
+		auto this_l (this->shared_from_this ());
+		node.workers.push_task ([this_l, request, handler] () {
+			nano::timer<std::chrono::microseconds> request_timer (nano::timer_state::started);
+			handler->process (request->data (), request->size (), [this_l, request_timer] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb) mutable {
+				if (this_l->node.config.logging.log_ipc ())
+				{
+					this_l->node.logger.always_log (boost::str (boost::format ("IPC/Flatbuffer request completed in: %1% %2%") % request_timer.stop ().count () % request_timer.unit ()));
+				}
+
+				auto big_endian_length = std::make_shared<uint32_t> (boost::endian::native_to_big (static_cast<uint32_t> (fbb->GetSize ())));
+				boost::array<boost::asio::const_buffer, 2> buffers = {
+					boost::asio::buffer (big_endian_length.get (), sizeof (std::uint32_t)),
+					boost::asio::buffer (fbb->GetBufferPointer (), fbb->GetSize ())
+				};
+
+				this_l->queued_write (buffers, [this_l, fbb, big_endian_length] (boost::system::error_code const & error_a, std::size_t size_a) {
+					// Write completions are invoked through the strand
+					--this_l->multiplexed_in_flight;
+					if (!error_a)
+					{
+						if (this_l->read_paused)
+						{
+							this_l->read_paused = false;
+							this_l->read_next_request ();
+						}
+					}
+					else if (this_l->node.config.logging.log_ipc ())
+					{
+						this_l->node.logger.always_log ("IPC: Write failed: ", error_a.message ());
+					}
+				});
+			});
+		});
+	}
+
 	/** Async request reader */
 	void read_next_request ()
 	{
@@ -395,6 +540,18 @@ public:
 					});
 				});
 			}
+			else if (encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::flatbuffers_multiplexed))
+			{
+				// Length of payload
+				this_l->async_read_exactly (&this_l->buffer_size, sizeof (this_l->buffer_size), [this_l] () {
+					boost::endian::big_to_native_inplace (this_l->buffer_size);
+					this_l->buffer.resize (this_l->buffer_size);
+					// Flatbuffers payload, the envelope's correlation id identifies the response
+					this_l->async_read_exactly (this_l->buffer.data (), this_l->buffer_size, [this_l] () {
+						this_l->handle_multiplexed_request ();
+					});
+				});
+			}
 			else if (this_l->node.config.logging.log_ipc ())
 			{
 				this_l->node.logger.always_log ("IPC: Unsupported payload encoding");
@@ -419,6 +576,7 @@ private:
 		std::function<void (boost::system::error_code const &, std::size_t)> callback;
 	};
 	std::size_t const queue_size_max = 64 * 1024;
+	std::size_t const multiplexed_in_flight_max = 64;
 
 	nano::ipc::ipc_server & server;
 	nano::node & node;
@@ -450,6 +608,20 @@ private:
 	/** The send queue is protected by always being accessed through the strand */
 	std::deque<queue_item> send_queue;
 
+	/** Events waiting for the client, bounded by the configured event_queue_size. Accessed through the strand. */
+	std::deque<nano::ipc::event_payload> event_queue;
+
+	/** True while an event is in the send queue. Accessed through the strand. */
+	bool event_write_in_progress{ false };
+
+	/** Multiplexed requests read but not yet answered, and whether reading waits for one of them. Accessed through the strand. */
+	std::size_t multiplexed_in_flight{ 0 };
+	bool read_paused{ false };
+
+	/** Number of events dropped because the client did not keep up, and the count last sent to the client. Accessed through the strand. */
+	uint64_t events_dropped{ 0 };
+	uint64_t events_dropped_reported{ 0 };
+
 	/** A socket of the given asio type */
 	SOCKET_TYPE socket;
 
@@ -1,5 +1,6 @@
 #include <nano/lib/config.hpp>
 #include <nano/lib/json_error_response.hpp>
+#include <nano/lib/json_writer.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/node/bootstrap/bootstrap_lazy.hpp>
 #include <nano/node/bootstrap_ascending/service.hpp>
@@ -15,6 +16,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <unordered_set>
 #include <vector>
 
 namespace
@@ -54,6 +56,60 @@ std::function<void ()> nano::json_handler::create_worker_task (std::function<voi
 	};
 }
 
+void nano::json_handler::parallel_for (std::size_t count_a, std::function<void (nano::transaction &, std::size_t, std::size_t)> const & action_a)
+{
+	class partitions_state final
+	{
+	public:
+		std::atomic<std::size_t> next{ 0 };
+		nano::mutex mutex;
+		nano::condition_variable condition;
+		std::size_t completed{ 0 };
+		std::exception_ptr exception;
+	};
+
+	if (count_a == 0)
+	{
+		return;
+	}
+	auto const parallelism (std::max<std::size_t> (1, std::min<std::size_t> (node_rpc_config.bulk_parallelism, node.workers.get_num_threads () + 1)));
+	auto const partitions (std::max<std::size_t> (1, std::min (parallelism, count_a / bulk_partition_min)));
+	auto const partition_size ((count_a + partitions - 1) / partitions);
+	auto state (std::make_shared<partitions_state> ());
+	// Tasks starting after every partition was taken return without touching the handler or the action
+	auto run = [this, state, partitions, partition_size, count_a, &action_a] () {
+		for (auto index (state->next++); index < partitions; index = state->next++)
+		{
+			try
+			{
+				auto transaction (node.store.tx_begin_read ());
+				action_a (transaction, index * partition_size, std::min (count_a, (index + 1) * partition_size));
+			}
+			catch (...)
+			{
+				nano::lock_guard<nano::mutex> guard{ state->mutex };
+				state->exception = std::current_exception ();
+			}
+			{
+				nano::lock_guard<nano::mutex> guard{ state->mutex };
+				++state->completed;
+			}
+			state->condition.notify_all ();
+		}
+	};
+	for (std::size_t i (1); i < partitions; ++i)
+	{
+		node.workers.push_task (run);
+	}
+	run ();
+	nano::unique_lock<nano::mutex> lock{ state->mutex };
+	state->condition.wait (lock, [&state, partitions] () { return state->completed == partitions; });
+	if (state->exception)
+	{
+		std::rethrow_exception (state->exception);
+	}
+}
+
 void nano::json_handler::process_request (bool unsafe_a)
 {
 	try
@@ -179,6 +235,20 @@ void nano::json_handler::response_errors ()
 	}
 }
 
+void nano::json_handler::response_json (nano::json_writer & writer_a)
+{
+	if (ec)
+	{
+		response_errors ();
+	}
+	else
+	{
+		// Members put into response_l while streaming, such as deprecation notices, lead the document as they would have with ptree
+		writer_a.prepend (response_l);
+		response (writer_a.finish ());
+	}
+}
+
 std::shared_ptr<nano::wallet> nano::json_handler::wallet_impl ()
 {
 	if (!ec)
@@ -897,57 +967,111 @@ void nano::json_handler::account_weight ()
 
 void nano::json_handler::accounts_balances ()
 {
-	boost::property_tree::ptree balances;
-	boost::property_tree::ptree errors;
-	auto transaction = node.store.tx_begin_read ();
+	bool const include_only_confirmed = request.get<bool> ("include_only_confirmed", true);
+	// Accounts are decoded on this thread as account_impl reports through ec and response_l
+	std::vector<std::pair<std::string, nano::account>> accounts;
+	std::vector<std::error_code> decode_errors;
 	for (auto & account_from_request : request.get_child ("accounts"))
 	{
-		boost::property_tree::ptree entry;
 		auto account = account_impl (account_from_request.second.data ());
-		if (!ec)
+		accounts.emplace_back (account_from_request.second.data (), account);
+		decode_errors.push_back (ec);
+		ec = {};
+	}
+	std::vector<std::pair<nano::uint128_t, nano::uint128_t>> results (accounts.size ());
+	parallel_for (accounts.size (), [this, &accounts, &decode_errors, &results, include_only_confirmed] (nano::transaction & transaction_a, std::size_t begin_a, std::size_t end_a) {
+		for (auto i (begin_a); i < end_a; ++i)
+		{
+			if (!decode_errors[i])
+			{
+				results[i].first = node.ledger.account_balance (transaction_a, accounts[i].second, include_only_confirmed);
+				results[i].second = node.ledger.account_receivable (transaction_a, accounts[i].second, include_only_confirmed);
+			}
+		}
+	});
+
+	nano::json_writer writer;
+	writer.begin_object ();
+	std::unordered_set<std::string> balances;
+	boost::property_tree::ptree errors;
+	for (std::size_t i (0); i < accounts.size (); ++i)
+	{
+		auto const & account_text (accounts[i].first);
+		if (!decode_errors[i])
 		{
-			bool const include_only_confirmed = request.get<bool> ("include_only_confirmed", true);
-			auto balance = node.balance_pending (account, include_only_confirmed);
-			entry.put ("balance", balance.first.convert_to<std::string> ());
-			entry.put ("pending", balance.second.convert_to<std::string> ());
-			entry.put ("receivable", balance.second.convert_to<std::string> ());
-			balances.put_child (account_from_request.second.data (), entry);
+			// Repeated accounts are reported once, as put_child would replace the earlier entry with an identical one
+			if (!balances.insert (account_text).second)
+			{
+				continue;
+			}
+			if (balances.size () == 1)
+			{
+				writer.key ("balances").begin_object ();
+			}
+			writer.key (account_text).begin_object ();
+			writer.put ("balance", results[i].first.convert_to<std::string> ());
+			writer.put ("pending", results[i].second.convert_to<std::string> ());
+			writer.put ("receivable", results[i].second.convert_to<std::string> ());
+			writer.end_object ();
 			continue;
 		}
-		debug_assert (ec);
-		errors.put (account_from_request.second.data (), ec.message ());
-		ec = {};
+		errors.put (account_text, decode_errors[i].message ());
 	}
 	if (!balances.empty ())
 	{
-		response_l.add_child ("balances", balances);
+		writer.end_object ();
 	}
 	if (!errors.empty ())
 	{
-		response_l.add_child ("errors", errors);
+		writer.key ("errors").value (errors);
 	}
-	response_errors ();
+	writer.end_object ();
+	if (balances.empty () && errors.empty ())
+	{
+		ec = nano::error_rpc::empty_response;
+	}
+	response_json (writer);
 }
 
 void nano::json_handler::accounts_representatives ()
 {
-	boost::property_tree::ptree representatives;
-	boost::property_tree::ptree errors;
-	auto transaction = node.store.tx_begin_read ();
+	std::vector<std::pair<std::string, nano::account>> accounts;
+	std::vector<std::error_code> decode_errors;
 	for (auto & account_from_request : request.get_child ("accounts"))
 	{
 		auto account = account_impl (account_from_request.second.data ());
+		accounts.emplace_back (account_from_request.second.data (), account);
+		decode_errors.push_back (ec);
+		ec = {};
+	}
+	std::vector<std::optional<nano::account_info>> infos (accounts.size ());
+	parallel_for (accounts.size (), [this, &accounts, &decode_errors, &infos] (nano::transaction & transaction_a, std::size_t begin_a, std::size_t end_a) {
+		for (auto i (begin_a); i < end_a; ++i)
+		{
+			if (!decode_errors[i])
+			{
+				infos[i] = node.ledger.account_info (transaction_a, accounts[i].second);
+			}
+		}
+	});
+
+	boost::property_tree::ptree representatives;
+	boost::property_tree::ptree errors;
+	for (std::size_t i (0); i < accounts.size (); ++i)
+	{
+		ec = decode_errors[i];
 		if (!ec)
 		{
-			auto info = account_info_impl (transaction, account);
-			if (!ec)
+			if (infos[i])
 			{
-				representatives.put (account_from_request.second.data (), info.representative.to_account ());
+				representatives.put (accounts[i].first, infos[i]->representative.to_account ());
 				continue;
 			}
+			ec = nano::error_common::account_not_found;
+			node.bootstrap_initiator.bootstrap_lazy (accounts[i].second, false, accounts[i].second.to_account ());
 		}
 		debug_assert (ec);
-		errors.put (account_from_request.second.data (), ec.message ());
+		errors.put (accounts[i].first, ec.message ());
 		ec = {};
 	}
 	if (!representatives.empty ())
@@ -988,18 +1112,36 @@ void nano::json_handler::accounts_create ()
 
 void nano::json_handler::accounts_frontiers ()
 {
-	boost::property_tree::ptree frontiers;
-	boost::property_tree::ptree errors;
-	auto transaction = node.store.tx_begin_read ();
+	std::vector<std::pair<std::string, nano::account>> accounts;
+	std::vector<std::error_code> decode_errors;
 	for (auto & account_from_request : request.get_child ("accounts"))
 	{
 		auto account = account_impl (account_from_request.second.data ());
+		accounts.emplace_back (account_from_request.second.data (), account);
+		decode_errors.push_back (ec);
+		ec = {};
+	}
+	std::vector<nano::block_hash> latest (accounts.size ());
+	parallel_for (accounts.size (), [this, &accounts, &decode_errors, &latest] (nano::transaction & transaction_a, std::size_t begin_a, std::size_t end_a) {
+		for (auto i (begin_a); i < end_a; ++i)
+		{
+			if (!decode_errors[i])
+			{
+				latest[i] = node.ledger.latest (transaction_a, accounts[i].second);
+			}
+		}
+	});
+
+	boost::property_tree::ptree frontiers;
+	boost::property_tree::ptree errors;
+	for (std::size_t i (0); i < accounts.size (); ++i)
+	{
+		ec = decode_errors[i];
 		if (!ec)
 		{
-			auto latest = node.ledger.latest (transaction, account);
-			if (!latest.is_zero ())
+			if (!latest[i].is_zero ())
 			{
-				frontiers.put (account.to_account (), latest.to_string ());
+				frontiers.put (accounts[i].second.to_account (), latest[i].to_string ());
 				continue;
 			}
 			else
@@ -1008,7 +1150,7 @@ void nano::json_handler::accounts_frontiers ()
 			}
 		}
 		debug_assert (ec);
-		errors.put (account_from_request.second.data (), ec.message ());
+		errors.put (accounts[i].first, ec.message ());
 		ec = {};
 	}
 	if (!frontiers.empty ())
@@ -1037,18 +1179,33 @@ void nano::json_handler::accounts_receivable ()
 	bool const include_only_confirmed = request.get<bool> ("include_only_confirmed", true);
 	bool const sorting = request.get<bool> ("sorting", false);
 	auto simple (threshold.is_zero () && !source && !sorting); // if simple, response is a list of hashes for each account
-	boost::property_tree::ptree pending;
-	auto transaction (node.store.tx_begin_read ());
-	for (auto & accounts : request.get_child ("accounts"))
+	std::vector<nano::account> accounts;
+	for (auto & accounts_l : request.get_child ("accounts"))
 	{
-		auto account (account_impl (accounts.second.data ()));
-		if (!ec)
+		auto account (account_impl (accounts_l.second.data ()));
+		if (ec)
 		{
-			boost::property_tree::ptree peers_l;
-			for (auto i (node.store.pending.begin (transaction, nano::pending_key (account, 0))), n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && peers_l.size () < count; ++i)
+			break;
+		}
+		accounts.push_back (account);
+	}
+	std::vector<boost::property_tree::ptree> results (ec ? 0 : accounts.size ());
+	parallel_for (results.size (), [this, &accounts, &results, &threshold, count, simple, source, sorting, include_active, include_only_confirmed] (nano::transaction & transaction, std::size_t begin_a, std::size_t end_a) {
+		for (auto index (begin_a); index < end_a; ++index)
+		{
+			auto const & account (accounts[index]);
+			// Skip accounts which cannot have a receivable entry above the threshold without iterating their pending entries
+			if (!node.ledger.cache.receivable.may_have (account, threshold.number ()))
+			{
+				continue;
+			}
+			auto & peers_l (results[index]);
+			for (auto i (node.store.pending.begin (transaction, account)), n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && peers_l.size () < count; ++i)
 			{
 				nano::pending_key const & key (i->first);
-				if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
+				nano::pending_info const & info (i->second);
+				// Compare the amount first as it is cheaper than checking confirmation
+				if ((simple || info.amount.number () >= threshold.number ()) && block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
 				{
 					if (simple)
 					{
@@ -1056,23 +1213,16 @@ void nano::json_handler::accounts_receivable ()
 						entry.put ("", key.hash.to_string ());
 						peers_l.push_back (std::make_pair ("", entry));
 					}
+					else if (source)
+					{
+						boost::property_tree::ptree pending_tree;
+						pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+						pending_tree.put ("source", info.source.to_account ());
+						peers_l.add_child (key.hash.to_string (), pending_tree);
+					}
 					else
 					{
-						nano::pending_info const & info (i->second);
-						if (info.amount.number () >= threshold.number ())
-						{
-							if (source)
-							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								pending_tree.put ("source", info.source.to_account ());
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-							}
-						}
+						peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 					}
 				}
 			}
@@ -1091,10 +1241,14 @@ void nano::json_handler::accounts_receivable ()
 					});
 				}
 			}
-			if (!peers_l.empty ())
-			{
-				pending.add_child (account.to_account (), peers_l);
-			}
+		}
+	});
+	boost::property_tree::ptree pending;
+	for (std::size_t i (0); i < results.size (); ++i)
+	{
+		if (!results[i].empty ())
+		{
+			pending.add_child (accounts[i].to_account (), results[i]);
 		}
 	}
 	response_l.add_child ("blocks", pending);
@@ -1293,138 +1447,179 @@ void nano::json_handler::blocks_info ()
 	bool const json_block_l = request.get<bool> ("json_block", false);
 	bool const include_not_found = request.get<bool> ("include_not_found", false);
 
-	boost::property_tree::ptree blocks;
-	boost::property_tree::ptree blocks_not_found;
-	auto transaction (node.store.tx_begin_read ());
+	// Looked up in parallel, rendered in request order afterwards
+	class block_entry final
+	{
+	public:
+		std::string hash_text;
+		nano::block_hash hash{ 0 };
+		bool bad_hash{ false };
+		std::shared_ptr<nano::block> block;
+		boost::optional<nano::uint128_t> amount;
+		nano::uint128_t balance{ 0 };
+		bool confirmed{ false };
+		std::string contents;
+		std::string receivable;
+		std::string receive_hash;
+		std::string source_account;
+	};
+	std::vector<block_entry> entries;
 	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
 	{
-		if (!ec)
+		auto & entry (entries.emplace_back ());
+		entry.hash_text = hashes.second.data ();
+		entry.bad_hash = entry.hash.decode_hex (entry.hash_text);
+	}
+	parallel_for (entries.size (), [this, &entries, receivable, receive_hash, source, json_block_l] (nano::transaction & transaction, std::size_t begin_a, std::size_t end_a) {
+		for (auto i (begin_a); i < end_a; ++i)
 		{
-			std::string hash_text = hashes.second.data ();
-			nano::block_hash hash;
-			if (!hash.decode_hex (hash_text))
+			auto & entry (entries[i]);
+			if (entry.bad_hash)
 			{
-				auto block (node.store.block.get (transaction, hash));
-				if (block != nullptr)
+				continue;
+			}
+			auto const & hash (entry.hash);
+			auto block (node.store.block.get (transaction, hash));
+			if (block == nullptr)
+			{
+				continue;
+			}
+			entry.block = block;
+			bool error_or_pruned (false);
+			auto amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
+			if (!error_or_pruned)
+			{
+				entry.amount = amount;
+			}
+			entry.balance = node.ledger.balance (transaction, hash);
+			entry.confirmed = node.ledger.block_confirmed (transaction, hash);
+			if (!json_block_l)
+			{
+				block->serialize_json (entry.contents);
+			}
+			if (receivable || receive_hash)
+			{
+				auto destination (node.ledger.block_destination (transaction, *block));
+				if (destination.is_zero ())
 				{
-					boost::property_tree::ptree entry;
-					nano::account account (block->account ().is_zero () ? block->sideband ().account : block->account ());
-					entry.put ("block_account", account.to_account ());
-					bool error_or_pruned (false);
-					auto amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
-					if (!error_or_pruned)
-					{
-						entry.put ("amount", amount.convert_to<std::string> ());
-					}
-					auto balance (node.ledger.balance (transaction, hash));
-					entry.put ("balance", balance.convert_to<std::string> ());
-					entry.put ("height", std::to_string (block->sideband ().height));
-					entry.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
-					entry.put ("successor", block->sideband ().successor.to_string ());
-					auto confirmed (node.ledger.block_confirmed (transaction, hash));
-					entry.put ("confirmed", confirmed);
-
-					if (json_block_l)
-					{
-						boost::property_tree::ptree block_node_l;
-						block->serialize_json (block_node_l);
-						entry.add_child ("contents", block_node_l);
-					}
-					else
-					{
-						std::string contents;
-						block->serialize_json (contents);
-						entry.put ("contents", contents);
-					}
-					if (block->type () == nano::block_type::state)
-					{
-						auto subtype (nano::state_subtype (block->sideband ().details));
-						entry.put ("subtype", subtype);
-					}
-					if (receivable || receive_hash)
-					{
-						auto destination (node.ledger.block_destination (transaction, *block));
-						if (destination.is_zero ())
-						{
-							if (receivable)
-							{
-								entry.put ("pending", "0");
-								entry.put ("receivable", "0");
-							}
-							if (receive_hash)
-							{
-								entry.put ("receive_hash", nano::block_hash (0).to_string ());
-							}
-						}
-						else if (node.store.pending.exists (transaction, nano::pending_key (destination, hash)))
-						{
-							if (receivable)
-							{
-								entry.put ("pending", "1");
-								entry.put ("receivable", "1");
-							}
-							if (receive_hash)
-							{
-								entry.put ("receive_hash", nano::block_hash (0).to_string ());
-							}
-						}
-						else
-						{
-							if (receivable)
-							{
-								entry.put ("pending", "0");
-								entry.put ("receivable", "0");
-							}
-							if (receive_hash)
-							{
-								std::shared_ptr<nano::block> receive_block = node.ledger.find_receive_block_by_send_hash (transaction, destination, hash);
-								std::string receive_hash = receive_block ? receive_block->hash ().to_string () : nano::block_hash (0).to_string ();
-								entry.put ("receive_hash", receive_hash);
-							}
-						}
-					}
-					if (source)
+					entry.receivable = "0";
+					entry.receive_hash = nano::block_hash (0).to_string ();
+				}
+				else if (node.store.pending.exists (transaction, nano::pending_key (destination, hash)))
+				{
+					entry.receivable = "1";
+					entry.receive_hash = nano::block_hash (0).to_string ();
+				}
+				else
+				{
+					entry.receivable = "0";
+					if (receive_hash)
 					{
-						nano::block_hash source_hash (node.ledger.block_source (transaction, *block));
-						auto block_a (node.store.block.get (transaction, source_hash));
-						if (block_a != nullptr)
-						{
-							auto source_account (node.ledger.account (transaction, source_hash));
-							entry.put ("source_account", source_account.to_account ());
-						}
-						else
-						{
-							entry.put ("source_account", "0");
-						}
+						std::shared_ptr<nano::block> receive_block = node.ledger.find_receive_block_by_send_hash (transaction, destination, hash);
+						entry.receive_hash = receive_block ? receive_block->hash ().to_string () : nano::block_hash (0).to_string ();
 					}
-					blocks.push_back (std::make_pair (hash_text, entry));
 				}
-				else if (include_not_found)
+			}
+			if (source)
+			{
+				nano::block_hash source_hash (node.ledger.block_source (transaction, *block));
+				auto block_a (node.store.block.get (transaction, source_hash));
+				if (block_a != nullptr)
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("", hash_text);
-					blocks_not_found.push_back (std::make_pair ("", entry));
+					auto source_account (node.ledger.account (transaction, source_hash));
+					entry.source_account = source_account.to_account ();
 				}
 				else
 				{
-					ec = nano::error_blocks::not_found;
+					entry.source_account = "0";
 				}
 			}
+		}
+	});
+
+	nano::json_writer writer;
+	writer.begin_object ();
+	writer.key ("blocks").begin_object ();
+	std::vector<std::string> blocks_not_found;
+	for (auto const & entry : entries)
+	{
+		if (ec)
+		{
+			break;
+		}
+		if (entry.bad_hash)
+		{
+			ec = nano::error_blocks::bad_hash_number;
+		}
+		else if (entry.block != nullptr)
+		{
+			auto const & block (entry.block);
+			writer.key (entry.hash_text).begin_object ();
+			nano::account account (block->account ().is_zero () ? block->sideband ().account : block->account ());
+			writer.put ("block_account", account.to_account ());
+			if (entry.amount)
+			{
+				writer.put ("amount", entry.amount->convert_to<std::string> ());
+			}
+			writer.put ("balance", entry.balance.convert_to<std::string> ());
+			writer.put ("height", std::to_string (block->sideband ().height));
+			writer.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
+			writer.put ("successor", block->sideband ().successor.to_string ());
+			writer.put ("confirmed", entry.confirmed ? "true" : "false");
+
+			if (json_block_l)
+			{
+				writer.key ("contents");
+				block->serialize_json (writer);
+			}
 			else
 			{
-				ec = nano::error_blocks::bad_hash_number;
+				writer.put ("contents", entry.contents);
+			}
+			if (block->type () == nano::block_type::state)
+			{
+				auto subtype (nano::state_subtype (block->sideband ().details));
+				writer.put ("subtype", subtype);
+			}
+			if (receivable)
+			{
+				writer.put ("pending", entry.receivable);
+				writer.put ("receivable", entry.receivable);
+			}
+			if (receive_hash)
+			{
+				writer.put ("receive_hash", entry.receive_hash);
+			}
+			if (source)
+			{
+				writer.put ("source_account", entry.source_account);
 			}
+			writer.end_object ();
+		}
+		else if (include_not_found)
+		{
+			blocks_not_found.push_back (entry.hash_text);
+		}
+		else
+		{
+			ec = nano::error_blocks::not_found;
 		}
 	}
 	if (!ec)
 	{
-		response_l.add_child ("blocks", blocks);
+		writer.end_object ();
 		if (include_not_found)
 		{
-			response_l.add_child ("blocks_not_found", blocks_not_found);
+			writer.key ("blocks_not_found").begin_array ();
+			for (auto const & hash_text : blocks_not_found)
+			{
+				writer.value (hash_text);
+			}
+			writer.end_array ();
 		}
+		writer.end_object ();
 	}
-	response_errors ();
+	response_json (writer);
 }
 
 void nano::json_handler::block_account ()
@@ -2374,16 +2569,34 @@ void nano::json_handler::account_count ()
 
 namespace
 {
+/** Opaque account_history cursor, the hash and height of the next block to visit */
+std::string history_cursor (nano::block_hash const & hash_a, uint64_t height_a)
+{
+	return hash_a.to_string () + nano::to_string_hex (height_a);
+}
+
+bool decode_history_cursor (std::string const & cursor_a, nano::block_hash & hash_a, uint64_t & height_a)
+{
+	auto error (cursor_a.size () != 80);
+	if (!error)
+	{
+		error = hash_a.decode_hex (cursor_a.substr (0, 64)) || nano::from_string_hex (cursor_a.substr (64), height_a);
+	}
+	return error;
+}
+
 class history_visitor : public nano::block_visitor
 {
 public:
-	history_visitor (nano::json_handler & handler_a, bool raw_a, nano::transaction & transaction_a, boost::property_tree::ptree & tree_a, nano::block_hash const & hash_a, std::vector<nano::public_key> const & accounts_filter_a) :
+	history_visitor (nano::json_handler & handler_a, bool raw_a, nano::transaction & transaction_a, boost::property_tree::ptree & tree_a, nano::block_hash const & hash_a, std::vector<nano::public_key> const & accounts_filter_a, std::shared_ptr<nano::block> const & block_a = nullptr, std::shared_ptr<nano::block> const & previous_a = nullptr) :
 		handler (handler_a),
 		raw (raw_a),
 		transaction (transaction_a),
 		tree (tree_a),
 		hash (hash_a),
-		accounts_filter (accounts_filter_a)
+		accounts_filter (accounts_filter_a),
+		block (block_a),
+		previous (previous_a)
 	{
 	}
 	virtual ~history_visitor () = default;
@@ -2397,7 +2610,7 @@ public:
 		auto account (block_a.hashables.destination.to_account ());
 		tree.put ("account", account);
 		bool error_or_pruned (false);
-		auto amount (handler.node.ledger.amount_safe (transaction, hash, error_or_pruned).convert_to<std::string> ());
+		auto amount (block_amount (error_or_pruned).convert_to<std::string> ());
 		if (!error_or_pruned)
 		{
 			tree.put ("amount", amount);
@@ -2413,7 +2626,7 @@ public:
 	{
 		tree.put ("type", "receive");
 		bool error_or_pruned (false);
-		auto amount (handler.node.ledger.amount_safe (transaction, hash, error_or_pruned).convert_to<std::string> ());
+		auto amount (block_amount (error_or_pruned).convert_to<std::string> ());
 		if (!error_or_pruned)
 		{
 			auto source_account (handler.node.ledger.account_safe (transaction, block_a.hashables.source, error_or_pruned));
@@ -2446,7 +2659,7 @@ public:
 		if (block_a.hashables.source != handler.node.ledger.constants.genesis->account ())
 		{
 			bool error_or_pruned (false);
-			auto amount (handler.node.ledger.amount_safe (transaction, hash, error_or_pruned).convert_to<std::string> ());
+			auto amount (block_amount (error_or_pruned).convert_to<std::string> ());
 			if (!error_or_pruned)
 			{
 				auto source_account (handler.node.ledger.account_safe (transaction, block_a.hashables.source, error_or_pruned));
@@ -2484,7 +2697,7 @@ public:
 		}
 		auto balance (block_a.hashables.balance.number ());
 		bool error_or_pruned (false);
-		auto previous_balance (handler.node.ledger.balance_safe (transaction, block_a.hashables.previous, error_or_pruned));
+		auto previous_balance (balance_before (block_a.hashables.previous, error_or_pruned));
 		if (error_or_pruned)
 		{
 			if (raw)
@@ -2555,6 +2768,26 @@ public:
 			}
 		}
 	}
+	/** Balance before the visited block, taken from the previous block when the walk already loaded it */
+	nano::uint128_t balance_before (nano::block_hash const & previous_hash_a, bool & error_a)
+	{
+		if (previous != nullptr)
+		{
+			return handler.node.store.block.balance_calculated (previous);
+		}
+		return handler.node.ledger.balance_safe (transaction, previous_hash_a, error_a);
+	}
+	nano::uint128_t block_amount (bool & error_a)
+	{
+		if (block == nullptr)
+		{
+			return handler.node.ledger.amount_safe (transaction, hash, error_a);
+		}
+		auto balance (handler.node.store.block.balance_calculated (block));
+		auto previous_balance_l (balance_before (block->previous (), error_a));
+		return error_a ? 0 : balance > previous_balance_l ? balance - previous_balance_l
+														  : previous_balance_l - balance;
+	}
 	bool should_ignore_account (nano::public_key const & account)
 	{
 		bool ignore (false);
@@ -2573,6 +2806,9 @@ public:
 	boost::property_tree::ptree & tree;
 	nano::block_hash const & hash;
 	std::vector<nano::public_key> const & accounts_filter;
+	/** The visited block and its predecessor when already loaded by the caller, saving lookups for amounts */
+	std::shared_ptr<nano::block> block;
+	std::shared_ptr<nano::block> previous;
 };
 }
 
@@ -2599,10 +2835,29 @@ void nano::json_handler::account_history ()
 	nano::block_hash hash;
 	bool reverse (request.get_optional<bool> ("reverse") == true);
 	auto head_str (request.get_optional<std::string> ("head"));
+	auto cursor_str (request.get_optional<std::string> ("cursor"));
 	auto transaction (node.store.tx_begin_read ());
 	auto count (count_impl ());
 	auto offset (offset_optional_impl (0));
-	if (head_str)
+	if (cursor_str)
+	{
+		// Resumes where an earlier page stopped, the height guards against the chain having been rolled back since
+		uint64_t height (0);
+		std::shared_ptr<nano::block> cursor_block;
+		if (!decode_history_cursor (*cursor_str, hash, height))
+		{
+			cursor_block = node.store.block.get (transaction, hash);
+		}
+		if (cursor_block != nullptr && cursor_block->sideband ().height == height)
+		{
+			account = cursor_block->account ().is_zero () ? cursor_block->sideband ().account : cursor_block->account ();
+		}
+		else
+		{
+			ec = nano::error_rpc::invalid_cursor;
+		}
+	}
+	else if (head_str)
 	{
 		if (!hash.decode_hex (*head_str))
 		{
@@ -2639,14 +2894,28 @@ void nano::json_handler::account_history ()
 			}
 		}
 	}
+	nano::json_writer writer;
 	if (!ec)
 	{
-		boost::property_tree::ptree history;
 		bool output_raw (request.get_optional<bool> ("raw") == true);
-		response_l.put ("account", account.to_account ());
+		writer.begin_object ();
+		writer.put ("account", account.to_account ());
+		// Entries stay small trees as the visitor may discard them, the history itself is streamed
+		writer.key ("history").begin_array ();
+		// All blocks belong to one account, a single confirmation height answers whether each is confirmed
+		nano::confirmation_height_info confirmation_height_info;
+		node.store.confirmation_height.get (transaction, account, confirmation_height_info);
 		auto block (node.store.block.get (transaction, hash));
+		std::shared_ptr<nano::block> previous;
 		while (block != nullptr && count > 0)
 		{
+			auto next_hash (reverse ? node.store.block.successor (transaction, hash) : block->previous ());
+			auto next (next_hash.is_zero () ? nullptr : node.store.block.get (transaction, next_hash));
+			if (!reverse)
+			{
+				// Walking backwards the next block is the previous one, it is loaded once for both
+				previous = next;
+			}
 			if (offset > 0)
 			{
 				--offset;
@@ -2654,33 +2923,42 @@ void nano::json_handler::account_history ()
 			else
 			{
 				boost::property_tree::ptree entry;
-				history_visitor visitor (*this, output_raw, transaction, entry, hash, accounts_to_filter);
+				history_visitor visitor (*this, output_raw, transaction, entry, hash, accounts_to_filter, block, previous);
 				block->visit (visitor);
 				if (!entry.empty ())
 				{
 					entry.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
 					entry.put ("height", std::to_string (block->sideband ().height));
 					entry.put ("hash", hash.to_string ());
-					entry.put ("confirmed", node.ledger.block_confirmed (transaction, hash));
+					entry.put ("confirmed", confirmation_height_info.height >= block->sideband ().height);
 					if (output_raw)
 					{
 						entry.put ("work", nano::to_string_hex (block->block_work ()));
 						entry.put ("signature", block->block_signature ().to_string ());
 					}
-					history.push_back (std::make_pair ("", entry));
+					writer.value (entry);
 					--count;
 				}
 			}
-			hash = reverse ? node.store.block.successor (transaction, hash) : block->previous ();
-			block = node.store.block.get (transaction, hash);
+			if (reverse)
+			{
+				previous = block;
+			}
+			hash = next_hash;
+			block = next;
 		}
-		response_l.add_child ("history", history);
+		writer.end_array ();
 		if (!hash.is_zero ())
 		{
-			response_l.put (reverse ? "next" : "previous", hash.to_string ());
+			writer.put (reverse ? "next" : "previous", hash.to_string ());
 		}
+		if (block != nullptr)
+		{
+			writer.put ("cursor", history_cursor (hash, block->sideband ().height));
+		}
+		writer.end_object ();
 	}
-	response_errors ();
+	response_json (writer);
 }
 
 void nano::json_handler::keepalive ()
@@ -2734,6 +3012,7 @@ void nano::json_handler::ledger ()
 {
 	auto count (count_optional_impl ());
 	auto threshold (threshold_optional_impl ());
+	nano::json_writer writer;
 	if (!ec)
 	{
 		nano::account start{};
@@ -2756,45 +3035,52 @@ void nano::json_handler::ledger ()
 		bool const weight = request.get<bool> ("weight", false);
 		bool const pending = request.get<bool> ("pending", false);
 		bool const receivable = request.get<bool> ("receivable", pending);
-		boost::property_tree::ptree accounts;
+		writer.begin_object ();
+		writer.key ("accounts").begin_object ();
+		uint64_t accounts (0);
 		auto transaction (node.store.tx_begin_read ());
 		if (!ec && !sorting) // Simple
 		{
-			for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n && accounts < count; ++i)
 			{
 				nano::account_info const & info (i->second);
 				if (info.modified >= modified_since && (receivable || info.balance.number () >= threshold.number ()))
 				{
 					nano::account const & account (i->first);
-					boost::property_tree::ptree response_a;
+					nano::uint128_t account_receivable (0);
 					if (receivable)
 					{
-						auto account_receivable = node.ledger.account_receivable (transaction, account);
+						account_receivable = node.ledger.account_receivable (transaction, account);
 						if (info.balance.number () + account_receivable < threshold.number ())
 						{
 							continue;
 						}
-						response_a.put ("pending", account_receivable.convert_to<std::string> ());
-						response_a.put ("receivable", account_receivable.convert_to<std::string> ());
 					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+					writer.key (account.to_account ()).begin_object ();
+					if (receivable)
+					{
+						writer.put ("pending", account_receivable.convert_to<std::string> ());
+						writer.put ("receivable", account_receivable.convert_to<std::string> ());
+					}
+					writer.put ("frontier", info.head.to_string ());
+					writer.put ("open_block", info.open_block.to_string ());
+					writer.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
 					std::string balance;
 					nano::uint128_union (info.balance).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
+					writer.put ("balance", balance);
+					writer.put ("modified_timestamp", std::to_string (info.modified));
+					writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						response_a.put ("representative", info.representative.to_account ());
+						writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
+						writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					writer.end_object ();
+					++accounts;
 				}
 			}
 		}
@@ -2813,47 +3099,53 @@ void nano::json_handler::ledger ()
 			std::sort (ledger_l.begin (), ledger_l.end ());
 			std::reverse (ledger_l.begin (), ledger_l.end ());
 			nano::account_info info;
-			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts < count; ++i)
 			{
 				node.store.account.get (transaction, i->second, info);
 				if (receivable || info.balance.number () >= threshold.number ())
 				{
 					nano::account const & account (i->second);
-					boost::property_tree::ptree response_a;
+					nano::uint128_t account_receivable (0);
 					if (receivable)
 					{
-						auto account_receivable = node.ledger.account_receivable (transaction, account);
+						account_receivable = node.ledger.account_receivable (transaction, account);
 						if (info.balance.number () + account_receivable < threshold.number ())
 						{
 							continue;
 						}
-						response_a.put ("pending", account_receivable.convert_to<std::string> ());
-						response_a.put ("receivable", account_receivable.convert_to<std::string> ());
 					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+					writer.key (account.to_account ()).begin_object ();
+					if (receivable)
+					{
+						writer.put ("pending", account_receivable.convert_to<std::string> ());
+						writer.put ("receivable", account_receivable.convert_to<std::string> ());
+					}
+					writer.put ("frontier", info.head.to_string ());
+					writer.put ("open_block", info.open_block.to_string ());
+					writer.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
 					std::string balance;
 					(i->first).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
+					writer.put ("balance", balance);
+					writer.put ("modified_timestamp", std::to_string (info.modified));
+					writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						response_a.put ("representative", info.representative.to_account ());
+						writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
+						writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					writer.end_object ();
+					++accounts;
 				}
 			}
 		}
-		response_l.add_child ("accounts", accounts);
+		writer.end_object ();
+		writer.end_object ();
 	}
-	response_errors ();
+	response_json (writer);
 }
 
 void nano::json_handler::mnano_from_raw (nano::uint128_t ratio)
@@ -3063,7 +3355,9 @@ void nano::json_handler::receivable ()
 		// The ptree container is used if there are any children nodes (e.g source/min_version) otherwise the amount container is used.
 		std::vector<std::pair<std::string, boost::property_tree::ptree>> hash_ptree_pairs;
 		std::vector<std::pair<std::string, nano::uint128_t>> hash_amount_pairs;
-		for (auto i (node.store.pending.begin (transaction, nano::pending_key (account, 0))), n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && (should_sort || peers_l.size () < count); ++i)
+		// Accounts which cannot have a receivable entry above the threshold are answered without iterating their pending entries
+		auto i (node.ledger.cache.receivable.may_have (account, threshold.number ()) ? node.store.pending.begin (transaction, account) : node.store.pending.end ());
+		for (auto n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && (should_sort || peers_l.size () < count); ++i)
 		{
 			nano::pending_key const & key (i->first);
 			if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
@@ -3948,6 +4242,11 @@ void nano::json_handler::stats ()
 		node.stats.log_samples (*sink);
 		use_sink = true;
 	}
+	else if (type == "latency")
+	{
+		node.stats.log_latencies (*sink);
+		use_sink = true;
+	}
 	else if (type == "database")
 	{
 		node.store.serialize_memory_stats (response_l);
@@ -4802,10 +5101,17 @@ void nano::json_handler::wallet_receivable ()
 		{
 			nano::account const & account (i->first);
 			boost::property_tree::ptree peers_l;
-			for (auto ii (node.store.pending.begin (block_transaction, nano::pending_key (account, 0))), nn (node.store.pending.end ()); ii != nn && nano::pending_key (ii->first).account == account && peers_l.size () < count; ++ii)
+			// Skip accounts which cannot have a receivable entry above the threshold without iterating their pending entries
+			if (!node.ledger.cache.receivable.may_have (account, threshold.number ()))
+			{
+				continue;
+			}
+			for (auto ii (node.store.pending.begin (block_transaction, account)), nn (node.store.pending.end ()); ii != nn && nano::pending_key (ii->first).account == account && peers_l.size () < count; ++ii)
 			{
 				nano::pending_key key (ii->first);
-				if (block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
+				nano::pending_info const & info (ii->second);
+				// Compare the amount first as it is cheaper than checking confirmation
+				if (info.amount.number () >= threshold.number () && block_confirmed (node, block_transaction, key.hash, include_active, include_only_confirmed))
 				{
 					if (threshold.is_zero () && !source)
 					{
@@ -4813,30 +5119,23 @@ void nano::json_handler::wallet_receivable ()
 						entry.put ("", key.hash.to_string ());
 						peers_l.push_back (std::make_pair ("", entry));
 					}
-					else
+					else if (source || min_version)
 					{
-						nano::pending_info info (ii->second);
-						if (info.amount.number () >= threshold.number ())
+						boost::property_tree::ptree pending_tree;
+						pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+						if (source)
 						{
-							if (source || min_version)
-							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								if (source)
-								{
-									pending_tree.put ("source", info.source.to_account ());
-								}
-								if (min_version)
-								{
-									pending_tree.put ("min_version", epoch_as_string (info.epoch));
-								}
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-							}
+							pending_tree.put ("source", info.source.to_account ());
+						}
+						if (min_version)
+						{
+							pending_tree.put ("min_version", epoch_as_string (info.epoch));
 						}
+						peers_l.add_child (key.hash.to_string (), pending_tree);
+					}
+					else
+					{
+						peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 					}
 				}
 			}
@@ -4978,6 +5277,38 @@ void nano::json_handler::wallet_seed ()
 	response_errors ();
 }
 
+void nano::json_handler::wallet_work_cache ()
+{
+	auto wallet (wallet_impl ());
+	if (!ec)
+	{
+		auto & work_cache (node.wallets.work_cache);
+		response_l.put ("queued", std::to_string (work_cache.queued ()));
+		response_l.put ("generating", std::to_string (work_cache.generating ()));
+		response_l.put ("hits", std::to_string (node.stats.count (nano::stat::type::wallet_work_cache, nano::stat::detail::hit)));
+		response_l.put ("misses", std::to_string (node.stats.count (nano::stat::type::wallet_work_cache, nano::stat::detail::miss)));
+		boost::property_tree::ptree accounts;
+		auto transaction (node.wallets.tx_begin_read ());
+		auto block_transaction (node.store.tx_begin_read ());
+		auto const difficulty (node.default_difficulty (nano::work_version::work_1));
+		for (auto i (wallet->store.begin (transaction)), n (wallet->store.end ()); i != n; ++i)
+		{
+			nano::account const & account (i->first);
+			auto root (node.ledger.latest_root (block_transaction, account));
+			uint64_t work (0);
+			auto ready (!wallet->store.work_get (transaction, account, work) && node.network_params.work.difficulty (nano::work_version::work_1, root, work) >= difficulty);
+			boost::property_tree::ptree entry;
+			entry.put ("root", root.to_string ());
+			entry.put ("work", nano::to_string_hex (work));
+			entry.put ("ready", ready);
+			entry.put ("scheduled", work_cache.scheduled (account, root));
+			accounts.add_child (account.to_account (), entry);
+		}
+		response_l.add_child ("accounts", accounts);
+	}
+	response_errors ();
+}
+
 void nano::json_handler::wallet_work_get ()
 {
 	auto wallet (wallet_impl ());
@@ -5433,6 +5764,7 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 	no_arg_funcs.emplace ("wallet_representative", &nano::json_handler::wallet_representative);
 	no_arg_funcs.emplace ("wallet_representative_set", &nano::json_handler::wallet_representative_set);
 	no_arg_funcs.emplace ("wallet_republish", &nano::json_handler::wallet_republish);
+	no_arg_funcs.emplace ("wallet_work_cache", &nano::json_handler::wallet_work_cache);
 	no_arg_funcs.emplace ("wallet_work_get", &nano::json_handler::wallet_work_get);
 	no_arg_funcs.emplace ("work_generate", &nano::json_handler::work_generate);
 	no_arg_funcs.emplace ("work_cancel", &nano::json_handler::work_cancel);
@@ -16,6 +16,7 @@ namespace ipc
 {
 	class ipc_server;
 }
+class json_writer;
 class node;
 class node_rpc_config;
 
@@ -137,6 +138,7 @@ public:
 	void wallet_representative_set ();
 	void wallet_republish ();
 	void wallet_seed ();
+	void wallet_work_cache ();
 	void wallet_work_get ();
 	void work_cancel ();
 	void work_generate ();
@@ -151,6 +153,8 @@ public:
 	boost::property_tree::ptree request;
 	std::function<void (std::string const &)> response;
 	void response_errors ();
+	/** Responds with the document streamed into \p writer_a, or with the error if one was set */
+	void response_json (nano::json_writer & writer_a);
 	std::error_code ec;
 	std::string action;
 	boost::property_tree::ptree response_l;
@@ -175,6 +179,13 @@ public:
 	std::function<void ()> stop_callback;
 	nano::node_rpc_config const & node_rpc_config;
 	std::function<void ()> create_worker_task (std::function<void (std::shared_ptr<nano::json_handler> const &)> const &);
+	/**
+	 * Runs the action over [0, count) split into contiguous partitions, each with its own read transaction.
+	 * The calling thread and up to `bulk_parallelism - 1` worker tasks take partitions until none are left, so the request completes even when no worker is idle.
+	 * Actions must not touch `ec` or `response_l`, results are merged in order by the caller afterwards.
+	 */
+	void parallel_for (std::size_t count, std::function<void (nano::transaction &, std::size_t begin, std::size_t end)> const & action);
+	static std::size_t constexpr bulk_partition_min{ 64 };
 };
 
 class inprocess_rpc_handler final : public nano::rpc_handler_interface
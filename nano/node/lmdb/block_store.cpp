@@ -115,6 +115,22 @@ std::shared_ptr<nano::block> nano::lmdb::block_store::get_no_sideband (nano::tra
 	return result;
 }
 
+bool nano::lmdb::block_store::get_serialized (nano::transaction const & transaction, nano::block_hash const & hash, std::vector<uint8_t> & buffer, nano::block_hash & successor) const
+{
+	nano::mdb_val value;
+	block_raw_get (transaction, hash, value);
+	auto error (value.size () == 0);
+	if (!error)
+	{
+		// The record is the serialized block followed by its sideband, which starts with the successor
+		auto data (reinterpret_cast<uint8_t const *> (value.data ()));
+		auto offset (block_successor_offset (transaction, value.size (), block_type_from_raw (value.data ())));
+		buffer.insert (buffer.end (), data, data + offset);
+		std::copy (data + offset, data + offset + successor.bytes.size (), successor.bytes.begin ());
+	}
+	return error;
+}
+
 std::shared_ptr<nano::block> nano::lmdb::block_store::random (nano::transaction const & transaction)
 {
 	nano::block_hash hash;
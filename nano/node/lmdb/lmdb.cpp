@@ -66,7 +66,10 @@ nano::lmdb::store::store (nano::logger_mt & logger_a, boost::filesystem::path co
 	logger (logger_a),
 	env (error, path_a, nano::mdb_env::options::make ().set_config (lmdb_config_a).set_use_no_mem_init (true)),
 	mdb_txn_tracker (logger_a, txn_tracking_config_a, block_processor_batch_max_time_a),
-	txn_tracking_enabled (txn_tracking_config_a.enable)
+	txn_tracking_enabled (txn_tracking_config_a.enable),
+	read_txn_pool (env, create_txn_callbacks (), lmdb_config_a.read_txn_pool_size),
+	read_txn_pool_enabled (false),
+	max_read_txn_age (lmdb_config_a.max_read_txn_age)
 {
 	if (!error)
 	{
@@ -121,6 +124,8 @@ nano::lmdb::store::store (nano::logger_mt & logger_a, boost::filesystem::path co
 			open_databases (error, transaction, 0);
 		}
 	}
+	// Databases opened with a read transaction are only kept once it commits, which pooled transactions never do, so pooling starts after they are open
+	read_txn_pool_enabled = lmdb_config_a.read_txn_pool;
 }
 
 bool nano::lmdb::store::vacuum_after_upgrade (boost::filesystem::path const & path_a, nano::lmdb_config const & lmdb_config_a)
@@ -131,6 +136,8 @@ bool nano::lmdb::store::vacuum_after_upgrade (boost::filesystem::path const & pa
 	auto vacuum_success = copy_db (vacuum_path);
 	if (vacuum_success)
 	{
+		// Pooled read transactions belong to the environment being closed
+		read_txn_pool.clear ();
 		// Need to close the database to release the file handle
 		mdb_env_sync (env.environment, true);
 		mdb_env_close (env.environment);
@@ -183,7 +190,11 @@ nano::write_transaction nano::lmdb::store::tx_begin_write (std::vector<nano::tab
 
 nano::read_transaction nano::lmdb::store::tx_begin_read () const
 {
-	return env.tx_begin_read (create_txn_callbacks ());
+	if (read_txn_pool_enabled)
+	{
+		return nano::read_transaction{ read_txn_pool.acquire (), max_read_txn_age };
+	}
+	return nano::read_transaction{ std::make_unique<nano::read_mdb_txn> (env, create_txn_callbacks ()), max_read_txn_age };
 }
 
 std::string nano::lmdb::store::vendor_get () const
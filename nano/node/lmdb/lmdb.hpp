@@ -161,6 +161,9 @@ namespace lmdb
 		mutable nano::mdb_txn_tracker mdb_txn_tracker;
 		nano::mdb_txn_callbacks create_txn_callbacks () const;
 		bool txn_tracking_enabled;
+		mutable nano::mdb_read_txn_pool read_txn_pool;
+		bool read_txn_pool_enabled;
+		std::chrono::milliseconds max_read_txn_age;
 
 		uint64_t count (nano::transaction const & transaction_a, tables table_a) const override;
 
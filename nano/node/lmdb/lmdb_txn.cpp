@@ -15,6 +15,8 @@
 #endif
 #include <boost/stacktrace.hpp>
 
+#include <algorithm>
+
 namespace
 {
 class matches_txn final
@@ -33,6 +35,50 @@ public:
 private:
 	nano::transaction_impl const * transaction_impl;
 };
+
+/**
+ * Read transaction handed out by mdb_read_txn_pool, the underlying transaction is reset and given back to the pool on destruction
+ */
+class pooled_read_mdb_txn final : public nano::read_transaction_impl
+{
+public:
+	pooled_read_mdb_txn (nano::mdb_read_txn_pool & pool_a, std::unique_ptr<nano::read_mdb_txn> transaction_a) :
+		pool (pool_a),
+		transaction (std::move (transaction_a))
+	{
+	}
+
+	~pooled_read_mdb_txn ()
+	{
+		if (active)
+		{
+			transaction->reset ();
+		}
+		pool.release (std::move (transaction));
+	}
+
+	void reset () override
+	{
+		transaction->reset ();
+		active = false;
+	}
+
+	void renew () override
+	{
+		transaction->renew ();
+		active = true;
+	}
+
+	void * get_handle () const override
+	{
+		return transaction->get_handle ();
+	}
+
+private:
+	nano::mdb_read_txn_pool & pool;
+	std::unique_ptr<nano::read_mdb_txn> transaction;
+	bool active{ true };
+};
 }
 
 nano::read_mdb_txn::read_mdb_txn (nano::mdb_env const & environment_a, nano::mdb_txn_callbacks txn_callbacks_a) :
@@ -114,6 +160,87 @@ bool nano::write_mdb_txn::contains (nano::tables table_a) const
 	return true;
 }
 
+nano::mdb_read_txn_pool::mdb_read_txn_pool (nano::mdb_env const & env_a, nano::mdb_txn_callbacks txn_callbacks_a, std::size_t max_size_a) :
+	env (env_a),
+	txn_callbacks (txn_callbacks_a),
+	max_size (max_size_a)
+{
+}
+
+std::unique_ptr<nano::read_transaction_impl> nano::mdb_read_txn_pool::acquire ()
+{
+	std::unique_ptr<nano::read_mdb_txn> transaction;
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto existing = transactions.find (std::this_thread::get_id ());
+		if (existing != transactions.end ())
+		{
+			transaction = std::move (existing->second.transaction);
+			transactions.erase (existing);
+		}
+	}
+	if (transaction != nullptr)
+	{
+		transaction->renew ();
+	}
+	else
+	{
+		transaction = std::make_unique<nano::read_mdb_txn> (env, txn_callbacks);
+	}
+	return std::make_unique<pooled_read_mdb_txn> (*this, std::move (transaction));
+}
+
+void nano::mdb_read_txn_pool::release (std::unique_ptr<nano::read_mdb_txn> transaction_a)
+{
+	// Evicted transactions are aborted outside of the lock
+	std::vector<std::unique_ptr<nano::read_mdb_txn>> evicted;
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto now = std::chrono::steady_clock::now ();
+		// Threads that exited never reacquire their transaction, so idle entries are dropped to release their reader slot
+		for (auto i = transactions.begin (), n = transactions.end (); i != n;)
+		{
+			if (now - i->second.released > max_idle)
+			{
+				evicted.push_back (std::move (i->second.transaction));
+				i = transactions.erase (i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+		// Only one transaction is kept per thread, any additional nested transaction is destroyed
+		if (max_size > 0 && transactions.find (std::this_thread::get_id ()) == transactions.end ())
+		{
+			if (transactions.size () >= max_size)
+			{
+				auto oldest = std::min_element (transactions.begin (), transactions.end (), [] (auto const & lhs, auto const & rhs) {
+					return lhs.second.released < rhs.second.released;
+				});
+				evicted.push_back (std::move (oldest->second.transaction));
+				transactions.erase (oldest);
+			}
+			transactions.emplace (std::this_thread::get_id (), entry{ std::move (transaction_a), now });
+		}
+	}
+}
+
+void nano::mdb_read_txn_pool::clear ()
+{
+	decltype (transactions) transactions_l;
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		transactions_l.swap (transactions);
+	}
+}
+
+std::size_t nano::mdb_read_txn_pool::size ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return transactions.size ();
+}
+
 nano::mdb_txn_tracker::mdb_txn_tracker (nano::logger_mt & logger_a, nano::txn_tracking_config const & txn_tracking_config_a, std::chrono::milliseconds block_processor_batch_max_time_a) :
 	logger (logger_a),
 	txn_tracking_config (txn_tracking_config_a),
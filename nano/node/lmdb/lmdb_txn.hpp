@@ -9,6 +9,9 @@
 
 #include <lmdb/libraries/liblmdb/lmdb.h>
 
+#include <thread>
+#include <unordered_map>
+
 namespace nano
 {
 class transaction_impl;
@@ -49,6 +52,39 @@ public:
 	bool active{ true };
 };
 
+/**
+ * Keeps one reset read transaction per thread so that tx_begin_read can renew an existing MDB_txn instead of beginning a new one.
+ * Transactions are reset before they are returned to the pool, so a pooled transaction always sees the latest snapshot once renewed.
+ * A reset transaction still holds its reader slot, so the pool is capped and transactions left idle, including those of exited threads, are aborted.
+ */
+class mdb_read_txn_pool final
+{
+public:
+	mdb_read_txn_pool (nano::mdb_env const &, mdb_txn_callbacks txn_callbacks_a, std::size_t max_size_a);
+	std::unique_ptr<nano::read_transaction_impl> acquire ();
+	void release (std::unique_ptr<nano::read_mdb_txn> transaction_a);
+	/** Destroys all pooled transactions, must be called before the environment is closed */
+	void clear ();
+	std::size_t size ();
+
+	/** Pooled transactions not reused within this duration are aborted to free their reader slot */
+	static std::chrono::seconds constexpr max_idle{ 30 };
+
+private:
+	class entry final
+	{
+	public:
+		std::unique_ptr<nano::read_mdb_txn> transaction;
+		std::chrono::steady_clock::time_point released;
+	};
+
+	nano::mdb_env const & env;
+	mdb_txn_callbacks txn_callbacks;
+	std::size_t const max_size;
+	nano::mutex mutex;
+	std::unordered_map<std::thread::id, entry> transactions;
+};
+
 class mdb_txn_stats
 {
 public:
@@ -53,6 +53,11 @@ nano::store_iterator<nano::pending_key, nano::pending_info> nano::lmdb::pending_
 	return store.make_iterator<nano::pending_key, nano::pending_info> (transaction_a, tables::pending);
 }
 
+nano::store_iterator<nano::pending_key, nano::pending_info> nano::lmdb::pending_store::begin (nano::transaction const & transaction_a, nano::account const & account_a) const
+{
+	return store.make_iterator<nano::pending_key, nano::pending_info> (transaction_a, tables::pending, nano::pending_key (account_a, 0));
+}
+
 nano::store_iterator<nano::pending_key, nano::pending_info> nano::lmdb::pending_store::end () const
 {
 	return nano::store_iterator<nano::pending_key, nano::pending_info> (nullptr);
@@ -1643,7 +1643,7 @@ bool nano::asc_pull_req::verify_consistency () const
 		{
 			debug_assert (false, "missing payload");
 		}
-		void operator() (blocks_payload) const
+		void operator() (blocks_payload const &) const
 		{
 			debug_assert (type == asc_pull_type::blocks);
 		}
@@ -1796,7 +1796,7 @@ bool nano::asc_pull_ack::verify_consistency () const
 		{
 			debug_assert (false, "missing payload");
 		}
-		void operator() (blocks_payload) const
+		void operator() (blocks_payload const &) const
 		{
 			debug_assert (type == asc_pull_type::blocks);
 		}
@@ -1815,7 +1815,9 @@ bool nano::asc_pull_ack::verify_consistency () const
 
 void nano::asc_pull_ack::blocks_payload::serialize (nano::stream & stream) const
 {
-	debug_assert (blocks.size () <= max_blocks);
+	debug_assert (count () <= max_blocks);
+	debug_assert (blocks.empty () || serialized.empty ());
+	nano::write (stream, serialized);
 	for (auto & block : blocks)
 	{
 		debug_assert (block != nullptr);
@@ -1825,6 +1827,11 @@ void nano::asc_pull_ack::blocks_payload::serialize (nano::stream & stream) const
 	nano::serialize_block_type (stream, nano::block_type::not_a_block);
 }
 
+std::size_t nano::asc_pull_ack::blocks_payload::count () const
+{
+	return blocks.size () + serialized_count;
+}
+
 void nano::asc_pull_ack::blocks_payload::deserialize (nano::stream & stream)
 {
 	auto current = nano::deserialize_block (stream);
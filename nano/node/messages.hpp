@@ -518,8 +518,18 @@ public: // Payload definitions
 		void serialize (nano::stream &) const;
 		void deserialize (nano::stream &);
 
+		/** Number of blocks in the payload, whether materialized or serialized */
+		std::size_t count () const;
+
 	public:
 		std::vector<std::shared_ptr<nano::block>> blocks{};
+		/**
+		 * Blocks already serialized with `nano::serialize_block`, written out instead of `blocks`.
+		 * Lets the bootstrap server copy blocks from the store into a response without deserializing them.
+		 * Never filled when deserializing.
+		 */
+		std::vector<uint8_t> serialized{};
+		std::size_t serialized_count{ 0 };
 
 	public:
 		/* Header allows for 16 bit extensions; 65535 bytes / 500 bytes (block size with some future margin) ~ 131 */
@@ -63,6 +63,13 @@ nano::outbound_bandwidth_limiter::config nano::outbound_bandwidth_limiter_config
 	return cfg;
 }
 
+nano::generate_cache nano::ledger_generate_cache (nano::node_config const & config, nano::node_flags const & flags)
+{
+	auto result (flags.generate_cache);
+	result.receivable = result.receivable || config.enable_receivable_summary;
+	return result;
+}
+
 /*
  * node
  */
@@ -156,11 +163,11 @@ nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 	logger (config_a.logging.min_time_between_log_output),
 	store_impl (nano::make_store (logger, application_path_a, network_params.ledger, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_config, config_a.backup_before_upgrade)),
 	store (*store_impl),
-	unchecked{ stats, flags.disable_block_processor_unchecked_deletion },
+	unchecked{ stats, flags.disable_block_processor_unchecked_deletion, flags.disable_unchecked_spill || flags.read_only ? boost::filesystem::path{} : application_path_a / "unchecked_spill.ldb", nano::unchecked_map::mem_block_count_max, config.unchecked_spill_max },
 	wallets_store_impl (std::make_unique<nano::mdb_wallets_store> (application_path_a / "wallets.ldb", config_a.lmdb_config)),
 	wallets_store (*wallets_store_impl),
 	gap_cache (*this),
-	ledger (store, stats, network_params.ledger, flags_a.generate_cache),
+	ledger (store, stats, network_params.ledger, ledger_generate_cache (config_a, flags_a)),
 	checker (config.signature_checker_threads),
 	outbound_limiter{ outbound_bandwidth_limiter_config (config) },
 	// empty `config.peering_port` means the user made no port choice at all;
@@ -197,8 +204,9 @@ nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 	aggregator (config, stats, generator, final_generator, history, ledger, wallets, active),
 	wallets (wallets_store.init_error (), *this),
 	backlog{ nano::backlog_population_config (config), store, stats },
-	ascendboot{ config, block_processor, ledger, network, stats },
+	ascendboot{ config, block_processor, ledger, network, stats, logger },
 	websocket{ config.websocket_config, observers, wallets, ledger, io_ctx, logger },
+	http_callbacks{ std::make_shared<nano::http_callbacks> (config, io_ctx, stats, logger) },
 	epoch_upgrader{ *this, ledger, store, network_params, logger },
 	startup_time (std::chrono::steady_clock::now ()),
 	node_seq (seq),
@@ -211,8 +219,14 @@ nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 	block_publisher.connect (block_processor);
 	gap_tracker.connect (block_processor);
 	process_live_dispatcher.connect (block_processor);
-	unchecked.satisfied.add ([this] (nano::unchecked_info const & info) {
-		this->block_processor.add (info.block);
+	unchecked.satisfied.add ([this] (std::vector<nano::unchecked_info> const & infos) {
+		std::vector<std::shared_ptr<nano::block>> blocks;
+		blocks.reserve (infos.size ());
+		for (auto const & info : infos)
+		{
+			blocks.push_back (info.block);
+		}
+		this->block_processor.add (blocks);
 	});
 
 	inactive_vote_cache.rep_weight_query = [this] (nano::account const & rep) {
@@ -283,25 +297,7 @@ nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 						std::stringstream ostream;
 						boost::property_tree::write_json (ostream, event);
 						ostream.flush ();
-						auto body (std::make_shared<std::string> (ostream.str ()));
-						auto address (node_l->config.callback_address);
-						auto port (node_l->config.callback_port);
-						auto target (std::make_shared<std::string> (node_l->config.callback_target));
-						auto resolver (std::make_shared<boost::asio::ip::tcp::resolver> (node_l->io_ctx));
-						resolver->async_resolve (boost::asio::ip::tcp::resolver::query (address, std::to_string (port)), [node_l, address, port, target, body, resolver] (boost::system::error_code const & ec, boost::asio::ip::tcp::resolver::iterator i_a) {
-							if (!ec)
-							{
-								node_l->do_rpc_callback (i_a, address, port, target, body, resolver);
-							}
-							else
-							{
-								if (node_l->config.logging.callback_logging ())
-								{
-									node_l->logger.always_log (boost::str (boost::format ("Error resolving callback: %1%:%2%: %3%") % address % port % ec.message ()));
-								}
-								node_l->stats.inc (nano::stat::type::error, nano::stat::detail::http_callback, nano::stat::dir::out);
-							}
-						});
+						node_l->http_callbacks->add (ostream.str ());
 					});
 				}
 			});
@@ -474,78 +470,6 @@ nano::node::~node ()
 	stop ();
 }
 
-void nano::node::do_rpc_callback (boost::asio::ip::tcp::resolver::iterator i_a, std::string const & address, uint16_t port, std::shared_ptr<std::string> const & target, std::shared_ptr<std::string> const & body, std::shared_ptr<boost::asio::ip::tcp::resolver> const & resolver)
-{
-	if (i_a != boost::asio::ip::tcp::resolver::iterator{})
-	{
-		auto node_l (shared_from_this ());
-		auto sock (std::make_shared<boost::asio::ip::tcp::socket> (node_l->io_ctx));
-		sock->async_connect (i_a->endpoint (), [node_l, target, body, sock, address, port, i_a, resolver] (boost::system::error_code const & ec) mutable {
-			if (!ec)
-			{
-				auto req (std::make_shared<boost::beast::http::request<boost::beast::http::string_body>> ());
-				req->method (boost::beast::http::verb::post);
-				req->target (*target);
-				req->version (11);
-				req->insert (boost::beast::http::field::host, address);
-				req->insert (boost::beast::http::field::content_type, "application/json");
-				req->body () = *body;
-				req->prepare_payload ();
-				boost::beast::http::async_write (*sock, *req, [node_l, sock, address, port, req, i_a, target, body, resolver] (boost::system::error_code const & ec, std::size_t bytes_transferred) mutable {
-					if (!ec)
-					{
-						auto sb (std::make_shared<boost::beast::flat_buffer> ());
-						auto resp (std::make_shared<boost::beast::http::response<boost::beast::http::string_body>> ());
-						boost::beast::http::async_read (*sock, *sb, *resp, [node_l, sb, resp, sock, address, port, i_a, target, body, resolver] (boost::system::error_code const & ec, std::size_t bytes_transferred) mutable {
-							if (!ec)
-							{
-								if (boost::beast::http::to_status_class (resp->result ()) == boost::beast::http::status_class::successful)
-								{
-									node_l->stats.inc (nano::stat::type::http_callback, nano::stat::detail::initiate, nano::stat::dir::out);
-								}
-								else
-								{
-									if (node_l->config.logging.callback_logging ())
-									{
-										node_l->logger.try_log (boost::str (boost::format ("Callback to %1%:%2% failed with status: %3%") % address % port % resp->result ()));
-									}
-									node_l->stats.inc (nano::stat::type::error, nano::stat::detail::http_callback, nano::stat::dir::out);
-								}
-							}
-							else
-							{
-								if (node_l->config.logging.callback_logging ())
-								{
-									node_l->logger.try_log (boost::str (boost::format ("Unable complete callback: %1%:%2%: %3%") % address % port % ec.message ()));
-								}
-								node_l->stats.inc (nano::stat::type::error, nano::stat::detail::http_callback, nano::stat::dir::out);
-							};
-						});
-					}
-					else
-					{
-						if (node_l->config.logging.callback_logging ())
-						{
-							node_l->logger.try_log (boost::str (boost::format ("Unable to send callback: %1%:%2%: %3%") % address % port % ec.message ()));
-						}
-						node_l->stats.inc (nano::stat::type::error, nano::stat::detail::http_callback, nano::stat::dir::out);
-					}
-				});
-			}
-			else
-			{
-				if (node_l->config.logging.callback_logging ())
-				{
-					node_l->logger.try_log (boost::str (boost::format ("Unable to connect to callback address: %1%:%2%: %3%") % address % port % ec.message ()));
-				}
-				node_l->stats.inc (nano::stat::type::error, nano::stat::detail::http_callback, nano::stat::dir::out);
-				++i_a;
-				node_l->do_rpc_callback (i_a, address, port, target, body, resolver);
-			}
-		});
-	}
-}
-
 bool nano::node::copy_with_compaction (boost::filesystem::path const & destination)
 {
 	return store.copy_db (destination);
@@ -582,6 +506,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (collect_container_info (node.final_generator, "vote_generator_final"));
 	composite->add_component (node.ascendboot.collect_container_info ("bootstrap_ascending"));
 	composite->add_component (node.unchecked.collect_container_info ("unchecked"));
+	composite->add_component (node.http_callbacks->collect_container_info ("http_callbacks"));
 	return composite;
 }
 
@@ -733,6 +658,7 @@ void nano::node::stop ()
 	network.stop ();
 	telemetry.stop ();
 	websocket.stop ();
+	http_callbacks->stop ();
 	bootstrap_server.stop ();
 	bootstrap_initiator.stop ();
 	tcp_listener.stop ();
@@ -990,16 +916,13 @@ void nano::node::unchecked_cleanup ()
 	// Delete old unchecked keys in batches
 	while (!cleaning_list.empty ())
 	{
-		std::size_t deleted_count (0);
-		while (deleted_count++ < 2 * 1024 && !cleaning_list.empty ())
+		std::vector<nano::unchecked_key> batch;
+		while (batch.size () < 2 * 1024 && !cleaning_list.empty ())
 		{
-			auto key (cleaning_list.front ());
+			batch.push_back (cleaning_list.front ());
 			cleaning_list.pop_front ();
-			if (unchecked.exists (key))
-			{
-				unchecked.del (key);
-			}
 		}
+		unchecked.del (batch);
 	}
 	// Delete from the duplicate filter
 	network.publish_filter.clear (digests);
@@ -1205,24 +1128,24 @@ boost::optional<uint64_t> nano::node::work_generate_blocking (nano::block & bloc
 	return opt_work_l;
 }
 
-void nano::node::work_generate (nano::work_version const version_a, nano::root const & root_a, uint64_t difficulty_a, std::function<void (boost::optional<uint64_t>)> callback_a, boost::optional<nano::account> const & account_a, bool secondary_work_peers_a)
+void nano::node::work_generate (nano::work_version const version_a, nano::root const & root_a, uint64_t difficulty_a, std::function<void (boost::optional<uint64_t>)> callback_a, boost::optional<nano::account> const & account_a, bool secondary_work_peers_a, nano::work_priority const priority_a)
 {
 	auto const & peers_l (secondary_work_peers_a ? config.secondary_work_peers : config.work_peers);
-	if (distributed_work.make (version_a, root_a, peers_l, difficulty_a, callback_a, account_a))
+	if (distributed_work.make (version_a, root_a, peers_l, difficulty_a, callback_a, account_a, priority_a))
 	{
 		// Error in creating the job (either stopped or work generation is not possible)
 		callback_a (boost::none);
 	}
 }
 
-boost::optional<uint64_t> nano::node::work_generate_blocking (nano::work_version const version_a, nano::root const & root_a, uint64_t difficulty_a, boost::optional<nano::account> const & account_a)
+boost::optional<uint64_t> nano::node::work_generate_blocking (nano::work_version const version_a, nano::root const & root_a, uint64_t difficulty_a, boost::optional<nano::account> const & account_a, nano::work_priority const priority_a)
 {
 	std::promise<boost::optional<uint64_t>> promise;
 	work_generate (
 	version_a, root_a, difficulty_a, [&promise] (boost::optional<uint64_t> opt_work_a) {
 		promise.set_value (opt_work_a);
 	},
-	account_a);
+	account_a, false, priority_a);
 	return promise.get_future ().get ();
 }
 
@@ -1577,6 +1500,7 @@ nano::node_flags const & nano::inactive_node_flag_defaults ()
 	node_flags.generate_cache.cemented_count = false;
 	node_flags.generate_cache.unchecked_count = false;
 	node_flags.generate_cache.account_count = false;
+	node_flags.generate_cache.receivable = false;
 	node_flags.disable_bootstrap_listener = true;
 	node_flags.disable_tcp_realtime = true;
 	return node_flags;
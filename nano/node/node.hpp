@@ -20,6 +20,7 @@
 #include <nano/node/epoch_upgrader.hpp>
 #include <nano/node/gap_cache.hpp>
 #include <nano/node/gap_tracker.hpp>
+#include <nano/node/http_callbacks.hpp>
 #include <nano/node/network.hpp>
 #include <nano/node/node_observers.hpp>
 #include <nano/node/nodeconfig.hpp>
@@ -66,6 +67,7 @@ std::unique_ptr<container_info_component> collect_container_info (rep_crawler &
 backlog_population::config backlog_population_config (node_config const &);
 vote_cache::config nodeconfig_to_vote_cache_config (node_config const &, node_flags const &);
 outbound_bandwidth_limiter::config outbound_bandwidth_limiter_config (node_config const &);
+generate_cache ledger_generate_cache (node_config const &, node_flags const &);
 
 class node final : public std::enable_shared_from_this<nano::node>
 {
@@ -118,8 +120,8 @@ public:
 	bool work_generation_enabled () const;
 	bool work_generation_enabled (std::vector<std::pair<std::string, uint16_t>> const &) const;
 	boost::optional<uint64_t> work_generate_blocking (nano::block &, uint64_t);
-	boost::optional<uint64_t> work_generate_blocking (nano::work_version const, nano::root const &, uint64_t, boost::optional<nano::account> const & = boost::none);
-	void work_generate (nano::work_version const, nano::root const &, uint64_t, std::function<void (boost::optional<uint64_t>)>, boost::optional<nano::account> const & = boost::none, bool const = false);
+	boost::optional<uint64_t> work_generate_blocking (nano::work_version const, nano::root const &, uint64_t, boost::optional<nano::account> const & = boost::none, nano::work_priority const = nano::work_priority::interactive);
+	void work_generate (nano::work_version const, nano::root const &, uint64_t, std::function<void (boost::optional<uint64_t>)>, boost::optional<nano::account> const & = boost::none, bool const = false, nano::work_priority const = nano::work_priority::interactive);
 	void add_initial_peers ();
 	/*
 	 * Starts an election for the block, DOES NOT confirm it
@@ -128,7 +130,6 @@ public:
 	std::shared_ptr<nano::election> block_confirm (std::shared_ptr<nano::block> const &);
 	bool block_confirmed (nano::block_hash const &);
 	bool block_confirmed_or_being_confirmed (nano::block_hash const &);
-	void do_rpc_callback (boost::asio::ip::tcp::resolver::iterator i_a, std::string const &, uint16_t, std::shared_ptr<std::string> const &, std::shared_ptr<std::string> const &, std::shared_ptr<boost::asio::ip::tcp::resolver> const &);
 	void ongoing_online_weight_calculation ();
 	void ongoing_online_weight_calculation_queue ();
 	bool online () const;
@@ -198,6 +199,7 @@ public:
 	nano::backlog_population backlog;
 	nano::bootstrap_ascending::service ascendboot;
 	nano::websocket_server websocket;
+	std::shared_ptr<nano::http_callbacks> http_callbacks;
 	nano::epoch_upgrader epoch_upgrader;
 	nano::block_broadcast block_broadcast;
 	nano::block_publisher block_publisher;
@@ -7,6 +7,7 @@
 nano::error nano::node_rpc_config::serialize_toml (nano::tomlconfig & toml) const
 {
 	toml.put ("enable_sign_hash", enable_sign_hash, "Allow or disallow signing of hashes.\ntype:bool");
+	toml.put ("bulk_parallelism", bulk_parallelism, "Maximum number of threads used by a single bulk request such as accounts_balances or blocks_info. A value of 1 processes requests on the calling thread only.\ntype:uint32");
 
 	nano::tomlconfig child_process_l;
 	child_process_l.put ("enable", child_process.enable, "Enable or disable RPC child process. If false, an in-process RPC server is used.\ntype:bool");
@@ -19,6 +20,11 @@ nano::error nano::node_rpc_config::deserialize_toml (nano::tomlconfig & toml)
 {
 	toml.get_optional ("enable_sign_hash", enable_sign_hash);
 	toml.get_optional<bool> ("enable_sign_hash", enable_sign_hash);
+	toml.get_optional<unsigned> ("bulk_parallelism", bulk_parallelism);
+	if (bulk_parallelism == 0)
+	{
+		toml.get_error ().set ("bulk_parallelism must be at least 1");
+	}
 
 	auto child_process_l (toml.get_optional_child ("child_process"));
 	if (child_process_l)
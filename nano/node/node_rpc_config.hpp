@@ -31,6 +31,8 @@ public:
 	nano::error deserialize_toml (nano::tomlconfig & toml);
 
 	bool enable_sign_hash{ false };
+	/** Threads, including the one handling the request, which may process the input list of a single bulk request */
+	unsigned bulk_parallelism{ 4 };
 	nano::rpc_child_process_config child_process;
 
 	// Used in tests to ensure requests are modified in specific cases
@@ -94,13 +94,18 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("io_threads", io_threads, "Number of threads dedicated to I/O operations. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
 	toml.put ("network_threads", network_threads, "Number of threads dedicated to processing network messages. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
 	toml.put ("work_threads", work_threads, "Number of threads dedicated to CPU generated work. Defaults to all available CPU threads.\ntype:uint64");
+	toml.put ("work_cache_concurrency", work_cache_concurrency, "Number of wallet accounts precaching work for their next block at the same time, using background work priority. 0 disables precaching.\ntype:uint64");
 	toml.put ("background_threads", background_threads, "Number of threads dedicated to background node work, including handling of RPC requests. Defaults to all available CPU threads.\ntype:uint64");
 	toml.put ("signature_checker_threads", signature_checker_threads, "Number of additional threads dedicated to signature verification. Defaults to number of CPU threads / 2.\ntype:uint64");
+	toml.put ("work_validation_threads", work_validation_threads, "Number of threads validating the work of incoming blocks in batches. 0 validates on the receiving thread. Defaults to number of CPU threads / 4, between 1 and 4.\ntype:uint64");
 	toml.put ("enable_voting", enable_voting, "Enable or disable voting. Enabling this option requires additional system resources, namely increased CPU, bandwidth and disk usage.\ntype:bool");
+	toml.put ("enable_receivable_summary", enable_receivable_summary, "Keep an in-memory summary of receivable amounts per account, which lets receivable queries with a threshold skip accounts without a qualifying entry. Enabling this scans the whole pending table at startup and uses memory for every account with receivable blocks.\ntype:bool");
 	toml.put ("bootstrap_connections", bootstrap_connections, "Number of outbound bootstrap connections. Must be a power of 2. Defaults to 4.\nWarning: a larger amount of connections may use substantially more system memory.\ntype:uint64");
 	toml.put ("bootstrap_connections_max", bootstrap_connections_max, "Maximum number of inbound bootstrap connections. Defaults to 64.\nWarning: a larger amount of connections may use additional system memory.\ntype:uint64");
 	toml.put ("bootstrap_initiator_threads", bootstrap_initiator_threads, "Number of threads dedicated to concurrent bootstrap attempts. Defaults to 1.\nWarning: a larger amount of attempts may use additional system memory and disk IO.\ntype:uint64");
 	toml.put ("bootstrap_serving_threads", bootstrap_serving_threads, "Number of threads dedicated to serving bootstrap data to other peers. Defaults to half the number of CPU threads, and at least 2.\ntype:uint64");
+	toml.put ("bootstrap_serving_batch_size", bootstrap_serving_batch_size, "Number of blocks, frontiers or receivable entries read under one database transaction and sent with one socket write when serving legacy bootstrap requests. Defaults to 128.\ntype:uint64");
+	toml.put ("bootstrap_serving_max_in_flight", bootstrap_serving_max_in_flight, "Number of chunks written at the same time per connection when serving legacy bootstrap requests. Defaults to 4.\ntype:uint64,[1..128]");
 	toml.put ("bootstrap_frontier_request_count", bootstrap_frontier_request_count, "Number frontiers per bootstrap frontier request. Defaults to 1048576.\ntype:uint32,[1024..4294967295]");
 	toml.put ("block_processor_batch_max_time", block_processor_batch_max_time.count (), "The maximum time the block processor can continuously process blocks for.\ntype:milliseconds");
 	toml.put ("block_process_timeout", block_process_timeout.count (), "Time to wait for block processing result.\ntype:seconds");
@@ -109,6 +114,7 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("vote_generator_delay", vote_generator_delay.count (), "Delay before votes are sent to allow for efficient bundling of hashes in votes.\ntype:milliseconds");
 	toml.put ("vote_generator_threshold", vote_generator_threshold, "Number of bundled hashes required for an additional generator delay.\ntype:uint64,[1..11]");
 	toml.put ("unchecked_cutoff_time", unchecked_cutoff_time.count (), "Number of seconds before deleting an unchecked entry.\nWarning: lower values (e.g., 3600 seconds, or 1 hour) may result in unsuccessful bootstraps, especially a bootstrap from scratch.\ntype:seconds");
+	toml.put ("unchecked_spill_max", unchecked_spill_max, "Maximum number of unchecked blocks kept on disk once the in-memory limit is reached. The oldest are dropped beyond this.\ntype:uint64");
 	toml.put ("tcp_io_timeout", tcp_io_timeout.count (), "Timeout for TCP connect-, read- and write operations.\nWarning: a low value (e.g., below 5 seconds) may result in TCP connections failing.\ntype:seconds");
 	toml.put ("pow_sleep_interval", pow_sleep_interval.count (), "Time to sleep between batch work generation attempts. Reduces max CPU usage at the expense of a longer generation time.\ntype:nanoseconds");
 	toml.put ("external_address", external_address, "The external address of this node (NAT). If not set, the node will request this information via UPnP.\ntype:string,ip");
@@ -166,6 +172,10 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	callback_l.put ("address", callback_address, "Callback address.\ntype:string,ip");
 	callback_l.put ("port", callback_port, "Callback port number.\ntype:uint16");
 	callback_l.put ("target", callback_target, "Callback target path.\ntype:string,uri");
+	callback_l.put ("connections", callback_connections, "Number of keep-alive connections used to deliver callbacks.\ntype:uint32");
+	callback_l.put ("batch_max", callback_batch_max, "Maximum number of events per callback request. With a value above 1 every request body is a JSON array of events.\ntype:uint32");
+	callback_l.put ("queue_max", callback_queue_max, "Maximum number of callbacks waiting for delivery, further callbacks are dropped.\ntype:uint64");
+	callback_l.put ("retries", callback_retries, "Number of times a failed callback is retried with exponential backoff before it is dropped.\ntype:uint32");
 	toml.put_child ("httpcallback", callback_l);
 
 	nano::tomlconfig logging_l;
@@ -217,6 +227,10 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 			callback_l.get<std::string> ("address", callback_address);
 			callback_l.get<uint16_t> ("port", callback_port);
 			callback_l.get<std::string> ("target", callback_target);
+			callback_l.get<unsigned> ("connections", callback_connections);
+			callback_l.get<unsigned> ("batch_max", callback_batch_max);
+			callback_l.get<std::size_t> ("queue_max", callback_queue_max);
+			callback_l.get<unsigned> ("retries", callback_retries);
 		}
 
 		if (toml.has_key ("logging"))
@@ -349,6 +363,8 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get ("unchecked_cutoff_time", unchecked_cutoff_time_l);
 		unchecked_cutoff_time = std::chrono::seconds (unchecked_cutoff_time_l);
 
+		toml.get<std::size_t> ("unchecked_spill_max", unchecked_spill_max);
+
 		auto tcp_io_timeout_l = static_cast<unsigned long> (tcp_io_timeout.count ());
 		toml.get ("tcp_io_timeout", tcp_io_timeout_l);
 		tcp_io_timeout = std::chrono::seconds (tcp_io_timeout_l);
@@ -371,10 +387,15 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get<unsigned> ("bootstrap_connections_max", bootstrap_connections_max);
 		toml.get<unsigned> ("bootstrap_initiator_threads", bootstrap_initiator_threads);
 		toml.get<unsigned> ("bootstrap_serving_threads", bootstrap_serving_threads);
+		toml.get<unsigned> ("bootstrap_serving_batch_size", bootstrap_serving_batch_size);
+		toml.get<unsigned> ("bootstrap_serving_max_in_flight", bootstrap_serving_max_in_flight);
 		toml.get<uint32_t> ("bootstrap_frontier_request_count", bootstrap_frontier_request_count);
 		toml.get<bool> ("enable_voting", enable_voting);
+		toml.get<bool> ("enable_receivable_summary", enable_receivable_summary);
 		toml.get<bool> ("allow_local_peers", allow_local_peers);
 		toml.get<unsigned> (signature_checker_threads_key, signature_checker_threads);
+		toml.get<unsigned> ("work_validation_threads", work_validation_threads);
+		toml.get<unsigned> ("work_cache_concurrency", work_cache_concurrency);
 
 		if (toml.has_key ("lmdb"))
 		{
@@ -483,6 +504,11 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		{
 			toml.get_error ().set ((boost::format ("block_processor_batch_max_time value must be equal or larger than %1%ms") % network_params.node.process_confirmed_interval.count ()).str ());
 		}
+		// Each chunk is one socket write, more in flight than the socket queues would drop writes
+		if (bootstrap_serving_max_in_flight < 1 || bootstrap_serving_max_in_flight > nano::transport::socket::default_max_queue_size)
+		{
+			toml.get_error ().set ((boost::format ("bootstrap_serving_max_in_flight must be a number between 1 and %1%") % nano::transport::socket::default_max_queue_size).str ());
+		}
 		if (max_pruning_age < std::chrono::seconds (5 * 60) && !network_params.network.is_dev_network ())
 		{
 			toml.get_error ().set ("max_pruning_age must be greater than or equal to 5 minutes");
@@ -64,14 +64,24 @@ public:
 	unsigned io_threads{ std::max (4u, nano::hardware_concurrency ()) };
 	unsigned network_threads{ std::max (4u, nano::hardware_concurrency ()) };
 	unsigned work_threads{ std::max (4u, nano::hardware_concurrency ()) };
+	/* Wallet accounts generating next-block work in the background at the same time, bounding the CPU used for precaching. Zero disables precaching */
+	unsigned work_cache_concurrency{ 1 };
 	unsigned background_threads{ std::max (4u, nano::hardware_concurrency ()) };
 	/* Use half available threads on the system for signature checking. The calling thread does checks as well, so these are extra worker threads */
 	unsigned signature_checker_threads{ std::max (2u, nano::hardware_concurrency () / 2) };
+	/* Threads validating the work of incoming blocks in batches ahead of the block processor. Zero validates on the calling thread */
+	unsigned work_validation_threads{ std::min (4u, std::max (1u, nano::hardware_concurrency () / 4)) };
 	bool enable_voting{ false };
+	/** Keeps nano::receivable_summary in the ledger cache, see generate_cache::receivable */
+	bool enable_receivable_summary{ false };
 	unsigned bootstrap_connections{ 4 };
 	unsigned bootstrap_connections_max{ 64 };
 	unsigned bootstrap_initiator_threads{ 1 };
 	unsigned bootstrap_serving_threads{ std::max (2u, nano::hardware_concurrency () / 2) };
+	/* Blocks, frontiers or receivable entries read under one transaction and sent with one socket write when serving legacy bootstrap */
+	unsigned bootstrap_serving_batch_size{ 128 };
+	/* Chunks written at the same time per legacy bootstrap serving connection */
+	unsigned bootstrap_serving_max_in_flight{ 4 };
 	uint32_t bootstrap_frontier_request_count{ 1024 * 1024 };
 	nano::websocket::config websocket_config;
 	nano::diagnostics_config diagnostics_config;
@@ -79,6 +89,12 @@ public:
 	std::string callback_address;
 	uint16_t callback_port{ 0 };
 	std::string callback_target;
+	/** Keep-alive connections used to deliver callbacks */
+	unsigned callback_connections{ 4 };
+	/** With more than one, callbacks are delivered as JSON arrays of up to this many events */
+	unsigned callback_batch_max{ 1 };
+	std::size_t callback_queue_max{ 16 * 1024 };
+	unsigned callback_retries{ 3 };
 	bool allow_local_peers{ !(network_params.network.is_live_network () || network_params.network.is_test_network ()) }; // disable by default for live network
 	nano::stats_config stats_config;
 	nano::ipc::ipc_config ipc_config;
@@ -88,6 +104,7 @@ public:
 	/** Time to wait for block processing result */
 	std::chrono::seconds block_process_timeout{ 15 };
 	std::chrono::seconds unchecked_cutoff_time{ std::chrono::seconds (4 * 60 * 60) }; // 4 hours
+	std::size_t unchecked_spill_max{ 1024 * 1024 };
 	/** Timeout for initiated async operations */
 	std::chrono::seconds tcp_io_timeout{ (network_params.network.is_dev_network () && !is_sanitizer_build ()) ? std::chrono::seconds (5) : std::chrono::seconds (15) };
 	std::chrono::nanoseconds pow_sleep_interval{ 0 };
@@ -151,6 +168,7 @@ public:
 	bool disable_tcp_realtime{ false };
 	bool disable_unchecked_cleanup{ false };
 	bool disable_unchecked_drop{ true };
+	bool disable_unchecked_spill{ false };
 	bool disable_providing_telemetry_metrics{ false };
 	bool disable_ongoing_telemetry_requests{ false };
 	bool disable_block_processor_unchecked_deletion{ false };
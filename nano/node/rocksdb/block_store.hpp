@@ -24,6 +24,7 @@ namespace rocksdb
 		void successor_clear (nano::write_transaction const & transaction_a, nano::block_hash const & hash_a) override;
 		std::shared_ptr<nano::block> get (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const override;
 		std::shared_ptr<nano::block> get_no_sideband (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const override;
+		bool get_serialized (nano::transaction const & transaction_a, nano::block_hash const & hash_a, std::vector<uint8_t> & buffer_a, nano::block_hash & successor_a) const override;
 		std::shared_ptr<nano::block> random (nano::transaction const & transaction_a) override;
 		void del (nano::write_transaction const & transaction_a, nano::block_hash const & hash_a) override;
 		bool exists (nano::transaction const & transaction_a, nano::block_hash const & hash_a) override;
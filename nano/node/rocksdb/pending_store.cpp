@@ -33,13 +33,12 @@ bool nano::rocksdb::pending_store::get (nano::transaction const & transaction, n
 
 bool nano::rocksdb::pending_store::exists (nano::transaction const & transaction_a, nano::pending_key const & key_a)
 {
-	auto iterator (begin (transaction_a, key_a));
-	return iterator != end () && nano::pending_key (iterator->first) == key_a;
+	return store.exists (transaction_a, tables::pending, key_a);
 }
 
 bool nano::rocksdb::pending_store::any (nano::transaction const & transaction_a, nano::account const & account_a)
 {
-	auto iterator (begin (transaction_a, nano::pending_key (account_a, 0)));
+	auto iterator (begin (transaction_a, account_a));
 	return iterator != end () && nano::pending_key (iterator->first).account == account_a;
 }
 
@@ -53,6 +52,11 @@ nano::store_iterator<nano::pending_key, nano::pending_info> nano::rocksdb::pendi
 	return store.template make_iterator<nano::pending_key, nano::pending_info> (transaction_a, tables::pending);
 }
 
+nano::store_iterator<nano::pending_key, nano::pending_info> nano::rocksdb::pending_store::begin (nano::transaction const & transaction_a, nano::account const & account_a) const
+{
+	return store.template make_prefix_iterator<nano::pending_key, nano::pending_info> (transaction_a, tables::pending, nano::pending_key (account_a, 0));
+}
+
 nano::store_iterator<nano::pending_key, nano::pending_info> nano::rocksdb::pending_store::end () const
 {
 	return nano::store_iterator<nano::pending_key, nano::pending_info> (nullptr);
@@ -10,6 +10,7 @@
 #include <rocksdb/merge_operator.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/slice_transform.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/utilities/backup_engine.h>
 #include <rocksdb/utilities/transaction.h>
 
@@ -341,14 +342,15 @@ rocksdb::ColumnFamilyOptions nano::rocksdb::store::get_cf_options (std::string c
 	auto const block_cache_size_bytes = 1024ULL * 1024 * rocksdb_config.memory_multiplier * base_block_cache_size;
 	if (cf_name_a == "blocks")
 	{
-		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 4)));
+		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_profile_table_options (rocksdb_config.blocks_profile, block_cache_size_bytes * 4)));
 		cf_options = get_active_cf_options (table_factory, blocks_memtable_size_bytes ());
 	}
 	else if (cf_name_a == "confirmation_height")
 	{
 		// Entries will not be deleted in the normal case, so can make memtables a lot bigger
-		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_profile_table_options (rocksdb_config.confirmation_height_profile, block_cache_size_bytes)));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes * 2);
+		apply_profile_cf_options (rocksdb_config.confirmation_height_profile, cf_options);
 	}
 	else if (cf_name_a == "meta" || cf_name_a == "online_weight" || cf_name_a == "peers")
 	{
@@ -365,8 +367,9 @@ rocksdb::ColumnFamilyOptions nano::rocksdb::store::get_cf_options (std::string c
 	else if (cf_name_a == "pending")
 	{
 		// Pending can have a lot of deletions too
-		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_profile_table_options (rocksdb_config.pending_profile, block_cache_size_bytes)));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+		apply_profile_cf_options (rocksdb_config.pending_profile, cf_options);
 
 		// Number of files in level 0 which triggers compaction. Size of L0 and L1 should be kept similar as this is the only compaction which is single threaded
 		cf_options.level0_file_num_compaction_trigger = 2;
@@ -383,8 +386,9 @@ rocksdb::ColumnFamilyOptions nano::rocksdb::store::get_cf_options (std::string c
 	else if (cf_name_a == "accounts")
 	{
 		// Can have deletions from rollbacks
-		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
+		std::shared_ptr<::rocksdb::TableFactory> table_factory (::rocksdb::NewBlockBasedTableFactory (get_profile_table_options (rocksdb_config.accounts_profile, block_cache_size_bytes * 2)));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+		apply_profile_cf_options (rocksdb_config.accounts_profile, cf_options);
 	}
 	else if (cf_name_a == "vote")
 	{
@@ -447,7 +451,7 @@ nano::write_transaction nano::rocksdb::store::tx_begin_write (std::vector<nano::
 
 nano::read_transaction nano::rocksdb::store::tx_begin_read () const
 {
-	return nano::read_transaction{ std::make_unique<nano::read_rocksdb_txn> (db.get ()) };
+	return nano::read_transaction{ std::make_unique<nano::read_rocksdb_txn> (db.get ()), rocksdb_config.max_read_txn_age };
 }
 
 std::string nano::rocksdb::store::vendor_get () const
@@ -817,6 +821,51 @@ rocksdb::BlockBasedTableOptions nano::rocksdb::store::get_active_table_options (
 	return table_options;
 }
 
+rocksdb::BlockBasedTableOptions nano::rocksdb::store::get_profile_table_options (nano::rocksdb_config::table_profile profile_a, std::size_t lru_size) const
+{
+	auto table_options = get_active_table_options (lru_size);
+	switch (profile_a)
+	{
+		case nano::rocksdb_config::table_profile::standard:
+			break;
+		case nano::rocksdb_config::table_profile::prefix_bloom:
+			// The bloom filter also covers key prefixes once the prefix extractor is set in apply_profile_cf_options
+			break;
+		case nano::rocksdb_config::table_profile::point_lookup:
+			// Ribbon filters use ~30% less memory than bloom filters for the same false positive rate
+			table_options.filter_policy.reset (::rocksdb::NewRibbonFilterPolicy (10));
+
+			// Partition index and filters so only the top level needs to stay in memory, the partitions are loaded through the block cache
+			table_options.index_type = ::rocksdb::BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch;
+			table_options.partition_filters = true;
+			table_options.cache_index_and_filter_blocks = true;
+			table_options.cache_index_and_filter_blocks_with_high_priority = true;
+			table_options.pin_top_level_index_and_filter = true;
+			break;
+		case nano::rocksdb_config::table_profile::hash_index:
+			// Requires the prefix extractor set in apply_profile_cf_options
+			table_options.index_type = ::rocksdb::BlockBasedTableOptions::IndexType::kHashSearch;
+			break;
+	}
+	return table_options;
+}
+
+void nano::rocksdb::store::apply_profile_cf_options (nano::rocksdb_config::table_profile profile_a, ::rocksdb::ColumnFamilyOptions & cf_options_a) const
+{
+	switch (profile_a)
+	{
+		case nano::rocksdb_config::table_profile::prefix_bloom:
+		case nano::rocksdb_config::table_profile::hash_index:
+			// Both pending keys (account + hash) and account keys start with the 32 byte account.
+			// Single account scans use prefix bounded iterators and keep the prefix bloom, other iterators use total order seek (see rocksdb_iterator).
+			cf_options_a.prefix_extractor.reset (::rocksdb::NewFixedPrefixTransform (sizeof (nano::account)));
+			cf_options_a.memtable_prefix_bloom_size_ratio = 0.1;
+			break;
+		default:
+			break;
+	}
+}
+
 rocksdb::BlockBasedTableOptions nano::rocksdb::store::get_small_table_options () const
 {
 	::rocksdb::BlockBasedTableOptions table_options;
@@ -943,7 +992,122 @@ bool nano::rocksdb::store::copy_db (boost::filesystem::path const & destination_
 
 void nano::rocksdb::store::rebuild_db (nano::write_transaction const & transaction_a)
 {
-	// Not available for RocksDB
+	// Rewrite every SST file directly, there is no need to replay records through the memtables
+	::rocksdb::CompactRangeOptions compact_options;
+	compact_options.bottommost_level_compaction = ::rocksdb::BottommostLevelCompaction::kForce;
+	for (auto const & handle : handles)
+	{
+		auto status = db->CompactRange (compact_options, handle.get (), nullptr, nullptr);
+		release_assert (status.ok (), status.ToString ());
+	}
+}
+
+template <typename Source, typename ToValue>
+bool nano::rocksdb::store::ingest (tables table_a, Source const & source_a, ToValue const & to_value_a, uint64_t & count_a)
+{
+	auto column_family = table_to_column_family (table_a);
+	auto options = db->GetOptions (column_family);
+	auto ingest_path = boost::filesystem::path (db->GetName ()) / "ingest";
+	boost::filesystem::create_directories (ingest_path);
+
+	nano::locked<std::vector<std::string>> files;
+	std::atomic<uint64_t> count{ 0 };
+	std::atomic<unsigned> file_id{ 0 };
+	std::atomic<bool> error{ false };
+	// for_each_par ranges are sorted and do not overlap, so each range produces an independent SST file
+	source_a.for_each_par ([&] (nano::read_transaction const & /*unused*/, auto i, auto n) {
+		if (i == n)
+		{
+			// Empty SST files cannot be finished
+			return;
+		}
+		auto file = (ingest_path / boost::str (boost::format ("%1%_%2%.sst") % column_family->GetName () % file_id++)).string ();
+		::rocksdb::SstFileWriter writer{ ::rocksdb::EnvOptions{}, options, column_family };
+		auto status = writer.Open (file);
+		uint64_t written{ 0 };
+		for (; i != n && status.ok (); ++i, ++written)
+		{
+			status = writer.Put (nano::rocksdb_val{ i->first }, to_value_a (i->second));
+		}
+		if (status.ok ())
+		{
+			status = writer.Finish ();
+		}
+		if (status.ok ())
+		{
+			files.lock ()->push_back (file);
+			count += written;
+		}
+		else
+		{
+			logger.always_log (boost::str (boost::format ("Failed writing SST file %1%: %2%") % file % status.ToString ()));
+			error = true;
+		}
+	});
+
+	auto files_l = files.lock ();
+	if (!error && !files_l->empty ())
+	{
+		// All files of a table are ingested atomically, moving them into the database directory instead of copying
+		::rocksdb::IngestExternalFileOptions ingest_options;
+		ingest_options.move_files = true;
+		auto status = db->IngestExternalFile (column_family, *files_l, ingest_options);
+		if (!status.ok ())
+		{
+			logger.always_log (boost::str (boost::format ("Failed ingesting into %1%: %2%") % column_family->GetName () % status.ToString ()));
+			error = true;
+		}
+	}
+	for (auto const & file : *files_l)
+	{
+		boost::system::error_code ec;
+		boost::filesystem::remove (file, ec);
+	}
+	count_a = count;
+	return error;
+}
+
+bool nano::rocksdb::store::bulk_load (nano::store & source_a, std::function<void (std::string const &, uint64_t)> const & progress_a)
+{
+	auto error (false);
+	auto ingest_l = [this, &error, &progress_a] (tables table_a, std::string const & name_a, auto const & table_source_a, auto const & to_value_a) {
+		if (!error)
+		{
+			uint64_t count{ 0 };
+			error = ingest (table_a, table_source_a, to_value_a, count);
+			if (!error && progress_a)
+			{
+				progress_a (name_a, count);
+			}
+		}
+	};
+	auto identity = [] (auto const & value_a) {
+		return nano::rocksdb_val{ value_a };
+	};
+
+	ingest_l (tables::blocks, "blocks", source_a.block, [] (nano::block_w_sideband const & value_a) {
+		nano::rocksdb_val value;
+		value.buffer = std::make_shared<std::vector<uint8_t>> ();
+		{
+			nano::vectorstream stream (*value.buffer);
+			nano::serialize_block (stream, *value_a.block);
+			value_a.sideband.serialize (stream, value_a.block->type ());
+		}
+		value.convert_buffer_to_value ();
+		return value;
+	});
+	ingest_l (tables::pending, "pending", source_a.pending, identity);
+	ingest_l (tables::confirmation_height, "confirmation_height", source_a.confirmation_height, identity);
+	ingest_l (tables::accounts, "accounts", source_a.account, identity);
+	ingest_l (tables::frontiers, "frontiers", source_a.frontier, identity);
+	ingest_l (tables::pruned, "pruned", source_a.pruned, [] (std::nullptr_t) {
+		return nano::rocksdb_val{ nullptr };
+	});
+	ingest_l (tables::final_votes, "final_votes", source_a.final_vote, identity);
+
+	boost::system::error_code ec;
+	boost::filesystem::remove_all (boost::filesystem::path (db->GetName ()) / "ingest", ec);
+	return error;
 }
 
 bool nano::rocksdb::store::init_error () const
@@ -3,6 +3,7 @@
 #include <nano/lib/config.hpp>
 #include <nano/lib/logger_mt.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/rocksdbconfig.hpp>
 #include <nano/node/rocksdb/account_store.hpp>
 #include <nano/node/rocksdb/block_store.hpp>
 #include <nano/node/rocksdb/confirmation_height_store.hpp>
@@ -26,7 +27,6 @@
 namespace nano
 {
 class logging_mt;
-class rocksdb_config;
 class rocksdb_block_store_tombstone_count_Test;
 
 namespace rocksdb
@@ -80,6 +80,7 @@ namespace rocksdb
 
 		bool copy_db (boost::filesystem::path const & destination) override;
 		void rebuild_db (nano::write_transaction const & transaction_a) override;
+		bool bulk_load (nano::store & source_a, std::function<void (std::string const &, uint64_t)> const & progress_a) override;
 
 		unsigned max_block_write_batch_num () const override;
 
@@ -95,6 +96,13 @@ namespace rocksdb
 			return nano::store_iterator<Key, Value> (std::make_unique<nano::rocksdb_iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), &key, true));
 		}
 
+		/** Iterates only the keys sharing the table's prefix extractor prefix with \p key, which keeps the prefix bloom in use */
+		template <typename Key, typename Value>
+		nano::store_iterator<Key, Value> make_prefix_iterator (nano::transaction const & transaction_a, tables table_a, nano::rocksdb_val const & key) const
+		{
+			return nano::store_iterator<Key, Value> (std::make_unique<nano::rocksdb_iterator<Key, Value>> (db.get (), transaction_a, table_to_column_family (table_a), &key, true, true));
+		}
+
 		bool init_error () const override;
 
 		std::string error_string (int status) const override;
@@ -157,8 +165,13 @@ namespace rocksdb
 		::rocksdb::ColumnFamilyOptions get_small_cf_options (std::shared_ptr<::rocksdb::TableFactory> const & table_factory_a) const;
 		::rocksdb::BlockBasedTableOptions get_active_table_options (std::size_t lru_size) const;
 		::rocksdb::BlockBasedTableOptions get_small_table_options () const;
+		::rocksdb::BlockBasedTableOptions get_profile_table_options (nano::rocksdb_config::table_profile, std::size_t lru_size) const;
+		void apply_profile_cf_options (nano::rocksdb_config::table_profile, ::rocksdb::ColumnFamilyOptions &) const;
 		::rocksdb::ColumnFamilyOptions get_cf_options (std::string const & cf_name_a) const;
 
+		template <typename Source, typename ToValue>
+		bool ingest (tables table_a, Source const & source_a, ToValue const & to_value_a, uint64_t & count_a);
+
 		void on_flush (::rocksdb::FlushJobInfo const &);
 		void flush_table (nano::tables table_a);
 		void flush_tombstones_check (nano::tables table_a);
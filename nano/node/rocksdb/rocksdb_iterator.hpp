@@ -32,19 +32,23 @@ class rocksdb_iterator : public store_iterator_impl<T, U>
 public:
 	rocksdb_iterator () = default;
 
-	rocksdb_iterator (::rocksdb::DB * db, nano::transaction const & transaction_a, ::rocksdb::ColumnFamilyHandle * handle_a, rocksdb_val const * val_a, bool const direction_asc)
+	rocksdb_iterator (::rocksdb::DB * db, nano::transaction const & transaction_a, ::rocksdb::ColumnFamilyHandle * handle_a, rocksdb_val const * val_a, bool const direction_asc, bool const prefix_bounded = false)
 	{
-		// Don't fill the block cache for any blocks read as a result of an iterator
+		// Don't fill the block cache for any blocks read as a result of an iterator.
+		// A prefix bounded iterator stops at the end of the seek key's prefix, which lets tables configured with a prefix extractor use their prefix bloom.
+		// All other iterators can cross key prefixes, so they need total order seek.
 		if (is_read (transaction_a))
 		{
 			auto read_options = snapshot_options (transaction_a);
 			read_options.fill_cache = false;
+			set_seek_mode (read_options, prefix_bounded);
 			cursor.reset (db->NewIterator (read_options, handle_a));
 		}
 		else
 		{
 			::rocksdb::ReadOptions ropts;
 			ropts.fill_cache = false;
+			set_seek_mode (ropts, prefix_bounded);
 			cursor.reset (tx (transaction_a)->GetIterator (ropts, handle_a));
 		}
 
@@ -201,5 +205,11 @@ private:
 	{
 		return static_cast<::rocksdb::Transaction *> (transaction_a.get_handle ());
 	}
+
+	static void set_seek_mode (::rocksdb::ReadOptions & options_a, bool const prefix_bounded_a)
+	{
+		options_a.total_order_seek = !prefix_bounded_a;
+		options_a.prefix_same_as_start = prefix_bounded_a;
+	}
 };
 }
@@ -3,6 +3,7 @@
 #include <nano/lib/locks.hpp>
 #include <nano/secure/common.hpp>
 
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <thread>
@@ -17,7 +18,8 @@ class signature_checker;
 class state_block_signature_verification
 {
 public:
-	using value_type = std::tuple<std::shared_ptr<nano::block>>;
+	/** Block and the time it was handed to the block processor */
+	using value_type = std::tuple<std::shared_ptr<nano::block>, std::chrono::steady_clock::time_point>;
 
 	state_block_signature_verification (nano::signature_checker &, nano::epochs &, nano::node_config &, nano::logger_mt &, uint64_t);
 	~state_block_signature_verification ();
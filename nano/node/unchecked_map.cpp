@@ -3,11 +3,312 @@
 #include <nano/lib/stats_enums.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/lib/timer.hpp>
+#include <nano/node/lmdb/lmdb_env.hpp>
 #include <nano/node/unchecked_map.hpp>
 
-nano::unchecked_map::unchecked_map (nano::stats & stats, bool const & disable_delete) :
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+
+namespace
+{
+std::array<uint8_t, 64> spill_key (nano::unchecked_key const & key_a)
+{
+	std::array<uint8_t, 64> result;
+	std::copy (key_a.previous.bytes.begin (), key_a.previous.bytes.end (), result.begin ());
+	std::copy (key_a.hash.bytes.begin (), key_a.hash.bytes.end (), result.begin () + 32);
+	return result;
+}
+
+nano::unchecked_key spill_key (MDB_val const & value_a)
+{
+	debug_assert (value_a.mv_size == 64);
+	nano::unchecked_key result;
+	auto data (static_cast<uint8_t const *> (value_a.mv_data));
+	std::copy (data, data + 32, result.previous.bytes.begin ());
+	std::copy (data + 32, data + 64, result.hash.bytes.begin ());
+	return result;
+}
+
+/** Big endian so the insertion order table iterates oldest first */
+uint64_t spill_sequence_key (uint64_t sequence_a)
+{
+	return boost::endian::native_to_big (sequence_a);
+}
+
+/** Returns the sequence prefix of a stored value as it is encoded, ready to be used as an insertion order key */
+uint64_t spill_sequence (MDB_val const & value_a)
+{
+	debug_assert (value_a.mv_size >= sizeof (uint64_t));
+	uint64_t result;
+	std::copy_n (static_cast<uint8_t const *> (value_a.mv_data), sizeof (result), reinterpret_cast<uint8_t *> (&result));
+	return result;
+}
+
+nano::unchecked_info spill_info (MDB_val const & value_a)
+{
+	nano::unchecked_info result;
+	nano::bufferstream stream (static_cast<uint8_t const *> (value_a.mv_data) + sizeof (uint64_t), value_a.mv_size - sizeof (uint64_t));
+	auto error (result.deserialize (stream));
+	(void)error;
+	debug_assert (!error);
+	return result;
+}
+
+/** Deletes an entry, given its key and value, together with its insertion order record */
+void spill_erase (MDB_txn * transaction_a, unsigned handle_a, unsigned order_handle_a, MDB_val & key_a, MDB_val const & value_a)
+{
+	auto sequence (spill_sequence (value_a));
+	MDB_val order_key{ sizeof (sequence), &sequence };
+	release_assert (!mdb_del (transaction_a, order_handle_a, &order_key, nullptr));
+	release_assert (!mdb_del (transaction_a, handle_a, &key_a, nullptr));
+}
+}
+
+nano::unchecked_spill::unchecked_spill (boost::filesystem::path const & path_a, std::size_t max_entries_a) :
+	path{ path_a },
+	max_entries{ max_entries_a }
+{
+}
+
+nano::unchecked_spill::~unchecked_spill ()
+{
+	close ();
+}
+
+void nano::unchecked_spill::open ()
+{
+	debug_assert (env == nullptr);
+	// Left over from an unclean shutdown, the dependencies are requested again by bootstrap
+	boost::system::error_code ignored;
+	boost::filesystem::remove (path, ignored);
+	boost::filesystem::remove (path.string () + "-lock", ignored);
+	bool error{ false };
+	env = std::make_unique<nano::mdb_env> (error, path, nano::mdb_env::options::make ().override_config_sync (nano::lmdb_config::sync_strategy::nosync_unsafe));
+	release_assert (!error);
+	auto transaction (env->tx_begin_write ());
+	release_assert (!mdb_dbi_open (env->tx (transaction), "unchecked", MDB_CREATE, &handle));
+	release_assert (!mdb_dbi_open (env->tx (transaction), "order", MDB_CREATE, &order_handle));
+	sequence = 0;
+	entries = 0;
+}
+
+void nano::unchecked_spill::close ()
+{
+	if (env != nullptr)
+	{
+		env.reset ();
+		boost::system::error_code ignored;
+		boost::filesystem::remove (path, ignored);
+		boost::filesystem::remove (path.string () + "-lock", ignored);
+	}
+}
+
+std::size_t nano::unchecked_spill::put (std::vector<std::pair<nano::unchecked_key, nano::unchecked_info>> const & entries_a)
+{
+	if (env == nullptr)
+	{
+		open ();
+	}
+	std::size_t dropped{ 0 };
+	auto transaction (env->tx_begin_write ());
+	auto tx (env->tx (transaction));
+	for (auto const & [key_a, info_a] : entries_a)
+	{
+		auto key_bytes (spill_key (key_a));
+		auto sequence_l (spill_sequence_key (sequence));
+		std::vector<uint8_t> info_bytes;
+		{
+			nano::vectorstream stream (info_bytes);
+			nano::write (stream, sequence_l);
+			info_a.serialize (stream);
+		}
+		MDB_val key{ key_bytes.size (), key_bytes.data () };
+		MDB_val value{ info_bytes.size (), info_bytes.data () };
+		auto status (mdb_put (tx, handle, &key, &value, MDB_NOOVERWRITE));
+		release_assert (status == MDB_SUCCESS || status == MDB_KEYEXIST);
+		if (status == MDB_SUCCESS)
+		{
+			MDB_val order_key{ sizeof (sequence_l), &sequence_l };
+			MDB_val order_value{ key_bytes.size (), key_bytes.data () };
+			release_assert (!mdb_put (tx, order_handle, &order_key, &order_value, MDB_APPEND));
+			++sequence;
+			++entries;
+		}
+	}
+	// Drop the oldest spilled entries over the limit
+	if (entries > max_entries)
+	{
+		MDB_cursor * cursor;
+		release_assert (!mdb_cursor_open (tx, order_handle, &cursor));
+		MDB_val order_key{};
+		MDB_val order_value{};
+		for (auto status (mdb_cursor_get (cursor, &order_key, &order_value, MDB_FIRST)); status == MDB_SUCCESS && entries > max_entries; status = mdb_cursor_get (cursor, &order_key, &order_value, MDB_FIRST))
+		{
+			MDB_val key{ order_value.mv_size, order_value.mv_data };
+			release_assert (!mdb_del (tx, handle, &key, nullptr));
+			release_assert (!mdb_cursor_del (cursor, 0));
+			--entries;
+			++dropped;
+		}
+		mdb_cursor_close (cursor);
+	}
+	return dropped;
+}
+
+void nano::unchecked_spill::for_each (std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> const & action, std::function<bool ()> const & predicate)
+{
+	if (env == nullptr)
+	{
+		return;
+	}
+	auto transaction (env->tx_begin_read ());
+	MDB_cursor * cursor;
+	release_assert (!mdb_cursor_open (env->tx (transaction), handle, &cursor));
+	MDB_val key{};
+	MDB_val value{};
+	for (auto status (mdb_cursor_get (cursor, &key, &value, MDB_FIRST)); status == MDB_SUCCESS && predicate (); status = mdb_cursor_get (cursor, &key, &value, MDB_NEXT))
+	{
+		action (spill_key (key), spill_info (value));
+	}
+	mdb_cursor_close (cursor);
+}
+
+void nano::unchecked_spill::for_each (nano::hash_or_account const & dependency, std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> const & action, std::function<bool ()> const & predicate)
+{
+	if (env == nullptr)
+	{
+		return;
+	}
+	auto transaction (env->tx_begin_read ());
+	MDB_cursor * cursor;
+	release_assert (!mdb_cursor_open (env->tx (transaction), handle, &cursor));
+	auto start (spill_key (nano::unchecked_key{ dependency, 0 }));
+	MDB_val key{ start.size (), start.data () };
+	MDB_val value{};
+	for (auto status (mdb_cursor_get (cursor, &key, &value, MDB_SET_RANGE)); status == MDB_SUCCESS && predicate (); status = mdb_cursor_get (cursor, &key, &value, MDB_NEXT))
+	{
+		auto current (spill_key (key));
+		if (current.key () != dependency.as_block_hash ())
+		{
+			break;
+		}
+		action (current, spill_info (value));
+	}
+	mdb_cursor_close (cursor);
+}
+
+bool nano::unchecked_spill::exists (nano::unchecked_key const & key_a)
+{
+	if (env == nullptr)
+	{
+		return false;
+	}
+	auto key_bytes (spill_key (key_a));
+	MDB_val key{ key_bytes.size (), key_bytes.data () };
+	MDB_val value{};
+	auto transaction (env->tx_begin_read ());
+	return mdb_get (env->tx (transaction), handle, &key, &value) == MDB_SUCCESS;
+}
+
+std::size_t nano::unchecked_spill::del (std::vector<nano::unchecked_key> const & keys_a)
+{
+	if (env == nullptr)
+	{
+		return 0;
+	}
+	std::size_t deleted{ 0 };
+	{
+		auto transaction (env->tx_begin_write ());
+		auto tx (env->tx (transaction));
+		for (auto const & key_a : keys_a)
+		{
+			auto key_bytes (spill_key (key_a));
+			MDB_val key{ key_bytes.size (), key_bytes.data () };
+			MDB_val value{};
+			auto status (mdb_get (tx, handle, &key, &value));
+			release_assert (status == MDB_SUCCESS || status == MDB_NOTFOUND);
+			if (status == MDB_SUCCESS)
+			{
+				spill_erase (tx, handle, order_handle, key, value);
+				++deleted;
+			}
+		}
+	}
+	entries -= deleted;
+	if (entries == 0)
+	{
+		// Everything spilled was satisfied, give the disk space back
+		close ();
+	}
+	return deleted;
+}
+
+void nano::unchecked_spill::extract (std::vector<nano::block_hash> const & dependencies_a, std::vector<nano::unchecked_info> & result_a, bool erase_a)
+{
+	debug_assert (std::is_sorted (dependencies_a.begin (), dependencies_a.end ()));
+	if (env == nullptr)
+	{
+		return;
+	}
+	{
+		auto transaction (env->tx_begin_write ());
+		auto tx (env->tx (transaction));
+		MDB_cursor * cursor;
+		release_assert (!mdb_cursor_open (tx, handle, &cursor));
+		std::vector<std::pair<std::array<uint8_t, 64>, uint64_t>> keys;
+		for (auto const & dependency : dependencies_a)
+		{
+			auto start (spill_key (nano::unchecked_key{ dependency, 0 }));
+			MDB_val key{ start.size (), start.data () };
+			MDB_val value{};
+			for (auto status (mdb_cursor_get (cursor, &key, &value, MDB_SET_RANGE)); status == MDB_SUCCESS; status = mdb_cursor_get (cursor, &key, &value, MDB_NEXT))
+			{
+				auto current (spill_key (key));
+				if (current.key () != dependency)
+				{
+					break;
+				}
+				result_a.push_back (spill_info (value));
+				keys.emplace_back (spill_key (current), spill_sequence (value));
+			}
+		}
+		mdb_cursor_close (cursor);
+		if (erase_a)
+		{
+			for (auto & [key_bytes, sequence_l] : keys)
+			{
+				MDB_val key{ key_bytes.size (), key_bytes.data () };
+				MDB_val order_key{ sizeof (sequence_l), &sequence_l };
+				release_assert (!mdb_del (tx, order_handle, &order_key, nullptr));
+				release_assert (!mdb_del (tx, handle, &key, nullptr));
+			}
+			entries -= keys.size ();
+		}
+	}
+	if (entries == 0)
+	{
+		close ();
+	}
+}
+
+void nano::unchecked_spill::clear ()
+{
+	close ();
+	entries = 0;
+}
+
+std::size_t nano::unchecked_spill::count () const
+{
+	return entries;
+}
+
+nano::unchecked_map::unchecked_map (nano::stats & stats, bool const & disable_delete, boost::filesystem::path const & spill_path, std::size_t memory_max, std::size_t spill_max) :
 	stats{ stats },
 	disable_delete{ disable_delete },
+	memory_max{ memory_max },
+	spill{ spill_path.empty () ? nullptr : std::make_unique<nano::unchecked_spill> (spill_path, spill_max) },
 	thread{ [this] () { run (); } }
 {
 }
@@ -22,10 +323,32 @@ void nano::unchecked_map::put (nano::hash_or_account const & dependency, nano::u
 {
 	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
 	nano::unchecked_key key{ dependency, info.block->hash () };
+	if (spill != nullptr && spill->exists (key))
+	{
+		return;
+	}
 	entries.get<tag_root> ().insert ({ key, info });
-	if (entries.size () > mem_block_count_max)
+	if (spill == nullptr)
+	{
+		if (entries.size () > memory_max)
+		{
+			entries.get<tag_sequenced> ().pop_front ();
+		}
+	}
+	else if (entries.size () >= memory_max + spill_batch_size)
 	{
-		entries.get<tag_sequenced> ().pop_front ();
+		// The oldest entries are written out together, so the disk tier sees one write transaction per batch
+		std::vector<std::pair<nano::unchecked_key, nano::unchecked_info>> batch;
+		batch.reserve (spill_batch_size);
+		auto & sequenced = entries.get<tag_sequenced> ();
+		for (auto i = sequenced.begin (), n = std::next (i, spill_batch_size); i != n; ++i)
+		{
+			batch.emplace_back (i->key, i->info);
+		}
+		auto dropped = spill->put (batch);
+		sequenced.erase (sequenced.begin (), std::next (sequenced.begin (), spill_batch_size));
+		stats.add (nano::stat::type::unchecked, nano::stat::detail::spill, nano::stat::dir::in, batch.size ());
+		stats.add (nano::stat::type::unchecked, nano::stat::detail::spill_drop, nano::stat::dir::in, dropped);
 	}
 	stats.inc (nano::stat::type::unchecked, nano::stat::detail::put);
 }
@@ -37,6 +360,10 @@ void nano::unchecked_map::for_each (std::function<void (nano::unchecked_key cons
 	{
 		action (i->key, i->info);
 	}
+	if (spill != nullptr)
+	{
+		spill->for_each (action, predicate);
+	}
 }
 
 void nano::unchecked_map::for_each (nano::hash_or_account const & dependency, std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> action, std::function<bool ()> predicate)
@@ -46,6 +373,10 @@ void nano::unchecked_map::for_each (nano::hash_or_account const & dependency, st
 	{
 		action (i->key, i->info);
 	}
+	if (spill != nullptr)
+	{
+		spill->for_each (dependency, action, predicate);
+	}
 }
 
 std::vector<nano::unchecked_info> nano::unchecked_map::get (nano::block_hash const & hash)
@@ -60,26 +391,45 @@ std::vector<nano::unchecked_info> nano::unchecked_map::get (nano::block_hash con
 bool nano::unchecked_map::exists (nano::unchecked_key const & key) const
 {
 	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	return entries.get<tag_root> ().count (key) != 0;
+	return entries.get<tag_root> ().count (key) != 0 || (spill != nullptr && spill->exists (key));
 }
 
 void nano::unchecked_map::del (nano::unchecked_key const & key)
+{
+	del (std::vector<nano::unchecked_key>{ key });
+}
+
+void nano::unchecked_map::del (std::vector<nano::unchecked_key> const & keys)
 {
 	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	auto erased = entries.get<tag_root> ().erase (key);
-	debug_assert (erased);
+	std::vector<nano::unchecked_key> spilled;
+	for (auto const & key : keys)
+	{
+		if (!entries.get<tag_root> ().erase (key))
+		{
+			spilled.push_back (key);
+		}
+	}
+	if (spill != nullptr && !spilled.empty ())
+	{
+		spill->del (spilled);
+	}
 }
 
 void nano::unchecked_map::clear ()
 {
 	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
 	entries.clear ();
+	if (spill != nullptr)
+	{
+		spill->clear ();
+	}
 }
 
 std::size_t nano::unchecked_map::count () const
 {
 	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	return entries.size ();
+	return entries.size () + (spill != nullptr ? spill->count () : 0);
 }
 
 void nano::unchecked_map::stop ()
@@ -111,9 +461,41 @@ void nano::unchecked_map::trigger (nano::hash_or_account const & dependency)
 
 void nano::unchecked_map::process_queries (decltype (buffer) const & back_buffer)
 {
+	// Sorted so both tiers are walked once in key order and repeated triggers collapse
+	std::vector<nano::block_hash> dependencies;
+	dependencies.reserve (back_buffer.size ());
 	for (auto const & item : back_buffer)
 	{
-		query_impl (item.hash);
+		dependencies.push_back (item.hash);
+	}
+	std::sort (dependencies.begin (), dependencies.end ());
+	dependencies.erase (std::unique (dependencies.begin (), dependencies.end ()), dependencies.end ());
+	std::vector<nano::unchecked_info> released;
+	{
+		nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
+		auto & index = entries.get<tag_root> ();
+		for (auto const & dependency : dependencies)
+		{
+			auto begin = index.lower_bound (nano::unchecked_key{ dependency, 0 });
+			auto end = begin;
+			for (auto n = index.end (); end != n && end->key.key () == dependency; ++end)
+			{
+				released.push_back (end->info);
+			}
+			if (!disable_delete)
+			{
+				index.erase (begin, end);
+			}
+		}
+		if (spill != nullptr)
+		{
+			spill->extract (dependencies, released, !disable_delete);
+		}
+	}
+	if (!released.empty ())
+	{
+		stats.add (nano::stat::type::unchecked, nano::stat::detail::satisfied, nano::stat::dir::in, released.size ());
+		satisfied.notify (released);
 	}
 }
 
@@ -143,29 +525,19 @@ void nano::unchecked_map::run ()
 	}
 }
 
-void nano::unchecked_map::query_impl (nano::block_hash const & hash)
+std::unique_ptr<nano::container_info_component> nano::unchecked_map::collect_container_info (const std::string & name)
 {
-	std::deque<nano::unchecked_key> delete_queue;
-	for_each (hash, [this, &delete_queue] (nano::unchecked_key const & key, nano::unchecked_info const & info) {
-		delete_queue.push_back (key);
-		stats.inc (nano::stat::type::unchecked, nano::stat::detail::satisfied);
-		satisfied.notify (info);
-	});
-	if (!disable_delete)
+	std::size_t spilled{ 0 };
 	{
-		for (auto const & key : delete_queue)
-		{
-			del (key);
-		}
+		nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
+		spilled = spill != nullptr ? spill->count () : 0;
 	}
-}
-
-std::unique_ptr<nano::container_info_component> nano::unchecked_map::collect_container_info (const std::string & name)
-{
 	nano::lock_guard<nano::mutex> lock{ mutex };
 
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", entries.size (), sizeof (decltype (entries)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "queries", buffer.size (), sizeof (decltype (buffer)::value_type) }));
+	// Spilled entries live on disk, only the count is of interest
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "spilled", spilled, 0 }));
 	return composite;
 }
@@ -5,6 +5,7 @@
 #include <nano/lib/observer_set.hpp>
 #include <nano/secure/common.hpp>
 
+#include <boost/filesystem/path.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/random_access_index.hpp>
@@ -17,12 +18,52 @@ namespace mi = boost::multi_index;
 
 namespace nano
 {
+class mdb_env;
 class stats;
 
+/**
+ * Disk tier for unchecked blocks evicted from memory, kept in a dedicated LMDB environment ordered by dependency.
+ * The environment is created on the first spilled block and removed again once every spilled block was satisfied or deleted, so its pages are only held while needed.
+ * A second table orders the spilled blocks by insertion, so the oldest are dropped once more than max_entries are spilled.
+ * Contents do not survive a restart, the same as the memory tier.
+ */
+class unchecked_spill final
+{
+public:
+	unchecked_spill (boost::filesystem::path const &, std::size_t max_entries);
+	~unchecked_spill ();
+	/** Writes the entries in a single transaction, returns the number of old entries dropped to stay within max_entries */
+	std::size_t put (std::vector<std::pair<nano::unchecked_key, nano::unchecked_info>> const &);
+	void for_each (std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> const & action, std::function<bool ()> const & predicate);
+	void for_each (nano::hash_or_account const & dependency, std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> const & action, std::function<bool ()> const & predicate);
+	bool exists (nano::unchecked_key const &);
+	/** Deletes the keys in a single transaction, returns the number of keys which were spilled */
+	std::size_t del (std::vector<nano::unchecked_key> const &);
+	/** Appends the entries of each sorted dependency to result in a single transaction, removing them as well if erase is set */
+	void extract (std::vector<nano::block_hash> const & dependencies, std::vector<nano::unchecked_info> & result, bool erase);
+	void clear ();
+	std::size_t count () const;
+
+private:
+	void open ();
+	void close ();
+
+	boost::filesystem::path const path;
+	std::size_t const max_entries;
+	std::unique_ptr<nano::mdb_env> env;
+	/** Entries keyed by dependency and hash, each value is prefixed with the entry's insertion sequence number */
+	unsigned handle{ 0 };
+	/** Insertion sequence number to entry key */
+	unsigned order_handle{ 0 };
+	uint64_t sequence{ 0 };
+	std::size_t entries{ 0 };
+};
+
 class unchecked_map
 {
 public:
-	unchecked_map (nano::stats &, bool const & do_delete);
+	/** With an empty spill_path blocks over memory_max are dropped, oldest first. Otherwise they are spilled to disk, where at most spill_max are kept */
+	unchecked_map (nano::stats &, bool const & do_delete, boost::filesystem::path const & spill_path = {}, std::size_t memory_max = mem_block_count_max, std::size_t spill_max = spill_block_count_max);
 	~unchecked_map ();
 
 	void put (nano::hash_or_account const & dependency, nano::unchecked_info const & info);
@@ -33,6 +74,8 @@ public:
 	std::vector<nano::unchecked_info> get (nano::block_hash const &);
 	bool exists (nano::unchecked_key const & key) const;
 	void del (nano::unchecked_key const & key);
+	/** Deletes the keys with a single write to the disk tier */
+	void del (std::vector<nano::unchecked_key> const & keys);
 	void clear ();
 	std::size_t count () const;
 	void stop ();
@@ -43,12 +86,14 @@ public:
 	 */
 	void trigger (nano::hash_or_account const & dependency);
 
+	static std::size_t constexpr mem_block_count_max = 64 * 1024;
+
 public: // Events
-	nano::observer_set<nano::unchecked_info const &> satisfied;
+	/** Called once per processed batch of triggers with every entry whose dependency was satisfied */
+	nano::observer_set<std::vector<nano::unchecked_info> const &> satisfied;
 
 private:
 	void run ();
-	void query_impl (nano::block_hash const & hash);
 
 private: // Dependencies
 	nano::stats & stats;
@@ -65,7 +110,10 @@ private:
 
 	void process_queries (decltype (buffer) const & back_buffer);
 
-	static std::size_t constexpr mem_block_count_max = 64 * 1024;
+	/** Blocks over memory_max are spilled in batches of this size, each written with one transaction */
+	static std::size_t constexpr spill_batch_size = 256;
+	static std::size_t constexpr spill_block_count_max = 1024 * 1024;
+	std::size_t const memory_max;
 
 private:
 	struct entry
@@ -85,6 +133,8 @@ private:
 				mi::member<entry, nano::unchecked_key, &entry::key>>>>;
 	// clang-format on
 	ordered_unchecked entries;
+	/** Receives the oldest entries once memory_max is exceeded */
+	std::unique_ptr<nano::unchecked_spill> spill;
 
 	mutable std::recursive_mutex entries_mutex;
 
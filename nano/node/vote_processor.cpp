@@ -119,7 +119,7 @@ bool nano::vote_processor::vote (std::shared_ptr<nano::vote> const & vote_a, std
 		}
 		if (process)
 		{
-			votes.emplace_back (vote_a, channel_a);
+			votes.emplace_back (vote_a, channel_a, std::chrono::steady_clock::now ());
 			lock.unlock ();
 			condition.notify_all ();
 			// Lock no longer required
@@ -146,22 +146,26 @@ void nano::vote_processor::verify_votes (decltype (votes) const & votes_a)
 	signatures.reserve (size);
 	std::vector<int> verifications;
 	verifications.resize (size);
-	for (auto const & vote : votes_a)
+	for (auto const & [vote, channel, queued] : votes_a)
 	{
-		hashes.push_back (vote.first->hash ());
+		hashes.push_back (vote->hash ());
 		messages.push_back (hashes.back ().bytes.data ());
-		pub_keys.push_back (vote.first->account.bytes.data ());
-		signatures.push_back (vote.first->signature.bytes.data ());
+		pub_keys.push_back (vote->account.bytes.data ());
+		signatures.push_back (vote->signature.bytes.data ());
 	}
 	nano::signature_check_set check = { size, messages.data (), lengths.data (), pub_keys.data (), signatures.data (), verifications.data () };
 	checker.verify (check);
+	auto verified (std::chrono::steady_clock::now ());
 	auto i (0);
-	for (auto const & vote : votes_a)
+	for (auto const & [vote, channel, queued] : votes_a)
 	{
 		debug_assert (verifications[i] == 1 || verifications[i] == 0);
 		if (verifications[i] == 1)
 		{
-			vote_blocking (vote.first, vote.second, true);
+			stats.sample (nano::stat::latency::vote_verified, verified - queued);
+			auto applying (std::chrono::steady_clock::now ());
+			vote_blocking (vote, channel, true);
+			stats.sample (nano::stat::latency::vote_applied, std::chrono::steady_clock::now () - applying);
 		}
 		++i;
 	}
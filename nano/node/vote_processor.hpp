@@ -4,9 +4,11 @@
 #include <nano/lib/utility.hpp>
 #include <nano/secure/common.hpp>
 
+#include <chrono>
 #include <deque>
 #include <memory>
 #include <thread>
+#include <tuple>
 #include <unordered_set>
 
 namespace nano
@@ -36,11 +38,14 @@ class vote_processor final
 public:
 	vote_processor (nano::signature_checker & checker_a, nano::active_transactions & active_a, nano::node_observers & observers_a, nano::stats & stats_a, nano::node_config & config_a, nano::node_flags & flags_a, nano::logger_mt & logger_a, nano::online_reps & online_reps_a, nano::rep_crawler & rep_crawler_a, nano::ledger & ledger_a, nano::network_params & network_params_a);
 
+	/** Queued vote, its channel and the time it was queued */
+	using entry_t = std::tuple<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>, std::chrono::steady_clock::time_point>;
+
 	/** Returns false if the vote was processed */
 	bool vote (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &);
 	/** Note: node.active.mutex lock is required */
 	nano::vote_code vote_blocking (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &, bool = false);
-	void verify_votes (std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> const &);
+	void verify_votes (std::deque<entry_t> const &);
 	/** Function blocks until either the current queue size (a established flush boundary as it'll continue to increase)
 	 * is processed or the queue is empty (end condition or cutoff's guard, as it is positioned ahead) */
 	void flush ();
@@ -65,7 +70,7 @@ private:
 	nano::ledger & ledger;
 	nano::network_params & network_params;
 	std::size_t const max_votes;
-	std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> votes;
+	std::deque<entry_t> votes;
 	/** Representatives levels for random early detection */
 	std::unordered_set<nano::account> representatives_1;
 	std::unordered_set<nano::account> representatives_2;
@@ -1034,12 +1034,15 @@ std::shared_ptr<nano::block> nano::wallet::send_action (nano::account const & so
 bool nano::wallet::action_complete (std::shared_ptr<nano::block> const & block_a, nano::account const & account_a, bool const generate_work_a, nano::block_details const & details_a)
 {
 	bool error{ false };
-	// Unschedule any work caching for this account
-	wallets.delayed_work->erase (account_a);
 	if (block_a != nullptr)
 	{
 		auto required_difficulty{ wallets.node.network_params.work.threshold (block_a->work_version (), details_a) };
-		if (wallets.node.network_params.work.difficulty (*block_a) < required_difficulty)
+		auto const insufficient (wallets.node.network_params.work.difficulty (*block_a) < required_difficulty);
+		if (generate_work_a)
+		{
+			wallets.node.stats.inc (nano::stat::type::wallet_work_cache, insufficient ? nano::stat::detail::miss : nano::stat::detail::hit);
+		}
+		if (insufficient)
 		{
 			wallets.node.logger.try_log (boost::str (boost::format ("Cached or provided work for block %1% account %2% is invalid, regenerating") % block_a->hash ().to_string () % account_a.to_account ()));
 			debug_assert (required_difficulty <= wallets.node.max_work_generate_difficulty (block_a->work_version ()));
@@ -1143,22 +1146,7 @@ void nano::wallet::work_update (nano::transaction const & transaction_a, nano::a
 
 void nano::wallet::work_ensure (nano::account const & account_a, nano::root const & root_a)
 {
-	using namespace std::chrono_literals;
-	std::chrono::seconds const precache_delay = wallets.node.network_params.network.is_dev_network () ? 1s : 10s;
-
-	wallets.delayed_work->operator[] (account_a) = root_a;
-
-	wallets.node.workers.add_timed_task (std::chrono::steady_clock::now () + precache_delay, [this_l = shared_from_this (), account_a, root_a] {
-		auto delayed_work = this_l->wallets.delayed_work.lock ();
-		auto existing (delayed_work->find (account_a));
-		if (existing != delayed_work->end () && existing->second == root_a)
-		{
-			delayed_work->erase (existing);
-			this_l->wallets.queue_wallet_action (nano::wallets::generate_priority, this_l, [account_a, root_a] (nano::wallet & wallet_a) {
-				wallet_a.work_cache_blocking (account_a, root_a);
-			});
-		}
-	});
+	wallets.work_cache.refill (shared_from_this (), account_a, root_a);
 }
 
 bool nano::wallet::search_receivable (nano::transaction const & wallet_transaction_a)
@@ -1171,10 +1159,10 @@ bool nano::wallet::search_receivable (nano::transaction const & wallet_transacti
 		{
 			auto block_transaction (wallets.node.store.tx_begin_read ());
 			nano::account const & account (i->first);
-			// Don't search pending for watch-only accounts
-			if (!nano::wallet_value (i->second).key.is_zero ())
+			// Don't search pending for watch-only accounts, nor accounts without any receivable above the minimum
+			if (!nano::wallet_value (i->second).key.is_zero () && wallets.node.ledger.cache.receivable.may_have (account, wallets.node.config.receive_minimum.number ()))
 			{
-				for (auto j (wallets.node.store.pending.begin (block_transaction, nano::pending_key (account, 0))), k (wallets.node.store.pending.end ()); j != k && nano::pending_key (j->first).account == account; ++j)
+				for (auto j (wallets.node.store.pending.begin (block_transaction, account)), k (wallets.node.store.pending.end ()); j != k && nano::pending_key (j->first).account == account; ++j)
 				{
 					nano::pending_key key (j->first);
 					auto hash (key.hash);
@@ -1239,7 +1227,7 @@ uint32_t nano::wallet::deterministic_check (nano::transaction const & transactio
 		else
 		{
 			// Check if there are pending blocks for account
-			for (auto ii (wallets.node.store.pending.begin (block_transaction, nano::pending_key (pair.pub, 0))), nn (wallets.node.store.pending.end ()); ii != nn && nano::pending_key (ii->first).account == pair.pub; ++ii)
+			for (auto ii (wallets.node.store.pending.begin (block_transaction, pair.pub)), nn (wallets.node.store.pending.end ()); ii != nn && nano::pending_key (ii->first).account == pair.pub; ++ii)
 			{
 				index = i;
 				n = i + 64 + (i / 64);
@@ -1287,7 +1275,8 @@ void nano::wallet::work_cache_blocking (nano::account const & account_a, nano::r
 	if (wallets.node.work_generation_enabled ())
 	{
 		auto difficulty (wallets.node.default_difficulty (nano::work_version::work_1));
-		auto opt_work_l (wallets.node.work_generate_blocking (nano::work_version::work_1, root_a, difficulty, account_a));
+		// Precached work is not waited on by anyone, so it must not delay interactive requests
+		auto opt_work_l (wallets.node.work_generate_blocking (nano::work_version::work_1, root_a, difficulty, account_a, nano::work_priority::background));
 		if (opt_work_l.is_initialized ())
 		{
 			auto transaction_l (wallets.tx_begin_write ());
@@ -1336,7 +1325,8 @@ nano::wallets::wallets (bool error_a, nano::node & node_a) :
 	kdf{ node_a.config.network_params.kdf_work },
 	node (node_a),
 	env (boost::polymorphic_downcast<nano::mdb_wallets_store *> (node_a.wallets_store_impl.get ())->environment),
-	stopped (false)
+	stopped (false),
+	work_cache{ *this, node_a, node_a.config.work_cache_concurrency }
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	if (!error_a)
@@ -1592,6 +1582,7 @@ void nano::wallets::stop ()
 		stopped = true;
 		actions.clear ();
 	}
+	work_cache.stop ();
 	condition.notify_all ();
 	if (thread.joinable ())
 	{
@@ -1847,5 +1838,6 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (wa
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "items", items_count, sizeof_item_element }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "actions", actions_count, sizeof_actions_element }));
+	composite->add_component (wallets.work_cache.collect_container_info ("work_cache"));
 	return composite;
 }
@@ -6,6 +6,7 @@
 #include <nano/node/lmdb/lmdb.hpp>
 #include <nano/node/lmdb/wallet_value.hpp>
 #include <nano/node/openclwork.hpp>
+#include <nano/node/wallet_work_cache.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/store.hpp>
 
@@ -220,7 +221,6 @@ public:
 	std::function<void (bool)> observer;
 	std::unordered_map<nano::wallet_id, std::shared_ptr<nano::wallet>> items;
 	std::multimap<nano::uint128_t, std::pair<std::shared_ptr<nano::wallet>, std::function<void (nano::wallet &)>>, std::greater<nano::uint128_t>> actions;
-	nano::locked<std::unordered_map<nano::account, nano::root>> delayed_work;
 	nano::mutex mutex;
 	nano::mutex action_mutex;
 	nano::condition_variable condition;
@@ -231,6 +231,7 @@ public:
 	nano::mdb_env & env;
 	std::atomic<bool> stopped;
 	std::thread thread;
+	nano::wallet_work_cache work_cache;
 	static nano::uint128_t const generate_priority;
 	static nano::uint128_t const high_priority;
 	/** Start read-write transaction */
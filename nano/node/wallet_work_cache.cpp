@@ -0,0 +1,203 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/node/node.hpp>
+#include <nano/node/wallet.hpp>
+#include <nano/node/wallet_work_cache.hpp>
+
+#include <unordered_set>
+
+nano::wallet_work_cache::wallet_work_cache (nano::wallets & wallets_a, nano::node & node_a, unsigned concurrency_a) :
+	wallets{ wallets_a },
+	node{ node_a },
+	concurrency{ concurrency_a }
+{
+	node.block_processor.processed.add ([this] (nano::process_return const & result_a, std::shared_ptr<nano::block> const & block_a) {
+		if (result_a.code == nano::process_result::progress)
+		{
+			observe (*block_a);
+		}
+	});
+	// Cementing can settle a different frontier than the one last processed, e.g. after a fork was resolved
+	node.confirmation_height_processor.add_cemented_observer ([this] (std::shared_ptr<nano::block> const & block_a) {
+		observe (*block_a);
+	});
+}
+
+void nano::wallet_work_cache::stop ()
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	stopped = true;
+	observed.clear ();
+	queue.clear ();
+	requests.clear ();
+}
+
+void nano::wallet_work_cache::observe (nano::block const & block_a)
+{
+	if (concurrency == 0 || !block_a.has_sideband ())
+	{
+		return;
+	}
+	auto const & account (!block_a.account ().is_zero () ? block_a.account () : block_a.sideband ().account);
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	if (!stopped && observed.size () < max_observed)
+	{
+		observed.push_back (account);
+		if (!draining)
+		{
+			draining = true;
+			node.workers.push_task ([this] () {
+				drain_observed ();
+			});
+		}
+	}
+}
+
+void nano::wallet_work_cache::drain_observed ()
+{
+	std::deque<nano::account> accounts;
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		accounts.swap (observed);
+		draining = false;
+	}
+	auto wallets_l (wallets.get_wallets ());
+	auto transaction (wallets.tx_begin_read ());
+	auto block_transaction (node.store.tx_begin_read ());
+	auto const difficulty (node.default_difficulty (nano::work_version::work_1));
+	std::unordered_set<nano::account> seen;
+	for (auto const & account : accounts)
+	{
+		if (!seen.insert (account).second)
+		{
+			continue;
+		}
+		for (auto const & [id, wallet] : wallets_l)
+		{
+			if (wallet->store.exists (transaction, account))
+			{
+				auto root (node.ledger.latest_root (block_transaction, account));
+				uint64_t work (0);
+				auto ready (!wallet->store.work_get (transaction, account, work) && node.network_params.work.difficulty (nano::work_version::work_1, root, work) >= difficulty);
+				if (!ready && !scheduled (account, root))
+				{
+					refill (wallet, account, root);
+				}
+				break;
+			}
+		}
+	}
+}
+
+void nano::wallet_work_cache::refill (std::shared_ptr<nano::wallet> const & wallet_a, nano::account const & account_a, nano::root const & root_a)
+{
+	if (concurrency == 0 || !node.work_generation_enabled ())
+	{
+		return;
+	}
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	auto generating_l (in_progress.find (account_a));
+	if (!stopped && (generating_l == in_progress.end () || generating_l->second != root_a))
+	{
+		auto [existing, inserted] = requests.insert_or_assign (account_a, request{ wallet_a, root_a });
+		if (inserted)
+		{
+			queue.push_back (account_a);
+		}
+		generate_next (lock);
+	}
+}
+
+void nano::wallet_work_cache::generate_next (nano::unique_lock<nano::mutex> & lock_a)
+{
+	debug_assert (lock_a.owns_lock ());
+	while (!stopped && in_progress.size () < concurrency && !queue.empty ())
+	{
+		auto account (queue.front ());
+		queue.pop_front ();
+		if (in_progress.count (account) != 0)
+		{
+			// Requeued by generated () once the running request for this account finishes
+			continue;
+		}
+		auto existing (requests.find (account));
+		debug_assert (existing != requests.end ());
+		auto request_l (existing->second);
+		requests.erase (existing);
+		in_progress[account] = request_l.root;
+		lock_a.unlock ();
+		node.stats.inc (nano::stat::type::wallet_work_cache, nano::stat::detail::request);
+		node.work_generate (
+		nano::work_version::work_1, request_l.root, node.default_difficulty (nano::work_version::work_1), [this, account, request_l] (boost::optional<uint64_t> work_a) {
+			// Storing the work needs a wallet write transaction, keep that off the work threads
+			node.workers.push_task ([this, account, request_l, work_a] () {
+				generated (account, *request_l.wallet, request_l.root, work_a);
+			});
+		},
+		account, false, nano::work_priority::background);
+		lock_a.lock ();
+	}
+}
+
+void nano::wallet_work_cache::generated (nano::account const & account_a, nano::wallet & wallet_a, nano::root const & root_a, boost::optional<uint64_t> const & work_a)
+{
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		in_progress.erase (account_a);
+		if (stopped)
+		{
+			return;
+		}
+	}
+	if (work_a.is_initialized ())
+	{
+		auto transaction (wallets.tx_begin_write ());
+		if (wallet_a.live () && wallet_a.store.exists (transaction, account_a))
+		{
+			wallet_a.work_update (transaction, account_a, root_a, *work_a);
+			node.stats.inc (nano::stat::type::wallet_work_cache, nano::stat::detail::update);
+		}
+	}
+	else if (!node.stopped)
+	{
+		node.logger.try_log (boost::str (boost::format ("Could not precache work for root %1% due to work generation failure") % root_a.to_string ()));
+	}
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	if (requests.count (account_a) != 0)
+	{
+		queue.push_back (account_a);
+	}
+	generate_next (lock);
+}
+
+std::size_t nano::wallet_work_cache::queued ()
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	return requests.size ();
+}
+
+std::size_t nano::wallet_work_cache::generating ()
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	return in_progress.size ();
+}
+
+bool nano::wallet_work_cache::scheduled (nano::account const & account_a, nano::root const & root_a)
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto queued_l (requests.find (account_a));
+	auto in_progress_l (in_progress.find (account_a));
+	return (queued_l != requests.end () && queued_l->second.root == root_a) || (in_progress_l != in_progress.end () && in_progress_l->second == root_a);
+}
+
+std::unique_ptr<nano::container_info_component> nano::wallet_work_cache::collect_container_info (std::string const & name)
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "observed", observed.size (), sizeof (decltype (observed)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "queue", queue.size (), sizeof (decltype (queue)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "requests", requests.size (), sizeof (decltype (requests)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "in_progress", in_progress.size (), sizeof (decltype (in_progress)::value_type) }));
+	return composite;
+}
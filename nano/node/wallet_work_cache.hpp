@@ -0,0 +1,67 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+
+#include <boost/optional.hpp>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace nano
+{
+class block;
+class container_info_component;
+class node;
+class wallet;
+class wallets;
+
+/**
+ * Keeps work for the next block of wallet accounts ready ahead of time.
+ * Blocks processed or cemented for a wallet account schedule a refill for the account's new frontier, which is generated with background work priority and stored in the wallet.
+ * At most `concurrency` accounts generate work at the same time, which bounds the CPU used for precaching.
+ */
+class wallet_work_cache final
+{
+public:
+	wallet_work_cache (nano::wallets &, nano::node &, unsigned concurrency);
+	/** Schedules work generation for the next block of account_a, replacing an earlier queued request for the account */
+	void refill (std::shared_ptr<nano::wallet> const &, nano::account const &, nano::root const &);
+	/** Schedules a refill if the account of the block belongs to a wallet and has no valid work for its frontier */
+	void observe (nano::block const &);
+	void stop ();
+	std::size_t queued ();
+	std::size_t generating ();
+	/** Returns true if work for root_a is queued or being generated for account_a */
+	bool scheduled (nano::account const &, nano::root const &);
+	std::unique_ptr<nano::container_info_component> collect_container_info (std::string const & name);
+
+	static std::size_t constexpr max_observed{ 64 * 1024 };
+
+private:
+	class request final
+	{
+	public:
+		std::shared_ptr<nano::wallet> wallet;
+		nano::root root;
+	};
+
+	void drain_observed ();
+	void generate_next (nano::unique_lock<nano::mutex> &);
+	void generated (nano::account const &, nano::wallet &, nano::root const &, boost::optional<uint64_t> const &);
+
+	nano::wallets & wallets;
+	nano::node & node;
+	unsigned const concurrency;
+	nano::mutex mutex;
+	bool stopped{ false };
+	/** Accounts seen by the block observers, checked against the wallets on a worker thread */
+	std::deque<nano::account> observed;
+	bool draining{ false };
+	std::deque<nano::account> queue;
+	std::unordered_map<nano::account, request> requests;
+	std::unordered_map<nano::account, nano::root> in_progress;
+};
+}
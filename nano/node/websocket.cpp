@@ -1,6 +1,7 @@
 #include <nano/boost/asio/bind_executor.hpp>
 #include <nano/boost/asio/dispatch.hpp>
 #include <nano/boost/asio/strand.hpp>
+#include <nano/lib/json_writer.hpp>
 #include <nano/lib/tlsconfig.hpp>
 #include <nano/lib/work.hpp>
 #include <nano/node/node_observers.hpp>
@@ -13,6 +14,7 @@
 #include <boost/property_tree/json_parser.hpp>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 
 nano::websocket::confirmation_options::confirmation_options (nano::wallets & wallets_a) :
@@ -75,8 +77,8 @@ nano::websocket::confirmation_options::confirmation_options (boost::property_tre
 			nano::account result_l{};
 			if (!result_l.decode_account (account_l.second.data ()))
 			{
-				// Do not insert the given raw data to keep old prefix support
-				accounts.insert (result_l.to_account ());
+				// Decoded keys match regardless of the prefix used
+				accounts.insert (result_l);
 			}
 			else
 			{
@@ -94,43 +96,52 @@ nano::websocket::confirmation_options::confirmation_options (boost::property_tre
 
 bool nano::websocket::confirmation_options::should_filter (nano::websocket::message const & message_a) const
 {
-	bool should_filter_conf_type_l (true);
-
+	uint8_t confirmation_type_l (0);
 	auto type_text_l (message_a.contents.get<std::string> ("message.confirmation_type"));
-	if (type_text_l == "active_quorum" && confirmation_types & type_active_quorum)
+	if (type_text_l == "active_quorum")
 	{
-		should_filter_conf_type_l = false;
+		confirmation_type_l = type_active_quorum;
 	}
-	else if (type_text_l == "active_confirmation_height" && confirmation_types & type_active_confirmation_height)
+	else if (type_text_l == "active_confirmation_height")
 	{
-		should_filter_conf_type_l = false;
+		confirmation_type_l = type_active_confirmation_height;
 	}
-	else if (type_text_l == "inactive" && confirmation_types & type_inactive)
+	else if (type_text_l == "inactive")
 	{
-		should_filter_conf_type_l = false;
+		confirmation_type_l = type_inactive;
 	}
 
-	bool should_filter_account (has_account_filtering_options);
+	nano::account source_l{};
+	boost::optional<nano::account> destination_l;
 	auto destination_opt_l (message_a.contents.get_optional<std::string> ("message.block.link_as_account"));
 	if (destination_opt_l)
 	{
-		auto source_text_l (message_a.contents.get<std::string> ("message.account"));
+		destination_l = nano::account{};
+		auto decode_source_ok_l (!source_l.decode_account (message_a.contents.get<std::string> ("message.account")));
+		auto decode_destination_ok_l (!destination_l->decode_account (destination_opt_l.get ()));
+		(void)decode_source_ok_l;
+		(void)decode_destination_ok_l;
+		debug_assert (decode_source_ok_l && decode_destination_ok_l);
+	}
+	return should_filter (confirmation_type_l, source_l, destination_l);
+}
+
+bool nano::websocket::confirmation_options::should_filter (uint8_t confirmation_type_a, nano::account const & account_a, boost::optional<nano::account> const & destination_a) const
+{
+	bool should_filter_conf_type_l ((confirmation_types & confirmation_type_a) == 0);
+	bool should_filter_account (has_account_filtering_options);
+	// Accounts are only filtered on for state blocks with block contents included
+	if (destination_a)
+	{
 		if (all_local_accounts)
 		{
 			auto transaction_l (wallets.tx_begin_read ());
-			nano::account source_l{};
-			nano::account destination_l{};
-			auto decode_source_ok_l (!source_l.decode_account (source_text_l));
-			auto decode_destination_ok_l (!destination_l.decode_account (destination_opt_l.get ()));
-			(void)decode_source_ok_l;
-			(void)decode_destination_ok_l;
-			debug_assert (decode_source_ok_l && decode_destination_ok_l);
-			if (wallets.exists (transaction_l, source_l) || wallets.exists (transaction_l, destination_l))
+			if (wallets.exists (transaction_l, account_a) || wallets.exists (transaction_l, *destination_a))
 			{
 				should_filter_account = false;
 			}
 		}
-		if (accounts.find (source_text_l) != accounts.end () || accounts.find (destination_opt_l.get ()) != accounts.end ())
+		if (accounts.count (account_a) > 0 || accounts.count (*destination_a) > 0)
 		{
 			should_filter_account = false;
 		}
@@ -141,22 +152,23 @@ bool nano::websocket::confirmation_options::should_filter (nano::websocket::mess
 
 bool nano::websocket::confirmation_options::update (boost::property_tree::ptree const & options_a)
 {
-	auto update_accounts = [this] (boost::property_tree::ptree const & accounts_text_a, bool insert_a) {
+	std::vector<std::pair<nano::account, bool>> changes_l;
+	return update (options_a, changes_l);
+}
+
+bool nano::websocket::confirmation_options::update (boost::property_tree::ptree const & options_a, std::vector<std::pair<nano::account, bool>> & changes_a)
+{
+	auto update_accounts = [this, &changes_a] (boost::property_tree::ptree const & accounts_text_a, bool insert_a) {
 		this->has_account_filtering_options = true;
 		for (auto const & account_l : accounts_text_a)
 		{
 			nano::account result_l{};
 			if (!result_l.decode_account (account_l.second.data ()))
 			{
-				// Re-encode to keep old prefix support
-				auto encoded_l (result_l.to_account ());
-				if (insert_a)
-				{
-					this->accounts.insert (encoded_l);
-				}
-				else
+				auto changed_l (insert_a ? this->accounts.insert (result_l).second : this->accounts.erase (result_l) > 0);
+				if (changed_l)
 				{
-					this->accounts.erase (encoded_l);
+					changes_a.emplace_back (result_l, insert_a);
 				}
 			}
 			else if (this->logger.is_initialized ())
@@ -258,6 +270,10 @@ nano::websocket::session::~session ()
 		nano::unique_lock<nano::mutex> lk (subscriptions_mutex);
 		for (auto & subscription : subscriptions)
 		{
+			if (subscription.first == nano::websocket::topic::confirmation)
+			{
+				ws_listener.confirmation_index.erase (*this, dynamic_cast<nano::websocket::confirmation_options *> (subscription.second.get ()));
+			}
 			ws_listener.decrease_subscriber_count (subscription.first);
 		}
 	}
@@ -294,32 +310,40 @@ void nano::websocket::session::close ()
 	});
 }
 
-void nano::websocket::session::write (nano::websocket::message message_a)
+bool nano::websocket::session::subscribed (nano::websocket::message const & message_a)
 {
-	nano::unique_lock<nano::mutex> lk (subscriptions_mutex);
+	nano::lock_guard<nano::mutex> lk (subscriptions_mutex);
 	auto subscription (subscriptions.find (message_a.topic));
-	if (message_a.topic == nano::websocket::topic::ack || (subscription != subscriptions.end () && !subscription->second->should_filter (message_a)))
-	{
-		lk.unlock ();
-		auto this_l (shared_from_this ());
-		boost::asio::post (ws.get_strand (),
-		[message_a, this_l] () {
-			bool write_in_progress = !this_l->send_queue.empty ();
-			this_l->send_queue.emplace_back (message_a);
-			if (!write_in_progress)
-			{
-				this_l->write_queued_messages ();
-			}
-		});
+	return message_a.topic == nano::websocket::topic::ack || (subscription != subscriptions.end () && !subscription->second->should_filter (message_a));
+}
+
+void nano::websocket::session::write (nano::websocket::message message_a)
+{
+	if (subscribed (message_a))
+	{
+		write (message_a.encode ());
 	}
 }
 
+void nano::websocket::session::write (nano::shared_const_buffer const & buffer_a)
+{
+	auto this_l (shared_from_this ());
+	boost::asio::post (ws.get_strand (),
+	[buffer_a, this_l] () {
+		bool write_in_progress = !this_l->send_queue.empty ();
+		this_l->send_queue.emplace_back (buffer_a);
+		if (!write_in_progress)
+		{
+			this_l->write_queued_messages ();
+		}
+	});
+}
+
 void nano::websocket::session::write_queued_messages ()
 {
-	auto msg (send_queue.front ().to_string ());
 	auto this_l (shared_from_this ());
 
-	ws.async_write (nano::shared_const_buffer (msg),
+	ws.async_write (send_queue.front (),
 	[this_l] (boost::system::error_code ec, std::size_t bytes_transferred) {
 		this_l->send_queue.pop_front ();
 		if (!ec)
@@ -497,11 +521,20 @@ void nano::websocket::session::handle_message (boost::property_tree::ptree const
 		auto existing (subscriptions.find (topic_l));
 		if (existing != subscriptions.end ())
 		{
+			if (topic_l == nano::websocket::topic::confirmation)
+			{
+				ws_listener.confirmation_index.erase (*this, dynamic_cast<nano::websocket::confirmation_options *> (existing->second.get ()));
+				ws_listener.confirmation_index.insert (*this, dynamic_cast<nano::websocket::confirmation_options *> (options_l.get ()));
+			}
 			existing->second = std::move (options_l);
 			ws_listener.get_logger ().always_log ("Websocket: updated subscription to topic: ", from_topic (topic_l));
 		}
 		else
 		{
+			if (topic_l == nano::websocket::topic::confirmation)
+			{
+				ws_listener.confirmation_index.insert (*this, dynamic_cast<nano::websocket::confirmation_options *> (options_l.get ()));
+			}
 			subscriptions.emplace (topic_l, std::move (options_l));
 			ws_listener.get_logger ().always_log ("Websocket: new subscription to topic: ", from_topic (topic_l));
 			ws_listener.increase_subscriber_count (topic_l);
@@ -515,7 +548,19 @@ void nano::websocket::session::handle_message (boost::property_tree::ptree const
 		if (existing != subscriptions.end ())
 		{
 			auto options_text_l (message_a.get_child_optional ("options"));
-			if (options_text_l.is_initialized () && !existing->second->update (*options_text_l))
+			auto conf_options (dynamic_cast<nano::websocket::confirmation_options *> (existing->second.get ()));
+			if (options_text_l.is_initialized () && conf_options != nullptr)
+			{
+				// Keep the account index in step with the filter
+				auto was_unfiltered (conf_options->is_unfiltered ());
+				std::vector<std::pair<nano::account, bool>> changes;
+				if (!conf_options->update (*options_text_l, changes))
+				{
+					ws_listener.confirmation_index.update (*this, *conf_options, was_unfiltered, changes);
+					action_succeeded = true;
+				}
+			}
+			else if (options_text_l.is_initialized () && !existing->second->update (*options_text_l))
 			{
 				action_succeeded = true;
 			}
@@ -524,6 +569,11 @@ void nano::websocket::session::handle_message (boost::property_tree::ptree const
 	else if (action == "unsubscribe" && topic_l != nano::websocket::topic::invalid)
 	{
 		nano::lock_guard<nano::mutex> lk (subscriptions_mutex);
+		auto existing (subscriptions.find (topic_l));
+		if (existing != subscriptions.end () && topic_l == nano::websocket::topic::confirmation)
+		{
+			ws_listener.confirmation_index.erase (*this, dynamic_cast<nano::websocket::confirmation_options *> (existing->second.get ()));
+		}
 		if (subscriptions.erase (topic_l))
 		{
 			ws_listener.get_logger ().always_log ("Websocket: removed subscription to topic: ", from_topic (topic_l));
@@ -640,35 +690,60 @@ void nano::websocket::listener::broadcast_confirmation (std::shared_ptr<nano::bl
 {
 	nano::websocket::message_builder builder;
 
-	nano::lock_guard<nano::mutex> lk (sessions_mutex);
-	boost::optional<nano::websocket::message> msg_with_block;
-	boost::optional<nano::websocket::message> msg_without_block;
-	for (auto & weak_session : sessions)
+	// One variant per combination of options that change the message contents
+	class variant final
 	{
-		auto session_ptr (weak_session.lock ());
-		if (session_ptr)
+	public:
+		boost::optional<nano::websocket::message> message;
+		boost::optional<nano::shared_const_buffer> encoded;
+	};
+	std::array<variant, 16> variants;
+
+	uint8_t confirmation_type (0);
+	switch (election_status_a.type)
+	{
+		case nano::election_status_type::active_confirmed_quorum:
+			confirmation_type = nano::websocket::confirmation_options::type_active_quorum;
+			break;
+		case nano::election_status_type::active_confirmation_height:
+			confirmation_type = nano::websocket::confirmation_options::type_active_confirmation_height;
+			break;
+		case nano::election_status_type::inactive_confirmation_height:
+			confirmation_type = nano::websocket::confirmation_options::type_inactive;
+			break;
+		default:
+			break;
+	};
+	auto is_state (block_a->type () == nano::block_type::state);
+	auto destination (block_a->link ().as_account ());
+
+	for (auto const & session_ptr : confirmation_index.candidates (account_a, is_state ? destination : account_a))
+	{
+		nano::lock_guard<nano::mutex> lk (session_ptr->subscriptions_mutex);
+		auto subscription (session_ptr->subscriptions.find (nano::websocket::topic::confirmation));
+		if (subscription != session_ptr->subscriptions.end ())
 		{
-			auto subscription (session_ptr->subscriptions.find (nano::websocket::topic::confirmation));
-			if (subscription != session_ptr->subscriptions.end ())
+			nano::websocket::confirmation_options default_options (wallets);
+			auto conf_options (dynamic_cast<nano::websocket::confirmation_options *> (subscription->second.get ()));
+			if (conf_options == nullptr)
 			{
-				nano::websocket::confirmation_options default_options (wallets);
-				auto conf_options (dynamic_cast<nano::websocket::confirmation_options *> (subscription->second.get ()));
-				if (conf_options == nullptr)
-				{
-					conf_options = &default_options;
-				}
-				auto include_block (conf_options == nullptr ? true : conf_options->get_include_block ());
-
-				if (include_block && !msg_with_block)
+				conf_options = &default_options;
+			}
+			auto include_block (conf_options->get_include_block ());
+			// The destination is only part of the message, and thus filtered on, with block contents included
+			if (!conf_options->should_filter (confirmation_type, account_a, is_state && include_block ? boost::make_optional (destination) : boost::none))
+			{
+				auto index (static_cast<std::size_t> (include_block) | conf_options->get_include_election_info () << 1 | conf_options->get_include_election_info_with_votes () << 2 | conf_options->get_include_sideband_info () << 3);
+				auto & variant (variants[index]);
+				if (!variant.message)
 				{
-					msg_with_block = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_a, election_votes_a, *conf_options);
+					variant.message = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_a, election_votes_a, *conf_options);
 				}
-				else if (!include_block && !msg_without_block)
+				if (!variant.encoded)
 				{
-					msg_without_block = builder.block_confirmed (block_a, account_a, amount_a, subtype, include_block, election_status_a, election_votes_a, *conf_options);
+					variant.encoded = variant.message->encode ();
 				}
-
-				session_ptr->write (include_block ? msg_with_block.get () : msg_without_block.get ());
+				session_ptr->write (*variant.encoded);
 			}
 		}
 	}
@@ -676,13 +751,145 @@ void nano::websocket::listener::broadcast_confirmation (std::shared_ptr<nano::bl
 
 void nano::websocket::listener::broadcast (nano::websocket::message message_a)
 {
+	boost::optional<nano::shared_const_buffer> encoded;
 	nano::lock_guard<nano::mutex> lk (sessions_mutex);
 	for (auto & weak_session : sessions)
 	{
 		auto session_ptr (weak_session.lock ());
-		if (session_ptr)
+		if (session_ptr && session_ptr->subscribed (message_a))
+		{
+			if (!encoded)
+			{
+				encoded = message_a.encode ();
+			}
+			session_ptr->write (*encoded);
+		}
+	}
+}
+
+void nano::websocket::confirmation_index::insert (nano::websocket::session & session_a, nano::websocket::confirmation_options const * options_a)
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	if (options_a == nullptr || options_a->is_unfiltered ())
+	{
+		unfiltered.insert (&session_a);
+	}
+	else
+	{
+		for (auto const & account : options_a->get_accounts ())
 		{
-			session_ptr->write (message_a);
+			insert (session_a, account);
+		}
+	}
+}
+
+void nano::websocket::confirmation_index::erase (nano::websocket::session & session_a, nano::websocket::confirmation_options const * options_a)
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	if (options_a == nullptr || options_a->is_unfiltered ())
+	{
+		unfiltered.erase (&session_a);
+	}
+	else
+	{
+		for (auto const & account : options_a->get_accounts ())
+		{
+			erase (session_a, account);
+		}
+	}
+}
+
+void nano::websocket::confirmation_index::update (nano::websocket::session & session_a, nano::websocket::confirmation_options const & options_a, bool was_unfiltered_a, std::vector<std::pair<nano::account, bool>> const & changes_a)
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	// Updates only ever add account filtering, a subscription does not become unfiltered
+	if (options_a.is_unfiltered ())
+	{
+		return;
+	}
+	if (was_unfiltered_a)
+	{
+		unfiltered.erase (&session_a);
+		for (auto const & account : options_a.get_accounts ())
+		{
+			insert (session_a, account);
+		}
+	}
+	else
+	{
+		for (auto const & [account, inserted] : changes_a)
+		{
+			if (inserted)
+			{
+				insert (session_a, account);
+			}
+			else
+			{
+				erase (session_a, account);
+			}
+		}
+	}
+}
+
+std::vector<std::shared_ptr<nano::websocket::session>> nano::websocket::confirmation_index::candidates (nano::account const & account_a, nano::account const & destination_a) const
+{
+	std::vector<std::shared_ptr<nano::websocket::session>> result;
+	// Duplicates are found by address before locking, a reference released here could be the last one and ~session erases under this mutex
+	std::unordered_set<nano::websocket::session *> seen;
+	nano::lock_guard<nano::mutex> guard (mutex);
+	auto add = [&result, &seen] (nano::websocket::session * session_a) {
+		if (seen.insert (session_a).second)
+		{
+			// Sessions being destroyed block on the mutex before removing themselves, and are skipped here
+			if (auto session_l = session_a->weak_from_this ().lock ())
+			{
+				result.push_back (std::move (session_l));
+			}
+		}
+	};
+	auto add_account = [this, &add] (nano::account const & account_a) {
+		auto existing (sessions_by_account.find (account_a));
+		if (existing != sessions_by_account.end ())
+		{
+			for (auto session : existing->second)
+			{
+				add (session);
+			}
+		}
+	};
+	for (auto session : unfiltered)
+	{
+		add (session);
+	}
+	add_account (account_a);
+	if (destination_a != account_a)
+	{
+		add_account (destination_a);
+	}
+	return result;
+}
+
+std::size_t nano::websocket::confirmation_index::account_count () const
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return sessions_by_account.size ();
+}
+
+void nano::websocket::confirmation_index::insert (nano::websocket::session & session_a, nano::account const & account_a)
+{
+	sessions_by_account[account_a].push_back (&session_a);
+}
+
+void nano::websocket::confirmation_index::erase (nano::websocket::session & session_a, nano::account const & account_a)
+{
+	auto existing (sessions_by_account.find (account_a));
+	if (existing != sessions_by_account.end ())
+	{
+		auto & sessions (existing->second);
+		sessions.erase (std::remove (sessions.begin (), sessions.end (), &session_a), sessions.end ());
+		if (sessions.empty ())
+		{
+			sessions_by_account.erase (existing);
 		}
 	}
 }
@@ -958,10 +1165,14 @@ void nano::websocket::message_builder::set_common_fields (nano::websocket::messa
 
 std::string nano::websocket::message::to_string () const
 {
-	std::ostringstream ostream;
-	boost::property_tree::write_json (ostream, contents);
-	ostream.flush ();
-	return ostream.str ();
+	nano::json_writer writer;
+	writer.value (contents);
+	return writer.finish ();
+}
+
+nano::shared_const_buffer nano::websocket::message::encode () const
+{
+	return nano::shared_const_buffer{ to_string () };
 }
 
 /*
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/lib/asio.hpp>
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/work.hpp>
@@ -33,6 +34,7 @@ namespace websocket
 {
 	class listener;
 	class confirmation_options;
+	class confirmation_index;
 	class session;
 
 	/** Supported topics */
@@ -76,6 +78,8 @@ namespace websocket
 		}
 
 		std::string to_string () const;
+		/** Serializes the message into a buffer which can be shared by every session it is written to */
+		nano::shared_const_buffer encode () const;
 		nano::websocket::topic topic;
 		boost::property_tree::ptree contents;
 	};
@@ -152,6 +156,14 @@ namespace websocket
 		 */
 		bool should_filter (message const & message_a) const override;
 
+		/**
+		 * Checks if a confirmation should be filtered, using the values its message is built from
+		 * @param confirmation_type_a one of the type_* flags
+		 * @param destination_a the link of a state block, only given if block contents are included in the message
+		 * @return false if the message should be broadcasted, true if it should be filtered
+		 */
+		bool should_filter (uint8_t confirmation_type_a, nano::account const & account_a, boost::optional<nano::account> const & destination_a) const;
+
 		/**
 		 * Update some existing options
 		 * Filtering options:
@@ -161,6 +173,20 @@ namespace websocket
 		 */
 		bool update (boost::property_tree::ptree const & options_a) override;
 
+		/** Same as update, also reporting each account added to (true) or removed from (false) the filter */
+		bool update (boost::property_tree::ptree const & options_a, std::vector<std::pair<nano::account, bool>> & changes_a);
+
+		/** Returns true if confirmations are not filtered on a set of accounts only. These subscriptions are not indexed by account. */
+		bool is_unfiltered () const
+		{
+			return !has_account_filtering_options || all_local_accounts;
+		}
+
+		std::unordered_set<nano::account> const & get_accounts () const
+		{
+			return accounts;
+		}
+
 		/** Returns whether or not block contents should be included */
 		bool get_include_block () const
 		{
@@ -203,7 +229,7 @@ namespace websocket
 		bool has_account_filtering_options{ false };
 		bool all_local_accounts{ false };
 		uint8_t confirmation_types{ type_all };
-		std::unordered_set<std::string> accounts;
+		std::unordered_set<nano::account> accounts;
 	};
 
 	/**
@@ -256,6 +282,12 @@ namespace websocket
 		/** Enqueue \p message_a for writing to the websockets */
 		void write (nano::websocket::message message_a);
 
+		/** Enqueue a message already encoded by the broadcaster and filtered with \p subscribed */
+		void write (nano::shared_const_buffer const & buffer_a);
+
+		/** Returns true if the session subscribed to the topic of \p message_a and its options do not filter it. Acks are always accepted. */
+		bool subscribed (nano::websocket::message const & message_a);
+
 	private:
 		/** The owning listener */
 		nano::websocket::listener & ws_listener;
@@ -263,8 +295,8 @@ namespace websocket
 		nano::websocket::stream ws;
 		/** Buffer for received messages */
 		boost::beast::multi_buffer read_buffer;
-		/** Outgoing messages. The send queue is protected by accessing it only through the strand */
-		std::deque<message> send_queue;
+		/** Encoded outgoing messages, shared with other sessions. The send queue is protected by accessing it only through the strand */
+		std::deque<nano::shared_const_buffer> send_queue;
 
 		/** Hash functor for topic enums */
 		struct topic_hash
@@ -287,6 +319,37 @@ namespace websocket
 		void write_queued_messages ();
 	};
 
+	/**
+	 * Index of confirmation subscriptions by the accounts they filter on. Broadcasting a confirmation looks up the sessions
+	 * interested in its accounts, rather than checking the filter of every session.
+	 * Sessions without an account filter, or filtering on local wallet accounts, are always candidates.
+	 */
+	class confirmation_index final
+	{
+	public:
+		/** Adds a confirmation subscription, \p options_a is null for subscriptions without options */
+		void insert (nano::websocket::session & session_a, nano::websocket::confirmation_options const * options_a);
+		/** Removes a confirmation subscription, \p options_a must be in the state it was last indexed with */
+		void erase (nano::websocket::session & session_a, nano::websocket::confirmation_options const * options_a);
+		/** Applies the changes of confirmation_options::update to an indexed subscription */
+		void update (nano::websocket::session & session_a, nano::websocket::confirmation_options const & options_a, bool was_unfiltered_a, std::vector<std::pair<nano::account, bool>> const & changes_a);
+		/** Returns the live sessions which may be interested in a confirmation involving either account */
+		std::vector<std::shared_ptr<nano::websocket::session>> candidates (nano::account const & account_a, nano::account const & destination_a) const;
+		/** Number of distinct indexed accounts */
+		std::size_t account_count () const;
+
+	private:
+		/** The mutex must be held */
+		void insert (nano::websocket::session & session_a, nano::account const & account_a);
+		/** The mutex must be held */
+		void erase (nano::websocket::session & session_a, nano::account const & account_a);
+
+		mutable nano::mutex mutex;
+		/** Sessions are removed from the index before they are destroyed */
+		std::unordered_map<nano::account, std::vector<nano::websocket::session *>> sessions_by_account;
+		std::unordered_set<nano::websocket::session *> unfiltered;
+	};
+
 	/** Creates a new session for each incoming connection */
 	class listener final : public std::enable_shared_from_this<listener>
 	{
@@ -301,10 +364,10 @@ namespace websocket
 		/** Close all websocket sessions and stop listening for new connections */
 		void stop ();
 
-		/** Broadcast block confirmation. The content of the message depends on subscription options (such as "include_block") */
+		/** Broadcast block confirmation. The content of the message depends on subscription options (such as "include_block"), each variant is built and encoded once */
 		void broadcast_confirmation (std::shared_ptr<nano::block> const & block_a, nano::account const & account_a, nano::amount const & amount_a, std::string const & subtype, nano::election_status const & election_status_a, std::vector<nano::vote_with_weight_info> const & election_votes_a);
 
-		/** Broadcast \p message to all session subscribing to the message topic. */
+		/** Broadcast \p message to all session subscribing to the message topic. The message is encoded once for all of them. */
 		void broadcast (nano::websocket::message message_a);
 
 		nano::logger_mt & get_logger () const
@@ -322,6 +385,11 @@ namespace websocket
 			return wallets;
 		}
 
+		nano::websocket::confirmation_index const & get_confirmation_index () const
+		{
+			return confirmation_index;
+		}
+
 		/**
 		 * Per-topic subscribers check. Relies on all sessions correctly increasing and
 		 * decreasing the subscriber counts themselves.
@@ -354,6 +422,7 @@ namespace websocket
 		std::vector<std::weak_ptr<session>> sessions;
 		std::array<std::atomic<std::size_t>, number_topics> topic_subscriber_count;
 		std::atomic<bool> stopped{ false };
+		nano::websocket::confirmation_index confirmation_index;
 	};
 }
 
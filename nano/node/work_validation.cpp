@@ -0,0 +1,147 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/config.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/lib/threading.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/node/work_validation.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+nano::work_validation::work_validation (nano::work_thresholds const & work_a, nano::stats & stats_a, unsigned threads_a) :
+	work (work_a),
+	stats (stats_a)
+{
+	for (auto i = 0u; i < threads_a; ++i)
+	{
+		threads.emplace_back ([this] () {
+			nano::thread_role::set (nano::thread_role::name::work_validation);
+			run ();
+		});
+	}
+}
+
+nano::work_validation::~work_validation ()
+{
+	stop ();
+}
+
+void nano::work_validation::stop ()
+{
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		stopped = true;
+	}
+	condition.notify_all ();
+	for (auto & thread : threads)
+	{
+		nano::join_or_pass (thread);
+	}
+}
+
+void nano::work_validation::add (value_type const & item_a)
+{
+	if (threads.empty ())
+	{
+		std::deque<value_type> items{ item_a };
+		auto insufficient = validate (items);
+		blocks_validated_callback (items, insufficient);
+		return;
+	}
+	// Blocks with a cached work value are queued as well, validating them is free but bypassing the queue would reorder them
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		blocks.push_back (item_a);
+	}
+	condition.notify_one ();
+}
+
+std::size_t nano::work_validation::size ()
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return blocks.size ();
+}
+
+bool nano::work_validation::is_active ()
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return !blocks.empty () || active != 0;
+}
+
+void nano::work_validation::run ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	while (!stopped)
+	{
+		if (!blocks.empty ())
+		{
+			std::deque<value_type> items;
+			auto count = std::min (blocks.size (), batch_size);
+			items.insert (items.end (), blocks.begin (), blocks.begin () + count);
+			blocks.erase (blocks.begin (), blocks.begin () + count);
+			auto sequence = next_sequence++;
+			++active;
+			lock.unlock ();
+			auto insufficient = validate (items);
+			lock.lock ();
+			validated.emplace (sequence, batch_t{ std::move (items), std::move (insufficient) });
+			deliver (lock);
+			--active;
+			if (blocks.empty () && active == 0 && transition_inactive_callback)
+			{
+				lock.unlock ();
+				transition_inactive_callback ();
+				lock.lock ();
+			}
+		}
+		else
+		{
+			condition.wait (lock);
+		}
+	}
+}
+
+void nano::work_validation::deliver (nano::unique_lock<nano::mutex> & lock_a)
+{
+	debug_assert (lock_a.owns_lock ());
+	// Another thread is delivering and picks up this batch once the earlier ones are done
+	if (delivering)
+	{
+		return;
+	}
+	delivering = true;
+	while (!validated.empty () && validated.begin ()->first == next_delivery)
+	{
+		auto batch = std::move (validated.begin ()->second);
+		validated.erase (validated.begin ());
+		++next_delivery;
+		lock_a.unlock ();
+		blocks_validated_callback (batch.first, batch.second);
+		lock_a.lock ();
+	}
+	delivering = false;
+}
+
+std::vector<bool> nano::work_validation::validate (std::deque<value_type> const & items)
+{
+	std::vector<std::shared_ptr<nano::block>> batch;
+	batch.reserve (items.size ());
+	std::transform (items.begin (), items.end (), std::back_inserter (batch), [] (auto const & item) { return std::get<0> (item); });
+	std::size_t cached = std::count_if (batch.begin (), batch.end (), [] (auto const & block) { return block->work_value_cached () != 0; });
+	auto insufficient = work.validate_entry (batch);
+	stats.add (nano::stat::type::work_validation, nano::stat::detail::work_cached, nano::stat::dir::in, cached);
+	if (batch.size () > cached)
+	{
+		stats.inc (nano::stat::type::work_validation, nano::stat::detail::batch);
+		stats.add (nano::stat::type::work_validation, nano::stat::detail::work_validated, nano::stat::dir::in, batch.size () - cached);
+	}
+	stats.add (nano::stat::type::work_validation, nano::stat::detail::insufficient_work, nano::stat::dir::in, std::count (insufficient.begin (), insufficient.end (), true));
+	return insufficient;
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (work_validation & work_validation, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "blocks", work_validation.size (), sizeof (work_validation::value_type) }));
+	return composite;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace nano
+{
+class block;
+class container_info_component;
+class stats;
+class work_thresholds;
+
+/**
+ * Validates the work of incoming blocks ahead of the block processor.
+ * Queued blocks are taken in batches and hashed with the widest work kernel the CPU supports on a small pool of threads.
+ * The work value is cached on each block so the block processor and ledger never recompute it.
+ * Batches validated concurrently are handed on in the order their blocks were added, so blocks of the same chain are never reordered.
+ */
+class work_validation final
+{
+public:
+	/** Block and the time it was handed to the block processor */
+	using value_type = std::tuple<std::shared_ptr<nano::block>, std::chrono::steady_clock::time_point>;
+
+	/** With zero threads blocks are validated on the calling thread */
+	work_validation (nano::work_thresholds const &, nano::stats &, unsigned threads);
+	~work_validation ();
+	void stop ();
+	void add (value_type const &);
+	std::size_t size ();
+	/** Returns true if blocks are queued or being validated */
+	bool is_active ();
+
+	/** Called with each validated batch, the element for each block is true if its work is insufficient */
+	std::function<void (std::deque<value_type> &, std::vector<bool> const &)> blocks_validated_callback;
+	std::function<void ()> transition_inactive_callback;
+
+	static std::size_t constexpr batch_size{ 256 };
+
+private:
+	using batch_t = std::pair<std::deque<value_type>, std::vector<bool>>;
+
+	void run ();
+	/** Returns for each block whether its work is insufficient */
+	std::vector<bool> validate (std::deque<value_type> const &);
+	/** Hands on validated batches in sequence, only one thread delivers at a time */
+	void deliver (nano::unique_lock<nano::mutex> &);
+
+	nano::work_thresholds const & work;
+	nano::stats & stats;
+	nano::mutex mutex{ mutex_identifier (mutexes::work_validation) };
+	nano::condition_variable condition;
+	bool stopped{ false };
+	unsigned active{ 0 };
+	std::deque<value_type> blocks;
+	/** Validated batches waiting for earlier batches to be delivered, keyed by sequence number */
+	std::map<uint64_t, batch_t> validated;
+	uint64_t next_sequence{ 0 };
+	uint64_t next_delivery{ 0 };
+	bool delivering{ false };
+	std::vector<std::thread> threads;
+};
+
+std::unique_ptr<nano::container_info_component> collect_container_info (work_validation &, std::string const & name);
+}
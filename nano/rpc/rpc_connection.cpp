@@ -14,6 +14,8 @@
 #endif
 #include <boost/format.hpp>
 
+#include <algorithm>
+
 nano::rpc_connection::rpc_connection (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface) :
 	socket (io_ctx),
 	strand (io_ctx.get_executor ()),
@@ -117,11 +119,7 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 				ss << std::hex << std::showbase << reinterpret_cast<uintptr_t> (this_l.get ());
 				auto request_id = ss.str ();
 				auto response_handler ([this_l, version, start, request_id, &stream] (std::string const & tree_a) {
-					auto body = tree_a;
-					this_l->write_result (body, version);
-					boost::beast::http::async_write (stream, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
-						this_l->write_completion_handler (this_l);
-					}));
+					this_l->write_response (stream, tree_a, version);
 
 					std::stringstream ss;
 					if (this_l->rpc_config.rpc_logging.log_rpc)
@@ -173,6 +171,68 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 	}));
 }
 
+template <typename STREAM_TYPE>
+void nano::rpc_connection::write_response (STREAM_TYPE & stream, std::string body, unsigned version)
+{
+	auto this_l (shared_from_this ());
+	auto chunk_size (rpc_config.response_chunk_size);
+	if (version < 11 || chunk_size == 0 || body.size () <= chunk_size)
+	{
+		write_result (std::move (body), version);
+		boost::beast::http::async_write (stream, res, boost::asio::bind_executor (strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			this_l->write_completion_handler (this_l);
+		}));
+	}
+	else if (!responded.test_and_set ())
+	{
+		// The client can start parsing while the remainder of a large response is still being written
+		prepare_head (version);
+		res.chunked (true);
+		auto serializer (std::make_shared<boost::beast::http::response_serializer<boost::beast::http::string_body>> (res));
+		auto body_l (std::make_shared<std::string> (std::move (body)));
+		boost::beast::http::async_write_header (stream, *serializer, boost::asio::bind_executor (strand, [this_l, serializer, body_l, &stream] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			if (!ec)
+			{
+				this_l->write_chunk (stream, body_l, 0);
+			}
+			else
+			{
+				this_l->write_completion_handler (this_l);
+			}
+		}));
+	}
+	else
+	{
+		debug_assert (false && "RPC already responded and should only respond once");
+	}
+}
+
+template <typename STREAM_TYPE>
+void nano::rpc_connection::write_chunk (STREAM_TYPE & stream, std::shared_ptr<std::string> const & body, std::size_t offset)
+{
+	auto this_l (shared_from_this ());
+	if (offset < body->size ())
+	{
+		auto size (std::min<std::size_t> (rpc_config.response_chunk_size, body->size () - offset));
+		boost::asio::async_write (stream, boost::beast::http::make_chunk (boost::asio::buffer (body->data () + offset, size)), boost::asio::bind_executor (strand, [this_l, body, offset, size, &stream] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			if (!ec)
+			{
+				this_l->write_chunk (stream, body, offset + size);
+			}
+			else
+			{
+				this_l->write_completion_handler (this_l);
+			}
+		}));
+	}
+	else
+	{
+		boost::asio::async_write (stream, boost::beast::http::make_chunk_last (), boost::asio::bind_executor (strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			this_l->write_completion_handler (this_l);
+		}));
+	}
+}
+
 template void nano::rpc_connection::read (socket_type &);
 template void nano::rpc_connection::parse_request (socket_type &, std::shared_ptr<boost::beast::http::request_parser<boost::beast::http::empty_body>> const &);
 #ifdef NANO_SECURE_RPC
@@ -8,6 +8,8 @@
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <atomic>
+#include <memory>
+#include <string>
 
 /* Boost v1.70 introduced breaking changes; the conditional compilation allows 1.6x to be supported as well. */
 #if BOOST_VERSION < 107000
@@ -48,5 +50,12 @@ protected:
 
 	template <typename STREAM_TYPE>
 	void parse_request (STREAM_TYPE & stream, std::shared_ptr<boost::beast::http::request_parser<boost::beast::http::empty_body>> const & header_parser);
+
+	/** Writes the response, large HTTP/1.1 bodies are sent with chunked transfer encoding */
+	template <typename STREAM_TYPE>
+	void write_response (STREAM_TYPE & stream, std::string body, unsigned version);
+
+	template <typename STREAM_TYPE>
+	void write_chunk (STREAM_TYPE & stream, std::shared_ptr<std::string> const & body, std::size_t offset);
 };
 }
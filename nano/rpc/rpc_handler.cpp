@@ -183,6 +183,7 @@ std::unordered_set<std::string> create_rpc_control_impls ()
 	set.emplace ("wallet_lock");
 	set.emplace ("wallet_representative_set");
 	set.emplace ("wallet_republish");
+	set.emplace ("wallet_work_cache");
 	set.emplace ("wallet_work_get");
 	set.emplace ("work_generate");
 	set.emplace ("work_cancel");
@@ -1139,6 +1139,47 @@ TEST (rpc, account_history)
 	}
 }
 
+TEST (rpc, account_history_cursor)
+{
+	nano::test::system system;
+	auto node = add_ipc_enabled_node (system);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	auto change (system.wallet (0)->change_action (nano::dev::genesis_key.pub, nano::dev::genesis_key.pub));
+	ASSERT_NE (nullptr, change);
+	auto send (system.wallet (0)->send_action (nano::dev::genesis_key.pub, nano::dev::genesis_key.pub, node->config.receive_minimum.number ()));
+	ASSERT_NE (nullptr, send);
+	auto receive (system.wallet (0)->receive_action (send->hash (), nano::dev::genesis_key.pub, node->config.receive_minimum.number (), send->link ().as_account ()));
+	ASSERT_NE (nullptr, receive);
+	auto const rpc_ctx = add_rpc (system, node);
+	// Pages are also larger than this, exercising chunked responses
+	rpc_ctx.rpc->config.response_chunk_size = 64;
+	boost::property_tree::ptree request;
+	request.put ("action", "account_history");
+	request.put ("account", nano::dev::genesis_key.pub.to_account ());
+	request.put ("raw", true);
+	request.put ("count", 2);
+	std::vector<std::string> heights;
+	std::string cursor;
+	do
+	{
+		auto response (wait_response (system, rpc_ctx, request));
+		for (auto & entry : response.get_child ("history"))
+		{
+			heights.push_back (entry.second.get<std::string> ("height"));
+		}
+		cursor = response.get<std::string> ("cursor", "");
+		request.put ("cursor", cursor);
+	} while (!cursor.empty ());
+	std::vector<std::string> expected{ "4", "3", "2", "1" };
+	ASSERT_EQ (expected, heights);
+
+	// A cursor whose block is no longer at the recorded height is rejected
+	request.put ("cursor", receive->hash ().to_string () + nano::to_string_hex (1));
+	auto response (wait_response (system, rpc_ctx, request));
+	std::error_code ec (nano::error_rpc::invalid_cursor);
+	ASSERT_EQ (ec.message (), response.get<std::string> ("error"));
+}
+
 TEST (rpc, history_count)
 {
 	nano::test::system system;
@@ -2972,6 +3013,52 @@ TEST (rpc, accounts_balances_with_errors)
 	ASSERT_EQ (get_error_message (nano::error_common::bad_account_number), bad_account_number_error_text);
 }
 
+/**
+ * Test the RPC accounts_balances with enough accounts to be split across threads, results must keep the request order
+ */
+TEST (rpc, accounts_balances_parallel)
+{
+	nano::test::system system;
+	auto node = add_ipc_enabled_node (system);
+	auto const rpc_ctx = add_rpc (system, node);
+	boost::property_tree::ptree request;
+	request.put ("action", "accounts_balances");
+	boost::property_tree::ptree accounts_l;
+	std::vector<std::string> expected;
+	auto const bad_account_number = "nano_3e3j5tkog48pnny9dmfzj1r16pg8t1e76dz5tmac6iq689wyjfpiij4txtd1";
+	for (auto i (0); i < 1000; ++i)
+	{
+		std::string account_text;
+		if (i == 500)
+		{
+			account_text = bad_account_number;
+		}
+		else
+		{
+			account_text = (i == 700 ? nano::dev::genesis_key.pub : nano::keypair ().pub).to_account ();
+			expected.push_back (account_text);
+		}
+		boost::property_tree::ptree entry;
+		entry.put ("", account_text);
+		accounts_l.push_back (std::make_pair ("", entry));
+	}
+	request.add_child ("accounts", accounts_l);
+	auto response (wait_response (system, rpc_ctx, request));
+
+	auto balances = response.get_child ("balances");
+	ASSERT_EQ (expected.size (), balances.size ());
+	auto expected_i (expected.begin ());
+	for (auto const & [account_text, balance] : balances)
+	{
+		ASSERT_EQ (*expected_i++, account_text);
+		auto const genesis (account_text == nano::dev::genesis_key.pub.to_account ());
+		ASSERT_EQ (genesis ? "340282366920938463463374607431768211455" : "0", balance.get<std::string> ("balance"));
+	}
+	auto errors = response.get_child ("errors");
+	ASSERT_EQ (1, errors.size ());
+	ASSERT_EQ (1, errors.count (bad_account_number));
+}
+
 /**
  * Test the case where an account has no blocks at all (unopened) but has receivables
  * In other words, sending to an a unopened account without receiving the funds
@@ -3492,6 +3579,33 @@ TEST (rpc, wallet_work_get)
 	}
 }
 
+TEST (rpc, wallet_work_cache)
+{
+	nano::test::system system;
+	auto node = add_ipc_enabled_node (system);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	// Work for the genesis frontier is precached when the key is inserted
+	ASSERT_TIMELY (10s, node->stats.count (nano::stat::type::wallet_work_cache, nano::stat::detail::update) == 1);
+	nano::keypair key;
+	ASSERT_NE (nullptr, system.wallet (0)->send_action (nano::dev::genesis_key.pub, key.pub, 100));
+	ASSERT_TIMELY (10s, node->stats.count (nano::stat::type::wallet_work_cache, nano::stat::detail::update) == 2);
+	auto const rpc_ctx = add_rpc (system, node);
+	boost::property_tree::ptree request;
+	request.put ("action", "wallet_work_cache");
+	request.put ("wallet", node->wallets.items.begin ()->first.to_string ());
+	auto response (wait_response (system, rpc_ctx, request));
+	ASSERT_EQ ("0", response.get<std::string> ("queued"));
+	ASSERT_EQ ("0", response.get<std::string> ("generating"));
+	ASSERT_EQ ("1", response.get<std::string> ("hits"));
+	ASSERT_EQ ("0", response.get<std::string> ("misses"));
+	auto & accounts (response.get_child ("accounts"));
+	ASSERT_EQ (1, accounts.size ());
+	auto & entry (accounts.get_child (nano::dev::genesis_key.pub.to_account ()));
+	ASSERT_EQ (node->latest (nano::dev::genesis_key.pub).to_string (), entry.get<std::string> ("root"));
+	ASSERT_TRUE (entry.get<bool> ("ready"));
+	ASSERT_FALSE (entry.get<bool> ("scheduled"));
+}
+
 TEST (rpc, work_set)
 {
 	nano::test::system system;
@@ -5429,6 +5543,32 @@ TEST (rpc, stats_clear)
 	ASSERT_LE (node->stats.last_reset ().count (), 5);
 }
 
+TEST (rpc, stats_latency)
+{
+	nano::test::system system;
+	auto node = add_ipc_enabled_node (system);
+	auto const rpc_ctx = add_rpc (system, node);
+	node->stats.sample (nano::stat::latency::vote_verified, std::chrono::microseconds (10));
+	node->stats.sample (nano::stat::latency::vote_verified, std::chrono::microseconds (20));
+	boost::property_tree::ptree request;
+	request.put ("action", "stats");
+	request.put ("type", "latency");
+	auto response (wait_response (system, rpc_ctx, request));
+	ASSERT_EQ ("latency", response.get<std::string> ("type"));
+	auto & entries (response.get_child ("entries"));
+	ASSERT_EQ (static_cast<std::size_t> (nano::stat::latency::_last), entries.size ());
+	auto vote_verified (std::find_if (entries.begin (), entries.end (), [] (auto const & entry_a) {
+		return entry_a.second.template get<std::string> ("stage") == "vote_verified";
+	}));
+	ASSERT_NE (entries.end (), vote_verified);
+	ASSERT_EQ (2, vote_verified->second.get<uint64_t> ("count"));
+	ASSERT_EQ (15, vote_verified->second.get<uint64_t> ("mean"));
+	ASSERT_EQ (10, vote_verified->second.get<uint64_t> ("p50"));
+	ASSERT_EQ (20, vote_verified->second.get<uint64_t> ("p99"));
+	ASSERT_EQ (20, vote_verified->second.get<uint64_t> ("p999"));
+	ASSERT_EQ (20, vote_verified->second.get<uint64_t> ("max"));
+}
+
 // Tests the RPC command returns the correct data for the unchecked blocks
 TEST (rpc, unchecked)
 {
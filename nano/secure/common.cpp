@@ -736,6 +736,7 @@ void nano::generate_cache::enable_all ()
 	cemented_count = true;
 	unchecked_count = true;
 	account_count = true;
+	receivable = true;
 }
 
 nano::stat::detail nano::to_stat_detail (nano::process_result process_result)
@@ -6,6 +6,7 @@
 #include <nano/lib/config.hpp>
 #include <nano/lib/epoch.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/receivable_summary.hpp>
 #include <nano/lib/rep_weights.hpp>
 #include <nano/lib/stats.hpp>
 #include <nano/lib/timer.hpp>
@@ -492,6 +493,8 @@ public:
 	bool unchecked_count = true;
 	bool account_count = true;
 	bool block_count = true;
+	/** Opt-in, generating the receivable summary scans the whole pending table */
+	bool receivable = false;
 
 	void enable_all ();
 };
@@ -501,6 +504,7 @@ class ledger_cache
 {
 public:
 	nano::rep_weights rep_weights;
+	nano::receivable_summary receivable;
 	std::atomic<uint64_t> cemented_count{ 0 };
 	std::atomic<uint64_t> block_count{ 0 };
 	std::atomic<uint64_t> pruned_count{ 0 };
@@ -10,6 +10,17 @@
 
 namespace
 {
+/**
+ * Additions to the receivable summary are applied immediately, removals only once they are committed.
+ * The summary never reports less than the committed pending table, so readers don't skip an account that still has a qualifying entry.
+ */
+void receivable_remove (nano::ledger & ledger_a, nano::write_transaction const & transaction_a, nano::account const & account_a, nano::uint128_t const & amount_a)
+{
+	transaction_a.on_commit ([&receivable = ledger_a.cache.receivable, account_a, amount_a] () {
+		receivable.remove (account_a, amount_a);
+	});
+}
+
 /**
  * Roll back the visited block
  */
@@ -37,6 +48,7 @@ public:
 			auto info = ledger.account_info (transaction, pending.source);
 			debug_assert (info);
 			ledger.store.pending.del (transaction, key);
+			receivable_remove (ledger, transaction, key.account, pending.amount.number ());
 			ledger.cache.rep_weights.representation_add (info->representative, pending.amount.number ());
 			nano::account_info new_info (block_a.hashables.previous, info->representative, info->open_block, ledger.balance (transaction, block_a.hashables.previous), nano::seconds_since_epoch (), info->block_count - 1, nano::epoch::epoch_0);
 			ledger.update_account (transaction, pending.source, *info, new_info);
@@ -62,6 +74,7 @@ public:
 		ledger.update_account (transaction, destination_account, *info, new_info);
 		ledger.store.block.del (transaction, hash);
 		ledger.store.pending.put (transaction, nano::pending_key (destination_account, block_a.hashables.source), { source_account, amount, nano::epoch::epoch_0 });
+		ledger.cache.receivable.add (destination_account, amount);
 		ledger.store.frontier.del (transaction, hash);
 		ledger.store.frontier.put (transaction, block_a.hashables.previous, destination_account);
 		ledger.store.block.successor_clear (transaction, block_a.hashables.previous);
@@ -80,6 +93,7 @@ public:
 		ledger.update_account (transaction, destination_account, new_info, new_info);
 		ledger.store.block.del (transaction, hash);
 		ledger.store.pending.put (transaction, nano::pending_key (destination_account, block_a.hashables.source), { source_account, amount, nano::epoch::epoch_0 });
+		ledger.cache.receivable.add (destination_account, amount);
 		ledger.store.frontier.del (transaction, hash);
 		ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::open);
 	}
@@ -139,6 +153,7 @@ public:
 				error = ledger.rollback (transaction, ledger.latest (transaction, block_a.hashables.link.as_account ()), list);
 			}
 			ledger.store.pending.del (transaction, key);
+			receivable_remove (ledger, transaction, key.account, balance - block_a.hashables.balance.number ());
 			ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::send);
 		}
 		else if (!block_a.hashables.link.is_zero () && !ledger.is_epoch_link (block_a.hashables.link))
@@ -148,6 +163,7 @@ public:
 			auto source_account (ledger.account_safe (transaction, block_a.hashables.link.as_block_hash (), is_pruned));
 			nano::pending_info pending_info (source_account, block_a.hashables.balance.number () - balance, block_a.sideband ().source_epoch);
 			ledger.store.pending.put (transaction, nano::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), pending_info);
+			ledger.cache.receivable.add (block_a.hashables.account, pending_info.amount.number ());
 			ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::receive);
 		}
 
@@ -349,10 +365,12 @@ void ledger_processor::state_block_impl (nano::state_block & block_a)
 							nano::pending_key key (block_a.hashables.link.as_account (), hash);
 							nano::pending_info info (block_a.hashables.account, amount.number (), epoch);
 							ledger.store.pending.put (transaction, key, info);
+							ledger.cache.receivable.add (key.account, amount.number ());
 						}
 						else if (!block_a.hashables.link.is_zero ())
 						{
 							ledger.store.pending.del (transaction, nano::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()));
+							receivable_remove (ledger, transaction, block_a.hashables.account, amount.number ());
 						}
 
 						nano::account_info new_info (hash, block_a.representative (), info.open_block.is_zero () ? hash : info.open_block, block_a.hashables.balance, nano::seconds_since_epoch (), info.block_count + 1, epoch);
@@ -525,6 +543,7 @@ void ledger_processor::send_block (nano::send_block & block_a)
 								nano::account_info new_info (hash, info->representative, info->open_block, block_a.hashables.balance, nano::seconds_since_epoch (), info->block_count + 1, nano::epoch::epoch_0);
 								ledger.update_account (transaction, account, *info, new_info);
 								ledger.store.pending.put (transaction, nano::pending_key (block_a.hashables.destination, hash), { account, amount, nano::epoch::epoch_0 });
+								ledger.cache.receivable.add (block_a.hashables.destination, amount);
 								ledger.store.frontier.del (transaction, block_a.hashables.previous);
 								ledger.store.frontier.put (transaction, hash, account);
 								ledger.stats.inc (nano::stat::type::ledger, nano::stat::detail::send);
@@ -588,6 +607,7 @@ void ledger_processor::receive_block (nano::receive_block & block_a)
 											}
 #endif
 											ledger.store.pending.del (transaction, key);
+											receivable_remove (ledger, transaction, key.account, pending.amount.number ());
 											block_a.sideband_set (nano::block_sideband (account, 0, new_balance, info->block_count + 1, nano::seconds_since_epoch (), block_details, nano::epoch::epoch_0 /* unused */));
 											ledger.store.block.put (transaction, hash, block_a);
 											nano::account_info new_info (hash, info->representative, info->open_block, new_balance, nano::seconds_since_epoch (), info->block_count + 1, nano::epoch::epoch_0);
@@ -654,6 +674,7 @@ void ledger_processor::open_block (nano::open_block & block_a)
 									}
 #endif
 									ledger.store.pending.del (transaction, key);
+									receivable_remove (ledger, transaction, key.account, pending.amount.number ());
 									block_a.sideband_set (nano::block_sideband (block_a.hashables.account, 0, pending.amount, 1, nano::seconds_since_epoch (), block_details, nano::epoch::epoch_0 /* unused */));
 									ledger.store.block.put (transaction, hash, block_a);
 									nano::account_info new_info (hash, block_a.representative (), hash, pending.amount.number (), nano::seconds_since_epoch (), 1, nano::epoch::epoch_0);
@@ -725,6 +746,21 @@ void nano::ledger::initialize (nano::generate_cache const & generate_cache_a)
 		});
 	}
 
+	if (generate_cache_a.receivable)
+	{
+		store.pending.for_each_par (
+		[this] (nano::read_transaction const & /*unused*/, nano::store_iterator<nano::pending_key, nano::pending_info> i, nano::store_iterator<nano::pending_key, nano::pending_info> n) {
+			decltype (this->cache.receivable) receivable_l;
+			receivable_l.set_populated ();
+			for (; i != n; ++i)
+			{
+				receivable_l.add (i->first.account, i->second.amount.number ());
+			}
+			this->cache.receivable.copy_from (receivable_l);
+		});
+		cache.receivable.set_populated ();
+	}
+
 	auto transaction (store.tx_begin_read ());
 	cache.pruned_count = store.pruned.count (transaction);
 
@@ -783,8 +819,7 @@ nano::uint128_t nano::ledger::account_balance (nano::transaction const & transac
 nano::uint128_t nano::ledger::account_receivable (nano::transaction const & transaction_a, nano::account const & account_a, bool only_confirmed_a)
 {
 	nano::uint128_t result (0);
-	nano::account end (account_a.number () + 1);
-	for (auto i (store.pending.begin (transaction_a, nano::pending_key (account_a, 0))), n (store.pending.begin (transaction_a, nano::pending_key (end, 0))); i != n; ++i)
+	for (auto i (store.pending.begin (transaction_a, account_a)), n (store.pending.end ()); i != n && i->first.account == account_a; ++i)
 	{
 		nano::pending_info const & info (i->second);
 		if (only_confirmed_a)
@@ -1435,7 +1470,7 @@ std::multimap<uint64_t, nano::uncemented_info, std::greater<>> nano::ledger::unc
 }
 
 // A precondition is that the store is an LMDB store
-bool nano::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data_path_a) const
+bool nano::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data_path_a, std::function<void (std::string const &, uint64_t)> const & progress_a) const
 {
 	boost::system::error_code error_chmod;
 	nano::set_secure_perm_directory (data_path_a, error_chmod);
@@ -1452,75 +1487,8 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data
 
 	if (!rocksdb_store->init_error ())
 	{
-		store.block.for_each_par (
-		[&rocksdb_store] (nano::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::blocks }));
-
-				std::vector<uint8_t> vector;
-				{
-					nano::vectorstream stream (vector);
-					nano::serialize_block (stream, *i->second.block);
-					i->second.sideband.serialize (stream, i->second.block->type ());
-				}
-				rocksdb_store->block.raw_put (rocksdb_transaction, vector, i->first);
-			}
-		});
-
-		store.pending.for_each_par (
-		[&rocksdb_store] (nano::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::pending }));
-				rocksdb_store->pending.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.confirmation_height.for_each_par (
-		[&rocksdb_store] (nano::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::confirmation_height }));
-				rocksdb_store->confirmation_height.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.account.for_each_par (
-		[&rocksdb_store] (nano::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::accounts }));
-				rocksdb_store->account.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.frontier.for_each_par (
-		[&rocksdb_store] (nano::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::frontiers }));
-				rocksdb_store->frontier.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
-
-		store.pruned.for_each_par (
-		[&rocksdb_store] (nano::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::pruned }));
-				rocksdb_store->pruned.put (rocksdb_transaction, i->first);
-			}
-		});
-
-		store.final_vote.for_each_par (
-		[&rocksdb_store] (nano::read_transaction const & /*unused*/, auto i, auto n) {
-			for (; i != n; ++i)
-			{
-				auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::final_votes }));
-				rocksdb_store->final_vote.put (rocksdb_transaction, i->first, i->second);
-			}
-		});
+		// Ledger tables are written to sorted SST files and ingested directly, bypassing write transactions and memtables
+		error = rocksdb_store->bulk_load (store, progress_a);
 
 		auto lmdb_transaction (store.tx_begin_read ());
 		auto version = store.version.get (lmdb_transaction);
@@ -1583,5 +1551,6 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (le
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "bootstrap_weights", count, sizeof_element }));
 	composite->add_component (collect_container_info (ledger.cache.rep_weights, "rep_weights"));
+	composite->add_component (collect_container_info (ledger.cache.receivable, "receivable_summary"));
 	return composite;
 }
@@ -83,7 +83,8 @@ public:
 	nano::account const & epoch_signer (nano::link const &) const;
 	nano::link const & epoch_link (nano::epoch) const;
 	std::multimap<uint64_t, uncemented_info, std::greater<>> unconfirmed_frontiers () const;
-	bool migrate_lmdb_to_rocksdb (boost::filesystem::path const &) const;
+	/** Migrates the ledger into a new RocksDB store under the data path, \p progress_a is called with the table name and record count as each table completes */
+	bool migrate_lmdb_to_rocksdb (boost::filesystem::path const &, std::function<void (std::string const &, uint64_t)> const & progress_a = nullptr) const;
 	bool bootstrap_weight_reached () const;
 	static nano::uint128_t const unit;
 	nano::ledger_constants & constants;
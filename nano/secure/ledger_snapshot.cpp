@@ -0,0 +1,426 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/locks.hpp>
+#include <nano/secure/buffer.hpp>
+#include <nano/secure/ledger_snapshot.hpp>
+#include <nano/secure/store.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+
+namespace
+{
+/**
+ * Appends serialized records to a snapshot table file, buffering writes and patching the record count into the header on completion
+ */
+class table_writer final
+{
+public:
+	explicit table_writer (boost::filesystem::path const & path_a) :
+		file (path_a.string (), std::ios::binary | std::ios::trunc)
+	{
+		write_header ();
+	}
+
+	template <typename Fn>
+	void add (Fn const & serialize_a)
+	{
+		{
+			nano::vectorstream stream (buffer);
+			serialize_a (stream);
+		}
+		++count;
+		if (buffer.size () >= flush_size)
+		{
+			flush ();
+		}
+	}
+
+	/** Returns true on error */
+	bool finish ()
+	{
+		flush ();
+		file.seekp (0);
+		write_header ();
+		file.close ();
+		return file.fail ();
+	}
+
+	uint64_t count{ 0 };
+
+private:
+	void write_header ()
+	{
+		std::vector<uint8_t> header;
+		{
+			nano::vectorstream stream (header);
+			nano::write (stream, nano::ledger_snapshot::magic);
+			nano::write (stream, nano::ledger_snapshot::format_version);
+			nano::write (stream, count);
+		}
+		file.write (reinterpret_cast<char const *> (header.data ()), header.size ());
+	}
+
+	void flush ()
+	{
+		file.write (reinterpret_cast<char const *> (buffer.data ()), buffer.size ());
+		buffer.clear ();
+	}
+
+	static std::size_t constexpr flush_size{ 4 * 1024 * 1024 };
+	std::ofstream file;
+	std::vector<uint8_t> buffer;
+};
+
+/**
+ * Memory maps a snapshot table file and validates its header
+ */
+class table_reader final
+{
+public:
+	explicit table_reader (boost::filesystem::path const & path_a)
+	{
+		try
+		{
+			file.open (path_a.string ());
+		}
+		catch (std::exception const &)
+		{
+			error = true;
+		}
+		if (!error)
+		{
+			stream = std::make_unique<nano::bufferstream> (reinterpret_cast<uint8_t const *> (file.data ()), file.size ());
+			uint32_t magic{ 0 };
+			uint8_t version{ 0 };
+			error = nano::try_read (*stream, magic) || nano::try_read (*stream, version) || nano::try_read (*stream, count);
+			error = error || magic != nano::ledger_snapshot::magic || version != nano::ledger_snapshot::format_version;
+		}
+	}
+
+	boost::iostreams::mapped_file_source file;
+	std::unique_ptr<nano::bufferstream> stream;
+	uint64_t count{ 0 };
+	bool error{ false };
+};
+
+template <typename Fn>
+bool import_table (nano::store & store_a, boost::filesystem::path const & path_a, nano::tables table_a, Fn const & put_a, uint64_t & count_a)
+{
+	table_reader reader{ path_a };
+	auto error = reader.error;
+	if (!error)
+	{
+		try
+		{
+			auto transaction = store_a.tx_begin_write ({ table_a });
+			for (uint64_t i = 0; i < reader.count; ++i)
+			{
+				put_a (transaction, *reader.stream);
+				if ((i + 1) % nano::ledger_snapshot::import_batch_size == 0)
+				{
+					transaction.refresh ();
+				}
+			}
+			error = !nano::at_end (*reader.stream);
+		}
+		catch (std::runtime_error const &)
+		{
+			error = true;
+		}
+		count_a = reader.count;
+	}
+	return error;
+}
+
+template <typename T>
+void read_checked (nano::stream & stream_a, T & value_a)
+{
+	if (value_a.deserialize (stream_a))
+	{
+		throw std::runtime_error ("Failed to deserialize snapshot record");
+	}
+}
+
+void write_account_info (nano::stream & stream_a, nano::account_info const & info_a)
+{
+	// Field order matches account_info::deserialize
+	nano::write (stream_a, info_a.head.bytes);
+	nano::write (stream_a, info_a.representative.bytes);
+	nano::write (stream_a, info_a.open_block.bytes);
+	nano::write (stream_a, info_a.balance.bytes);
+	nano::write (stream_a, info_a.modified);
+	nano::write (stream_a, info_a.block_count);
+	nano::write (stream_a, info_a.epoch_m);
+}
+}
+
+nano::ledger_snapshot::ledger_snapshot (nano::store & store_a) :
+	store (store_a)
+{
+}
+
+bool nano::ledger_snapshot::export_to (boost::filesystem::path const & directory_a) const
+{
+	boost::filesystem::create_directories (directory_a);
+	auto notify = [this] (std::string const & name_a, uint64_t count_a) {
+		if (progress)
+		{
+			progress (name_a, count_a);
+		}
+	};
+
+	auto error (false);
+	auto transaction (store.tx_begin_read ());
+
+	// Representative weights are derived from the same account records so they are consistent with the rest of the snapshot
+	std::unordered_map<nano::account, nano::uint128_t> weights;
+	{
+		table_writer writer{ directory_a / "accounts.snapshot" };
+		for (auto i (store.account.begin (transaction)), n (store.account.end ()); i != n; ++i)
+		{
+			writer.add ([&i] (nano::stream & stream_a) {
+				nano::write (stream_a, i->first.bytes);
+				write_account_info (stream_a, i->second);
+			});
+			weights[i->second.representative] += i->second.balance.number ();
+		}
+		error |= writer.finish ();
+		notify ("accounts", writer.count);
+	}
+	{
+		table_writer writer{ directory_a / "rep_weights.snapshot" };
+		for (auto const & [representative, weight] : weights)
+		{
+			writer.add ([&representative = representative, &weight = weight] (nano::stream & stream_a) {
+				nano::write (stream_a, representative.bytes);
+				nano::write (stream_a, nano::amount{ weight }.bytes);
+			});
+		}
+		error |= writer.finish ();
+		notify ("rep_weights", writer.count);
+	}
+	{
+		table_writer writer{ directory_a / "blocks.snapshot" };
+		std::vector<uint8_t> value;
+		for (auto i (store.block.begin (transaction)), n (store.block.end ()); i != n; ++i)
+		{
+			value.clear ();
+			{
+				nano::vectorstream stream (value);
+				nano::serialize_block (stream, *i->second.block);
+				i->second.sideband.serialize (stream, i->second.block->type ());
+			}
+			writer.add ([&i, &value] (nano::stream & stream_a) {
+				nano::write (stream_a, i->first.bytes);
+				nano::write (stream_a, static_cast<uint32_t> (value.size ()));
+				nano::write (stream_a, value);
+			});
+		}
+		error |= writer.finish ();
+		notify ("blocks", writer.count);
+	}
+	{
+		table_writer writer{ directory_a / "pending.snapshot" };
+		for (auto i (store.pending.begin (transaction)), n (store.pending.end ()); i != n; ++i)
+		{
+			writer.add ([&i] (nano::stream & stream_a) {
+				nano::write (stream_a, i->first.account.bytes);
+				nano::write (stream_a, i->first.hash.bytes);
+				nano::write (stream_a, i->second.source.bytes);
+				nano::write (stream_a, i->second.amount.bytes);
+				nano::write (stream_a, i->second.epoch);
+			});
+		}
+		error |= writer.finish ();
+		notify ("pending", writer.count);
+	}
+	{
+		table_writer writer{ directory_a / "confirmation_height.snapshot" };
+		for (auto i (store.confirmation_height.begin (transaction)), n (store.confirmation_height.end ()); i != n; ++i)
+		{
+			writer.add ([&i] (nano::stream & stream_a) {
+				nano::write (stream_a, i->first.bytes);
+				i->second.serialize (stream_a);
+			});
+		}
+		error |= writer.finish ();
+		notify ("confirmation_height", writer.count);
+	}
+	{
+		table_writer writer{ directory_a / "frontiers.snapshot" };
+		for (auto i (store.frontier.begin (transaction)), n (store.frontier.end ()); i != n; ++i)
+		{
+			writer.add ([&i] (nano::stream & stream_a) {
+				nano::write (stream_a, i->first.bytes);
+				nano::write (stream_a, i->second.bytes);
+			});
+		}
+		error |= writer.finish ();
+		notify ("frontiers", writer.count);
+	}
+	{
+		table_writer writer{ directory_a / "pruned.snapshot" };
+		for (auto i (store.pruned.begin (transaction)), n (store.pruned.end ()); i != n; ++i)
+		{
+			writer.add ([&i] (nano::stream & stream_a) {
+				nano::write (stream_a, i->first.bytes);
+			});
+		}
+		error |= writer.finish ();
+		notify ("pruned", writer.count);
+	}
+	{
+		table_writer writer{ directory_a / "final_votes.snapshot" };
+		for (auto i (store.final_vote.begin (transaction)), n (store.final_vote.end ()); i != n; ++i)
+		{
+			writer.add ([&i] (nano::stream & stream_a) {
+				nano::write (stream_a, i->first.bytes);
+				nano::write (stream_a, i->second.bytes);
+			});
+		}
+		error |= writer.finish ();
+		notify ("final_votes", writer.count);
+	}
+	{
+		table_writer writer{ directory_a / "version.snapshot" };
+		auto version = store.version.get (transaction);
+		writer.add ([version] (nano::stream & stream_a) {
+			nano::write (stream_a, version);
+		});
+		error |= writer.finish ();
+	}
+	return error;
+}
+
+bool nano::ledger_snapshot::import_from (boost::filesystem::path const & directory_a)
+{
+	auto error (false);
+	{
+		auto transaction (store.tx_begin_read ());
+		// Only a freshly initialized ledger (genesis only) can be bulk loaded
+		error = store.block.count (transaction) > 1;
+
+		table_reader reader{ directory_a / "version.snapshot" };
+		int version{ 0 };
+		error = error || reader.error || reader.count != 1 || nano::try_read (*reader.stream, version);
+		error = error || version != store.version.get (transaction);
+	}
+	if (error)
+	{
+		return error;
+	}
+
+	// Records go through the table put functions in batched write transactions. store::bulk_load only copies from the tables of another store
+	// and is not implemented for LMDB, so it cannot load from snapshot files.
+	std::atomic<bool> failed{ false };
+	std::vector<std::thread> threads;
+	nano::mutex progress_mutex;
+	auto spawn = [this, &directory_a, &failed, &threads, &progress_mutex] (std::string const & name_a, nano::tables table_a, auto put_a) {
+		auto import = [this, path = directory_a / (name_a + ".snapshot"), name_a, table_a, put_a, &failed, &progress_mutex] () {
+			uint64_t count{ 0 };
+			if (import_table (store, path, table_a, put_a, count))
+			{
+				failed = true;
+			}
+			else if (progress)
+			{
+				nano::lock_guard<nano::mutex> guard{ progress_mutex };
+				progress (name_a, count);
+			}
+		};
+		if (parallel_import)
+		{
+			threads.emplace_back (import);
+		}
+		else
+		{
+			import ();
+		}
+	};
+
+	std::unordered_map<nano::account, nano::uint128_t> weights;
+	spawn ("accounts", nano::tables::accounts, [this, &weights] (nano::write_transaction const & transaction_a, nano::stream & stream_a) {
+		nano::account account;
+		nano::account_info info;
+		nano::read (stream_a, account.bytes);
+		read_checked (stream_a, info);
+		store.account.put (transaction_a, account, info);
+		weights[info.representative] += info.balance.number ();
+	});
+	spawn ("blocks", nano::tables::blocks, [this] (nano::write_transaction const & transaction_a, nano::stream & stream_a) {
+		nano::block_hash hash;
+		uint32_t size{ 0 };
+		std::vector<uint8_t> value;
+		nano::read (stream_a, hash.bytes);
+		nano::read (stream_a, size);
+		nano::read (stream_a, value, size);
+		store.block.raw_put (transaction_a, value, hash);
+	});
+	spawn ("pending", nano::tables::pending, [this] (nano::write_transaction const & transaction_a, nano::stream & stream_a) {
+		nano::pending_key key;
+		nano::pending_info info;
+		read_checked (stream_a, key);
+		read_checked (stream_a, info);
+		store.pending.put (transaction_a, key, info);
+	});
+	spawn ("confirmation_height", nano::tables::confirmation_height, [this] (nano::write_transaction const & transaction_a, nano::stream & stream_a) {
+		nano::account account;
+		nano::confirmation_height_info info;
+		nano::read (stream_a, account.bytes);
+		read_checked (stream_a, info);
+		store.confirmation_height.put (transaction_a, account, info);
+	});
+	spawn ("frontiers", nano::tables::frontiers, [this] (nano::write_transaction const & transaction_a, nano::stream & stream_a) {
+		nano::block_hash hash;
+		nano::account account;
+		nano::read (stream_a, hash.bytes);
+		nano::read (stream_a, account.bytes);
+		store.frontier.put (transaction_a, hash, account);
+	});
+	spawn ("pruned", nano::tables::pruned, [this] (nano::write_transaction const & transaction_a, nano::stream & stream_a) {
+		nano::block_hash hash;
+		nano::read (stream_a, hash.bytes);
+		store.pruned.put (transaction_a, hash);
+	});
+	spawn ("final_votes", nano::tables::final_votes, [this] (nano::write_transaction const & transaction_a, nano::stream & stream_a) {
+		nano::qualified_root root;
+		nano::block_hash hash;
+		nano::read (stream_a, root.bytes);
+		nano::read (stream_a, hash.bytes);
+		store.final_vote.put (transaction_a, root, hash);
+	});
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	error = failed;
+
+	// Verify the imported accounts reproduce the exported representative weights
+	if (!error)
+	{
+		table_reader reader{ directory_a / "rep_weights.snapshot" };
+		error = reader.error || reader.count != weights.size ();
+		try
+		{
+			for (uint64_t i = 0; !error && i < reader.count; ++i)
+			{
+				nano::account representative;
+				nano::amount weight;
+				nano::read (*reader.stream, representative.bytes);
+				nano::read (*reader.stream, weight.bytes);
+				auto existing = weights.find (representative);
+				error = existing == weights.end () || existing->second != weight.number ();
+			}
+		}
+		catch (std::runtime_error const &)
+		{
+			error = true;
+		}
+	}
+	return error;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace nano
+{
+class store;
+
+/**
+ * Exports the ledger tables into a directory of per-table snapshot files and bulk loads them back into an empty store.
+ * The export runs inside a single read transaction so it is consistent and can be taken while the node is running.
+ * Each table is written in key order to its own file, which allows the import to load tables with large write batches, in parallel where the store supports it.
+ */
+class ledger_snapshot final
+{
+public:
+	explicit ledger_snapshot (nano::store &);
+
+	/** Writes a consistent snapshot of the ledger to `directory`. Returns true on error */
+	bool export_to (boost::filesystem::path const & directory) const;
+	/** Loads the snapshot in `directory` into the store, which must not contain anything but the genesis block. Returns true on error */
+	bool import_from (boost::filesystem::path const & directory);
+
+	/** Called with the table name and number of records once a table has been exported or imported. Calls never overlap, also during a parallel import */
+	std::function<void (std::string const &, uint64_t)> progress;
+
+	/**
+	 * Import each table on its own thread. This only helps stores which allow concurrent write transactions, such as RocksDB.
+	 * LMDB has a single writer, so per-table threads would just wait for each other's write transactions.
+	 */
+	bool parallel_import{ false };
+
+	/** Number of records written per write transaction during import */
+	static uint64_t constexpr import_batch_size{ 256 * 1024 };
+	static uint32_t constexpr magic{ 0x4e534e50 }; // "NSNP"
+	static uint8_t constexpr format_version{ 1 };
+
+private:
+	nano::store & store;
+};
+}
@@ -45,8 +45,10 @@ void nano::representative_visitor::state_block (nano::state_block const & block_
 	result = block_a.hash ();
 }
 
-nano::read_transaction::read_transaction (std::unique_ptr<nano::read_transaction_impl> read_transaction_impl) :
-	impl (std::move (read_transaction_impl))
+nano::read_transaction::read_transaction (std::unique_ptr<nano::read_transaction_impl> read_transaction_impl, std::chrono::milliseconds max_age_a) :
+	impl (std::move (read_transaction_impl)),
+	max_age (max_age_a),
+	start (std::chrono::steady_clock::now ())
 {
 }
 
@@ -63,6 +65,7 @@ void nano::read_transaction::reset () const
 void nano::read_transaction::renew () const
 {
 	impl->renew ();
+	start = std::chrono::steady_clock::now ();
 }
 
 void nano::read_transaction::refresh () const
@@ -71,6 +74,14 @@ void nano::read_transaction::refresh () const
 	renew ();
 }
 
+void nano::read_transaction::refresh_if_needed () const
+{
+	if (std::chrono::steady_clock::now () - start > max_age)
+	{
+		refresh ();
+	}
+}
+
 nano::write_transaction::write_transaction (std::unique_ptr<nano::write_transaction_impl> write_transaction_impl) :
 	impl (std::move (write_transaction_impl))
 {
@@ -80,6 +91,15 @@ nano::write_transaction::write_transaction (std::unique_ptr<nano::write_transact
 	debug_assert (nano::thread_role::get () != nano::thread_role::name::io);
 }
 
+nano::write_transaction::~write_transaction ()
+{
+	// The implementation commits on destruction, commit explicitly first so callbacks run after it
+	if (impl != nullptr && !commit_callbacks.empty ())
+	{
+		commit ();
+	}
+}
+
 void * nano::write_transaction::get_handle () const
 {
 	return impl->get_handle ();
@@ -88,6 +108,7 @@ void * nano::write_transaction::get_handle () const
 void nano::write_transaction::commit ()
 {
 	impl->commit ();
+	notify_committed ();
 }
 
 void nano::write_transaction::renew ()
@@ -98,6 +119,7 @@ void nano::write_transaction::renew ()
 void nano::write_transaction::refresh ()
 {
 	impl->commit ();
+	notify_committed ();
 	impl->renew ();
 }
 
@@ -106,6 +128,21 @@ bool nano::write_transaction::contains (nano::tables table_a) const
 	return impl->contains (table_a);
 }
 
+void nano::write_transaction::on_commit (std::function<void ()> callback_a) const
+{
+	commit_callbacks.push_back (std::move (callback_a));
+}
+
+void nano::write_transaction::notify_committed ()
+{
+	decltype (commit_callbacks) callbacks_l;
+	callbacks_l.swap (commit_callbacks);
+	for (auto const & callback : callbacks_l)
+	{
+		callback ();
+	}
+}
+
 // clang-format off
 nano::store::store (
 	nano::block_store & block_store_a,
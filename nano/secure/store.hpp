@@ -554,14 +554,18 @@ public:
 class read_transaction final : public transaction
 {
 public:
-	explicit read_transaction (std::unique_ptr<nano::read_transaction_impl> read_transaction_impl);
+	explicit read_transaction (std::unique_ptr<nano::read_transaction_impl> read_transaction_impl, std::chrono::milliseconds max_age_a = std::chrono::milliseconds (500));
 	void * get_handle () const override;
 	void reset () const;
 	void renew () const;
 	void refresh () const;
+	/** Refreshes the transaction if it has been open for longer than the store's staleness bound, for long running readers */
+	void refresh_if_needed () const;
 
 private:
 	std::unique_ptr<nano::read_transaction_impl> impl;
+	std::chrono::milliseconds max_age;
+	mutable std::chrono::steady_clock::time_point start;
 };
 
 /**
@@ -572,14 +576,20 @@ class write_transaction final : public transaction
 {
 public:
 	explicit write_transaction (std::unique_ptr<nano::write_transaction_impl> write_transaction_impl);
+	write_transaction (nano::write_transaction &&) = default;
+	~write_transaction ();
 	void * get_handle () const override;
 	void commit ();
 	void renew ();
 	void refresh ();
 	bool contains (nano::tables table_a) const;
+	/** Runs \p callback_a once the changes made so far have been committed, for in-memory state which must not run ahead of the database */
+	void on_commit (std::function<void ()> callback_a) const;
 
 private:
+	void notify_committed ();
 	std::unique_ptr<nano::write_transaction_impl> impl;
+	mutable std::vector<std::function<void ()>> commit_callbacks;
 };
 
 class ledger_cache;
@@ -631,6 +641,11 @@ public:
 	virtual bool any (nano::transaction const &, nano::account const &) = 0;
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> begin (nano::transaction const &, nano::pending_key const &) const = 0;
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> begin (nano::transaction const &) const = 0;
+	/**
+	 * Iterates the receivable entries of a single account. Backends may stop at the end of the account or continue into the following accounts,
+	 * so callers must still stop once the iterated account changes.
+	 */
+	virtual nano::store_iterator<nano::pending_key, nano::pending_info> begin (nano::transaction const &, nano::account const &) const = 0;
 	virtual nano::store_iterator<nano::pending_key, nano::pending_info> end () const = 0;
 	virtual void for_each_par (std::function<void (nano::read_transaction const &, nano::store_iterator<nano::pending_key, nano::pending_info>, nano::store_iterator<nano::pending_key, nano::pending_info>)> const & action_a) const = 0;
 };
@@ -749,6 +764,8 @@ public:
 	virtual void successor_clear (nano::write_transaction const &, nano::block_hash const &) = 0;
 	virtual std::shared_ptr<nano::block> get (nano::transaction const &, nano::block_hash const &) const = 0;
 	virtual std::shared_ptr<nano::block> get_no_sideband (nano::transaction const &, nano::block_hash const &) const = 0;
+	/** Appends the block, as written by `nano::serialize_block`, to the buffer straight from the stored record and reads its successor. Returns true if the block is missing */
+	virtual bool get_serialized (nano::transaction const &, nano::block_hash const &, std::vector<uint8_t> &, nano::block_hash & successor) const = 0;
 	virtual std::shared_ptr<nano::block> random (nano::transaction const &) = 0;
 	virtual void del (nano::write_transaction const &, nano::block_hash const &) = 0;
 	virtual bool exists (nano::transaction const &, nano::block_hash const &) = 0;
@@ -817,6 +834,16 @@ public:
 	virtual bool copy_db (boost::filesystem::path const & destination) = 0;
 	virtual void rebuild_db (nano::write_transaction const & transaction_a) = 0;
 
+	/**
+	 * Bulk loads the ledger tables of a source store into this store, bypassing write transactions. Returns true on error.
+	 * The progress callback is called with the table name and record count as each table completes.
+	 * Not applicable to all sub-classes
+	 */
+	virtual bool bulk_load (nano::store &, std::function<void (std::string const &, uint64_t)> const &)
+	{
+		return true;
+	}
+
 	/** Not applicable to all sub-classes */
 	virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
 	virtual void serialize_memory_stats (boost::property_tree::ptree &) = 0;
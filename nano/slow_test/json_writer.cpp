@@ -0,0 +1,191 @@
+#include <nano/lib/blockbuilders.hpp>
+#include <nano/lib/json_writer.hpp>
+#include <nano/secure/common.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+/*
+ * Microbenchmarks of RPC response rendering, comparing the property tree path the handlers used to take with the streaming writer.
+ * Each benchmark also checks that both paths produce the same bytes.
+ */
+
+namespace
+{
+std::chrono::milliseconds measure (std::function<void ()> const & action_a)
+{
+	auto start (std::chrono::steady_clock::now ());
+	action_a ();
+	return std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+}
+
+void report (std::string const & name_a, std::chrono::milliseconds ptree_a, std::chrono::milliseconds writer_a, std::size_t size_a)
+{
+	std::cout << name_a << ": ptree " << ptree_a.count () << " ms, json_writer " << writer_a.count () << " ms, " << size_a << " bytes" << std::endl;
+}
+
+std::vector<std::shared_ptr<nano::block>> make_blocks (std::size_t count_a)
+{
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	nano::keypair key;
+	nano::block_builder builder;
+	for (std::size_t i (0); i < count_a; ++i)
+	{
+		blocks.push_back (builder
+						  .state ()
+						  .account (key.pub)
+						  .previous (i)
+						  .representative (key.pub)
+						  .balance (i)
+						  .link (i)
+						  .sign (key.prv, key.pub)
+						  .work (i)
+						  .build_shared ());
+	}
+	return blocks;
+}
+}
+
+// Shape of a blocks_info response with json_block enabled
+TEST (json_writer, benchmark_blocks_info)
+{
+	auto blocks (make_blocks (50000));
+	std::string ptree_result;
+	auto ptree_time (measure ([&blocks, &ptree_result] () {
+		boost::property_tree::ptree response;
+		boost::property_tree::ptree entries;
+		for (auto const & block : blocks)
+		{
+			boost::property_tree::ptree entry;
+			entry.put ("block_account", block->account ().to_account ());
+			entry.put ("balance", block->balance ().to_string_dec ());
+			entry.put ("height", "1");
+			entry.put ("confirmed", true);
+			boost::property_tree::ptree contents;
+			block->serialize_json (contents);
+			entry.add_child ("contents", contents);
+			entries.push_back (std::make_pair (block->hash ().to_string (), entry));
+		}
+		response.add_child ("blocks", entries);
+		std::stringstream ostream;
+		boost::property_tree::write_json (ostream, response);
+		ptree_result = ostream.str ();
+	}));
+	std::string writer_result;
+	auto writer_time (measure ([&blocks, &writer_result] () {
+		nano::json_writer writer;
+		writer.begin_object ();
+		writer.key ("blocks").begin_object ();
+		for (auto const & block : blocks)
+		{
+			writer.key (block->hash ().to_string ()).begin_object ();
+			writer.put ("block_account", block->account ().to_account ());
+			writer.put ("balance", block->balance ().to_string_dec ());
+			writer.put ("height", "1");
+			writer.put ("confirmed", "true");
+			writer.key ("contents");
+			block->serialize_json (writer);
+			writer.end_object ();
+		}
+		writer.end_object ();
+		writer.end_object ();
+		writer_result = writer.finish ();
+	}));
+	ASSERT_EQ (ptree_result, writer_result);
+	report ("blocks_info", ptree_time, writer_time, writer_result.size ());
+}
+
+// Shape of a ledger or accounts_balances response
+TEST (json_writer, benchmark_ledger)
+{
+	std::size_t const count (200000);
+	std::string ptree_result;
+	auto ptree_time (measure ([count, &ptree_result] () {
+		boost::property_tree::ptree response;
+		boost::property_tree::ptree accounts;
+		for (std::size_t i (0); i < count; ++i)
+		{
+			nano::account account (i);
+			boost::property_tree::ptree entry;
+			entry.put ("frontier", account.to_string ());
+			entry.put ("balance", std::to_string (i));
+			entry.put ("modified_timestamp", std::to_string (i));
+			entry.put ("block_count", std::to_string (i));
+			accounts.push_back (std::make_pair (account.to_account (), entry));
+		}
+		response.add_child ("accounts", accounts);
+		std::stringstream ostream;
+		boost::property_tree::write_json (ostream, response);
+		ptree_result = ostream.str ();
+	}));
+	std::string writer_result;
+	auto writer_time (measure ([count, &writer_result] () {
+		nano::json_writer writer;
+		writer.begin_object ();
+		writer.key ("accounts").begin_object ();
+		for (std::size_t i (0); i < count; ++i)
+		{
+			nano::account account (i);
+			writer.key (account.to_account ()).begin_object ();
+			writer.put ("frontier", account.to_string ());
+			writer.put ("balance", std::to_string (i));
+			writer.put ("modified_timestamp", std::to_string (i));
+			writer.put ("block_count", std::to_string (i));
+			writer.end_object ();
+		}
+		writer.end_object ();
+		writer.end_object ();
+		writer_result = writer.finish ();
+	}));
+	ASSERT_EQ (ptree_result, writer_result);
+	report ("ledger", ptree_time, writer_time, writer_result.size ());
+}
+
+// Shape of an account_history response, entries are still built as small trees by the handler
+TEST (json_writer, benchmark_account_history)
+{
+	auto blocks (make_blocks (50000));
+	auto entry_for = [] (nano::block const & block_a) {
+		boost::property_tree::ptree entry;
+		entry.put ("type", "send");
+		entry.put ("account", block_a.link ().to_account ());
+		entry.put ("amount", block_a.balance ().to_string_dec ());
+		entry.put ("hash", block_a.hash ().to_string ());
+		entry.put ("confirmed", true);
+		return entry;
+	};
+	std::string ptree_result;
+	auto ptree_time (measure ([&blocks, &ptree_result, &entry_for] () {
+		boost::property_tree::ptree response;
+		boost::property_tree::ptree history;
+		for (auto const & block : blocks)
+		{
+			history.push_back (std::make_pair ("", entry_for (*block)));
+		}
+		response.add_child ("history", history);
+		std::stringstream ostream;
+		boost::property_tree::write_json (ostream, response);
+		ptree_result = ostream.str ();
+	}));
+	std::string writer_result;
+	auto writer_time (measure ([&blocks, &writer_result, &entry_for] () {
+		nano::json_writer writer;
+		writer.begin_object ();
+		writer.key ("history").begin_array ();
+		for (auto const & block : blocks)
+		{
+			writer.value (entry_for (*block));
+		}
+		writer.end_array ();
+		writer.end_object ();
+		writer_result = writer.finish ();
+	}));
+	ASSERT_EQ (ptree_result, writer_result);
+	report ("account_history", ptree_time, writer_time, writer_result.size ());
+}
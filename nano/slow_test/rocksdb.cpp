@@ -0,0 +1,142 @@
+#include <nano/crypto_lib/random_pool.hpp>
+#include <nano/lib/rocksdbconfig.hpp>
+#include <nano/lib/timer.hpp>
+#include <nano/node/rocksdb/rocksdb.hpp>
+#include <nano/secure/utility.hpp>
+#include <nano/test_common/system.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/format.hpp>
+
+#include <iostream>
+
+namespace
+{
+template <typename T>
+T random_key ()
+{
+	T result;
+	nano::random_pool::generate_block (result.bytes.data (), result.bytes.size ());
+	return result;
+}
+
+template <typename Fn>
+void measure (std::string const & profile_a, std::string const & name_a, std::size_t count_a, Fn const & action_a)
+{
+	nano::timer<std::chrono::microseconds> timer (nano::timer_state::started);
+	for (std::size_t i = 0; i < count_a; ++i)
+	{
+		action_a (i);
+	}
+	auto elapsed = std::max<uint64_t> (timer.stop ().count (), 1);
+	std::cout << boost::str (boost::format ("%1% %|20t|%2% %|50t|%3% ops/s\n") % profile_a % name_a % (count_a * 1000000 / elapsed));
+}
+
+/**
+ * Populates the tables whose tuning differs between profiles, reopens the database and measures the lookups each profile targets
+ */
+void run_profile (std::string const & name_a, nano::rocksdb_config const & config_a)
+{
+	auto constexpr account_count = 100'000;
+	auto constexpr pending_per_account = 4;
+	auto constexpr block_count = 200'000;
+	auto constexpr lookup_count = 100'000;
+
+	nano::logger_mt logger;
+	auto path = nano::unique_path () / "rocksdb";
+	std::vector<nano::account> accounts;
+	std::vector<nano::pending_key> pending_keys;
+	std::vector<nano::block_hash> hashes;
+	{
+		nano::rocksdb::store store{ logger, path, nano::dev::constants, config_a };
+		ASSERT_FALSE (store.init_error ());
+		std::vector<uint8_t> block_data (nano::state_block::size + nano::block_sideband::size (nano::block_type::state));
+		auto transaction = store.tx_begin_write ();
+		for (auto i = 0; i < account_count; ++i)
+		{
+			auto account = random_key<nano::account> ();
+			accounts.push_back (account);
+			store.account.put (transaction, account, nano::account_info{});
+			store.confirmation_height.put (transaction, account, { 1, random_key<nano::block_hash> () });
+			for (auto j = 0; j < pending_per_account; ++j)
+			{
+				nano::pending_key key{ account, random_key<nano::block_hash> () };
+				pending_keys.push_back (key);
+				store.pending.put (transaction, key, nano::pending_info{ random_key<nano::account> (), 1, nano::epoch::epoch_0 });
+			}
+			if ((i + 1) % 10'000 == 0)
+			{
+				transaction.refresh ();
+			}
+		}
+		for (auto i = 0; i < block_count; ++i)
+		{
+			auto hash = random_key<nano::block_hash> ();
+			hashes.push_back (hash);
+			nano::random_pool::generate_block (block_data.data (), block_data.size ());
+			store.block.raw_put (transaction, block_data, hash);
+			if ((i + 1) % 10'000 == 0)
+			{
+				transaction.refresh ();
+			}
+		}
+	}
+
+	// Reopen so lookups are served from SST files and block cache rather than the memtables
+	nano::rocksdb::store store{ logger, path, nano::dev::constants, config_a };
+	ASSERT_FALSE (store.init_error ());
+	auto transaction = store.tx_begin_read ();
+	std::size_t found{ 0 };
+	measure (name_a, "pending.exists hit", lookup_count, [&] (std::size_t i) {
+		found += store.pending.exists (transaction, pending_keys[i % pending_keys.size ()]);
+	});
+	measure (name_a, "pending.exists miss", lookup_count, [&] (std::size_t) {
+		found += store.pending.exists (transaction, nano::pending_key{ random_key<nano::account> (), random_key<nano::block_hash> () });
+	});
+	measure (name_a, "pending.any hit", lookup_count, [&] (std::size_t i) {
+		found += store.pending.any (transaction, accounts[i % accounts.size ()]);
+	});
+	measure (name_a, "block.exists hit", lookup_count, [&] (std::size_t i) {
+		found += store.block.exists (transaction, hashes[i % hashes.size ()]);
+	});
+	measure (name_a, "block.exists miss", lookup_count, [&] (std::size_t) {
+		found += store.block.exists (transaction, random_key<nano::block_hash> ());
+	});
+	measure (name_a, "account.exists hit", lookup_count, [&] (std::size_t i) {
+		found += store.account.exists (transaction, accounts[i % accounts.size ()]);
+	});
+	measure (name_a, "confirmation_height hit", lookup_count, [&] (std::size_t i) {
+		nano::confirmation_height_info info;
+		found += !store.confirmation_height.get (transaction, accounts[i % accounts.size ()], info);
+	});
+	measure (name_a, "confirmation_height miss", lookup_count, [&] (std::size_t) {
+		nano::confirmation_height_info info;
+		found += !store.confirmation_height.get (transaction, random_key<nano::account> (), info);
+	});
+	// Every "hit" benchmark must have found all of its keys
+	ASSERT_EQ (5 * lookup_count, found);
+}
+}
+
+/*
+ * db_bench style comparison of the RocksDB per table tuning profiles, see rocksdb_config::table_profile
+ */
+TEST (rocksdb, table_profiles)
+{
+	nano::rocksdb_config standard;
+	standard.enable = true;
+	standard.pending_profile = nano::rocksdb_config::table_profile::standard;
+	standard.blocks_profile = nano::rocksdb_config::table_profile::standard;
+	standard.accounts_profile = nano::rocksdb_config::table_profile::standard;
+	standard.confirmation_height_profile = nano::rocksdb_config::table_profile::standard;
+	run_profile ("standard", standard);
+
+	nano::rocksdb_config tuned;
+	tuned.enable = true;
+	tuned.pending_profile = nano::rocksdb_config::table_profile::prefix_bloom;
+	tuned.blocks_profile = nano::rocksdb_config::table_profile::point_lookup;
+	tuned.accounts_profile = nano::rocksdb_config::table_profile::hash_index;
+	tuned.confirmation_height_profile = nano::rocksdb_config::table_profile::hash_index;
+	run_profile ("tuned", tuned);
+}